@@ -25,16 +25,20 @@
 #include "Catalog/Catalog.h"
 #include "Logger/Logger.h"
 #include "OSDependent/omnisci_path.h"
+#include "Shared/Restriction.h"
 #include "Shared/SystemParameters.h"
 #include "Shared/ThriftClient.h"
 #include "Shared/fixautotools.h"
 #include "Shared/mapd_shared_ptr.h"
 #include "Shared/measure.h"
+#include "StringDictionary/LruCache.hpp"
 #include "ThriftHandler/QueryState.h"
 
 #include <thrift/protocol/TBinaryProtocol.h>
 #include <thrift/transport/TSocket.h>
 #include <thrift/transport/TTransportUtils.h>
+#include <cctype>
+#include <optional>
 #include <type_traits>
 
 #ifdef _MSC_VER
@@ -351,6 +355,135 @@ int Calcite::ping(int retry_num, int max_retry) {
   }
 }
 
+/**
+ * Plans returned by the Calcite server, by SQL text and the session context the plan
+ * depends on. Calcite plans as its internal user, and the privileges of the session
+ * user are checked against the objects accessed by the plan on every query, so the
+ * plans stay valid until the tables, views or functions they use change.
+ *
+ * Only the round trip to the Calcite server is saved: literals are part of the key,
+ * so queries which differ in their filter values don't share a plan, and the cached
+ * RA JSON is still parsed on every query.
+ */
+class CalcitePlanCache {
+ public:
+  CalcitePlanCache(const size_t max_size) : max_size_(max_size), plans_(max_size) {}
+
+  std::optional<TPlanResult> get(const std::string& key) {
+    if (!max_size_) {
+      return std::nullopt;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto plan = plans_.get(key);
+    if (!plan) {
+      ++misses_;
+      return std::nullopt;
+    }
+    ++hits_;
+    return *plan;
+  }
+
+  void put(const std::string& key, const TPlanResult& plan) {
+    if (!max_size_) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    plans_.put(key, TPlanResult(plan));
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    plans_.clear();
+  }
+
+  size_t getHits() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+
+  size_t getMisses() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+  }
+
+ private:
+  const size_t max_size_;
+  std::mutex mutex_;
+  size_t hits_{0};
+  size_t misses_{0};
+  LruCache<std::string, TPlanResult> plans_;
+};
+
+namespace {
+
+// Collapses the whitespace outside of quotes and drops the trailing semicolons, so that
+// queries which only differ in formatting share a plan. Queries with comments are kept
+// as they are, since a line comment ends at a newline.
+std::string normalize_sql(const std::string& sql_string) {
+  std::string normalized;
+  normalized.reserve(sql_string.size());
+  char quote{0};
+  bool pending_space{false};
+  for (size_t i = 0; i < sql_string.size(); ++i) {
+    const char c = sql_string[i];
+    if (quote) {
+      normalized += c;
+      if (c == quote) {
+        quote = 0;
+      }
+      continue;
+    }
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      pending_space = !normalized.empty();
+      continue;
+    }
+    const char next = i + 1 < sql_string.size() ? sql_string[i + 1] : 0;
+    if ((c == '-' && next == '-') || (c == '/' && next == '*')) {
+      return sql_string;
+    }
+    if (pending_space) {
+      normalized += ' ';
+      pending_space = false;
+    }
+    if (c == '\'' || c == '"' || c == '`') {
+      quote = c;
+    }
+    normalized += c;
+  }
+  while (!quote && !normalized.empty() &&
+         (normalized.back() == ';' || normalized.back() == ' ')) {
+    normalized.pop_back();
+  }
+  return normalized;
+}
+
+std::string get_plan_cache_key(const Catalog_Namespace::SessionInfo& session_info,
+                               const std::string& sql_string,
+                               const bool legacy_syntax,
+                               const bool is_explain,
+                               const bool is_view_optimize) {
+  std::string key = session_info.getCatalog().getCurrentDB().dbName;
+  key += '\0';
+  key += session_info.get_currentUser().userName;
+  key += '\0';
+  key += legacy_syntax ? '1' : '0';
+  key += is_explain ? '1' : '0';
+  key += is_view_optimize ? '1' : '0';
+  const auto restriction = session_info.get_restriction_ptr();
+  if (restriction) {
+    key += restriction->column;
+    for (const auto& value : restriction->values) {
+      key += '\0';
+      key += value;
+    }
+  }
+  key += '\0';
+  key += normalize_sql(sql_string);
+  return key;
+}
+
+}  // namespace
+
 Calcite::Calcite(const int db_port,
                  const int calcite_port,
                  const std::string& data_dir,
@@ -361,17 +494,24 @@ Calcite::Calcite(const int db_port,
     : server_available_(false)
     , service_timeout_(service_timeout)
     , service_keepalive_(service_keepalive) {
-  init(db_port, calcite_port, data_dir, calcite_max_mem, udf_filename);
+  init(db_port,
+       calcite_port,
+       data_dir,
+       calcite_max_mem,
+       udf_filename,
+       SystemParameters().calcite_plan_cache_size);
 }
 
 void Calcite::init(const int db_port,
                    const int calcite_port,
                    const std::string& data_dir,
                    const size_t calcite_max_mem,
-                   const std::string& udf_filename) {
+                   const std::string& udf_filename,
+                   const size_t plan_cache_size) {
   LOG(INFO) << "Creating Calcite Handler,  Calcite Port is " << calcite_port
             << " base data dir is " << data_dir;
   connMgr_ = std::make_shared<ThriftClientConnection>();
+  plan_cache_ = std::make_unique<CalcitePlanCache>(plan_cache_size);
   if (calcite_port < 0) {
     CHECK(false) << "JNI mode no longer supported.";
   }
@@ -402,10 +542,25 @@ Calcite::Calcite(const SystemParameters& system_parameters,
        system_parameters.calcite_port,
        data_dir,
        system_parameters.calcite_max_mem,
-       udf_filename);
+       udf_filename,
+       system_parameters.calcite_plan_cache_size);
+}
+
+void Calcite::setPlanCacheSize(const size_t plan_cache_size) {
+  plan_cache_ = std::make_unique<CalcitePlanCache>(plan_cache_size);
+}
+
+size_t Calcite::getPlanCacheHits() const {
+  return plan_cache_->getHits();
+}
+
+size_t Calcite::getPlanCacheMisses() const {
+  return plan_cache_->getMisses();
 }
 
 void Calcite::updateMetadata(std::string catalog, std::string table) {
+  // called on every change of a table or view, which the cached plans may depend on
+  clearPlanCache();
   if (server_available_) {
     auto ms = measure<>::execution([&]() {
       auto clientP = getClient(remote_calcite_port_);
@@ -418,6 +573,10 @@ void Calcite::updateMetadata(std::string catalog, std::string table) {
   }
 }
 
+void Calcite::clearPlanCache() {
+  plan_cache_->clear();
+}
+
 void checkPermissionForTables(const Catalog_Namespace::SessionInfo& session_info,
                               std::vector<std::vector<std::string>> tableOrViewNames,
                               AccessPrivileges tablePrivs,
@@ -466,13 +625,35 @@ TPlanResult Calcite::process(
     const bool is_view_optimize,
     const bool check_privileges,
     const std::string& calcite_session_id) {
-  TPlanResult result = processImpl(query_state_proxy,
-                                   std::move(sql_string),
-                                   filter_push_down_info,
-                                   legacy_syntax,
-                                   is_explain,
-                                   is_view_optimize,
-                                   calcite_session_id);
+  // the queries with filter push down are planned again after a first execution, their
+  // plans aren't reused
+  std::optional<std::string> plan_cache_key;
+  if (filter_push_down_info.empty()) {
+    plan_cache_key =
+        get_plan_cache_key(*query_state_proxy.getQueryState().getConstSessionInfo(),
+                           sql_string,
+                           legacy_syntax,
+                           is_explain,
+                           is_view_optimize);
+  }
+  auto cached_result = plan_cache_key ? plan_cache_->get(*plan_cache_key) : std::nullopt;
+  TPlanResult result;
+  if (cached_result) {
+    VLOG(1) << "Reusing cached Calcite plan";
+    result = std::move(*cached_result);
+    result.execution_time_ms = 0;
+  } else {
+    result = processImpl(query_state_proxy,
+                         std::move(sql_string),
+                         filter_push_down_info,
+                         legacy_syntax,
+                         is_explain,
+                         is_view_optimize,
+                         calcite_session_id);
+    if (plan_cache_key) {
+      plan_cache_->put(*plan_cache_key, result);
+    }
+  }
   if (check_privileges && !is_explain) {
     checkAccessedObjectsPrivileges(query_state_proxy, result);
   }
@@ -688,6 +869,7 @@ void Calcite::setRuntimeExtensionFunctions(
     const std::vector<TUserDefinedFunction>& udfs,
     const std::vector<TUserDefinedTableFunction>& udtfs,
     bool isruntime) {
+  clearPlanCache();
   if (server_available_) {
     auto clientP = getClient(remote_calcite_port_);
     clientP.first->setRuntimeExtensionFunctions(udfs, udtfs, isruntime);
@@ -28,6 +28,7 @@
 
 #include <thrift/transport/TTransport.h>
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -40,6 +41,7 @@ constexpr char const* kCalciteUserPassword = "HyperInteractive";
 }  // namespace
 
 class CalciteServerClient;
+class CalcitePlanCache;
 
 namespace Catalog_Namespace {
 class SessionInfo;
@@ -89,6 +91,11 @@ class Calcite final {
   std::string getExtensionFunctionWhitelist();
   std::string getUserDefinedFunctionWhitelist();
   void updateMetadata(std::string catalog, std::string table);
+  void clearPlanCache();
+  // replaces the plan cache and its counters, not to be called while queries are planned
+  void setPlanCacheSize(const size_t plan_cache_size);
+  size_t getPlanCacheHits() const;
+  size_t getPlanCacheMisses() const;
   void close_calcite_server(bool log = true);
   ~Calcite();
   std::string getRuntimeExtensionFunctionWhitelist();
@@ -103,7 +110,8 @@ class Calcite final {
             const int port,
             const std::string& data_dir,
             const size_t calcite_max_mem,
-            const std::string& udf_filename);
+            const std::string& udf_filename,
+            const size_t plan_cache_size);
   void runServer(const int db_port,
                  const int port,
                  const std::string& data_dir,
@@ -136,4 +144,6 @@ class Calcite final {
   std::string ssl_ca_file_;
   std::string db_config_file_;
   std::once_flag shutdown_once_flag_;
+  // plans of the queries without filter push down, by SQL text and session context
+  std::unique_ptr<CalcitePlanCache> plan_cache_;
 };
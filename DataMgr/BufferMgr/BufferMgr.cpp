@@ -22,6 +22,7 @@
 #include "DataMgr/BufferMgr/BufferMgr.h"
 
 #include <algorithm>
+#include <deque>
 #include <iomanip>
 #include <limits>
 
@@ -103,6 +104,7 @@ void BufferMgr::clear() {
   slabs_.clear();
   slab_segments_.clear();
   unsized_segs_.clear();
+  free_segs_.clear();
   buffer_epoch_ = 0;
 }
 
@@ -161,6 +163,8 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
   while (num_pages < num_pages_requested) {
     if (evict_it->mem_status == USED) {
       CHECK(evict_it->buffer->getPinCount() < 1);
+    } else {
+      removeFreeSegment(evict_it);
     }
     num_pages += evict_it->num_pages;
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
@@ -180,11 +184,14 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
     size_t excess_pages = num_pages - num_pages_requested;
     if (evict_it != slab_segments_[slab_num].end() &&
         evict_it->mem_status == FREE) {  // need to merge with current page
+      removeFreeSegment(evict_it);
       evict_it->start_page = start_page + num_pages_requested;
       evict_it->num_pages += excess_pages;
+      addFreeSegment(evict_it);
     } else {  // need to insert a free seg before evict_it for excess_pages
       BufferSeg free_seg(start_page + num_pages_requested, excess_pages, FREE);
-      slab_segments_[slab_num].insert(evict_it, free_seg);
+      free_seg.slab_num = slab_num;
+      addFreeSegment(slab_segments_[slab_num].insert(evict_it, free_seg));
     }
   }
   return data_seg_it;
@@ -209,9 +216,15 @@ BufferList::iterator BufferMgr::reserveBuffer(
         next_it->num_pages >= num_pages_extra_needed) {
       // Then we can just use the next BufferSeg which happens to be free
       size_t leftover_pages = next_it->num_pages - num_pages_extra_needed;
+      removeFreeSegment(next_it);
       seg_it->num_pages = num_pages_requested;
-      next_it->num_pages = leftover_pages;
-      next_it->start_page = seg_it->start_page + seg_it->num_pages;
+      if (leftover_pages > 0) {
+        next_it->num_pages = leftover_pages;
+        next_it->start_page = seg_it->start_page + seg_it->num_pages;
+        addFreeSegment(next_it);
+      } else {
+        slab_segments_[slab_num].erase(next_it);
+      }
       return seg_it;
     }
   }
@@ -245,32 +258,35 @@ BufferList::iterator BufferMgr::reserveBuffer(
   return new_seg_it;
 }
 
-BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
-                                                     const size_t num_pages_requested) {
-  for (auto buffer_it = slab_segments_[slab_num].begin();
-       buffer_it != slab_segments_[slab_num].end();
-       ++buffer_it) {
-    if (buffer_it->mem_status == FREE && buffer_it->num_pages >= num_pages_requested) {
-      // startPage doesn't change
-      size_t excess_pages = buffer_it->num_pages - num_pages_requested;
-      buffer_it->num_pages = num_pages_requested;
-      buffer_it->mem_status = USED;
-      buffer_it->last_touched = buffer_epoch_++;
-      buffer_it->slab_num = slab_num;
-      if (excess_pages > 0) {
-        BufferSeg free_seg(
-            buffer_it->start_page + num_pages_requested, excess_pages, FREE);
-        auto temp_it = buffer_it;  // this should make a copy and not be a reference
-        // - as we do not want to increment buffer_it
-        temp_it++;
-        slab_segments_[slab_num].insert(temp_it, free_seg);
-      }
-      return buffer_it;
-    }
+void BufferMgr::addFreeSegment(BufferList::iterator seg_it) {
+  CHECK_GE(seg_it->slab_num, 0);
+  seg_it->mem_status = FREE;
+  const auto inserted = free_segs_.insert(seg_it).second;
+  CHECK(inserted);
+}
+
+void BufferMgr::removeFreeSegment(BufferList::iterator seg_it) {
+  CHECK_EQ(seg_it->mem_status, FREE);
+  const auto erased = free_segs_.erase(seg_it);
+  CHECK_EQ(erased, size_t(1));
+}
+
+BufferList::iterator BufferMgr::useFreeSegment(BufferList::iterator seg_it,
+                                               const size_t num_pages_requested) {
+  CHECK_GE(seg_it->num_pages, num_pages_requested);
+  removeFreeSegment(seg_it);
+  // startPage doesn't change
+  size_t excess_pages = seg_it->num_pages - num_pages_requested;
+  seg_it->num_pages = num_pages_requested;
+  seg_it->mem_status = USED;
+  seg_it->last_touched = buffer_epoch_++;
+  if (excess_pages > 0) {
+    const auto slab_num = seg_it->slab_num;
+    BufferSeg free_seg(seg_it->start_page + num_pages_requested, excess_pages, FREE);
+    free_seg.slab_num = slab_num;
+    addFreeSegment(slab_segments_[slab_num].insert(std::next(seg_it), free_seg));
   }
-  // If here then we did not find a free buffer of sufficient size in this slab,
-  // return the end iterator
-  return slab_segments_[slab_num].end();
+  return seg_it;
 }
 
 BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
@@ -279,15 +295,14 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
     throw TooBigForSlab(num_bytes);
   }
 
-  size_t num_slabs = slab_segments_.size();
-
-  for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
-    auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
-    if (seg_it != slab_segments_[slab_num].end()) {
-      return seg_it;
-    }
+  // best fit, to keep the large free segments for the large buffers
+  const auto free_seg_it = free_segs_.lower_bound(num_pages_requested);
+  if (free_seg_it != free_segs_.end()) {
+    return useFreeSegment(*free_seg_it, num_pages_requested);
   }
 
+  size_t num_slabs = slab_segments_.size();
+
   // If we're here then we didn't find a free segment of sufficient size
   // First we see if we can add another slab
   while (!allocations_capped_ && num_pages_allocated_ < max_buffer_pool_num_pages_) {
@@ -309,10 +324,13 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
       }
       // if here then addSlab succeeded
       num_pages_allocated_ += current_max_slab_page_size_;
-      return findFreeBufferInSlab(
-          num_slabs,
-          num_pages_requested);  // has to succeed since we made sure to request a slab
-                                 // big enough to accomodate request
+      CHECK_EQ(slab_segments_.size(), num_slabs + 1);
+      auto slab_seg_it = slab_segments_[num_slabs].begin();
+      slab_seg_it->slab_num = num_slabs;
+      addFreeSegment(slab_seg_it);
+      // has to succeed since we made sure to request a slab big enough to accomodate
+      // request
+      return useFreeSegment(slab_seg_it, num_pages_requested);
     } catch (std::runtime_error& error) {  // failed to allocate slab
       LOG(INFO) << "ALLOCATION Attempted slab of " << current_max_slab_page_size_
                 << " pages (" << current_max_slab_page_size_ * page_size_ << "B) failed "
@@ -344,82 +362,85 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
   }
 
   // If here then we can't add a slab - so we need to evict
+  auto [best_eviction_start, best_eviction_start_slab] =
+      findEvictionStart(num_pages_requested);
+  if (best_eviction_start_slab < 0) {
+    LOG(ERROR) << "ALLOCATION failed to find " << num_bytes << "B throwing out of memory "
+               << getStringMgrType() << ":" << device_id_;
+    VLOG(2) << printSlabs();
+    throw OutOfMemory(num_bytes);
+  }
+  LOG(INFO) << "ALLOCATION failed to find " << num_bytes << "B free. Forcing Eviction."
+            << " Eviction start " << best_eviction_start->start_page
+            << " Number pages requested " << num_pages_requested
+            << " Best Eviction Start Slab " << best_eviction_start_slab << " "
+            << getStringMgrType() << ":" << device_id_;
+  return evict(best_eviction_start, num_pages_requested, best_eviction_start_slab);
+}
 
+std::pair<BufferList::iterator, int> BufferMgr::findEvictionStart(
+    const size_t num_pages_requested) {
   size_t min_score = std::numeric_limits<size_t>::max();
   // We're going for lowest score here, like golf
-  // This is because score is the sum of the lastTouched score for all pages evicted.
+  // This is because score is the max of the lastTouched score for all pages evicted.
   // Evicting fewer pages and older pages will lower the score
-  BufferList::iterator best_eviction_start = slab_segments_[0].end();
+  BufferList::iterator best_eviction_start;
   int best_eviction_start_slab = -1;
-  int slab_num = 0;
 
-  for (auto slab_it = slab_segments_.begin(); slab_it != slab_segments_.end();
-       ++slab_it, ++slab_num) {
-    for (auto buffer_it = slab_it->begin(); buffer_it != slab_it->end(); ++buffer_it) {
-      // Note there are some shortcuts we could take here - like we should never consider
-      // a USED buffer coming after a free buffer as we would have used the FREE buffer,
-      // but we won't worry about this for now
-
-      // We can't evict pinned buffers - only normal usedbuffers
-
-      // if (buffer_it->mem_status == FREE || buffer_it->buffer->getPinCount() == 0) {
-      size_t page_count = 0;
-      size_t score = 0;
-      bool solution_found = false;
-      auto evict_it = buffer_it;
-      for (; evict_it != slab_segments_[slab_num].end(); ++evict_it) {
-        // pinCount should never go up - only down because we have
-        // global lock on buffer pool and pin count only increments
-        // on getChunk
-        if (evict_it->mem_status == USED && evict_it->buffer->getPinCount() > 0) {
-          break;
-        }
-        page_count += evict_it->num_pages;
-        if (evict_it->mem_status == USED) {
-          // MAT changed from
-          // score += evictIt->lastTouched;
-          // Issue was thrashing when going from 8M fragment size chunks back to 64M
-          // basically the large chunks were being evicted prior to small as many small
-          // chunk score was larger than one large chunk so it always would evict a large
-          // chunk so under memory pressure a query would evict its own current chunks and
-          // cause reloads rather than evict several smaller unused older chunks.
-          score = std::max(score, static_cast<size_t>(evict_it->last_touched));
+  // pinCount should never go up - only down because we have
+  // global lock on buffer pool and pin count only increments
+  // on getChunk
+  const auto is_pinned = [](const BufferList::iterator& seg_it) {
+    return seg_it->mem_status == USED && seg_it->buffer->getPinCount() > 0;
+  };
+  for (size_t slab_num = 0; slab_num < slab_segments_.size(); ++slab_num) {
+    auto& slab = slab_segments_[slab_num];
+    // Slides a window over the segments of the slab, with the shortest run of
+    // unpinned segments large enough for the request starting at each segment. The
+    // window end only moves forward, and the used segments of the window are kept in
+    // decreasing last touched order so the score is the first one.
+    auto window_start = slab.begin();
+    auto window_end = slab.begin();
+    size_t page_count = 0;
+    std::deque<BufferList::iterator> used_segs;
+    while (window_start != slab.end()) {
+      while ((page_count < num_pages_requested || window_end == window_start) &&
+             window_end != slab.end() && !is_pinned(window_end)) {
+        page_count += window_end->num_pages;
+        if (window_end->mem_status == USED) {
+          while (!used_segs.empty() &&
+                 used_segs.back()->last_touched <= window_end->last_touched) {
+            used_segs.pop_back();
+          }
+          used_segs.push_back(window_end);
         }
-        if (page_count >= num_pages_requested) {
-          solution_found = true;
+        ++window_end;
+      }
+      if (page_count < num_pages_requested || window_end == window_start) {
+        if (window_end == slab.end()) {
+          // this means that every segment after this will fail as well
           break;
         }
+        // the window ends at a pinned segment, restart after it
+        window_start = ++window_end;
+        page_count = 0;
+        used_segs.clear();
+        continue;
       }
-      if (solution_found && score < min_score) {
+      const size_t score = used_segs.empty() ? 0 : used_segs.front()->last_touched;
+      if (score < min_score) {
         min_score = score;
-        best_eviction_start = buffer_it;
+        best_eviction_start = window_start;
         best_eviction_start_slab = slab_num;
-      } else if (evict_it == slab_segments_[slab_num].end()) {
-        // this means that every segment after this will fail as well, so our search has
-        // proven futile
-        // throw std::runtime_error ("Couldn't evict chunks to get free space");
-        break;
-        // in reality we should try to rearrange the buffer to get more contiguous free
-        // space
       }
-      // other possibility is ending at PINNED - do nothing in this case
-      //}
+      page_count -= window_start->num_pages;
+      if (!used_segs.empty() && used_segs.front() == window_start) {
+        used_segs.pop_front();
+      }
+      ++window_start;
     }
   }
-  if (best_eviction_start == slab_segments_[0].end()) {
-    LOG(ERROR) << "ALLOCATION failed to find " << num_bytes << "B throwing out of memory "
-               << getStringMgrType() << ":" << device_id_;
-    VLOG(2) << printSlabs();
-    throw OutOfMemory(num_bytes);
-  }
-  LOG(INFO) << "ALLOCATION failed to find " << num_bytes << "B free. Forcing Eviction."
-            << " Eviction start " << best_eviction_start->start_page
-            << " Number pages requested " << num_pages_requested
-            << " Best Eviction Start Slab " << best_eviction_start_slab << " "
-            << getStringMgrType() << ":" << device_id_;
-  best_eviction_start =
-      evict(best_eviction_start, num_pages_requested, best_eviction_start_slab);
-  return best_eviction_start;
+  return {best_eviction_start, best_eviction_start_slab};
 }
 
 std::string BufferMgr::printSlab(size_t slab_num) {
@@ -649,6 +670,7 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
       // LOG(INFO) << "PrevIt: " << " " << getStringMgrType() << ":" << device_id_;
       // printSeg(prev_it);
       if (prev_it->mem_status == FREE) {
+        removeFreeSegment(prev_it);
         seg_it->start_page = prev_it->start_page;
         seg_it->num_pages += prev_it->num_pages;
         slab_segments_[slab_num].erase(prev_it);
@@ -657,13 +679,14 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
     auto next_it = std::next(seg_it);
     if (next_it != slab_segments_[slab_num].end()) {
       if (next_it->mem_status == FREE) {
+        removeFreeSegment(next_it);
         seg_it->num_pages += next_it->num_pages;
         slab_segments_[slab_num].erase(next_it);
       }
     }
-    seg_it->mem_status = FREE;
     // seg_it->pinCount = 0;
     seg_it->buffer = 0;
+    addFreeSegment(seg_it);
   }
 }
 
@@ -30,6 +30,8 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <set>
+#include <tuple>
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/AbstractBufferMgr.h"
@@ -86,6 +88,29 @@ using namespace Data_Namespace;
 
 namespace Buffer_Namespace {
 
+/**
+ * Orders the free segments of all the slabs by size, then by position, so the best fit
+ * for an allocation is found with a lower bound on the number of pages. The segments
+ * must be removed from the index before their size or position changes.
+ */
+struct FreeSegmentOrder {
+  using is_transparent = void;
+
+  bool operator()(const BufferList::iterator& lhs,
+                  const BufferList::iterator& rhs) const {
+    return std::make_tuple(lhs->num_pages, lhs->slab_num, lhs->start_page) <
+           std::make_tuple(rhs->num_pages, rhs->slab_num, rhs->start_page);
+  }
+
+  bool operator()(const BufferList::iterator& lhs, const size_t num_pages) const {
+    return lhs->num_pages < num_pages;
+  }
+
+  bool operator()(const size_t num_pages, const BufferList::iterator& rhs) const {
+    return num_pages < rhs->num_pages;
+  }
+};
+
 /**
  * @class   BufferMgr
  * @brief
@@ -185,8 +210,10 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   BufferMgr(const BufferMgr&);             // private copy constructor
   BufferMgr& operator=(const BufferMgr&);  // private assignment
   void removeSegment(BufferList::iterator& seg_it);
-  BufferList::iterator findFreeBufferInSlab(const size_t slab_num,
-                                            const size_t num_pages_requested);
+  void addFreeSegment(BufferList::iterator seg_it);
+  void removeFreeSegment(BufferList::iterator seg_it);
+  BufferList::iterator useFreeSegment(BufferList::iterator seg_it,
+                                      const size_t num_pages_requested);
   int getBufferId();
   virtual void addSlab(const size_t slab_size) = 0;
   virtual void freeAllMem() = 0;
@@ -211,14 +238,24 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   unsigned int buffer_epoch_;
 
   BufferList unsized_segs_;
+  std::set<BufferList::iterator, FreeSegmentOrder> free_segs_;
 
   BufferList::iterator evict(BufferList::iterator& evict_start,
                              const size_t num_pages_requested,
                              const int slab_num);
+  /**
+   * @brief Finds the contiguous unpinned segments to evict for a buffer of the given
+   * number of pages, in a single pass over each slab
+   *
+   * @return The first segment to evict and its slab, or -1 as the slab if there is no
+   * such run of segments
+   */
+  std::pair<BufferList::iterator, int> findEvictionStart(
+      const size_t num_pages_requested);
   /**
    * @brief Gets a buffer of required size and returns an iterator to it
    *
-   * If possible, this function will just select a free buffer of
+   * If possible, this function will just select the smallest free buffer of
    * sufficient size and use that. If not, it will evict as many
    * non-pinned but used buffers as needed to have enough space for the
    * buffer
@@ -0,0 +1,307 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/CompressedIntEncoding.h"
+
+#include <cstring>
+#include <limits>
+
+#include "Logger/Logger.h"
+
+namespace {
+
+int64_t read_int(const int8_t* ptr, const size_t width) {
+  switch (width) {
+    case 1:
+      return *ptr;
+    case 2: {
+      int16_t val;
+      std::memcpy(&val, ptr, sizeof(val));
+      return val;
+    }
+    case 4: {
+      int32_t val;
+      std::memcpy(&val, ptr, sizeof(val));
+      return val;
+    }
+    case 8: {
+      int64_t val;
+      std::memcpy(&val, ptr, sizeof(val));
+      return val;
+    }
+    default:
+      UNREACHABLE() << "Invalid integer width " << width;
+  }
+  return 0;
+}
+
+void write_int(int8_t* ptr, const size_t width, const int64_t val) {
+  switch (width) {
+    case 1:
+      *ptr = static_cast<int8_t>(val);
+      break;
+    case 2: {
+      const auto narrow_val = static_cast<int16_t>(val);
+      std::memcpy(ptr, &narrow_val, sizeof(narrow_val));
+      break;
+    }
+    case 4: {
+      const auto narrow_val = static_cast<int32_t>(val);
+      std::memcpy(ptr, &narrow_val, sizeof(narrow_val));
+      break;
+    }
+    case 8:
+      std::memcpy(ptr, &val, sizeof(val));
+      break;
+    default:
+      UNREACHABLE() << "Invalid integer width " << width;
+  }
+}
+
+int64_t get_null_value(const size_t width) {
+  return width == sizeof(int64_t) ? std::numeric_limits<int64_t>::min()
+                                  : -(int64_t(1) << (8 * width - 1));
+}
+
+}  // namespace
+
+namespace run_length_encoding {
+
+int64_t get_run_count(const int8_t* encoded) {
+  return read_int(encoded, sizeof(int64_t));
+}
+
+size_t get_encoded_size(const int8_t* encoded, const size_t value_width) {
+  return kHeaderSize + get_run_count(encoded) * 2 * get_entry_width(value_width);
+}
+
+void decode(const int8_t* encoded,
+            const size_t value_width,
+            const size_t num_elems,
+            int8_t* decoded) {
+  const auto entry_width = get_entry_width(value_width);
+  const auto run_count = get_run_count(encoded);
+  const auto runs = encoded + kHeaderSize;
+  size_t pos = 0;
+  for (int64_t run_idx = 0; run_idx < run_count && pos < num_elems; ++run_idx) {
+    const auto run_end = static_cast<size_t>(
+        read_int(runs + 2 * run_idx * entry_width, entry_width));
+    const auto val = read_int(runs + (2 * run_idx + 1) * entry_width, entry_width);
+    for (; pos < std::min(run_end, num_elems); ++pos) {
+      write_int(decoded + pos * value_width, value_width, val);
+    }
+  }
+  CHECK_EQ(pos, num_elems);
+}
+
+std::vector<int8_t> encode(const int8_t* values,
+                           const size_t value_width,
+                           const size_t num_elems) {
+  const auto entry_width = get_entry_width(value_width);
+  std::vector<int8_t> encoded(kHeaderSize);
+  int64_t run_count = 0;
+  for (size_t pos = 0; pos < num_elems; ++pos) {
+    const auto val = read_int(values + pos * value_width, value_width);
+    if (run_count) {
+      const auto last_run = encoded.data() + encoded.size() - 2 * entry_width;
+      if (read_int(last_run + entry_width, entry_width) == val) {
+        write_int(last_run, entry_width, pos + 1);
+        continue;
+      }
+    }
+    encoded.resize(encoded.size() + 2 * entry_width);
+    const auto run = encoded.data() + encoded.size() - 2 * entry_width;
+    write_int(run, entry_width, pos + 1);
+    write_int(run + entry_width, entry_width, val);
+    ++run_count;
+  }
+  write_int(encoded.data(), sizeof(int64_t), run_count);
+  return encoded;
+}
+
+}  // namespace run_length_encoding
+
+namespace diff_encoding {
+
+size_t get_delta_width(const int8_t* encoded) {
+  return read_int(encoded, sizeof(int32_t));
+}
+
+size_t get_encoded_size(const size_t num_elems, const size_t delta_width) {
+  if (!num_elems) {
+    return kHeaderSize;
+  }
+  const auto full_blocks = num_elems / kBlockSize;
+  const auto last_block_elems = num_elems % kBlockSize;
+  return kHeaderSize + full_blocks * get_block_bytes(delta_width) +
+         (last_block_elems ? sizeof(int64_t) + last_block_elems * delta_width : 0);
+}
+
+int64_t get_block_base(const int8_t* values,
+                       const size_t value_width,
+                       const size_t num_elems,
+                       const size_t delta_width) {
+  if (delta_width == sizeof(int64_t)) {
+    return 0;
+  }
+  const auto null_val = get_null_value(value_width);
+  for (size_t pos = 0; pos < std::min(num_elems, kBlockSize); ++pos) {
+    const auto val = read_int(values + pos * value_width, value_width);
+    if (val != null_val) {
+      return val;
+    }
+  }
+  return 0;
+}
+
+bool encode_value(const int64_t value,
+                  const size_t value_width,
+                  const int64_t base,
+                  const size_t delta_width,
+                  int8_t* delta) {
+  if (value == get_null_value(value_width)) {
+    write_int(delta, delta_width, get_null_value(delta_width));
+    return true;
+  }
+  if ((base > 0 && value < std::numeric_limits<int64_t>::min() + base) ||
+      (base < 0 && value > std::numeric_limits<int64_t>::max() + base)) {
+    return false;
+  }
+  const auto diff = value - base;
+  if (delta_width < sizeof(int64_t)) {
+    const auto max_delta = (int64_t(1) << (8 * delta_width - 1)) - 1;
+    // the lowest delta is taken by the null sentinel
+    if (diff > max_delta || diff <= -max_delta - 1) {
+      return false;
+    }
+  } else if (diff == std::numeric_limits<int64_t>::min()) {
+    return false;
+  }
+  write_int(delta, delta_width, diff);
+  return true;
+}
+
+size_t get_required_delta_width(const int8_t* values,
+                                const size_t value_width,
+                                const size_t num_elems,
+                                const size_t min_delta_width) {
+  size_t delta_width = min_delta_width;
+  int8_t delta[sizeof(int64_t)];
+  for (size_t block_start = 0; block_start < num_elems; block_start += kBlockSize) {
+    const auto block_values = values + block_start * value_width;
+    const auto block_elems = std::min(kBlockSize, num_elems - block_start);
+    auto base = get_block_base(block_values, value_width, block_elems, delta_width);
+    for (size_t pos = 0; pos < block_elems; ++pos) {
+      const auto val = read_int(block_values + pos * value_width, value_width);
+      while (!encode_value(val, value_width, base, delta_width, delta)) {
+        // a delta width of 8 bytes fits any value
+        CHECK_LT(delta_width, sizeof(int64_t));
+        delta_width *= 2;
+        base = get_block_base(block_values, value_width, block_elems, delta_width);
+      }
+    }
+  }
+  return delta_width;
+}
+
+void decode(const int8_t* encoded,
+            const size_t value_width,
+            const size_t num_elems,
+            int8_t* decoded) {
+  const auto delta_width = get_delta_width(encoded);
+  const auto delta_null_val = get_null_value(delta_width);
+  const auto null_val = get_null_value(value_width);
+  for (size_t pos = 0; pos < num_elems; ++pos) {
+    const auto block =
+        encoded + kHeaderSize + (pos / kBlockSize) * get_block_bytes(delta_width);
+    const auto delta = read_int(
+        block + sizeof(int64_t) + (pos % kBlockSize) * delta_width, delta_width);
+    write_int(decoded + pos * value_width,
+              value_width,
+              delta == delta_null_val ? null_val
+                                      : read_int(block, sizeof(int64_t)) + delta);
+  }
+}
+
+std::vector<int8_t> encode(const int8_t* values,
+                           const size_t value_width,
+                           const size_t num_elems,
+                           const size_t delta_width) {
+  std::vector<int8_t> encoded(get_encoded_size(num_elems, delta_width));
+  write_int(encoded.data(), sizeof(int32_t), delta_width);
+  auto out = encoded.data() + kHeaderSize;
+  int64_t base = 0;
+  for (size_t pos = 0; pos < num_elems; ++pos) {
+    if (pos % kBlockSize == 0) {
+      base = get_block_base(
+          values + pos * value_width, value_width, num_elems - pos, delta_width);
+      write_int(out, sizeof(int64_t), base);
+      out += sizeof(int64_t);
+    }
+    CHECK(encode_value(read_int(values + pos * value_width, value_width),
+                       value_width,
+                       base,
+                       delta_width,
+                       out));
+    out += delta_width;
+  }
+  CHECK_EQ(out, encoded.data() + encoded.size());
+  return encoded;
+}
+
+}  // namespace diff_encoding
+
+size_t get_compressed_int_encoded_size(const SQLTypeInfo& ti,
+                                       const int8_t* encoded,
+                                       const size_t num_elems) {
+  if (!num_elems) {
+    // empty chunks have no header
+    return 0;
+  }
+  if (ti.get_compression() == kENCODING_RL) {
+    return run_length_encoding::get_encoded_size(encoded, ti.get_size());
+  }
+  CHECK_EQ(kENCODING_DIFF, ti.get_compression());
+  return diff_encoding::get_encoded_size(num_elems,
+                                         diff_encoding::get_delta_width(encoded));
+}
+
+void decode_compressed_ints(const SQLTypeInfo& ti,
+                            const int8_t* encoded,
+                            const size_t num_elems,
+                            int8_t* decoded) {
+  if (!num_elems) {
+    return;
+  }
+  if (ti.get_compression() == kENCODING_RL) {
+    run_length_encoding::decode(encoded, ti.get_size(), num_elems, decoded);
+    return;
+  }
+  CHECK_EQ(kENCODING_DIFF, ti.get_compression());
+  diff_encoding::decode(encoded, ti.get_size(), num_elems, decoded);
+}
+
+std::vector<int8_t> encode_compressed_ints(const SQLTypeInfo& ti,
+                                           const int8_t* values,
+                                           const size_t num_elems) {
+  if (ti.get_compression() == kENCODING_RL) {
+    return run_length_encoding::encode(values, ti.get_size(), num_elems);
+  }
+  CHECK_EQ(kENCODING_DIFF, ti.get_compression());
+  const auto delta_width = diff_encoding::get_required_delta_width(
+      values, ti.get_size(), num_elems, diff_encoding::get_min_delta_width(ti));
+  return diff_encoding::encode(values, ti.get_size(), num_elems, delta_width);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Chunk layouts of the run length (RL) and differential (DIFF) encodings of integer,
+ * decimal and date / time columns. Both store the logical values of the column, nulls
+ * included, so decoded values need no null adjustment. Generated code decodes them with
+ * the functions in QueryEngine/DecodersImpl.h, which must be kept in sync.
+ *
+ * RL: an int64_t run count followed by the runs, each made of the exclusive end position
+ * of the run and its value. Both are int32_t for types of up to 4 bytes, int64_t
+ * otherwise. A value is found with a binary search over the run ends.
+ *
+ * DIFF: an int32_t delta width in bytes and 4 bytes of padding, followed by blocks of
+ * kBlockSize values, each made of an int64_t base and signed deltas of the delta width
+ * from it. The lowest delta is the null sentinel. With a delta width of 8 the base is 0.
+ * A value is found in constant time.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Shared/sqltypes.h"
+
+namespace run_length_encoding {
+
+constexpr size_t kHeaderSize{sizeof(int64_t)};
+
+inline size_t get_entry_width(const size_t value_width) {
+  return value_width <= sizeof(int32_t) ? sizeof(int32_t) : sizeof(int64_t);
+}
+
+int64_t get_run_count(const int8_t* encoded);
+
+size_t get_encoded_size(const int8_t* encoded, const size_t value_width);
+
+void decode(const int8_t* encoded,
+            const size_t value_width,
+            const size_t num_elems,
+            int8_t* decoded);
+
+std::vector<int8_t> encode(const int8_t* values,
+                           const size_t value_width,
+                           const size_t num_elems);
+
+}  // namespace run_length_encoding
+
+namespace diff_encoding {
+
+constexpr size_t kHeaderSize{2 * sizeof(int32_t)};
+constexpr size_t kBlockSize{1024};
+
+inline size_t get_block_bytes(const size_t delta_width) {
+  return sizeof(int64_t) + kBlockSize * delta_width;
+}
+
+// the delta width new chunks start with, from the compression parameter in bits
+inline size_t get_min_delta_width(const SQLTypeInfo& ti) {
+  return ti.get_comp_param() ? ti.get_comp_param() / 8 : sizeof(int16_t);
+}
+
+size_t get_delta_width(const int8_t* encoded);
+
+size_t get_encoded_size(const size_t num_elems, const size_t delta_width);
+
+// the narrowest delta width, at least `min_delta_width`, which fits every block
+size_t get_required_delta_width(const int8_t* values,
+                                const size_t value_width,
+                                const size_t num_elems,
+                                const size_t min_delta_width);
+
+// the base of the block starting at `values`, from its first non-null value
+int64_t get_block_base(const int8_t* values,
+                       const size_t value_width,
+                       const size_t num_elems,
+                       const size_t delta_width);
+
+// writes the delta of `value` from `base`, false if it does not fit the delta width
+bool encode_value(const int64_t value,
+                  const size_t value_width,
+                  const int64_t base,
+                  const size_t delta_width,
+                  int8_t* delta);
+
+void decode(const int8_t* encoded,
+            const size_t value_width,
+            const size_t num_elems,
+            int8_t* decoded);
+
+std::vector<int8_t> encode(const int8_t* values,
+                           const size_t value_width,
+                           const size_t num_elems,
+                           const size_t delta_width);
+
+}  // namespace diff_encoding
+
+inline bool is_run_length_or_diff_encoded(const SQLTypeInfo& ti) {
+  return ti.get_compression() == kENCODING_RL || ti.get_compression() == kENCODING_DIFF;
+}
+
+/**
+ * Size in bytes of a RL or DIFF encoded chunk of `num_elems` values.
+ */
+size_t get_compressed_int_encoded_size(const SQLTypeInfo& ti,
+                                       const int8_t* encoded,
+                                       const size_t num_elems);
+
+/**
+ * Decodes a RL or DIFF encoded chunk into `num_elems` values of `ti.get_size()` bytes.
+ */
+void decode_compressed_ints(const SQLTypeInfo& ti,
+                            const int8_t* encoded,
+                            const size_t num_elems,
+                            int8_t* decoded);
+
+/**
+ * Encodes `num_elems` values of `ti.get_size()` bytes as a RL or DIFF chunk.
+ */
+std::vector<int8_t> encode_compressed_ints(const SQLTypeInfo& ti,
+                                           const int8_t* values,
+                                           const size_t num_elems);
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DIFF_ENCODER_H
+#define DIFF_ENCODER_H
+
+#include "AbstractBuffer.h"
+#include "CompressedIntEncoding.h"
+#include "NoneEncoder.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Stores a column of logical type T as blocks of deltas from a per block base, see
+ * CompressedIntEncoding.h for the layout. Appends which don't fit the delta width of the
+ * chunk re-encode it with a wider one, so the fragmenter keeps the readers of the table
+ * out while appending. The stats are the ones of the none encoded column.
+ */
+template <typename T>
+class DiffEncoder : public NoneEncoder<T> {
+ public:
+  DiffEncoder(Data_Namespace::AbstractBuffer* buffer, const size_t min_delta_width)
+      : NoneEncoder<T>(buffer), min_delta_width_(min_delta_width) {}
+
+  std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
+                                            const size_t num_elems_to_append,
+                                            const SQLTypeInfo&,
+                                            const bool replicating = false,
+                                            const int64_t offset = -1) override {
+    if (offset == 0 && num_elems_to_append >= this->num_elems_) {
+      this->resetChunkStats();
+      this->num_elems_ = 0;
+      this->buffer_->setSize(0);
+    } else if (offset != -1) {
+      throw std::runtime_error(
+          "Partial overwrite of a differentially encoded chunk is not supported.");
+    }
+    std::vector<T> replicated_data;
+    if (replicating) {
+      replicated_data.assign(num_elems_to_append, *reinterpret_cast<T*>(src_data));
+    }
+    const T* data =
+        replicating ? replicated_data.data() : reinterpret_cast<const T*>(src_data);
+    this->updateStats(reinterpret_cast<const int8_t*>(data), num_elems_to_append);
+    if (!appendDeltas(data, num_elems_to_append)) {
+      reencode(data, num_elems_to_append);
+    }
+    this->num_elems_ += num_elems_to_append;
+    if (!replicating) {
+      src_data += num_elems_to_append * sizeof(T);
+    }
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    this->getMetadata(chunk_metadata);
+    return chunk_metadata;
+  }
+
+  void updateStatsEncoded(const int8_t* const dst_data,
+                          const size_t num_elements) override {
+    UNREACHABLE() << "Differentially encoded chunks can't be filled in place.";
+  }
+
+ private:
+  // appends to the chunk with its current delta width, returns false if a value doesn't
+  // fit it
+  bool appendDeltas(const T* data, const size_t num_elems) {
+    using namespace diff_encoding;
+    if (!num_elems) {
+      return true;
+    }
+    auto buffer = this->buffer_;
+    const auto values = reinterpret_cast<const int8_t*>(data);
+    if (!this->num_elems_) {
+      const auto delta_width =
+          get_required_delta_width(values, sizeof(T), num_elems, min_delta_width_);
+      auto encoded = encode(values, sizeof(T), num_elems, delta_width);
+      buffer->write(encoded.data(), encoded.size(), 0);
+      return true;
+    }
+    int32_t delta_width{0};
+    buffer->read(reinterpret_cast<int8_t*>(&delta_width), sizeof(delta_width), 0);
+    const auto tail_offset = get_encoded_size(this->num_elems_, delta_width);
+    CHECK_EQ(tail_offset, buffer->size());
+    int64_t base{0};
+    if (this->num_elems_ % kBlockSize) {
+      const auto block_offset =
+          kHeaderSize + (this->num_elems_ / kBlockSize) * get_block_bytes(delta_width);
+      buffer->read(reinterpret_cast<int8_t*>(&base), sizeof(base), block_offset);
+    }
+    std::vector<int8_t> tail(
+        get_encoded_size(this->num_elems_ + num_elems, delta_width) - tail_offset);
+    auto out = tail.data();
+    for (size_t i = 0; i < num_elems; ++i) {
+      if ((this->num_elems_ + i) % kBlockSize == 0) {
+        base = get_block_base(
+            values + i * sizeof(T), sizeof(T), num_elems - i, delta_width);
+        std::memcpy(out, &base, sizeof(base));
+        out += sizeof(base);
+      }
+      if (!encode_value(data[i], sizeof(T), base, delta_width, out)) {
+        return false;
+      }
+      out += delta_width;
+    }
+    CHECK_EQ(out, tail.data() + tail.size());
+    buffer->append(tail.data(), tail.size());
+    return true;
+  }
+
+  // rewrites the chunk followed by the new values with the narrowest delta width which
+  // fits all of them
+  void reencode(const T* data, const size_t num_elems) {
+    auto buffer = this->buffer_;
+    std::vector<int8_t> encoded(buffer->size());
+    buffer->read(encoded.data(), encoded.size(), 0);
+    std::vector<T> values(this->num_elems_ + num_elems);
+    diff_encoding::decode(encoded.data(),
+                          sizeof(T),
+                          this->num_elems_,
+                          reinterpret_cast<int8_t*>(values.data()));
+    std::copy(data, data + num_elems, values.begin() + this->num_elems_);
+    const auto value_bytes = reinterpret_cast<const int8_t*>(values.data());
+    const auto delta_width = diff_encoding::get_required_delta_width(
+        value_bytes, sizeof(T), values.size(), min_delta_width_);
+    encoded = diff_encoding::encode(value_bytes, sizeof(T), values.size(), delta_width);
+    buffer->write(encoded.data(), encoded.size(), 0);
+    buffer->setSize(encoded.size());
+  }
+
+  const size_t min_delta_width_;
+};  // class DiffEncoder
+
+#endif  // DIFF_ENCODER_H
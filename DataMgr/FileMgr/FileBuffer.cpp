@@ -28,6 +28,7 @@
 #include <utility>  // std::pair
 
 #include "DataMgr/FileMgr/FileMgr.h"
+#include "DataMgr/FileMgr/FileReadPool.h"
 #include "Shared/File.h"
 #include "Shared/checked_alloc.h"
 
@@ -227,58 +228,6 @@ void FileBuffer::freePagesBeforeEpoch(const int32_t targetEpoch) {
   }
 }
 
-struct readThreadDS {
-  FileMgr* t_fm;       // ptr to FileMgr
-  size_t t_startPage;  // start page for the thread
-  size_t t_endPage;    // last page for the thread
-  int8_t* t_curPtr;    // pointer to the current location of the target for the thread
-  size_t t_bytesLeft;  // number of bytes to be read in the thread
-  size_t t_startPageOffset;  // offset - used for the first page of the buffer
-  bool t_isFirstPage;        // true - for first page of the buffer, false - otherwise
-  std::vector<MultiPage> multiPages;  // MultiPages of the FileBuffer passed to the thread
-};
-
-static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS) {
-  size_t startPage = threadDS.t_startPage;  // start reading at startPage, including it
-  size_t endPage = threadDS.t_endPage;      // stop reading at endPage, not including it
-  int8_t* curPtr = threadDS.t_curPtr;
-  size_t bytesLeft = threadDS.t_bytesLeft;
-  size_t totalBytesRead = 0;
-  bool isFirstPage = threadDS.t_isFirstPage;
-
-  // Traverse the logical pages
-  for (size_t pageNum = startPage; pageNum < endPage; ++pageNum) {
-    CHECK(threadDS.multiPages[pageNum].pageSize == fileBuffer->pageSize());
-    Page page = threadDS.multiPages[pageNum].current().page;
-
-    FileInfo* fileInfo = threadDS.t_fm->getFileInfoForFileId(page.fileId);
-    CHECK(fileInfo);
-
-    // Read the page into the destination (dst) buffer at its
-    // current (cur) location
-    size_t bytesRead = 0;
-    if (isFirstPage) {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + threadDS.t_startPageOffset +
-              fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize() - threadDS.t_startPageOffset, bytesLeft),
-          curPtr);
-      isFirstPage = false;
-    } else {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize(), bytesLeft),
-          curPtr);
-    }
-    curPtr += bytesRead;
-    bytesLeft -= bytesRead;
-    totalBytesRead += bytesRead;
-  }
-  CHECK(bytesLeft == 0);
-
-  return (totalBytesRead);
-}
-
 void FileBuffer::read(int8_t* const dst,
                       const size_t numBytes,
                       const size_t offset,
@@ -305,80 +254,29 @@ void FileBuffer::read(int8_t* const dst,
 
   CHECK(startPage + numPagesToRead <= multiPages_.size());
 
-  size_t numPagesPerThread = 0;
-  size_t numBytesCurrent = numBytes;  // total number of bytes still to be read
-  size_t bytesRead = 0;               // total number of bytes already being read
-  size_t bytesLeftForThread = 0;      // number of bytes to be read in the thread
-  size_t numExtraPages = 0;  // extra pages to be assigned one per thread as needed
-  size_t numThreads = fm_->getNumReaderThreads();
-  std::vector<readThreadDS>
-      threadDSArr;  // array of threadDS, needed to avoid racing conditions
-
-  if (numPagesToRead > numThreads) {
-    numPagesPerThread = numPagesToRead / numThreads;
-    numExtraPages = numPagesToRead - (numThreads * numPagesPerThread);
-  } else {
-    numThreads = numPagesToRead;
-    numPagesPerThread = 1;
-  }
-
-  /* set threadDS for the first thread */
-  readThreadDS threadDS;
-  threadDS.t_fm = fm_;
-  threadDS.t_startPage = offset / pageDataSize_;
-  if (numExtraPages > 0) {
-    threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread + 1;
-    numExtraPages--;
-  } else {
-    threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread;
-  }
-  threadDS.t_curPtr = dst;
-  threadDS.t_startPageOffset = offset % pageDataSize_;
-  threadDS.t_isFirstPage = true;
-
-  bytesLeftForThread = min(((threadDS.t_endPage - threadDS.t_startPage) * pageDataSize_ -
-                            threadDS.t_startPageOffset),
-                           numBytesCurrent);
-  threadDS.t_bytesLeft = bytesLeftForThread;
-  threadDS.multiPages = getMultiPage();
-
-  if (numThreads == 1) {
-    bytesRead += readForThread(this, threadDS);
-  } else {
-    std::vector<std::future<size_t>> threads;
-
-    for (size_t i = 0; i < numThreads; i++) {
-      threadDSArr.push_back(threadDS);
-      threads.push_back(
-          std::async(std::launch::async, readForThread, this, threadDSArr[i]));
-
-      // calculate elements of threadDS
-      threadDS.t_fm = fm_;
-      threadDS.t_isFirstPage = false;
-      threadDS.t_curPtr += bytesLeftForThread;
-      threadDS.t_startPage +=
-          threadDS.t_endPage -
-          threadDS.t_startPage;  // based on # of pages read on previous iteration
-      if (numExtraPages > 0) {
-        threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread + 1;
-        numExtraPages--;
-      } else {
-        threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread;
-      }
-      numBytesCurrent -= bytesLeftForThread;
-      bytesLeftForThread = min(
-          ((threadDS.t_endPage - threadDS.t_startPage) * pageDataSize_), numBytesCurrent);
-      threadDS.t_bytesLeft = bytesLeftForThread;
-      threadDS.multiPages = getMultiPage();
-    }
-
-    for (auto& p : threads) {
-      p.wait();
-    }
-    for (auto& p : threads) {
-      bytesRead += p.get();
-    }
+  // the pages are read with positional reads, spread over the reader threads
+  std::vector<FileReadRequest> requests;
+  requests.reserve(numPagesToRead);
+  int8_t* curPtr = dst;
+  size_t bytesLeft = numBytes;
+  for (size_t pageNum = startPage; pageNum < startPage + numPagesToRead; ++pageNum) {
+    CHECK(multiPages_[pageNum].pageSize == pageSize_);
+    const Page& page = multiPages_[pageNum].current().page;
+    FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+    CHECK(fileInfo);
+    const size_t pageOffset = pageNum == startPage ? startPageOffset : 0;
+    const size_t readSize = min(pageDataSize_ - pageOffset, bytesLeft);
+    requests.push_back(
+        {fileInfo,
+         page.pageNum * pageSize_ + pageOffset + reservedHeaderSize_,
+         readSize,
+         curPtr});
+    curPtr += readSize;
+    bytesLeft -= readSize;
   }
+  CHECK_EQ(bytesLeft, size_t(0));
+  const auto bytesRead =
+      FileReadPool::instance().read(requests, fm_->getNumReaderThreads());
   CHECK(bytesRead == numBytes);
 }
 
@@ -483,6 +381,9 @@ void FileBuffer::writeMetadata(const int32_t epoch) {
   if (hasEncoder()) {  // redundant
     encoder_->writeMetadata(f);
   }
+  // the pages are otherwise written and read with positional I/O, which bypasses the
+  // stream buffer
+  CHECK_EQ(fflush(f), 0);
   metadataPages_.push(page, epoch);
 }
 
@@ -48,6 +48,7 @@ void FileInfo::initNewFile() {
   // initialize pages and free page list
   // Also zeroes out first four bytes of every header
 
+  fileMgr->invalidateChunkIndexSnapshot();
   int32_t headerSize = 0;
   int8_t* headerSizePtr = (int8_t*)(&headerSize);
   for (size_t pageId = 0; pageId < numPages; ++pageId) {
@@ -58,13 +59,14 @@ void FileInfo::initNewFile() {
 }
 
 size_t FileInfo::write(const size_t offset, const size_t size, int8_t* buf) {
+  fileMgr->invalidateChunkIndexSnapshot();
   std::lock_guard<std::mutex> lock(readWriteMutex_);
   isDirty = true;
   return File_Namespace::write(f, offset, size, buf);
 }
 
 size_t FileInfo::read(const size_t offset, const size_t size, int8_t* buf) {
-  std::lock_guard<std::mutex> lock(readWriteMutex_);
+  // positional reads don't share a file offset, they don't need the lock
   return File_Namespace::read(f, offset, size, buf);
 }
 
@@ -80,8 +82,8 @@ void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec) {
   for (size_t pageNum = 0; pageNum < numPages; ++pageNum) {
     constexpr size_t MAX_INTS_TO_READ{10};  // currently use 1+6 ints
     int32_t ints[MAX_INTS_TO_READ];
-    CHECK_EQ(fseek(f, pageNum * pageSize, SEEK_SET), 0);
-    CHECK_EQ(fread(ints, sizeof(int32_t), MAX_INTS_TO_READ, f), MAX_INTS_TO_READ);
+    File_Namespace::read(
+        f, pageNum * pageSize, sizeof(ints), reinterpret_cast<int8_t*>(ints));
 
     auto headerSize = ints[0];
     if (headerSize == 0) {
@@ -176,6 +178,7 @@ static void sighandler(int sig) {
 #endif
 
 void FileInfo::freePage(int pageId, const bool isRolloff, int32_t epoch) {
+  fileMgr->invalidateChunkIndexSnapshot();
   std::lock_guard<std::mutex> lock(readWriteMutex_);
 #define RESILIENT_PAGE_HEADER
 #ifdef RESILIENT_PAGE_HEADER
@@ -247,6 +250,7 @@ void FileInfo::freePageImmediate(int32_t page_num) {
   // as it seems we are no guaranteed to have f/synced so
   // protecting from RO trying to write
   if (!g_read_only) {
+    fileMgr->invalidateChunkIndexSnapshot();
     int32_t zero{0};
     File_Namespace::write(
         f, page_num * pageSize, sizeof(int32_t), reinterpret_cast<int8_t*>(&zero));
@@ -260,6 +264,7 @@ void FileInfo::recoverPage(const ChunkKey& chunk_key, int32_t page_num) {
   // as it seems we are no guaranteed to have f/synced so
   // protecting from RO trying to write
   if (!g_read_only) {
+    fileMgr->invalidateChunkIndexSnapshot();
     File_Namespace::write(f,
                           page_num * pageSize + sizeof(int32_t),
                           2 * sizeof(int32_t),
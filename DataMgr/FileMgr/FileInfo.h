@@ -61,7 +61,7 @@ struct FileInfo {
   bool isDirty{false};         // True if writes have occured since last sync
   std::set<size_t> freePages;  /// set of page numbers of free pages
   std::mutex freePagesMutex_;
-  std::mutex readWriteMutex_;
+  std::mutex readWriteMutex_;  /// serializes writes and syncs, reads don't take it
 
   /// Constructor
   FileInfo(FileMgr* fileMgr,
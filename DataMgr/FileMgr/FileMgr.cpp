@@ -23,7 +23,11 @@
 #include "DataMgr/FileMgr/FileMgr.h"
 
 #include <fcntl.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <future>
 #include <string>
@@ -31,6 +35,7 @@
 #include <utility>
 #include <vector>
 
+#include <boost/crc.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/system/error_code.hpp>
@@ -42,6 +47,8 @@
 
 using namespace std;
 
+bool g_enable_chunk_index_snapshot{true};
+
 namespace File_Namespace {
 
 FileMgr::FileMgr(const int32_t deviceId,
@@ -104,6 +111,14 @@ FileMgr::FileMgr(const int epoch) : AbstractBufferMgr(-1) {
 FileMgr::FileMgr() : AbstractBufferMgr(0) {}
 
 FileMgr::~FileMgr() {
+  if (write_chunk_index_snapshot_on_close_.load()) {
+    try {
+      writeChunkIndexSnapshot();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Could not write chunk index snapshot of " << describeSelf()
+                   << ": " << e.what();
+    }
+  }
   // free memory used by FileInfo objects
   for (auto chunkIt = chunkIndex_.begin(); chunkIt != chunkIndex_.end(); ++chunkIt) {
     delete chunkIt->second;
@@ -233,6 +248,308 @@ OpenFilesResult FileMgr::openFiles() {
   return result;
 }
 
+namespace {
+
+constexpr int32_t kChunkIndexSnapshotVersion{1};
+
+struct ChunkIndexSnapshotHeader {
+  int32_t version;
+  int32_t epoch_floor;
+  int32_t epoch_ceiling;
+  uint32_t checksum;
+  uint64_t payload_size;
+};
+
+uint32_t chunk_index_snapshot_checksum(const std::vector<int8_t>& payload) {
+  boost::crc_32_type crc;
+  crc.process_bytes(payload.data(), payload.size());
+  return crc.checksum();
+}
+
+class ChunkIndexSnapshotWriter {
+ public:
+  template <typename T>
+  void put(const T value) {
+    const auto bytes = reinterpret_cast<const int8_t*>(&value);
+    payload_.insert(payload_.end(), bytes, bytes + sizeof(T));
+  }
+
+  const std::vector<int8_t>& payload() const { return payload_; }
+
+ private:
+  std::vector<int8_t> payload_;
+};
+
+class ChunkIndexSnapshotReader {
+ public:
+  ChunkIndexSnapshotReader(const std::vector<int8_t>& payload) : payload_(payload) {}
+
+  template <typename T>
+  bool get(T& value) {
+    if (payload_.size() - offset_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, payload_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool atEnd() const { return offset_ == payload_.size(); }
+
+ private:
+  const std::vector<int8_t>& payload_;
+  size_t offset_{0};
+};
+
+// Makes the creation, renaming or removal of a file in the directory durable.
+void sync_directory(const std::string& path) {
+#ifndef _WIN32
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    omnisci::fsync(fd);
+    ::close(fd);
+  }
+#endif
+}
+
+}  // namespace
+
+/*
+ * The snapshot is a header followed by a checksummed payload of:
+ *   number of data files, then for each: file id, page size, number of pages, number of
+ *   free pages and the free page numbers
+ *   number of chunks, then for each: chunk key size and elements, number of pages and
+ *   for each page version: page id (-1 for metadata pages), epoch, file id, page number
+ * It is only used if the epoch file and data files on disk are those it was written
+ * for, otherwise startup reads the page headers of all the data files.
+ */
+bool FileMgr::openFilesFromChunkIndexSnapshot(OpenFilesResult& result) {
+  const auto snapshot_path = getFilePath(CHUNK_INDEX_SNAPSHOT_FILENAME);
+  if (!g_enable_chunk_index_snapshot || !boost::filesystem::exists(snapshot_path)) {
+    return false;
+  }
+  auto clock_begin = timer_start();
+  std::ifstream snapshot_file(snapshot_path.string(), std::ios::binary);
+  ChunkIndexSnapshotHeader header;
+  if (!snapshot_file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      header.version != kChunkIndexSnapshotVersion ||
+      header.payload_size !=
+          boost::filesystem::file_size(snapshot_path) - sizeof(header)) {
+    LOG(WARNING) << "Ignoring invalid chunk index snapshot of " << describeSelf();
+    return false;
+  }
+  if (header.epoch_floor != epoch_.floor() || header.epoch_ceiling != epoch_.ceiling()) {
+    LOG(INFO) << "Ignoring chunk index snapshot of " << describeSelf() << " at epoch "
+              << header.epoch_ceiling << ", checkpointed epoch is " << epoch_.ceiling();
+    return false;
+  }
+  std::vector<int8_t> payload(header.payload_size);
+  if (!snapshot_file.read(reinterpret_cast<char*>(payload.data()), payload.size()) ||
+      chunk_index_snapshot_checksum(payload) != header.checksum) {
+    LOG(WARNING) << "Ignoring corrupt chunk index snapshot of " << describeSelf();
+    return false;
+  }
+
+  std::map<int32_t, FileMetadata> data_files;
+  boost::filesystem::directory_iterator end_itr;
+  for (boost::filesystem::directory_iterator file_it(fileMgrBasePath_);
+       file_it != end_itr;
+       ++file_it) {
+    if (is_compaction_status_file(file_it->path().filename().string())) {
+      return false;
+    }
+    auto file_metadata = getMetadataForFile(file_it);
+    if (file_metadata.is_data_file) {
+      data_files.emplace(file_metadata.file_id, file_metadata);
+    }
+  }
+
+  ChunkIndexSnapshotReader reader(payload);
+  std::map<int32_t, std::set<size_t>> free_pages;
+  std::vector<HeaderInfo> header_infos;
+  auto parse_payload = [&]() {
+    uint64_t num_files;
+    if (!reader.get(num_files) || num_files != data_files.size()) {
+      return false;
+    }
+    for (uint64_t i = 0; i < num_files; ++i) {
+      int32_t file_id;
+      uint64_t page_size, num_pages, num_free_pages;
+      if (!reader.get(file_id) || !reader.get(page_size) || !reader.get(num_pages) ||
+          !reader.get(num_free_pages)) {
+        return false;
+      }
+      auto data_file_it = data_files.find(file_id);
+      if (data_file_it == data_files.end() ||
+          data_file_it->second.page_size != page_size ||
+          data_file_it->second.num_pages != num_pages) {
+        return false;
+      }
+      auto& file_free_pages = free_pages[file_id];
+      for (uint64_t j = 0; j < num_free_pages; ++j) {
+        uint64_t page_num;
+        if (!reader.get(page_num) || page_num >= num_pages) {
+          return false;
+        }
+        file_free_pages.emplace_hint(file_free_pages.end(), page_num);
+      }
+    }
+    uint64_t num_chunks;
+    if (!reader.get(num_chunks)) {
+      return false;
+    }
+    for (uint64_t i = 0; i < num_chunks; ++i) {
+      uint64_t key_size, num_headers;
+      if (!reader.get(key_size)) {
+        return false;
+      }
+      ChunkKey chunk_key;
+      for (uint64_t j = 0; j < key_size; ++j) {
+        int32_t key_elem;
+        if (!reader.get(key_elem)) {
+          return false;
+        }
+        chunk_key.push_back(key_elem);
+      }
+      if (!reader.get(num_headers)) {
+        return false;
+      }
+      for (uint64_t j = 0; j < num_headers; ++j) {
+        int32_t page_id, version_epoch, file_id;
+        uint64_t page_num;
+        if (!reader.get(page_id) || !reader.get(version_epoch) || !reader.get(file_id) ||
+            !reader.get(page_num)) {
+          return false;
+        }
+        auto data_file_it = data_files.find(file_id);
+        if (data_file_it == data_files.end() ||
+            page_num >= data_file_it->second.num_pages) {
+          return false;
+        }
+        header_infos.emplace_back(
+            chunk_key, page_id, version_epoch, Page(file_id, page_num));
+      }
+    }
+    return reader.atEnd();
+  };
+  if (!parse_payload()) {
+    LOG(WARNING) << "Ignoring chunk index snapshot of " << describeSelf()
+                 << " that doesn't match its data files";
+    return false;
+  }
+
+  result.max_file_id = -1;
+  {
+    mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
+    for (auto& [file_id, file_metadata] : data_files) {
+      auto file_info = new FileInfo(this,
+                                    file_id,
+                                    open(file_metadata.file_path),
+                                    file_metadata.page_size,
+                                    file_metadata.num_pages,
+                                    false);
+      file_info->freePages = std::move(free_pages[file_id]);
+      files_[file_id] = file_info;
+      fileIndex_.insert(std::pair<size_t, int32_t>(file_metadata.page_size, file_id));
+      result.max_file_id = std::max(result.max_file_id, file_id);
+    }
+  }
+  result.header_infos = std::move(header_infos);
+  chunk_index_snapshot_valid_ = true;
+
+  int64_t queue_time_ms = timer_stop(clock_begin);
+  LOG(INFO) << "Completed Reading table's chunk index snapshot, Elapsed time : "
+            << queue_time_ms << "ms Epoch: " << epoch_.ceiling()
+            << " files: " << data_files.size() << " table location: '"
+            << fileMgrBasePath_ << "'";
+  return true;
+}
+
+void FileMgr::writeChunkIndexSnapshot() {
+  if (!g_enable_chunk_index_snapshot || g_read_only) {
+    return;
+  }
+  ChunkIndexSnapshotWriter writer;
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(files_rw_mutex_);
+    writer.put<uint64_t>(files_.size());
+    for (const auto& [file_id, file_info] : files_) {
+      std::lock_guard<std::mutex> free_pages_lock(file_info->freePagesMutex_);
+      writer.put<int32_t>(file_id);
+      writer.put<uint64_t>(file_info->pageSize);
+      writer.put<uint64_t>(file_info->numPages);
+      writer.put<uint64_t>(file_info->freePages.size());
+      for (const auto page_num : file_info->freePages) {
+        writer.put<uint64_t>(page_num);
+      }
+    }
+  }
+  {
+    mapd_shared_lock<mapd_shared_mutex> chunk_index_read_lock(chunkIndexMutex_);
+    writer.put<uint64_t>(chunkIndex_.size());
+    for (const auto& [chunk_key, buffer] : chunkIndex_) {
+      writer.put<uint64_t>(chunk_key.size());
+      for (const auto key_elem : chunk_key) {
+        writer.put<int32_t>(key_elem);
+      }
+      size_t num_headers = buffer->metadataPages_.pageVersions.size();
+      for (const auto& multi_page : buffer->multiPages_) {
+        num_headers += multi_page.pageVersions.size();
+      }
+      writer.put<uint64_t>(num_headers);
+      auto put_page_versions = [&writer](const MultiPage& multi_page,
+                                         const int32_t page_id) {
+        for (const auto& epoched_page : multi_page.pageVersions) {
+          writer.put<int32_t>(page_id);
+          writer.put<int32_t>(epoched_page.epoch);
+          writer.put<int32_t>(epoched_page.page.fileId);
+          writer.put<uint64_t>(epoched_page.page.pageNum);
+        }
+      };
+      put_page_versions(buffer->metadataPages_, -1);
+      for (size_t page_id = 0; page_id < buffer->multiPages_.size(); ++page_id) {
+        put_page_versions(buffer->multiPages_[page_id], page_id);
+      }
+    }
+  }
+
+  const auto& payload = writer.payload();
+  ChunkIndexSnapshotHeader header{kChunkIndexSnapshotVersion,
+                                  epochFloor(),
+                                  lastCheckpointedEpoch(),
+                                  chunk_index_snapshot_checksum(payload),
+                                  payload.size()};
+  const auto snapshot_path = getFilePath(CHUNK_INDEX_SNAPSHOT_FILENAME);
+  const auto temp_path = snapshot_path.string() + ".tmp";
+  FILE* f = omnisci::fopen(temp_path.c_str(), "wb");
+  if (!f) {
+    LOG(WARNING) << "Could not create chunk index snapshot '" << temp_path
+                 << "': " << std::strerror(errno);
+    return;
+  }
+  write(f, 0, sizeof(header), reinterpret_cast<const int8_t*>(&header));
+  write(f, sizeof(header), payload.size(), payload.data());
+  CHECK_EQ(fflush(f), 0) << "Could not flush chunk index snapshot to disk";
+  CHECK_EQ(omnisci::fsync(fileno(f)), 0) << "Could not sync chunk index snapshot to disk";
+  close(f);
+
+  std::lock_guard<std::mutex> lock(chunk_index_snapshot_mutex_);
+  boost::filesystem::rename(temp_path, snapshot_path);
+  sync_directory(fileMgrBasePath_);
+  chunk_index_snapshot_valid_ = true;
+}
+
+void FileMgr::removeChunkIndexSnapshot() {
+  write_chunk_index_snapshot_on_close_ = false;
+  std::lock_guard<std::mutex> lock(chunk_index_snapshot_mutex_);
+  const auto snapshot_path = getFilePath(CHUNK_INDEX_SNAPSHOT_FILENAME);
+  if (!g_read_only && boost::filesystem::exists(snapshot_path)) {
+    boost::filesystem::remove(snapshot_path);
+    sync_directory(fileMgrBasePath_);
+  }
+  chunk_index_snapshot_valid_ = false;
+}
+
 void FileMgr::clearFileInfos() {
   for (auto file_info_entry : files_) {
     auto file_info = file_info_entry.second;
@@ -255,12 +572,16 @@ void FileMgr::init(const size_t num_reader_threads, const int32_t epochOverride)
       setEpoch(epochOverride);
     }
 
-    auto open_files_result = openFiles();
-    if (!open_files_result.compaction_status_file_name.empty()) {
-      resumeFileCompaction(open_files_result.compaction_status_file_name);
-      clearFileInfos();
+    OpenFilesResult open_files_result;
+    if (!openFilesFromChunkIndexSnapshot(open_files_result)) {
+      removeChunkIndexSnapshot();
       open_files_result = openFiles();
-      CHECK(open_files_result.compaction_status_file_name.empty());
+      if (!open_files_result.compaction_status_file_name.empty()) {
+        resumeFileCompaction(open_files_result.compaction_status_file_name);
+        clearFileInfos();
+        open_files_result = openFiles();
+        CHECK(open_files_result.compaction_status_file_name.empty());
+      }
     }
 
     /* Sort headerVec so that all HeaderInfos
@@ -555,6 +876,7 @@ void FileMgr::closePhysicalUnlocked() {
 }
 
 void FileMgr::closeRemovePhysical() {
+  write_chunk_index_snapshot_on_close_ = false;
   mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
   closePhysicalUnlocked();
   /* rename for later deletion the directory containing table related data */
@@ -690,6 +1012,9 @@ void FileMgr::checkpoint() {
   writeAndSyncEpochToDisk();
   incrementEpoch();
   freePages();
+  // writing the whole chunk index at every checkpoint would cost more than the header
+  // scan it saves at startup, so it is deferred until the table is closed
+  write_chunk_index_snapshot_on_close_ = true;
 }
 
 FileBuffer* FileMgr::createBuffer(const ChunkKey& key,
@@ -1157,6 +1482,10 @@ void FileMgr::setEpoch(const int32_t newEpoch) {
                   << " lower than the minimum rollback epoch (" << epoch_.floor() << ").";
     throw std::runtime_error(error_message.str());
   }
+  if (newEpoch != epoch_.ceiling()) {
+    // pages of the later epochs still have to be rolled back by the header scan
+    removeChunkIndexSnapshot();
+  }
   epoch_.ceiling(newEpoch);
   writeAndSyncEpochToDisk();
 }
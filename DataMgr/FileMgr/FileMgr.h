@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <future>
 #include <iostream>
 #include <map>
@@ -331,6 +332,21 @@ class FileMgr : public AbstractBufferMgr {  // implements
   void removeTableRelatedDS(const int32_t db_id, const int32_t table_id) override;
 
   void free_page(std::pair<FileInfo*, int32_t>&& page);
+
+  /**
+   * @brief Removes the chunk index snapshot of the last checkpoint, if it still
+   * describes the data files. Called before any write to the data files, since startup
+   * must then go back to reading the page headers.
+   */
+  inline void invalidateChunkIndexSnapshot() {
+    if (write_chunk_index_snapshot_on_close_.load()) {
+      write_chunk_index_snapshot_on_close_ = false;
+    }
+    if (chunk_index_snapshot_valid_.load()) {
+      removeChunkIndexSnapshot();
+    }
+  }
+
   inline virtual bool hasFileMgrKey() const { return true; }
   const TablePair get_fileMgrKey() const { return fileMgrKey_; }
 
@@ -378,6 +394,7 @@ class FileMgr : public AbstractBufferMgr {  // implements
   static constexpr char EPOCH_FILENAME[] = "epoch_metadata";
   static constexpr char DB_META_FILENAME[] = "dbmeta";
   static constexpr char FILE_MGR_VERSION_FILENAME[] = "filemgr_version";
+  static constexpr char CHUNK_INDEX_SNAPSHOT_FILENAME[] = "chunk_index_snapshot";
   static constexpr int32_t INVALID_VERSION = -1;
 
  protected:
@@ -451,6 +468,16 @@ class FileMgr : public AbstractBufferMgr {  // implements
 
   OpenFilesResult openFiles();
 
+  /**
+   * @brief Opens the data files using the chunk index snapshot written by the last
+   * checkpoint instead of reading every page header.
+   * @return false, without opening any file, if the snapshot is missing, damaged or
+   * doesn't match the checkpointed epoch and the data files on disk
+   */
+  bool openFilesFromChunkIndexSnapshot(OpenFilesResult& result);
+  void writeChunkIndexSnapshot();
+  void removeChunkIndexSnapshot();
+
   void clearFileInfos();
 
   // Data compaction methods
@@ -506,6 +533,13 @@ class FileMgr : public AbstractBufferMgr {  // implements
   Epoch epoch_;
   bool epochIsCheckpointed_ = true;
   FILE* epochFile_ = nullptr;
+
+  // True while the chunk index snapshot on disk matches the data files
+  std::atomic<bool> chunk_index_snapshot_valid_{false};
+  // True while the data files are those of the last checkpoint, the snapshot is only
+  // written once the table is closed rather than at every checkpoint
+  std::atomic<bool> write_chunk_index_snapshot_on_close_{false};
+  std::mutex chunk_index_snapshot_mutex_;
 };
 
 }  // namespace File_Namespace
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/FileMgr/FileReadPool.h"
+
+#include <algorithm>
+#include <future>
+
+#include "DataMgr/FileMgr/FileInfo.h"
+#include "Logger/Logger.h"
+
+namespace File_Namespace {
+
+namespace {
+
+size_t read_requests(const std::vector<FileReadRequest>& requests,
+                     const size_t begin,
+                     const size_t end) {
+  size_t bytes_read{0};
+  for (size_t i = begin; i < end; ++i) {
+    const auto& request = requests[i];
+    bytes_read += request.file_info->read(request.offset, request.size, request.dst);
+  }
+  return bytes_read;
+}
+
+}  // namespace
+
+FileReadPool& FileReadPool::instance() {
+  static FileReadPool pool(std::max(std::thread::hardware_concurrency(), 1u));
+  return pool;
+}
+
+FileReadPool::FileReadPool(const size_t num_threads) {
+  // the calling thread reads a share of the requests as well
+  for (size_t i = 1; i < num_threads; ++i) {
+    workers_.emplace_back([this] { runWorker(); });
+  }
+}
+
+FileReadPool::~FileReadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void FileReadPool::runWorker() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+size_t FileReadPool::read(const std::vector<FileReadRequest>& requests,
+                          const size_t max_threads) {
+  const auto num_tasks =
+      std::min({requests.size(), std::max(max_threads, size_t(1)), workers_.size() + 1});
+  if (num_tasks <= 1) {
+    return read_requests(requests, 0, requests.size());
+  }
+  const auto requests_per_task = (requests.size() + num_tasks - 1) / num_tasks;
+  std::vector<std::future<size_t>> task_results;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t begin = requests_per_task; begin < requests.size();
+         begin += requests_per_task) {
+      const auto end = std::min(begin + requests_per_task, requests.size());
+      auto task = std::make_shared<std::packaged_task<size_t()>>(
+          [&requests, begin, end] { return read_requests(requests, begin, end); });
+      task_results.emplace_back(task->get_future());
+      tasks_.emplace_back([task] { (*task)(); });
+    }
+  }
+  cv_.notify_all();
+  size_t bytes_read = read_requests(requests, 0, requests_per_task);
+  for (auto& task_result : task_results) {
+    bytes_read += task_result.get();
+  }
+  return bytes_read;
+}
+
+}  // namespace File_Namespace
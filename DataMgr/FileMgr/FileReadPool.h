@@ -0,0 +1,67 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace File_Namespace {
+
+struct FileInfo;
+
+struct FileReadRequest {
+  FileInfo* file_info;
+  size_t offset;
+  size_t size;
+  int8_t* dst;
+};
+
+/**
+ * @type FileReadPool
+ * @brief Threads shared by all the file managers to read pages of data files.
+ *
+ * All the pages of a buffer are submitted at once and split over up to the given number
+ * of threads, which issue positional reads and don't contend on any lock. The threads
+ * are started once rather than for each read.
+ */
+class FileReadPool {
+ public:
+  static FileReadPool& instance();
+
+  ~FileReadPool();
+
+  /// Reads all the requests using up to max_threads threads, including the calling one,
+  /// and returns the number of bytes read.
+  size_t read(const std::vector<FileReadRequest>& requests, const size_t max_threads);
+
+ private:
+  FileReadPool(const size_t num_threads);
+
+  void runWorker();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  std::vector<std::thread> workers_;
+  bool stop_{false};
+};
+
+}  // namespace File_Namespace
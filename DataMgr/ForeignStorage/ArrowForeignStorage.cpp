@@ -187,73 +187,84 @@ std::shared_ptr<arrow::ChunkedArray> ArrowForeignStorageBase::replaceNullValuesI
   }
 
   auto null_value = get_null_value<T>();
-
-  auto resultBuf =
-      arrow::AllocateBuffer(sizeof(T) * arr_col_chunked_array->length()).ValueOrDie();
-  auto resultData = reinterpret_cast<T*>(resultBuf->mutable_data());
-
+  // booleans are stored one byte per value
+  using ValueType = std::conditional_t<std::is_same_v<T, bool>, int8_t, T>;
+  auto result_type =
+      std::is_same_v<T, bool> ? arrow::int8() : arr_col_chunked_array->type();
+
+  // Only the chunks with nulls (and boolean chunks) are converted, the other chunks
+  // keep their Arrow buffers so that the fragments over them stay zero copy.
+  std::vector<std::shared_ptr<arrow::Array>> result_chunks(
+      arr_col_chunked_array->num_chunks());
   tbb::parallel_for(
       tbb::blocked_range<size_t>(0, arr_col_chunked_array->num_chunks()),
       [&](const tbb::blocked_range<size_t>& r) {
         for (size_t c = r.begin(); c != r.end(); ++c) {
-          size_t offset = 0;
-          for (int i = 0; i < c; i++) {
-            offset += arr_col_chunked_array->chunk(i)->length();
-          }
-          auto resWithOffset = resultData + offset;
-
           auto chunk = arr_col_chunked_array->chunk(c);
-
-          if (chunk->null_count() == chunk->length()) {
-            std::fill(resWithOffset, resWithOffset + chunk->length(), null_value);
-            continue;
-          }
-
-          auto chunkData = reinterpret_cast<const T*>(chunk->data()->buffers[1]->data());
-
-          if (chunk->null_count() == 0) {
-            std::copy(chunkData, chunkData + chunk->length(), resWithOffset);
+          if (!std::is_same_v<T, bool> && chunk->null_count() == 0) {
+            result_chunks[c] = chunk;
             continue;
           }
 
-          const uint8_t* bitmap_data = chunk->null_bitmap_data();
           const int64_t length = chunk->length();
-          const int64_t bitmap_length = chunk->null_bitmap()->size();
-
-          if constexpr (std::is_same_v<T, bool>) {
-            convertBoolBitmapBuffer(reinterpret_cast<int8_t*>(resWithOffset),
-                                    reinterpret_cast<const uint8_t*>(chunkData),
-                                    bitmap_data,
-                                    length,
-                                    bitmap_length,
-                                    null_value);
-          } else {
-            for (int64_t bitmap_idx = 0; bitmap_idx < bitmap_length - 1; ++bitmap_idx) {
-              auto source = chunkData + bitmap_idx * 8;
-              auto dest = resWithOffset + bitmap_idx * 8;
-              auto inversed_bitmap = ~bitmap_data[bitmap_idx];
-              for (int8_t bitmap_offset = 0; bitmap_offset < 8; ++bitmap_offset) {
-                auto is_null = (inversed_bitmap >> bitmap_offset) & 1;
-                auto val = is_null ? null_value : source[bitmap_offset];
-                dest[bitmap_offset] = val;
+          auto resultBuf = arrow::AllocateBuffer(sizeof(ValueType) * length).ValueOrDie();
+          auto resWithOffset = reinterpret_cast<ValueType*>(resultBuf->mutable_data());
+
+          if (chunk->null_count() == length) {
+            std::fill(resWithOffset, resWithOffset + length, null_value);
+          } else if (chunk->null_count() == 0 || chunk->offset() != 0) {
+            // bitmaps of sliced arrays don't start at a byte boundary
+            for (int64_t j = 0; j < length; ++j) {
+              if (chunk->IsNull(j)) {
+                resWithOffset[j] = null_value;
+              } else if constexpr (std::is_same_v<T, bool>) {
+                resWithOffset[j] =
+                    std::static_pointer_cast<arrow::BooleanArray>(chunk)->Value(j);
+              } else {
+                resWithOffset[j] = chunk->data()->GetValues<T>(1)[j];
               }
             }
+          } else {
+            auto chunkData =
+                reinterpret_cast<const T*>(chunk->data()->buffers[1]->data());
+            const uint8_t* bitmap_data = chunk->null_bitmap_data();
+            // the bitmap buffer may be padded
+            const int64_t bitmap_length = (length + 7) / 8;
+
+            if constexpr (std::is_same_v<T, bool>) {
+              convertBoolBitmapBuffer(resWithOffset,
+                                      reinterpret_cast<const uint8_t*>(chunkData),
+                                      bitmap_data,
+                                      length,
+                                      bitmap_length,
+                                      null_value);
+            } else {
+              for (int64_t bitmap_idx = 0; bitmap_idx < bitmap_length - 1;
+                   ++bitmap_idx) {
+                auto source = chunkData + bitmap_idx * 8;
+                auto dest = resWithOffset + bitmap_idx * 8;
+                auto inversed_bitmap = ~bitmap_data[bitmap_idx];
+                for (int8_t bitmap_offset = 0; bitmap_offset < 8; ++bitmap_offset) {
+                  auto is_null = (inversed_bitmap >> bitmap_offset) & 1;
+                  auto val = is_null ? null_value : source[bitmap_offset];
+                  dest[bitmap_offset] = val;
+                }
+              }
 
-            for (int64_t j = (bitmap_length - 1) * 8; j < length; ++j) {
-              auto is_null = (~bitmap_data[bitmap_length - 1] >> (j % 8)) & 1;
-              auto val = is_null ? null_value : chunkData[j];
-              resWithOffset[j] = val;
+              for (int64_t j = (bitmap_length - 1) * 8; j < length; ++j) {
+                auto is_null = (~bitmap_data[bitmap_length - 1] >> (j % 8)) & 1;
+                auto val = is_null ? null_value : chunkData[j];
+                resWithOffset[j] = val;
+              }
             }
           }
+
+          result_chunks[c] = arrow::MakeArray(arrow::ArrayData::Make(
+              result_type, length, {nullptr, std::move(resultBuf)}, 0));
         }
       });
 
-  using ArrowType = typename arrow::CTypeTraits<T>::ArrowType;
-  using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
-
-  auto array =
-      std::make_shared<ArrayType>(arr_col_chunked_array->length(), std::move(resultBuf));
-  return std::make_shared<arrow::ChunkedArray>(array);
+  return std::make_shared<arrow::ChunkedArray>(result_chunks, result_type);
 }
 
 void ArrowForeignStorageBase::getSizeAndOffset(const Frag& frag,
@@ -284,7 +295,8 @@ int64_t ArrowForeignStorageBase::makeFragment(
         throw std::runtime_error(
             "Importing fixed length arrow array as variable length column");
       }
-      auto offsets_buffer = reinterpret_cast<const uint32_t*>(buffers[1]->data());
+      auto offsets_buffer = reinterpret_cast<const uint32_t*>(buffers[1]->data()) +
+                            chunks[i]->offset();
       varlen += offsets_buffer[offset + size] - offsets_buffer[offset];
     } else if (buffers.size() != 2) {
       throw std::runtime_error(
@@ -295,37 +307,67 @@ int64_t ArrowForeignStorageBase::makeFragment(
   return varlen;
 }
 
+/**
+ * Returns the first row of every fragment followed by the number of rows. When all
+ * columns are split into Arrow chunks at the same rows, a fragment ends at every chunk
+ * boundary and only chunks longer than maxFragRows are sliced, so that every fragment
+ * can use the Arrow buffers directly, see tryZeroCopy. Otherwise every fragment except
+ * the last one has maxFragRows rows.
+ */
+std::vector<int64_t> calculateFragmentBoundaries(const arrow::Table& table,
+                                                 size_t maxFragRows) {
+  const int64_t max_frag_rows = maxFragRows;
+  const int64_t num_rows = table.num_rows();
+  std::vector<int64_t> boundaries{0};
+  bool same_chunks = table.num_columns() > 0;
+  for (int i = 1; same_chunks && i < table.num_columns(); i++) {
+    const auto& chunks = table.column(i)->chunks();
+    const auto& first_chunks = table.column(0)->chunks();
+    same_chunks = chunks.size() == first_chunks.size() &&
+                  std::equal(chunks.begin(),
+                             chunks.end(),
+                             first_chunks.begin(),
+                             [](const auto& lhs, const auto& rhs) {
+                               return lhs->length() == rhs->length();
+                             });
+  }
+  if (!same_chunks) {
+    for (int64_t start = 0; start < num_rows; start += max_frag_rows) {
+      boundaries.push_back(std::min(start + max_frag_rows, num_rows));
+    }
+    return boundaries;
+  }
+  for (const auto& chunk : table.column(0)->chunks()) {
+    // a fragment never spans two chunks: record batches have their own buffers
+    for (int64_t chunk_rows = chunk->length(); chunk_rows > 0;
+         chunk_rows -= max_frag_rows) {
+      boundaries.push_back(boundaries.back() + std::min(chunk_rows, max_frag_rows));
+    }
+  }
+  CHECK_EQ(boundaries.back(), num_rows);
+  return boundaries;
+}
+
+// Maps the fragment row boundaries to the chunks of one column.
 std::vector<Frag> calculateFragmentsOffsets(const arrow::ChunkedArray& array,
-                                            size_t maxFragRows) {
+                                            const std::vector<int64_t>& boundaries) {
   std::vector<Frag> fragments;
-  size_t sz = 0;
-  size_t offset = 0;
-  fragments.push_back({0, 0, 0, 0});
-  size_t num_chunks = (size_t)array.num_chunks();
-  for (size_t i = 0; i < num_chunks;) {
-    auto& chunk = *array.chunk(i);
-    auto& frag = *fragments.rbegin();
-    if (maxFragRows - sz > chunk.length() - offset) {
-      sz += chunk.length() - offset;
-      if (i == num_chunks - 1) {
-        fragments.rbegin()->last_chunk = num_chunks - 1;
-        fragments.rbegin()->last_chunk_size =
-            array.chunk((int)num_chunks - 1)->length() - offset;
-      }
-      offset = 0;
-      i++;
-    } else {
-      frag.last_chunk = i;
-      frag.last_chunk_size = maxFragRows - sz;
-      offset += maxFragRows - sz;
-      sz = 0;
-      fragments.push_back({i, offset, 0, 0});
+  size_t chunk_idx = 0;
+  int64_t chunk_start = 0;
+  for (size_t f = 0; f + 1 < boundaries.size(); f++) {
+    const auto frag_start = boundaries[f];
+    const auto frag_end = boundaries[f + 1];
+    CHECK_LT(frag_start, frag_end);
+    while (chunk_start + array.chunk(chunk_idx)->length() <= frag_start) {
+      chunk_start += array.chunk(chunk_idx++)->length();
     }
-  }
-  if (fragments.rbegin()->first_chunk == fragments.rbegin()->first_chunk &&
-      fragments.rbegin()->last_chunk_size == 0) {
-    // remove empty fragment at the end if any
-    fragments.pop_back();
+    Frag frag{chunk_idx, static_cast<size_t>(frag_start - chunk_start), 0, 0};
+    while (chunk_start + array.chunk(chunk_idx)->length() < frag_end) {
+      chunk_start += array.chunk(chunk_idx++)->length();
+    }
+    frag.last_chunk = chunk_idx;
+    frag.last_chunk_size = frag_end - std::max(chunk_start, frag_start);
+    fragments.push_back(frag);
   }
   return fragments;
 }
@@ -339,6 +381,12 @@ void ArrowForeignStorageBase::parseArrowTable(Catalog_Namespace::Catalog* catalo
                                               const arrow::Table& table) {
   std::map<std::array<int, 3>, StringDictionary*> dictionaries;
   for (auto& c : cols) {
+    if (c.columnType.get_compression() == kENCODING_RL ||
+        c.columnType.get_compression() == kENCODING_DIFF) {
+      // Arrow buffers are used as the chunk data, they can't be stored compressed
+      throw std::runtime_error("Encoding of column " + c.columnName +
+                               " is not supported for Arrow foreign tables.");
+    }
     std::array<int, 3> col_key{table_key.first, table_key.second, c.columnId};
     m_columns[col_key] = {};
     // fsi registerTable runs under SqliteLock which does not allow invoking
@@ -349,11 +397,22 @@ void ArrowForeignStorageBase::parseArrowTable(Catalog_Namespace::Catalog* catalo
     }
   }
 
+  // computed on the chunks as imported, conversions below keep the chunks of a column
+  // or make a single chunk
+  const auto fragment_boundaries = calculateFragmentBoundaries(table, td.maxFragRows);
+
   tbb::task_group tg;
 
   tbb::parallel_for(
       tbb::blocked_range(0, (int)cols.size()),
-      [this, &tg, &table_key, &td, mgr, &table, &cols, &dictionaries](auto range) {
+      [this,
+       &tg,
+       &table_key,
+       mgr,
+       &table,
+       &cols,
+       &dictionaries,
+       &fragment_boundaries](auto range) {
         auto columnIter = std::next(cols.begin(), range.begin());
         for (auto col_idx = range.begin(); col_idx != range.end(); col_idx++) {
           auto& c = *(columnIter++);
@@ -417,7 +476,7 @@ void ArrowForeignStorageBase::parseArrowTable(Catalog_Namespace::Catalog* catalo
           }
 
           auto fragments =
-              calculateFragmentsOffsets(*arr_col_chunked_array, td.maxFragRows);
+              calculateFragmentsOffsets(*arr_col_chunked_array, fragment_boundaries);
 
           auto ctype = c.columnType.get_type();
           auto& col = m_columns[col_key];
@@ -460,7 +519,7 @@ void ArrowForeignStorageBase::parseArrowTable(Catalog_Namespace::Catalog* catalo
                   sz += size;
                   auto data = chunk->buffers[1]->data();
                   b->getEncoder()->updateStatsEncoded(
-                      (const int8_t*)data + offset * type_size, size);
+                      (const int8_t*)data + (chunk->offset + offset) * type_size, size);
                 }
               });
               b->getEncoder()->setNumElems(frag.sz);
@@ -478,6 +537,29 @@ void ArrowForeignStorageBase::append(
   CHECK(false);
 }
 
+namespace {
+
+// Returns the Arrow buffer holding the data of a chunk buffer, nullptr when the array
+// has no values because all of them are null.
+arrow::Buffer* get_arrow_data_buffer(const SQLTypeInfo& sql_type,
+                                     const arrow::ArrayData& array_data) {
+  if (sql_type.is_dict_encoded_string()) {
+    // array_data->buffers[1] stores dictionary indexes
+    return array_data.buffers[1].get();
+  } else if (sql_type.get_type() == kTEXT) {
+    CHECK_GE(array_data.buffers.size(), 3UL);
+    // array_data->buffers[2] stores string array
+    return array_data.buffers[2].get();
+  } else if (array_data.null_count != array_data.length) {
+    // any type except strings (none encoded strings offsets go here as well)
+    CHECK_GE(array_data.buffers.size(), 2UL);
+    return array_data.buffers[1].get();
+  }
+  return nullptr;
+}
+
+}  // namespace
+
 void ArrowForeignStorageBase::read(const ChunkKey& chunk_key,
                                    const SQLTypeInfo& sql_type,
                                    int8_t* dest,
@@ -495,41 +577,35 @@ void ArrowForeignStorageBase::read(const ChunkKey& chunk_key,
     size_t size = (i == frag.chunks.size() - 1) ? (frag.sz - read_size)
                                                 : (array_data->length - offset);
     read_size += size;
-    arrow::Buffer* bp = nullptr;
-    if (sql_type.is_dict_encoded_string()) {
-      // array_data->buffers[1] stores dictionary indexes
-      bp = array_data->buffers[1].get();
-    } else if (sql_type.get_type() == kTEXT) {
-      CHECK_GE(array_data->buffers.size(), 3UL);
-      // array_data->buffers[2] stores string array
-      bp = array_data->buffers[2].get();
-    } else if (array_data->null_count != array_data->length) {
-      // any type except strings (none encoded strings offsets go here as well)
-      CHECK_GE(array_data->buffers.size(), 2UL);
-      bp = array_data->buffers[1].get();
+    // A fragment can end at the start of a chunk, which then adds nothing. The string
+    // offsets of the first chunk are kept even if it is empty, they hold the leading
+    // offset of the fragment.
+    if (i != 0 && size == 0) {
+      continue;
     }
+    arrow::Buffer* bp = get_arrow_data_buffer(sql_type, *array_data);
     CHECK(bp);
     // offset buffer for none encoded strings need to be merged
     if (chunk_key.size() == 5 && chunk_key[4] == 2) {
-      auto data = reinterpret_cast<const uint32_t*>(bp->data()) + offset;
+      auto data = reinterpret_cast<const uint32_t*>(bp->data()) + array_data->offset +
+                  offset;
       auto dest_ui32 = reinterpret_cast<uint32_t*>(dest);
       // as size contains count of string in chunk slice it would always be one less
       // then offsets array size
       sz = (size + 1) * sizeof(uint32_t);
+      // As we support cases when fragment starts with offset of arrow chunk we need
+      // to substract the first element of every chunk from all its elements, a
+      // sliced chunk doesn't start from zero either.
+      varlen_offset -= data[0];
+      if (i != 0) {
+        // We merge arrow chunks with string offsets into a single contigous fragment.
+        // Each string is represented by a pair of offsets, thus size of offset table
+        // is num strings + 1. When merging two chunks, the last number in the first
+        // chunk duplicates the first number in the second chunk, so we skip it.
+        data++;
+        sz -= sizeof(uint32_t);
+      }
       if (sz > 0) {
-        if (i != 0) {
-          // We merge arrow chunks with string offsets into a single contigous fragment.
-          // Each string is represented by a pair of offsets, thus size of offset table
-          // is num strings + 1. When merging two chunks, the last number in the first
-          // chunk duplicates the first number in the second chunk, so we skip it.
-          data++;
-          sz -= sizeof(uint32_t);
-        } else {
-          // As we support cases when fragment starts with offset of arrow chunk we need
-          // to substract the first element of the first chunk from all elements in that
-          // fragment
-          varlen_offset -= data[0];
-        }
         // We also re-calculate offsets in the second chunk as it is a continuation of
         // the first one.
         std::transform(data,
@@ -566,54 +642,66 @@ int8_t* ArrowForeignStorageBase::tryZeroCopy(const ChunkKey& chunk_key,
   std::array<int, 3> col_key{chunk_key[0], chunk_key[1], chunk_key[2]};
   auto& frag = m_columns.at(col_key).at(chunk_key[3]);
 
-  // fragment should be continious to allow zero copy
-  if (frag.chunks.size() != 1) {
-    return nullptr;
-  }
-
-  auto& array_data = frag.chunks[0];
-  int offset = frag.offset;
-
-  arrow::Buffer* bp = nullptr;
-  if (sql_type.is_dict_encoded_string()) {
-    // array_data->buffers[1] stores dictionary indexes
-    bp = array_data->buffers[1].get();
-  } else if (sql_type.get_type() == kTEXT) {
-    CHECK_GE(array_data->buffers.size(), 3UL);
-    // array_data->buffers[2] stores string array
-    bp = array_data->buffers[2].get();
-  } else if (array_data->null_count != array_data->length) {
-    // any type except strings (none encoded strings offsets go here as well)
-    CHECK_GE(array_data->buffers.size(), 2UL);
-    bp = array_data->buffers[1].get();
-  }
-
-  // arrow buffer is empty, it means we should fill fragment with null's in read function
-  if (!bp) {
-    return nullptr;
-  }
-
-  auto data = reinterpret_cast<int8_t*>(const_cast<uint8_t*>(bp->data()));
+  // The parts of the fragment in its Arrow chunks must follow each other in memory,
+  // which is always true for a single chunk and holds for several chunks sliced from
+  // the same buffers.
+  const bool is_string_offsets = chunk_key.size() == 5 && chunk_key[4] == 2;
+  int8_t* frag_data = nullptr;
+  int8_t* frag_data_end = nullptr;
+  size_t read_size = 0;
+  for (size_t i = 0; i < frag.chunks.size(); i++) {
+    auto& array_data = frag.chunks[i];
+    int offset = (i == 0) ? frag.offset : 0;
+    size_t size = (i == frag.chunks.size() - 1) ? (frag.sz - read_size)
+                                                : (array_data->length - offset);
+    read_size += size;
+    if (i != 0 && size == 0) {
+      continue;
+    }
 
-  // if buffer is null encoded string index buffer
-  if (chunk_key.size() == 5 && chunk_key[4] == 2) {
-    // if offset != 0 we need to recalculate index buffer by adding  offset to each index
-    if (offset != 0) {
+    auto bp = get_arrow_data_buffer(sql_type, *array_data);
+    // arrow buffer is empty, it means we should fill fragment with null's in read
+    // function
+    if (!bp) {
       return nullptr;
+    }
+    auto data = reinterpret_cast<int8_t*>(const_cast<uint8_t*>(bp->data()));
+
+    int8_t* begin = nullptr;
+    int8_t* end = nullptr;
+    if (is_string_offsets) {
+      auto offsets =
+          reinterpret_cast<const uint32_t*>(data) + array_data->offset + offset;
+      // offsets not starting from zero need to be recalculated in read function
+      if (i == 0 && offsets[0] != 0) {
+        return nullptr;
+      }
+      // the last offset of a chunk is the first offset of the next one
+      begin = reinterpret_cast<int8_t*>(const_cast<uint32_t*>(offsets));
+      end = reinterpret_cast<int8_t*>(const_cast<uint32_t*>(offsets + size));
+    } else if (auto fixed_type =
+                   dynamic_cast<arrow::FixedWidthType*>(array_data->type.get())) {
+      const auto elem_size = fixed_type->bit_width() / 8;
+      begin = data + (array_data->offset + offset) * elem_size;
+      end = begin + size * elem_size;
     } else {
-      return data;
+      // if buffer is none encoded string data buffer
+      // then we should find it's offset in offset buffer
+      auto offsets_buffer =
+          reinterpret_cast<const uint32_t*>(array_data->buffers[1]->data()) +
+          array_data->offset + offset;
+      begin = data + offsets_buffer[0];
+      end = data + offsets_buffer[size];
     }
-  }
 
-  auto fixed_type = dynamic_cast<arrow::FixedWidthType*>(array_data->type.get());
-  if (fixed_type) {
-    return data + (array_data->offset + offset) * (fixed_type->bit_width() / 8);
+    if (!frag_data) {
+      frag_data = begin;
+    } else if (begin != frag_data_end) {
+      return nullptr;
+    }
+    frag_data_end = end;
   }
-  // if buffer is none encoded string data buffer
-  // then we should find it's offset in offset buffer
-  auto offsets_buffer = reinterpret_cast<const uint32_t*>(array_data->buffers[1]->data());
-  auto string_buffer_offset = offsets_buffer[offset + array_data->offset];
-  return data + string_buffer_offset;
+  return frag_data;
 }
 
 std::shared_ptr<arrow::ChunkedArray>
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RUN_LENGTH_ENCODER_H
+#define RUN_LENGTH_ENCODER_H
+
+#include "AbstractBuffer.h"
+#include "CompressedIntEncoding.h"
+#include "NoneEncoder.h"
+
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Stores a column of logical type T as runs of equal values, see
+ * CompressedIntEncoding.h for the layout. Appends extend the last run of the chunk in
+ * place, so the fragmenter keeps the readers of the table out while appending. The stats
+ * are the ones of the none encoded column.
+ */
+template <typename T>
+class RunLengthEncoder : public NoneEncoder<T> {
+ public:
+  RunLengthEncoder(Data_Namespace::AbstractBuffer* buffer) : NoneEncoder<T>(buffer) {}
+
+  std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
+                                            const size_t num_elems_to_append,
+                                            const SQLTypeInfo&,
+                                            const bool replicating = false,
+                                            const int64_t offset = -1) override {
+    if (offset == 0 && num_elems_to_append >= this->num_elems_) {
+      this->resetChunkStats();
+      this->num_elems_ = 0;
+      this->buffer_->setSize(0);
+    } else if (offset != -1) {
+      throw std::runtime_error(
+          "Partial overwrite of a run length encoded chunk is not supported.");
+    }
+    std::vector<T> replicated_data;
+    if (replicating) {
+      replicated_data.assign(num_elems_to_append, *reinterpret_cast<T*>(src_data));
+    }
+    const T* data =
+        replicating ? replicated_data.data() : reinterpret_cast<const T*>(src_data);
+    this->updateStats(reinterpret_cast<const int8_t*>(data), num_elems_to_append);
+    appendRuns(data, num_elems_to_append);
+    this->num_elems_ += num_elems_to_append;
+    if (!replicating) {
+      src_data += num_elems_to_append * sizeof(T);
+    }
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    this->getMetadata(chunk_metadata);
+    return chunk_metadata;
+  }
+
+  void updateStatsEncoded(const int8_t* const dst_data,
+                          const size_t num_elements) override {
+    UNREACHABLE() << "Run length encoded chunks can't be filled in place.";
+  }
+
+ private:
+  using RunEntry = std::conditional_t<sizeof(T) <= sizeof(int32_t), int32_t, int64_t>;
+
+  void appendRuns(const T* data, const size_t num_elems) {
+    if (!num_elems) {
+      return;
+    }
+    auto buffer = this->buffer_;
+    int64_t run_count{0};
+    if (buffer->size()) {
+      buffer->read(reinterpret_cast<int8_t*>(&run_count), sizeof(run_count), 0);
+    }
+    // (run end, value) pairs, starting with the last run of the chunk which the new
+    // values may extend
+    std::vector<RunEntry> runs;
+    size_t runs_offset = run_length_encoding::kHeaderSize;
+    if (run_count) {
+      runs.resize(2);
+      runs_offset += (run_count - 1) * 2 * sizeof(RunEntry);
+      buffer->read(
+          reinterpret_cast<int8_t*>(runs.data()), 2 * sizeof(RunEntry), runs_offset);
+      --run_count;
+    }
+    for (size_t i = 0; i < num_elems; ++i) {
+      const RunEntry run_end = this->num_elems_ + i + 1;
+      if (!runs.empty() && runs.back() == static_cast<RunEntry>(data[i])) {
+        runs[runs.size() - 2] = run_end;
+      } else {
+        runs.push_back(run_end);
+        runs.push_back(data[i]);
+      }
+    }
+    run_count += runs.size() / 2;
+    buffer->write(reinterpret_cast<int8_t*>(&run_count), sizeof(run_count), 0);
+    buffer->write(reinterpret_cast<int8_t*>(runs.data()),
+                  runs.size() * sizeof(RunEntry),
+                  runs_offset);
+  }
+};  // class RunLengthEncoder
+
+#endif  // RUN_LENGTH_ENCODER_H
@@ -27,6 +27,7 @@
 #include <type_traits>
 
 #include "DataMgr/AbstractBuffer.h"
+#include "DataMgr/CompressedIntEncoding.h"
 #include "DataMgr/DataMgr.h"
 #include "DataMgr/FileMgr/GlobalFileMgr.h"
 #include "LockMgr/LockMgr.h"
@@ -110,6 +111,27 @@ int compute_device_for_fragment(const int table_id,
   }
 }
 
+/**
+ * Appends to RL and DIFF encoded chunks rewrite their header and last run or block, see
+ * DataMgr/CompressedIntEncoding.h, which the copies cached above the insert level miss
+ * when they only fetch the appended bytes. Refreshes the cached CPU copy of such a chunk
+ * and drops the GPU ones. The caller keeps the queries on the table out.
+ */
+void refresh_cached_chunk_copies(DataMgr* data_mgr,
+                                 const ChunkKey& chunk_key,
+                                 AbstractBuffer* insert_buffer,
+                                 const Data_Namespace::MemoryLevel insert_level) {
+  if (insert_level == Data_Namespace::MemoryLevel::DISK_LEVEL &&
+      data_mgr->isBufferOnDevice(chunk_key, Data_Namespace::MemoryLevel::CPU_LEVEL, 0)) {
+    auto cpu_buffer =
+        data_mgr->getChunkBuffer(chunk_key, Data_Namespace::MemoryLevel::CPU_LEVEL, 0);
+    CHECK(cpu_buffer);
+    insert_buffer->copyTo(cpu_buffer);
+    cpu_buffer->unPin();
+  }
+  data_mgr->deleteChunksWithPrefix(chunk_key, Data_Namespace::MemoryLevel::GPU_LEVEL);
+}
+
 }  // namespace
 
 void InsertOrderFragmenter::conditionallyInstantiateFileMgrWithParams() {
@@ -597,9 +619,14 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insert_data) {
   }
   CHECK(insert_data.is_default.size() == insert_data.columnIds.size());
   std::unordered_map<int, int> inverseInsertDataColIdMap;
+  bool has_compressed_int_columns{false};
   for (size_t insertId = 0; insertId < insert_data.columnIds.size(); ++insertId) {
     inverseInsertDataColIdMap.insert(
         std::make_pair(insert_data.columnIds[insertId], insertId));
+    const auto colMapIt = columnMap_.find(insert_data.columnIds[insertId]);
+    CHECK(colMapIt != columnMap_.end());
+    has_compressed_int_columns |=
+        is_run_length_or_diff_encoded(colMapIt->second.getColumnDesc()->columnType);
   }
 
   size_t numRowsLeft = insert_data.numRows;
@@ -679,6 +706,17 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insert_data) {
                                            // never be able to insert anything
 
     {
+      // RL and DIFF encoded chunks are partly rewritten by the append, the queries on the
+      // table must not read them meanwhile. Same lock seq as deleteFragments.
+      std::unique_ptr<lockmgr::WriteLock> compressed_chunks_lock;
+      if (has_compressed_int_columns) {
+        auto chunkKeyPrefix = chunkKeyPrefix_;
+        if (shard_ >= 0) {
+          chunkKeyPrefix[1] = catalog_->getLogicalTableId(chunkKeyPrefix[1]);
+        }
+        compressed_chunks_lock = std::make_unique<lockmgr::WriteLock>(
+            lockmgr::TableDataLockMgr::getWriteLockForTable(chunkKeyPrefix));
+      }
       mapd_unique_lock<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
       // for each column, append the data in the appropriate insert buffer
       for (size_t i = 0; i < insert_data.columnIds.size(); ++i) {
@@ -687,6 +725,13 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insert_data) {
         CHECK(colMapIt != columnMap_.end());
         currentFragment->shadowChunkMetadataMap[columnId] = colMapIt->second.appendData(
             dataCopy[i], numRowsToInsert, numRowsInserted, insert_data.is_default[i]);
+        if (is_run_length_or_diff_encoded(colMapIt->second.getColumnDesc()->columnType)) {
+          ChunkKey chunkKey = chunkKeyPrefix_;
+          chunkKey.push_back(columnId);
+          chunkKey.push_back(currentFragment->fragmentId);
+          refresh_cached_chunk_copies(
+              dataMgr_, chunkKey, colMapIt->second.getBuffer(), defaultInsertLevel_);
+        }
         auto varLenColInfoIt = varLenColInfo_.find(columnId);
         if (varLenColInfoIt != varLenColInfo_.end()) {
           varLenColInfoIt->second = colMapIt->second.getBuffer()->size();
@@ -23,6 +23,7 @@
 
 #include "Catalog/Catalog.h"
 #include "DataMgr/ArrayNoneEncoder.h"
+#include "DataMgr/CompressedIntEncoding.h"
 #include "DataMgr/FixedLengthArrayNoneEncoder.h"
 #include "Fragmenter/InsertOrderFragmenter.h"
 #include "LockMgr/LockMgr.h"
@@ -141,6 +142,46 @@ struct ScalarChunkConverter : public ChunkToInsertDataConverter {
   }
 };
 
+struct CompressedIntChunkConverter : public ChunkToInsertDataConverter {
+  const Chunk_NS::Chunk* chunk_;
+  const ColumnDescriptor* column_descriptor_;
+  const size_t element_size_;
+
+  std::vector<int8_t> decoded_data_;
+  std::vector<int8_t> column_data_;
+
+  CompressedIntChunkConverter(const size_t num_rows, const Chunk_NS::Chunk* chunk)
+      : chunk_(chunk)
+      , column_descriptor_(chunk->getColumnDesc())
+      , element_size_(column_descriptor_->columnType.get_size()) {
+    // run length and differential encoded chunks have no random access by address,
+    // decode the whole chunk once
+    const auto buffer = chunk->getBuffer();
+    const auto num_elems = buffer->getEncoder()->getNumElems();
+    decoded_data_.resize(num_elems * element_size_);
+    decode_compressed_ints(column_descriptor_->columnType,
+                           buffer->getMemoryPtr(),
+                           num_elems,
+                           decoded_data_.data());
+    column_data_.resize(num_rows * element_size_);
+  }
+
+  ~CompressedIntChunkConverter() override {}
+
+  void convertToColumnarFormat(size_t row, size_t indexInFragment) override {
+    memcpy(column_data_.data() + row * element_size_,
+           decoded_data_.data() + indexInFragment * element_size_,
+           element_size_);
+  }
+
+  void addDataBlocksToInsertData(Fragmenter_Namespace::InsertData& insertData) override {
+    DataBlockPtr dataBlock;
+    dataBlock.numbersPtr = column_data_.data();
+    insertData.data.push_back(dataBlock);
+    insertData.columnIds.push_back(column_descriptor_->columnId);
+  }
+};
+
 struct FixedLenArrayChunkConverter : public ChunkToInsertDataConverter {
   const Chunk_NS::Chunk* chunk_;
   const ColumnDescriptor* column_descriptor_;
@@ -376,6 +417,9 @@ void InsertOrderFragmenter::updateColumns(
 
         chunkConverters.push_back(std::move(converter));
 
+      } else if (is_run_length_or_diff_encoded(chunk_cd->columnType)) {
+        chunkConverters.push_back(
+            std::make_unique<CompressedIntChunkConverter>(num_rows, chunk.get()));
       } else if (chunk_cd->columnType.is_date_in_days()) {
         /* Q: Why do we need this?
            A: In variable length updates path we move the chunk content of column
@@ -657,6 +701,12 @@ std::optional<ChunkUpdateStats> InsertOrderFragmenter::updateColumn(
   }
   CHECK(nrow == n_rhs_values || 1 == n_rhs_values);
 
+  if (is_run_length_or_diff_encoded(cd->columnType)) {
+    // these are routed to the variable length update path, which rewrites the chunks
+    throw std::runtime_error("In place update of column " + cd->columnName +
+                             " is not supported for its encoding.");
+  }
+
   auto fragment_ptr = getFragmentInfo(fragment_id);
   auto& fragment = *fragment_ptr;
   auto chunk_meta_it = fragment.getChunkMetadataMapPhysical().find(cd->columnId);
@@ -1376,6 +1426,47 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
           }
         };
 
+    auto compressed_int_vacuum =
+        [=, &update_stats_per_thread, &updel_roll, &frag_offsets, &fragment] {
+          // runs and blocks of deltas can't be compacted in place, the rows to keep are
+          // decoded and the chunk is encoded again
+          const auto element_size = col_type.get_size();
+          std::vector<int8_t> values(nrows_in_fragment * element_size);
+          decode_compressed_ints(col_type, data_addr, nrows_in_fragment, values.data());
+          size_t irow_to_fill = 0;
+          auto offset_it = frag_offsets.begin();
+          for (size_t irow = 0; irow < nrows_in_fragment; ++irow) {
+            if (offset_it != frag_offsets.end() && *offset_it == irow) {
+              ++offset_it;
+              continue;
+            }
+            if (irow_to_fill != irow) {
+              memcpy(values.data() + irow_to_fill * element_size,
+                     values.data() + irow * element_size,
+                     element_size);
+            }
+            ++irow_to_fill;
+          }
+          CHECK_EQ(irow_to_fill, nrows_to_keep);
+
+          auto encoder = data_buffer->getEncoder();
+          encoder->setNumElems(0);
+          auto values_ptr = values.data();
+          encoder->appendData(values_ptr, nrows_to_keep, col_type, false, 0);
+          data_buffer->setUpdated();
+
+          set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
+
+          auto& stats = update_stats_per_thread[ci].new_values_stats;
+          for (size_t irow = 0; irow < nrows_to_keep; ++irow) {
+            set_chunk_stats(col_type,
+                            values.data() + irow * element_size,
+                            stats.has_null,
+                            stats.min_int64t,
+                            stats.max_int64t);
+          }
+        };
+
     auto varlen_vacuum = [=, &updel_roll, &frag_offsets, &fragment] {
       size_t nbytes_var_data_to_keep;
       if (nrows_to_keep == 0) {
@@ -1397,6 +1488,8 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
 
     if (is_varlen) {
       threads.emplace_back(std::async(std::launch::async, varlen_vacuum));
+    } else if (is_run_length_or_diff_encoded(col_type)) {
+      threads.emplace_back(std::async(std::launch::async, compressed_int_vacuum));
     } else {
       threads.emplace_back(std::async(std::launch::async, fixlen_vacuum));
     }
@@ -22,12 +22,169 @@
 
 #include "ImportExport/DelimitedParserUtils.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <string_view>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #include "Logger/Logger.h"
 #include "StringDictionary/StringDictionary.h"
 
 namespace {
+
+// The parsers look at the input in blocks of 64 bytes, with a bit per byte for the
+// characters which delimit fields, rows and quoted regions. The bytes in between are
+// skipped without testing them one at a time.
+constexpr size_t kBlockSize{64};
+
+// Up to 64 bytes of input, padded to a full block when the input ends before that.
+class CharBlock {
+ public:
+  CharBlock(const char* begin, const char* end)
+      : size_(std::min<size_t>(kBlockSize, end - begin)) {
+    if (size_ == kBlockSize) {
+      data_ = begin;
+    } else {
+      std::memcpy(padded_.data(), begin, size_);
+      data_ = padded_.data();
+    }
+  }
+
+  size_t size() const { return size_; }
+
+  // Bits of the bytes equal to any of the first char_count characters.
+  uint64_t match(const char* chars, const size_t char_count) const {
+    uint64_t mask{0};
+#if defined(__AVX2__)
+    const auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data_));
+    const auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data_ + 32));
+    auto lo_eq = _mm256_setzero_si256();
+    auto hi_eq = _mm256_setzero_si256();
+    for (size_t i = 0; i < char_count; ++i) {
+      const auto c = _mm256_set1_epi8(chars[i]);
+      lo_eq = _mm256_or_si256(lo_eq, _mm256_cmpeq_epi8(lo, c));
+      hi_eq = _mm256_or_si256(hi_eq, _mm256_cmpeq_epi8(hi, c));
+    }
+    mask = static_cast<uint32_t>(_mm256_movemask_epi8(lo_eq)) |
+           (uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(hi_eq))) << 32);
+#elif defined(__SSE2__)
+    for (size_t part = 0; part < kBlockSize / 16; ++part) {
+      const auto bytes =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data_ + 16 * part));
+      auto eq = _mm_setzero_si128();
+      for (size_t i = 0; i < char_count; ++i) {
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(chars[i])));
+      }
+      mask |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(eq))) << (16 * part);
+    }
+#else
+    for (size_t pos = 0; pos < kBlockSize; ++pos) {
+      for (size_t i = 0; i < char_count; ++i) {
+        if (data_[pos] == chars[i]) {
+          mask |= uint64_t(1) << pos;
+          break;
+        }
+      }
+    }
+#endif
+    return size_ == kBlockSize ? mask : mask & ((uint64_t(1) << size_) - 1);
+  }
+
+  uint64_t match(const char c) const { return match(&c, 1); }
+
+ private:
+  const char* data_;
+  size_t size_;
+  std::array<char, kBlockSize> padded_;
+};
+
+// Bits of the bytes from an opening quote, included, to the next quote, excluded.
+inline uint64_t get_quoted_region(uint64_t quotes) {
+  quotes ^= quotes << 1;
+  quotes ^= quotes << 2;
+  quotes ^= quotes << 4;
+  quotes ^= quotes << 8;
+  quotes ^= quotes << 16;
+  quotes ^= quotes << 32;
+  return quotes;
+}
+
+// Position of the lowest and of the highest set bit of a non-zero mask.
+inline unsigned lowest_set_bit(const uint64_t mask) {
+#ifdef _MSC_VER
+  unsigned long pos;
+  _BitScanForward64(&pos, mask);
+  return pos;
+#else
+  return __builtin_ctzll(mask);
+#endif
+}
+
+inline unsigned highest_set_bit(const uint64_t mask) {
+#ifdef _MSC_VER
+  unsigned long pos;
+  _BitScanReverse64(&pos, mask);
+  return pos;
+#else
+  return 63 - __builtin_clzll(mask);
+#endif
+}
+
+inline unsigned count_set_bits(const uint64_t mask) {
+#ifdef _MSC_VER
+  return static_cast<unsigned>(__popcnt64(mask));
+#else
+  return __builtin_popcountll(mask);
+#endif
+}
+
+// Finds the next occurrence of any of a few characters, reusing the bits of the last
+// block for the following calls.
+class CharScanner {
+ public:
+  CharScanner(const char* end) : end_(end) {}
+
+  void addChar(const char c) {
+    if (std::find(chars_.begin(), chars_.begin() + char_count_, c) ==
+        chars_.begin() + char_count_) {
+      CHECK_LT(char_count_, chars_.size());
+      chars_[char_count_++] = c;
+    }
+  }
+
+  // Returns the first of the characters at or after p, or the end of the input.
+  const char* next(const char* p) {
+    while (p < end_) {
+      if (!block_begin_ || p < block_begin_ || p >= block_begin_ + kBlockSize) {
+        block_begin_ = p;
+        block_mask_ = CharBlock(p, end_).match(chars_.data(), char_count_);
+      }
+      const auto mask = block_mask_ & (~uint64_t(0) << (p - block_begin_));
+      if (mask) {
+        return block_begin_ + lowest_set_bit(mask);
+      }
+      p = block_begin_ + kBlockSize;
+    }
+    return end_;
+  }
+
+ private:
+  const char* end_;
+  std::array<char, 8> chars_;
+  size_t char_count_{0};
+  const char* block_begin_{nullptr};
+  uint64_t block_mask_{0};
+};
+
 inline bool is_eol(const char& c, const import_export::CopyParams& copy_params) {
   return c == copy_params.line_delim || c == '\n' || c == '\r';
 }
@@ -85,38 +242,47 @@ size_t find_end(const char* buffer,
                 size_t offset) {
   size_t last_line_delim_pos = 0;
   const char* current = buffer + offset;
-  if (copy_params.quoted) {
-    while (current < buffer + size) {
-      while (!in_quote && current < buffer + size) {
-        // We are outside of quotes. We have to find the last possible line delimiter.
-        if (*current == copy_params.line_delim) {
-          last_line_delim_pos = current - buffer;
-          ++num_rows_this_buffer;
-        } else if (*current == copy_params.quote) {
-          in_quote = true;
-        }
-        ++current;
-      }
-
-      while (in_quote && current < buffer + size) {
-        // We are in a quoted field. We have to find the ending quote.
-        if ((*current == copy_params.escape) && (current < buffer + size - 1) &&
-            (*(current + 1) == copy_params.quote)) {
+  const char* const buffer_end = buffer + size;
+  // an escape character which is also the quote character toggles the quoted region
+  // twice, like an empty quoted string, the region doesn't depend on escapes then
+  const bool has_escapes = copy_params.quoted && copy_params.escape != copy_params.quote;
+  while (current < buffer_end) {
+    const CharBlock block(current, buffer_end);
+    uint64_t line_delims = block.match(copy_params.line_delim);
+    if (copy_params.quoted) {
+      if (has_escapes && block.match(copy_params.escape)) {
+        // escaped quotes don't delimit the quoted region, test the bytes one at a time
+        const char* const block_end = current + block.size();
+        while (current < block_end) {
+          if (!in_quote) {
+            if (*current == copy_params.line_delim) {
+              last_line_delim_pos = current - buffer;
+              ++num_rows_this_buffer;
+            } else if (*current == copy_params.quote) {
+              in_quote = true;
+            }
+          } else if ((*current == copy_params.escape) && (current < buffer_end - 1) &&
+                     (*(current + 1) == copy_params.quote)) {
+            ++current;
+          } else if (*current == copy_params.quote) {
+            in_quote = false;
+          }
           ++current;
-        } else if (*current == copy_params.quote) {
-          in_quote = false;
         }
-        ++current;
+        continue;
       }
-    }
-  } else {
-    while (current < buffer + size) {
-      if (*current == copy_params.line_delim) {
-        last_line_delim_pos = current - buffer;
-        ++num_rows_this_buffer;
+      auto quoted_region = get_quoted_region(block.match(copy_params.quote));
+      if (in_quote) {
+        quoted_region = ~quoted_region;
       }
-      ++current;
+      line_delims &= ~quoted_region;
+      in_quote = (quoted_region >> (block.size() - 1)) & 1;
+    }
+    if (line_delims) {
+      num_rows_this_buffer += count_set_bits(line_delims);
+      last_line_delim_pos = current - buffer + highest_set_bit(line_delims);
     }
+    current += block.size();
   }
 
   if (last_line_delim_pos <= 0) {
@@ -213,7 +379,22 @@ const char* get_row(const char* buf,
   bool has_escape = false;
   bool strip_quotes = false;
   try_single_thread = false;
-  for (p = buf; p < entire_buf_end; ++p) {
+  // only these characters change the state of the parser, skip to them
+  CharScanner scanner(entire_buf_end);
+  for (const auto c : {copy_params.escape,
+                       copy_params.delimiter,
+                       copy_params.line_delim,
+                       '\n',
+                       '\r'}) {
+    scanner.addChar(c);
+  }
+  if (copy_params.quoted) {
+    scanner.addChar(copy_params.quote);
+  }
+  if (is_array) {
+    scanner.addChar(copy_params.array_begin);
+  }
+  for (p = scanner.next(buf); p < entire_buf_end; p = scanner.next(p + 1)) {
     if (*p == copy_params.escape && p < entire_buf_end - 1 &&
         *(p + 1) == copy_params.quote) {
       p++;
@@ -53,6 +53,27 @@ size_t find_beginning(const char* buffer,
                       size_t end,
                       const CopyParams& copy_params);
 
+/**
+ * @brief Finds the last row ending in the given buffer, outside of quoted fields.
+ *
+ * @param buffer                 Given buffer which has the rows in csv format. (NOT OWN)
+ * @param size                   Size of the buffer.
+ * @param copy_params            Copy params for the table.
+ * @param num_rows_this_buffer   Incremented by the number of row endings found.
+ * @param buffer_first_row_index Index of first row in the buffer, for error messages.
+ * @param in_quote               Whether the scan starts and ends in a quoted field.
+ * @param offset                 Start index of buffer to look for row endings.
+ *
+ * @return The position after the last row ending in the buffer.
+ */
+size_t find_end(const char* buffer,
+                size_t size,
+                const CopyParams& copy_params,
+                unsigned int& num_rows_this_buffer,
+                size_t buffer_first_row_index,
+                bool& in_quote,
+                size_t offset);
+
 /**
  * @brief Gets the maximum size to which thread buffers should be automatically resized.
  */
@@ -62,6 +62,7 @@
 #include "OSDependent/omnisci_glob.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/ResultCache.h"
 #include "QueryEngine/TypePunning.h"
 #include "Shared/DateTimeParser.h"
 #include "Shared/SqlTypesLayout.h"
@@ -4338,6 +4339,8 @@ void Loader::checkpoint() {
                                                   // tables
     getCatalog().checkpointWithAutoRollback(getTableDesc()->tableId);
   }
+  ResultCache::instance().invalidateTable(getCatalog().getCurrentDB().dbId,
+                                          getTableDesc()->tableId);
 }
 
 std::vector<Catalog_Namespace::TableEpochInfo> Loader::getTableEpochs() const {
@@ -18,6 +18,7 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <ImportExport/QueryExporterArrow.h>
 #include <ImportExport/QueryExporterCSV.h>
 #include <ImportExport/QueryExporterGDAL.h>
 
@@ -33,6 +34,9 @@ std::unique_ptr<QueryExporter> QueryExporter::create(FileType file_type) {
     case FileType::kGeoJSONL:
     case FileType::kShapefile:
       return std::make_unique<QueryExporterGDAL>(file_type);
+    case FileType::kParquet:
+    case FileType::kArrow:
+      return std::make_unique<QueryExporterArrow>(file_type);
   }
   CHECK(false);
   return nullptr;
@@ -0,0 +1,286 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ImportExport/QueryExporterArrow.h"
+
+#include <arrow/api.h>
+#include <arrow/array/concatenate.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/api.h>
+
+#ifdef ENABLE_IMPORT_PARQUET
+#include <parquet/arrow/writer.h>
+#include <parquet/exception.h>
+#include <parquet/properties.h>
+#endif
+
+#include "QueryEngine/ArrowResultSet.h"
+#include "QueryEngine/ResultSet.h"
+#include "Shared/ArrowUtil.h"
+
+namespace import_export {
+
+namespace {
+
+std::string file_type_name(const QueryExporter::FileType file_type) {
+  return file_type == QueryExporter::FileType::kParquet ? "Parquet" : "Arrow";
+}
+
+#ifdef ENABLE_IMPORT_PARQUET
+// replaces the dictionaries of the batch with only the strings its rows reference,
+// since Parquet writes the whole dictionary into every row group
+std::shared_ptr<arrow::RecordBatch> referenced_dictionary_entries(
+    const std::shared_ptr<arrow::RecordBatch>& batch) {
+  auto columns = batch->columns();
+  for (auto& column : columns) {
+    if (column->type_id() != arrow::Type::DICTIONARY) {
+      continue;
+    }
+    auto const& dict_column = static_cast<const arrow::DictionaryArray&>(*column);
+    auto const& indices = static_cast<const arrow::Int32Array&>(*dict_column.indices());
+    auto const& strings =
+        static_cast<const arrow::StringArray&>(*dict_column.dictionary());
+    std::unordered_map<int32_t, int32_t> remapped_ids;
+    arrow::Int32Builder indices_builder;
+    arrow::StringBuilder strings_builder;
+    ARROW_THROW_NOT_OK(indices_builder.Reserve(indices.length()));
+    for (int64_t i = 0; i < indices.length(); ++i) {
+      if (indices.IsNull(i)) {
+        indices_builder.UnsafeAppendNull();
+        continue;
+      }
+      auto const inserted = remapped_ids.emplace(
+          indices.Value(i), static_cast<int32_t>(remapped_ids.size()));
+      if (inserted.second) {
+        ARROW_THROW_NOT_OK(strings_builder.Append(strings.GetView(indices.Value(i))));
+      }
+      indices_builder.UnsafeAppend(inserted.first->second);
+    }
+    std::shared_ptr<arrow::Array> new_indices;
+    ARROW_THROW_NOT_OK(indices_builder.Finish(&new_indices));
+    std::shared_ptr<arrow::Array> new_strings;
+    ARROW_THROW_NOT_OK(strings_builder.Finish(&new_strings));
+    ARROW_ASSIGN_OR_THROW(
+        column,
+        arrow::DictionaryArray::FromArrays(column->type(), new_indices, new_strings));
+  }
+  return arrow::RecordBatch::Make(batch->schema(), batch->num_rows(), columns);
+}
+#endif
+
+}  // namespace
+
+QueryExporterArrow::QueryExporterArrow(const FileType file_type)
+    : QueryExporter(file_type), file_compression_{FileCompression::kNone} {
+  CHECK(file_type == FileType::kParquet || file_type == FileType::kArrow);
+}
+
+QueryExporterArrow::~QueryExporterArrow() {}
+
+void QueryExporterArrow::beginExport(const std::string& file_path,
+                                     const std::string& layer_name,
+                                     const CopyParams& copy_params,
+                                     const std::vector<TargetMetaInfo>& column_infos,
+                                     const FileCompression file_compression,
+                                     const ArrayNullHandling array_null_handling) {
+  if (file_type_ == FileType::kParquet) {
+#ifndef ENABLE_IMPORT_PARQUET
+    throw std::runtime_error("Parquet export is not supported in this build");
+#endif
+    validateFileExtensions(file_path, file_type_name(file_type_), {".parquet"});
+    if (file_compression == FileCompression::kZip) {
+      throw std::runtime_error(
+          "Selected file compression option not yet supported for file type 'Parquet'");
+    }
+  } else {
+    validateFileExtensions(file_path, file_type_name(file_type_), {".arrow", ".feather"});
+    if (file_compression != FileCompression::kNone) {
+      throw std::runtime_error("Compression not yet supported for this file type");
+    }
+  }
+  file_compression_ = file_compression;
+  string_dictionaries_.clear();
+
+  // validate column types before running any query, the converter only handles scalars
+  column_names_.clear();
+  for (auto const& column_info : column_infos) {
+    auto column_name =
+        safeColumnName(column_info.get_resname(), column_names_.size() + 1);
+    auto const& type_info = column_info.get_type_info();
+    if (type_info.is_array() || type_info.is_geometry()) {
+      throw std::runtime_error("Column '" + column_name + "' has unsupported type '" +
+                               type_info.get_type_name() + "' for file type '" +
+                               file_type_name(file_type_) + "'");
+    }
+    column_names_.push_back(column_name);
+  }
+
+  auto outfile_result = arrow::io::FileOutputStream::Open(file_path);
+  if (!outfile_result.ok()) {
+    throw std::runtime_error("Failed to create file '" + file_path +
+                             "': " + outfile_result.status().ToString());
+  }
+  outfile_ = outfile_result.ValueOrDie();
+}
+
+void QueryExporterArrow::exportResults(
+    const std::vector<AggregatedResult>& query_results) {
+  // convert the result sets of this fragment concurrently, each conversion also splits
+  // its rows across threads
+  std::vector<std::future<std::shared_ptr<arrow::RecordBatch>>> conversions;
+  for (auto const& agg_result : query_results) {
+    CHECK(agg_result.rs);
+    updateStringDictionaries(*agg_result.rs);
+    conversions.push_back(std::async(
+        std::launch::async,
+        [this, results = agg_result.rs, string_dictionaries = string_dictionaries_] {
+          ArrowResultSetConverter converter(results,
+                                            nullptr,
+                                            ExecutorDeviceType::CPU,
+                                            0,
+                                            column_names_,
+                                            -1,
+                                            ArrowTransport::WIRE);
+          converter.setStringDictionaries(string_dictionaries);
+          return converter.convertToArrow();
+        }));
+  }
+
+  for (auto& conversion : conversions) {
+    auto batch = conversion.get();
+    if (!schema_) {
+      openWriter(batch->schema());
+    }
+    if (!batch->num_rows()) {
+      continue;
+    }
+    // write in the background while the next fragment is queried, which keeps at most
+    // one converted batch waiting on the writer
+    finishPendingWrite();
+    pending_write_ = std::async(
+        std::launch::async, [this, batch = std::move(batch)] { writeBatch(batch); });
+  }
+}
+
+void QueryExporterArrow::endExport() {
+  finishPendingWrite();
+  if (!schema_) {
+    throw std::runtime_error("No query results to export");
+  }
+  if (ipc_writer_) {
+    ARROW_THROW_NOT_OK(ipc_writer_->Close());
+    ipc_writer_.reset();
+  }
+#ifdef ENABLE_IMPORT_PARQUET
+  if (parquet_writer_) {
+    PARQUET_THROW_NOT_OK(parquet_writer_->Close());
+    parquet_writer_.reset();
+  }
+#endif
+  ARROW_THROW_NOT_OK(outfile_->Close());
+  outfile_.reset();
+}
+
+void QueryExporterArrow::updateStringDictionaries(const ResultSet& results) {
+  for (size_t i = 0; i < results.colCount(); ++i) {
+    auto const col_type = results.getColType(i);
+    if (!col_type.is_dict_encoded_string()) {
+      continue;
+    }
+    // the payload copy is cached by the string dictionary until it grows, and string
+    // ids are never reassigned, so new strings only need to be appended
+    const int dict_id = col_type.get_comp_param();
+    auto const strings = results.getStringDictionaryPayloadCopy(dict_id);
+    auto& dictionary = string_dictionaries_[dict_id];
+    const size_t known_count = dictionary ? dictionary->length() : 0;
+    if (strings->size() <= known_count) {
+      continue;
+    }
+    arrow::StringBuilder builder;
+    for (size_t string_id = known_count; string_id < strings->size(); ++string_id) {
+      ARROW_THROW_NOT_OK(builder.Append((*strings)[string_id]));
+    }
+    std::shared_ptr<arrow::Array> new_strings;
+    ARROW_THROW_NOT_OK(builder.Finish(&new_strings));
+    if (dictionary) {
+      ARROW_ASSIGN_OR_THROW(dictionary, arrow::Concatenate({dictionary, new_strings}));
+    } else {
+      dictionary = new_strings;
+    }
+  }
+}
+
+void QueryExporterArrow::openWriter(const std::shared_ptr<arrow::Schema>& schema) {
+  CHECK(!schema_);
+  CHECK(outfile_);
+  schema_ = schema;
+  if (file_type_ == FileType::kArrow) {
+    // an IPC file can't replace a dictionary, the strings added to a string dictionary
+    // during the export are written as a delta of the shared dictionary instead
+    auto options = arrow::ipc::IpcWriteOptions::Defaults();
+    options.emit_dictionary_deltas = true;
+    ARROW_ASSIGN_OR_THROW(ipc_writer_,
+                          arrow::ipc::MakeFileWriter(outfile_, schema_, options));
+    return;
+  }
+#ifdef ENABLE_IMPORT_PARQUET
+  auto properties = parquet::WriterProperties::Builder()
+                        .compression(file_compression_ == FileCompression::kGZip
+                                         ? parquet::Compression::GZIP
+                                         : parquet::Compression::UNCOMPRESSED)
+                        ->build();
+  // store the Arrow schema so that readers get the dictionary types back, and encode
+  // the columns of a row group in parallel
+  auto arrow_properties = parquet::ArrowWriterProperties::Builder()
+                              .store_schema()
+                              ->set_use_threads(true)
+                              ->build();
+  PARQUET_THROW_NOT_OK(parquet::arrow::FileWriter::Open(*schema_,
+                                                        arrow::default_memory_pool(),
+                                                        outfile_,
+                                                        properties,
+                                                        arrow_properties,
+                                                        &parquet_writer_));
+#else
+  CHECK(false);
+#endif
+}
+
+void QueryExporterArrow::writeBatch(const std::shared_ptr<arrow::RecordBatch>& batch) {
+  if (ipc_writer_) {
+    ARROW_THROW_NOT_OK(ipc_writer_->WriteRecordBatch(*batch));
+    return;
+  }
+#ifdef ENABLE_IMPORT_PARQUET
+  CHECK(parquet_writer_);
+  std::shared_ptr<arrow::Table> table;
+  ARROW_ASSIGN_OR_THROW(
+      table, arrow::Table::FromRecordBatches({referenced_dictionary_entries(batch)}));
+  PARQUET_THROW_NOT_OK(
+      parquet_writer_->WriteTable(*table, parquet::DEFAULT_MAX_ROW_GROUP_LENGTH));
+#else
+  CHECK(false);
+#endif
+}
+
+void QueryExporterArrow::finishPendingWrite() {
+  if (pending_write_.valid()) {
+    // rethrows a failed write
+    pending_write_.get();
+  }
+}
+
+}  // namespace import_export
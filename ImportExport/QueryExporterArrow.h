@@ -0,0 +1,96 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ImportExport/QueryExporter.h>
+
+// forward declare instead of #include Arrow headers
+namespace arrow {
+class Array;
+class RecordBatch;
+class Schema;
+namespace io {
+class FileOutputStream;
+}  // namespace io
+namespace ipc {
+class RecordBatchWriter;
+}  // namespace ipc
+}  // namespace arrow
+
+#ifdef ENABLE_IMPORT_PARQUET
+namespace parquet {
+namespace arrow {
+class FileWriter;
+}  // namespace arrow
+}  // namespace parquet
+#endif
+
+class ResultSet;
+
+namespace import_export {
+
+/**
+ * Exports query results to Parquet or Arrow IPC files. The results of each fragment are
+ * converted with ArrowResultSetConverter and written as their own record batch (Arrow)
+ * or row groups (Parquet), while the next fragment is queried and converted. Only one
+ * batch is held in memory at a time beyond the one being converted. Dictionary encoded
+ * strings are written as Arrow dictionaries. Arrow files share one dictionary per
+ * string dictionary across all batches, extended with deltas if the string dictionary
+ * grows during the export. Parquet row groups only keep the referenced strings.
+ */
+class QueryExporterArrow : public QueryExporter {
+ public:
+  explicit QueryExporterArrow(const FileType file_type);
+  QueryExporterArrow() = delete;
+  ~QueryExporterArrow();
+
+  void beginExport(const std::string& file_path,
+                   const std::string& layer_name,
+                   const CopyParams& copy_params,
+                   const std::vector<TargetMetaInfo>& column_infos,
+                   const FileCompression file_compression,
+                   const ArrayNullHandling array_null_handling) final;
+  void exportResults(const std::vector<AggregatedResult>& query_results) final;
+  void endExport() final;
+
+ private:
+  std::vector<std::string> column_names_;
+  FileCompression file_compression_;
+  std::shared_ptr<arrow::io::FileOutputStream> outfile_;
+  std::shared_ptr<arrow::Schema> schema_;
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> ipc_writer_;
+  // by string dictionary id, only ever appended to so that earlier batches stay valid
+  std::unordered_map<int, std::shared_ptr<arrow::Array>> string_dictionaries_;
+#ifdef ENABLE_IMPORT_PARQUET
+  std::unique_ptr<parquet::arrow::FileWriter> parquet_writer_;
+#endif
+  // declared last so that an in flight write is joined before the writers go away
+  std::future<void> pending_write_;
+
+  void updateStringDictionaries(const ResultSet& results);
+  void openWriter(const std::shared_ptr<arrow::Schema>& schema);
+  void writeBatch(const std::shared_ptr<arrow::RecordBatch>& batch);
+  void finishPendingWrite();
+};
+
+}  // namespace import_export
@@ -19,6 +19,7 @@
 #include <sys/fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include "Logger/Logger.h"
 
@@ -61,6 +62,14 @@ int fsync(int fd) {
   return ::fsync(fd);
 }
 
+int64_t pread(const int fd, void* buf, const size_t count, const size_t offset) {
+  return ::pread(fd, buf, count, offset);
+}
+
+int64_t pwrite(const int fd, const void* buf, const size_t count, const size_t offset) {
+  return ::pwrite(fd, buf, count, offset);
+}
+
 int open(const char* path, int flags, int mode) {
   return ::open(path, flags, mode);
 }
@@ -64,6 +64,36 @@ int fsync(int fd) {
   return fflush(file);
 }
 
+int64_t pread(const int fd, void* buf, const size_t count, const size_t offset) {
+  OVERLAPPED overlapped{};
+  overlapped.Offset = static_cast<DWORD>(offset);
+  overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+  DWORD bytes_read;
+  if (!ReadFile(reinterpret_cast<HANDLE>(_get_osfhandle(fd)),
+                buf,
+                static_cast<DWORD>(count),
+                &bytes_read,
+                &overlapped)) {
+    return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+  }
+  return bytes_read;
+}
+
+int64_t pwrite(const int fd, const void* buf, const size_t count, const size_t offset) {
+  OVERLAPPED overlapped{};
+  overlapped.Offset = static_cast<DWORD>(offset);
+  overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+  DWORD bytes_written;
+  if (!WriteFile(reinterpret_cast<HANDLE>(_get_osfhandle(fd)),
+                 buf,
+                 static_cast<DWORD>(count),
+                 &bytes_written,
+                 &overlapped)) {
+    return -1;
+  }
+  return bytes_written;
+}
+
 int open(const char* path, int flags, int mode) {
   return _open(path, flags, mode);
 }
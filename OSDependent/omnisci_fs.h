@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
 namespace omnisci {
@@ -31,6 +32,12 @@ int msync(void* addr, size_t length, bool async);
 
 int fsync(int fd);
 
+// Reads or writes at the given offset without moving the file offset, returns the
+// number of bytes transferred or -1 on error.
+int64_t pread(const int fd, void* buf, const size_t count, const size_t offset);
+
+int64_t pwrite(const int fd, const void* buf, const size_t count, const size_t offset);
+
 int open(const char* path, int flags, int mode);
 
 void close(const int fd);
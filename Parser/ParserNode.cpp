@@ -61,6 +61,7 @@
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/JsonAccessors.h"
 #include "QueryEngine/RelAlgExecutor.h"
+#include "QueryEngine/ResultCache.h"
 #include "ReservedKeywords.h"
 #include "Shared/StringTransform.h"
 #include "Shared/measure.h"
@@ -3631,10 +3632,12 @@ void DropTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
 
   auto table_data_write_lock =
       lockmgr::TableDataLockMgr::getWriteLockForTable(catalog, *table);
+  const auto table_id = td->tableId;
   catalog.dropTable(td);
 
   // invalidate cached hashtable
   DeleteTriggeredCacheInvalidator::invalidateCaches();
+  ResultCache::instance().invalidateTable(catalog.getCurrentDB().dbId, table_id);
 }
 
 void AlterTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {}
@@ -3857,10 +3860,12 @@ void TruncateTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   foreign_storage::validate_non_foreign_table_write(td);
   auto table_data_write_lock =
       lockmgr::TableDataLockMgr::getWriteLockForTable(catalog, *table);
+  const auto table_id = td->tableId;
   catalog.truncateTable(td);
 
   // invalidate cached hashtable
   DeleteTriggeredCacheInvalidator::invalidateCaches();
+  ResultCache::instance().invalidateTable(catalog.getCurrentDB().dbId, table_id);
 }
 
 void check_alter_table_privilege(const Catalog_Namespace::SessionInfo& session,
@@ -4347,6 +4352,7 @@ void DropColumnStmt::execute(const Catalog_Namespace::SessionInfo& session) {
 
   // invalidate cached hashtable
   DeleteTriggeredCacheInvalidator::invalidateCaches();
+  ResultCache::instance().invalidateTable(catalog.getCurrentDB().dbId, td->tableId);
 }
 
 void RenameColumnStmt::execute(const Catalog_Namespace::SessionInfo& session) {
@@ -5443,9 +5449,14 @@ void ExportQueryStmt::parseOptions(
           file_type = import_export::QueryExporter::FileType::kGeoJSONL;
         } else if (file_type_str == "shapefile") {
           file_type = import_export::QueryExporter::FileType::kShapefile;
+        } else if (file_type_str == "parquet") {
+          file_type = import_export::QueryExporter::FileType::kParquet;
+        } else if (file_type_str == "arrow") {
+          file_type = import_export::QueryExporter::FileType::kArrow;
         } else {
           throw std::runtime_error(
-              "File Type option must be 'CSV', 'GeoJSON', 'GeoJSONL' or 'Shapefile'");
+              "File Type option must be 'CSV', 'GeoJSON', 'GeoJSONL', 'Shapefile', "
+              "'Parquet' or 'Arrow'");
         }
       } else if (boost::iequals(*p->get_name(), "layer_name")) {
         const StringLiteral* str_literal =
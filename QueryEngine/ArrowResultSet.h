@@ -24,6 +24,7 @@
 #include "TargetValue.h"
 
 #include <type_traits>
+#include <unordered_map>
 
 #include "arrow/api.h"
 #include "arrow/ipc/api.h"
@@ -204,6 +205,8 @@ class ArrowResultSetConverter {
     std::unique_ptr<arrow::ArrayBuilder> builder;
     SQLTypeInfo col_type;
     SQLTypes physical_type;
+    // set when the string ids are collected for a caller provided dictionary
+    std::shared_ptr<arrow::Array> dictionary;
   };
 
   ArrowResultSetConverter(const std::shared_ptr<ResultSet>& results,
@@ -213,6 +216,14 @@ class ArrowResultSetConverter {
 
   std::shared_ptr<arrow::RecordBatch> convertToArrow() const;
 
+  // Dictionaries to attach to the dictionary encoded string columns instead of copying
+  // the string dictionary payload for every conversion, keyed by dictionary id. All the
+  // string ids of the results must be covered by the given dictionaries.
+  void setStringDictionaries(
+      const std::unordered_map<int, std::shared_ptr<arrow::Array>>& dictionaries) {
+    string_dictionaries_ = dictionaries;
+  }
+
  private:
   std::shared_ptr<arrow::RecordBatch> getArrowBatch(
       const std::shared_ptr<arrow::Schema>& schema) const;
@@ -245,6 +256,7 @@ class ArrowResultSetConverter {
   std::vector<std::string> col_names_;
   int32_t top_n_;
   ArrowTransport transport_method_;
+  std::unordered_map<int, std::shared_ptr<arrow::Array>> string_dictionaries_;
 
   friend class ArrowResultSet;
 };
@@ -1042,9 +1042,16 @@ void ArrowResultSetConverter::initializeColumnBuilder(
 
   auto value_type = field->type();
   if (col_type.is_dict_encoded_string()) {
+    const int dict_id = col_type.get_comp_param();
+    const auto dictionary_it = string_dictionaries_.find(dict_id);
+    if (dictionary_it != string_dictionaries_.end()) {
+      // only collect the string ids, the dictionary is attached in finishColumnBuilder
+      column_builder.dictionary = dictionary_it->second;
+      column_builder.builder.reset(new Int32Builder());
+      return;
+    }
     column_builder.builder.reset(new StringDictionary32Builder());
     // add values to the builder
-    const int dict_id = col_type.get_comp_param();
     auto str_list = results_->getStringDictionaryPayloadCopy(dict_id);
 
     arrow::StringBuilder str_array_builder;
@@ -1067,6 +1074,13 @@ std::shared_ptr<arrow::Array> ArrowResultSetConverter::finishColumnBuilder(
     ColumnBuilder& column_builder) const {
   std::shared_ptr<Array> values;
   ARROW_THROW_NOT_OK(column_builder.builder->Finish(&values));
+  if (column_builder.dictionary) {
+    // validates that the string ids fall within the dictionary
+    ARROW_ASSIGN_OR_THROW(values,
+                          DictionaryArray::FromArrays(column_builder.field->type(),
+                                                      values,
+                                                      column_builder.dictionary));
+  }
   return values;
 }
 
@@ -1139,8 +1153,12 @@ void ArrowResultSetConverter::append(
   if (column_builder.col_type.is_dict_encoded_string()) {
     CHECK_EQ(column_builder.physical_type,
              kINT);  // assume all dicts use none-encoded type for now
-    appendToColumnBuilder<StringDictionary32Builder, int32_t>(
-        column_builder, values, is_valid);
+    if (column_builder.dictionary) {
+      appendToColumnBuilder<Int32Builder, int32_t>(column_builder, values, is_valid);
+    } else {
+      appendToColumnBuilder<StringDictionary32Builder, int32_t>(
+          column_builder, values, is_valid);
+    }
     return;
   }
   switch (column_builder.physical_type) {
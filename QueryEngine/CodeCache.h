@@ -16,14 +16,111 @@
 
 #pragma once
 
-#include <boost/functional/hash.hpp>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
 #include <memory>
+#include <string>
 
 #include "QueryEngine/CompilationContext.h"
 #include "StringDictionary/LruCache.hpp"
 
-using CodeCacheKey = std::vector<std::string>;
+/**
+ * Key of the code caches: a 128-bit MD5 fingerprint of the code (usually textual IR) an
+ * entry was compiled from. Parts are hashed as they're added, the IR is printed straight
+ * into the hash, and no text is kept, so keys are cheap to hash and compare. Two keys
+ * are equal iff their fingerprints are.
+ */
+class CodeCacheKey {
+ public:
+  CodeCacheKey() {}
+
+  CodeCacheKey(std::initializer_list<std::string> parts) {
+    for (const auto& part : parts) {
+      push_back(part);
+    }
+  }
+
+  void push_back(const std::string& part) {
+    Stream os(*this);
+    os << part;
+  }
+
+  // Adds the textual IR of an LLVM object, without materializing it as a string.
+  template <class T>
+  void addLlvmObject(const T* llvm_obj) {
+    Stream os(*this);
+    os << *llvm_obj;
+  }
+
+  bool operator==(const CodeCacheKey& that) const {
+    return high_ == that.high_ && low_ == that.low_;
+  }
+
+  bool operator!=(const CodeCacheKey& that) const { return !(*this == that); }
+
+  uint64_t getHigh() const { return high_; }
+  uint64_t getLow() const { return low_; }
+
+  // the fingerprint as 32 hex digits
+  std::string toString() const {
+    char str[33];
+    snprintf(str,
+             sizeof(str),
+             "%016llx%016llx",
+             static_cast<unsigned long long>(high_),
+             static_cast<unsigned long long>(low_));
+    return str;
+  }
+
+  size_t hash() const { return low_; }
+
+ private:
+  // Hashes a part into the fingerprint: the new fingerprint is the MD5 of the previous
+  // one, the part and its length, so the same text split into different parts makes
+  // different keys.
+  class Stream : public llvm::raw_ostream {
+   public:
+    Stream(CodeCacheKey& key) : key_(key) {
+      const uint64_t fingerprint[] = {key_.high_, key_.low_};
+      md5_.update(llvm::StringRef(reinterpret_cast<const char*>(fingerprint),
+                                  sizeof(fingerprint)));
+    }
+
+    ~Stream() override {
+      flush();
+      md5_.update(llvm::StringRef(reinterpret_cast<const char*>(&part_size_),
+                                  sizeof(part_size_)));
+      llvm::MD5::MD5Result result;
+      md5_.final(result);
+      key_.high_ = result.high();
+      key_.low_ = result.low();
+    }
+
+   private:
+    void write_impl(const char* ptr, size_t size) override {
+      md5_.update(llvm::StringRef(ptr, size));
+      part_size_ += size;
+    }
+
+    uint64_t current_pos() const override { return part_size_; }
+
+    CodeCacheKey& key_;
+    llvm::MD5 md5_;
+    uint64_t part_size_{0};
+  };
+
+  uint64_t high_{0};
+  uint64_t low_{0};
+};
+
+struct CodeCacheKeyHash {
+  size_t operator()(const CodeCacheKey& key) const { return key.hash(); }
+};
+
 using CodeCacheVal = std::shared_ptr<CompilationContext>;
 using CodeCacheValWithModule = std::pair<CodeCacheVal, llvm::Module*>;
-using CodeCache =
-    LruCache<CodeCacheKey, CodeCacheValWithModule, boost::hash<CodeCacheKey>>;
+using CodeCache = LruCache<CodeCacheKey, CodeCacheValWithModule, CodeCacheKeyHash>;
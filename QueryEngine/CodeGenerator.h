@@ -21,6 +21,8 @@
 #include "../Analyzer/Analyzer.h"
 #include "Execute.h"
 
+class PersistentObjectCache;
+
 // Code generation utility to be used for queries and scalar expressions.
 class CodeGenerator {
  public:
@@ -75,6 +77,13 @@ class CodeGenerator {
       const std::unordered_set<llvm::Function*>& live_funcs,
       const CompilationOptions& co);
 
+  // Uses the persisted object code of the module if there is one, and persists it if not.
+  static ExecutionEngineWrapper generateNativeCPUCode(
+      llvm::Function* func,
+      const std::unordered_set<llvm::Function*>& live_funcs,
+      const CompilationOptions& co,
+      std::unique_ptr<PersistentObjectCache> object_cache);
+
   static std::string generatePTX(const std::string& cuda_llir,
                                  llvm::TargetMachine* nvptx_target_machine,
                                  llvm::LLVMContext& context);
@@ -100,3 +100,33 @@ llvm::Instruction* FixedWidthSmallDate::codegenDecode(llvm::Value* byte_stream,
       pos};
   return llvm::CallInst::Create(f, args);
 }
+
+RunLengthInt::RunLengthInt(const size_t entry_width) : entry_width_{entry_width} {}
+
+llvm::Instruction* RunLengthInt::codegenDecode(llvm::Value* byte_stream,
+                                               llvm::Value* pos,
+                                               llvm::Module* module) const {
+  auto& context = getGlobalLLVMContext();
+  auto f = module->getFunction("run_length_int_decode");
+  CHECK(f);
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), entry_width_),
+      pos};
+  return llvm::CallInst::Create(f, args);
+}
+
+DiffBlockInt::DiffBlockInt(const int64_t null_val) : null_val_{null_val} {}
+
+llvm::Instruction* DiffBlockInt::codegenDecode(llvm::Value* byte_stream,
+                                               llvm::Value* pos,
+                                               llvm::Module* module) const {
+  auto& context = getGlobalLLVMContext();
+  auto f = module->getFunction("diff_block_int_decode");
+  CHECK(f);
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), null_val_),
+      pos};
+  return llvm::CallInst::Create(f, args);
+}
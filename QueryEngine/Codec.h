@@ -89,4 +89,26 @@ class FixedWidthSmallDate : public Decoder {
   static constexpr int64_t ret_null_val_ = NULL_BIGINT;
 };
 
+class RunLengthInt : public Decoder {
+ public:
+  RunLengthInt(const size_t entry_width);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* module) const override;
+
+ private:
+  const size_t entry_width_;
+};
+
+class DiffBlockInt : public Decoder {
+ public:
+  DiffBlockInt(const int64_t null_val);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* module) const override;
+
+ private:
+  const int64_t null_val_;
+};
+
 #endif  // QUERYENGINE_CODEC_H
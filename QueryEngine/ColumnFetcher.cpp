@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "DataMgr/ArrayNoneEncoder.h"
+#include "DataMgr/CompressedIntEncoding.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/Execute.h"
 #include "Shared/Intervals.h"
@@ -96,12 +97,17 @@ std::pair<const int8_t*, size_t> ColumnFetcher::getOneColumnFragment(
                        fragment.physicalTableId,
                        hash_col.get_column_id(),
                        fragment.fragmentId};
+    // run length and differential encoded chunks are decoded on the CPU, callers expect
+    // one value of the logical type per row
+    const bool decode_chunk = is_run_length_or_diff_encoded(cd->columnType);
+    const auto chunk_mem_lvl =
+        decode_chunk ? Data_Namespace::CPU_LEVEL : effective_mem_lvl;
     const auto chunk = Chunk_NS::Chunk::getChunk(
         cd,
         &catalog.getDataMgr(),
         chunk_key,
-        effective_mem_lvl,
-        effective_mem_lvl == Data_Namespace::CPU_LEVEL ? 0 : device_id,
+        chunk_mem_lvl,
+        chunk_mem_lvl == Data_Namespace::CPU_LEVEL ? 0 : device_id,
         chunk_meta_it->second->numBytes,
         chunk_meta_it->second->numElements);
     chunks_owner.push_back(chunk);
@@ -109,6 +115,19 @@ std::pair<const int8_t*, size_t> ColumnFetcher::getOneColumnFragment(
     auto ab = chunk->getBuffer();
     CHECK(ab->getMemoryPtr());
     col_buff = reinterpret_cast<int8_t*>(ab->getMemoryPtr());
+    if (decode_chunk) {
+      const auto num_elems = chunk_meta_it->second->numElements;
+      const auto num_bytes = num_elems * cd->columnType.get_size();
+      auto decoded = executor->row_set_mem_owner_->allocate(num_bytes, thread_idx);
+      decode_compressed_ints(cd->columnType, col_buff, num_elems, decoded);
+      col_buff = decoded;
+      if (effective_mem_lvl == Data_Namespace::GPU_LEVEL) {
+        CHECK(device_allocator);
+        auto gpu_col_buff = device_allocator->alloc(num_bytes);
+        device_allocator->copyToDevice(gpu_col_buff, decoded, num_bytes);
+        col_buff = gpu_col_buff;
+      }
+    }
   } else {  // temporary table
     const ColumnarResults* col_frag{nullptr};
     {
@@ -917,8 +936,7 @@ const int8_t* ColumnFetcher::transferColumnIfNeeded(
   const auto& col_buffers = columnar_results->getColumnBuffers();
   CHECK_LT(static_cast<size_t>(col_id), col_buffers.size());
   if (memory_level == Data_Namespace::GPU_LEVEL) {
-    const auto& col_ti = columnar_results->getColumnType(col_id);
-    const auto num_bytes = columnar_results->size() * col_ti.get_size();
+    const auto num_bytes = columnar_results->getColumnBufferSize(col_id);
     CHECK(device_allocator);
     auto gpu_col_buffer = device_allocator->alloc(num_bytes);
     device_allocator->copyToDevice(gpu_col_buffer, col_buffers[col_id], num_bytes);
@@ -16,6 +16,7 @@
 
 #include "CodeGenerator.h"
 #include "Codec.h"
+#include "DataMgr/CompressedIntEncoding.h"
 #include "Execute.h"
 #include "WindowContext.h"
 
@@ -73,6 +74,11 @@ std::shared_ptr<Decoder> get_col_decoder(const Analyzer::ColumnVar* col_var) {
       return col_var->get_comp_param() == 16 ? std::make_shared<FixedWidthSmallDate>(2)
                                              : std::make_shared<FixedWidthSmallDate>(4);
     }
+    case kENCODING_RL:
+      return std::make_shared<RunLengthInt>(
+          run_length_encoding::get_entry_width(ti.get_size()));
+    case kENCODING_DIFF:
+      return std::make_shared<DiffBlockInt>(inline_fixed_encoding_null_val(ti));
     default:
       abort();
   }
@@ -15,6 +15,7 @@
  */
 
 #include "ColumnarResults.h"
+#include "DataMgr/CompressedIntEncoding.h"
 #include "Descriptors/RowSetMemoryOwner.h"
 #include "ErrorHandling.h"
 #include "Execute.h"
@@ -103,12 +104,23 @@ ColumnarResults::ColumnarResults(std::shared_ptr<RowSetMemoryOwner> row_set_mem_
   if (is_varlen) {
     throw ColumnarConversionNotSupported();
   }
-  const auto buf_size = num_rows * target_type.get_size();
+  const auto buf_size =
+      is_run_length_or_diff_encoded(target_type)
+          ? get_compressed_int_encoded_size(target_type, one_col_buffer, num_rows)
+          : num_rows * target_type.get_size();
   column_buffers_[0] =
       reinterpret_cast<int8_t*>(row_set_mem_owner->allocate(buf_size, thread_idx_));
   memcpy(((void*)column_buffers_[0]), one_col_buffer, buf_size);
 }
 
+size_t ColumnarResults::getColumnBufferSize(const int col_id) const {
+  const auto& col_ti = getColumnType(col_id);
+  if (is_run_length_or_diff_encoded(col_ti)) {
+    return get_compressed_int_encoded_size(col_ti, column_buffers_[col_id], num_rows_);
+  }
+  return num_rows_ * col_ti.get_size();
+}
+
 std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const std::vector<std::unique_ptr<ColumnarResults>>& sub_results) {
@@ -133,7 +145,28 @@ std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
     return nullptr;
   }
   for (size_t col_idx = 0; col_idx < col_count; ++col_idx) {
-    const auto byte_width = (*nonempty_it)->getColumnType(col_idx).get_size();
+    const auto& col_ti = (*nonempty_it)->getColumnType(col_idx);
+    const auto byte_width = col_ti.get_size();
+    if (is_run_length_or_diff_encoded(col_ti)) {
+      // the runs and blocks of deltas can't be concatenated, decode and re-encode
+      std::vector<int8_t> decoded(byte_width * total_row_count);
+      auto decoded_ptr = decoded.data();
+      for (auto& rs : sub_results) {
+        CHECK_EQ(col_count, rs->column_buffers_.size());
+        if (!rs->size()) {
+          continue;
+        }
+        decode_compressed_ints(
+            col_ti, rs->column_buffers_[col_idx], rs->size(), decoded_ptr);
+        decoded_ptr += rs->size() * byte_width;
+      }
+      const auto encoded =
+          encode_compressed_ints(col_ti, decoded.data(), total_row_count);
+      auto write_ptr = row_set_mem_owner->allocate(encoded.size());
+      memcpy(write_ptr, encoded.data(), encoded.size());
+      merged_results->column_buffers_.push_back(write_ptr);
+      continue;
+    }
     auto write_ptr = row_set_mem_owner->allocate(byte_width * total_row_count);
     merged_results->column_buffers_.push_back(write_ptr);
     for (auto& rs : sub_results) {
@@ -81,6 +81,9 @@ class ColumnarResults {
 
   const size_t size() const { return num_rows_; }
 
+  // run length and differential encoded columns of tables are kept encoded
+  size_t getColumnBufferSize(const int col_id) const;
+
   const SQLTypeInfo& getColumnType(const int col_id) const {
     CHECK_GE(col_id, 0);
     CHECK_LT(static_cast<size_t>(col_id), target_types_.size());
@@ -18,10 +18,13 @@
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <llvm/IR/Module.h>
 
 #include <memory>
 
+#include "Logger/Logger.h"
+
 class CompilationContext {
  public:
   virtual ~CompilationContext() {}
@@ -53,7 +56,14 @@ class ExecutionEngineWrapper {
   llvm::ExecutionEngine* operator->() { return execution_engine_.get(); }
   const llvm::ExecutionEngine* operator->() const { return execution_engine_.get(); }
 
+  void setObjectCache(std::unique_ptr<llvm::ObjectCache> object_cache) {
+    object_cache_ = std::move(object_cache);
+    execution_engine_->setObjectCache(object_cache_.get());
+  }
+
  private:
+  // must outlive the engine
+  std::unique_ptr<llvm::ObjectCache> object_cache_;
   std::unique_ptr<llvm::ExecutionEngine> execution_engine_;
   std::unique_ptr<llvm::JITEventListener> intel_jit_listener_;
 };
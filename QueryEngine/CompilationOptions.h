@@ -84,6 +84,8 @@ struct ExecutionOptions {
   const std::vector<size_t> outer_fragment_indices{};
   bool multifrag_result = false;
   bool preserve_order = false;
+  size_t kernel_priority = 1;         // share of the kernel scheduler workers
+  size_t max_kernel_parallelism = 0;  // 0 means bounded by the scheduler only
 
   static ExecutionOptions defaults() {
     return ExecutionOptions{false,
@@ -109,11 +111,25 @@ struct ExecutionOptions {
     return eo;
   }
 
+  ExecutionOptions with_output_columnar_hint(bool enable = true) const {
+    ExecutionOptions eo = *this;
+    eo.output_columnar_hint = enable;
+    return eo;
+  }
+
   ExecutionOptions with_preserve_order(bool enable = true) const {
     ExecutionOptions eo = *this;
     eo.preserve_order = enable;
     return eo;
   }
+
+  ExecutionOptions with_kernel_scheduling(const size_t priority,
+                                          const size_t max_parallelism) const {
+    ExecutionOptions eo = *this;
+    eo.kernel_priority = priority;
+    eo.max_kernel_parallelism = max_parallelism;
+    return eo;
+  }
 };
 
 #endif  // QUERYENGINE_COMPILATIONOPTIONS_H
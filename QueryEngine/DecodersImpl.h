@@ -155,6 +155,65 @@ SUFFIX(fixed_width_small_date_decode_noinline)(const int8_t* byte_stream,
       byte_stream, byte_width, null_val, ret_null_val, pos);
 }
 
+// Run length and differential decoders, see DataMgr/CompressedIntEncoding.h for the
+// layouts of the chunks.
+
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(run_length_int_decode)(const int8_t* byte_stream,
+                              const int32_t entry_width,
+                              const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  const auto run_count = *reinterpret_cast<const int64_t*>(byte_stream);
+  const auto runs = byte_stream + sizeof(int64_t);
+  // binary search for the first run which ends past pos
+  int64_t lo = 0;
+  int64_t hi = run_count - 1;
+  while (lo < hi) {
+    const auto mid = lo + (hi - lo) / 2;
+    if (SUFFIX(fixed_width_int_decode)(runs, entry_width, 2 * mid) <= pos) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return SUFFIX(fixed_width_int_decode)(runs, entry_width, 2 * lo + 1);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(run_length_int_decode_noinline)(const int8_t* byte_stream,
+                                       const int32_t entry_width,
+                                       const int64_t pos) {
+  return SUFFIX(run_length_int_decode)(byte_stream, entry_width, pos);
+}
+
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(diff_block_int_decode)(const int8_t* byte_stream,
+                              const int64_t null_val,
+                              const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  const int64_t delta_width = *reinterpret_cast<const int32_t*>(byte_stream);
+  // blocks of 1024 deltas, each preceded by the int64_t base
+  const auto block_bytes = sizeof(int64_t) + (delta_width << 10);
+  const auto block = byte_stream + sizeof(int64_t) + (pos >> 10) * block_bytes;
+  const auto delta =
+      SUFFIX(fixed_width_int_decode)(block + sizeof(int64_t), delta_width, pos & 1023);
+  const int64_t delta_null_val =
+      -static_cast<int64_t>((uint64_t(1) << (8 * delta_width - 1)) - 1) - 1;
+  return delta == delta_null_val ? null_val
+                                 : *reinterpret_cast<const int64_t*>(block) + delta;
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(diff_block_int_decode_noinline)(const int8_t* byte_stream,
+                                       const int64_t null_val,
+                                       const int64_t pos) {
+  return SUFFIX(diff_block_int_decode)(byte_stream, null_val, pos);
+}
+
 #undef SUFFIX
 
 #endif  // QUERYENGINE_DECODERSIMPL_H
@@ -157,6 +157,10 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     if (skip_frag.first) {
       continue;
     }
+    if (!table_desc_offset && skip_frag.second == -1 &&
+        executor->skipFragmentJoinKeyRanges(table_desc, fragment)) {
+      continue;
+    }
     rowid_lookup_key_ = std::max(rowid_lookup_key_, skip_frag.second);
     const int chosen_device_count =
         device_type == ExecutorDeviceType::CPU ? 1 : device_count;
@@ -390,6 +394,10 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
     if (skip_frag.first) {
       continue;
     }
+    if (skip_frag.second == -1 &&
+        executor->skipFragmentJoinKeyRanges(outer_table_desc, fragment)) {
+      continue;
+    }
     const int device_id =
         fragment.shard == -1
             ? fragment.deviceIds[static_cast<int>(Data_Namespace::GPU_LEVEL)]
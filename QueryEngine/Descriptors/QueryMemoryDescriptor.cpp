@@ -26,6 +26,9 @@
 #include <boost/algorithm/cxx11/any_of.hpp>
 
 bool g_enable_smem_group_by{true};
+bool g_enable_cpu_shared_group_by_buffer{true};
+// below this many entries the kernels would contend on too few cache lines
+size_t g_cpu_shared_group_by_buffer_min_entries{1 << 20};
 extern bool g_enable_columnar_output;
 
 namespace {
@@ -221,6 +224,45 @@ inline std::vector<int8_t> get_col_byte_widths(const T& col_expr_list) {
   return col_widths;
 }
 
+// All the CPU kernels of a baseline hash group by can insert into the same buffer if
+// every aggregate has an atomic version, see the shared aggregators in
+// RuntimeFunctions.cpp, and the other targets are group by columns, which are read
+// from the key. The other queries keep a buffer per kernel.
+bool cpu_kernels_can_share_memory(const RelAlgExecutionUnit& ra_exe_unit,
+                                  const std::vector<int64_t>& target_groupby_indices) {
+  if (ra_exe_unit.scan_limit || ra_exe_unit.union_all || ra_exe_unit.estimator) {
+    return false;
+  }
+  CHECK_EQ(ra_exe_unit.target_exprs.size(), target_groupby_indices.size());
+  for (size_t target_idx = 0; target_idx < ra_exe_unit.target_exprs.size();
+       ++target_idx) {
+    if (target_groupby_indices[target_idx] >= 0) {
+      continue;
+    }
+    const auto agg_expr =
+        dynamic_cast<const Analyzer::AggExpr*>(ra_exe_unit.target_exprs[target_idx]);
+    if (!agg_expr || agg_expr->get_is_distinct()) {
+      return false;
+    }
+    switch (agg_expr->get_aggtype()) {
+      case kAVG:
+      case kMIN:
+      case kMAX:
+      case kSUM:
+      case kCOUNT:
+        break;
+      default:
+        return false;
+    }
+    const auto arg_expr = agg_expr->get_arg();
+    if (arg_expr && (arg_expr->get_type_info().is_varlen() ||
+                     arg_expr->get_type_info().is_geometry())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
@@ -289,6 +331,7 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
   int8_t group_col_compact_width = 0;
   int32_t idx_target_as_key = -1;
   auto output_columnar = output_columnar_hint;
+  bool kernels_share_memory = false;
   std::vector<int64_t> target_groupby_indices;
 
   switch (col_range_info.hash_type_) {
@@ -364,6 +407,14 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
 
       actual_col_range_info =
           ColRangeInfo{QueryDescriptionType::GroupByBaselineHash, 0, 0, 0, false};
+
+      kernels_share_memory =
+          g_enable_cpu_shared_group_by_buffer && device_type == ExecutorDeviceType::CPU &&
+          entry_count >= g_cpu_shared_group_by_buffer_min_entries && !output_columnar &&
+          !shard_count && !render_info &&
+          QueryMemoryDescriptor::countDescriptorsLogicallyEmpty(
+              count_distinct_descriptors) &&
+          cpu_kernels_can_share_memory(ra_exe_unit, target_groupby_indices);
       break;
     }
     case QueryDescriptionType::Projection: {
@@ -396,7 +447,7 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
       UNREACHABLE() << "Unknown query type";
   }
 
-  return std::make_unique<QueryMemoryDescriptor>(
+  auto query_mem_desc = std::make_unique<QueryMemoryDescriptor>(
       executor,
       ra_exe_unit,
       query_infos,
@@ -416,6 +467,8 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
       render_info && render_info->isPotentialInSituRender(),
       must_use_baseline_sort,
       streaming_top_n);
+  query_mem_desc->kernels_share_memory_ = kernels_share_memory;
+  return query_mem_desc;
 }
 
 namespace {
@@ -467,6 +520,7 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(
     , must_use_baseline_sort_(must_use_baseline_sort)
     , is_table_function_(false)
     , use_streaming_top_n_(use_streaming_top_n)
+    , kernels_share_memory_(false)
     , force_4byte_float_(false)
     , col_slot_context_(col_slot_context) {
   col_slot_context_.setAllUnsetSlotsPaddedSize(8);
@@ -543,6 +597,7 @@ QueryMemoryDescriptor::QueryMemoryDescriptor()
     , must_use_baseline_sort_(false)
     , is_table_function_(false)
     , use_streaming_top_n_(false)
+    , kernels_share_memory_(false)
     , force_4byte_float_(false) {}
 
 QueryMemoryDescriptor::QueryMemoryDescriptor(const Executor* executor,
@@ -567,6 +622,7 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(const Executor* executor,
     , must_use_baseline_sort_(false)
     , is_table_function_(is_table_function)
     , use_streaming_top_n_(false)
+    , kernels_share_memory_(false)
     , force_4byte_float_(false) {}
 
 QueryMemoryDescriptor::QueryMemoryDescriptor(const QueryDescriptionType query_desc_type,
@@ -593,6 +649,7 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(const QueryDescriptionType query_de
     , must_use_baseline_sort_(false)
     , is_table_function_(false)
     , use_streaming_top_n_(false)
+    , kernels_share_memory_(false)
     , force_4byte_float_(false) {}
 
 bool QueryMemoryDescriptor::operator==(const QueryMemoryDescriptor& other) const {
@@ -1195,6 +1252,7 @@ std::string QueryMemoryDescriptor::toString() const {
   str += "\tBucket Val (perfect hash only): " + std::to_string(bucket_) + "\n";
   str += "\tSort on GPU: " + ::toString(sort_on_gpu_) + "\n";
   str += "\tUse Streaming Top N: " + ::toString(use_streaming_top_n_) + "\n";
+  str += "\tKernels Share Memory: " + ::toString(kernels_share_memory_) + "\n";
   str += "\tOutput Columnar: " + ::toString(output_columnar_) + "\n";
   str += "\tRender Output: " + ::toString(render_output_) + "\n";
   str += "\tUse Baseline Sort: " + ::toString(must_use_baseline_sort_) + "\n";
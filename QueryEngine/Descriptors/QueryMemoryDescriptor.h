@@ -267,6 +267,10 @@ class QueryMemoryDescriptor {
 
   bool useStreamingTopN() const { return use_streaming_top_n_; }
 
+  // All the CPU kernels of the query insert into the same group by buffer, instead of
+  // one buffer each which have to be reduced afterwards.
+  bool kernelsShareMemory() const { return kernels_share_memory_; }
+
   bool isLogicalSizedColumnsAllowed() const;
 
   bool mustUseBaselineSort() const { return must_use_baseline_sort_; }
@@ -360,6 +364,7 @@ class QueryMemoryDescriptor {
   bool must_use_baseline_sort_;
   bool is_table_function_;
   bool use_streaming_top_n_;
+  bool kernels_share_memory_;
 
   bool force_4byte_float_;
 
@@ -35,6 +35,7 @@
 #include "QueryEngine/QueryDispatchQueue.h"
 #include "QueryRewrite.h"
 #include "QueryTemplateGenerator.h"
+#include "ResultCache.h"
 #include "ResultSetReductionJIT.h"
 #include "RuntimeFunctions.h"
 #include "SpeculativeTopN.h"
@@ -45,6 +46,7 @@
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
 #include "Parser/ParserNode.h"
+#include "Shared/KernelScheduler.h"
 #include "Shared/SystemParameters.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/checked_alloc.h"
@@ -76,6 +78,9 @@
 bool g_enable_watchdog{false};
 bool g_enable_dynamic_watchdog{false};
 bool g_use_tbb_pool{false};
+bool g_enable_kernel_scheduler{true};
+bool g_enable_parallel_reduction{true};
+size_t g_kernel_scheduler_max_query_parallelism{0};
 bool g_enable_filter_function{true};
 unsigned g_dynamic_watchdog_time_limit{10000};
 bool g_allow_cpu_retry{true};
@@ -92,17 +97,26 @@ float g_filter_push_down_low_frac{-1.0f};
 float g_filter_push_down_high_frac{-1.0f};
 size_t g_filter_push_down_passing_row_ubound{0};
 bool g_enable_columnar_output{false};
+bool g_enable_columnar_intermediate_results{false};
 bool g_enable_left_join_filter_hoisting{true};
 bool g_optimize_row_initialization{true};
 bool g_enable_overlaps_hashjoin{true};
 bool g_enable_hashjoin_many_to_many{false};
 size_t g_overlaps_max_table_size_bytes{1024 * 1024 * 1024};
+size_t g_hash_table_cache_max_size_bytes{0};  // 0 means unbounded
+bool g_hash_table_cache_cost_aware_eviction{false};
+bool g_enable_join_runtime_filters{true};
+size_t g_join_bloom_filter_min_hash_table_bytes{1 << 20};
 double g_overlaps_target_entries_per_bin{1.3};
 bool g_strip_join_covered_quals{false};
 size_t g_constrained_by_in_threshold{10};
 size_t g_big_group_threshold{20000};
 bool g_enable_window_functions{true};
+bool g_enable_parallel_window_partition_compute{true};
+size_t g_parallel_window_partition_compute_threshold{1 << 12};
+size_t g_parallel_window_partition_sort_threshold{1 << 20};
 bool g_enable_table_functions{false};
+size_t g_parallel_table_function_rows_per_thread{1 << 16};
 size_t g_max_memory_allocation_size{2000000000};  // set to max slab size
 size_t g_min_memory_allocation_size{
     256};  // minimum memory allocation required for projection query output buffer
@@ -202,6 +216,7 @@ void Executor::clearMemory(const Data_Namespace::MemoryLevel memory_level) {
         // For now, assume the user wants to purge the hash table cache when they clear
         // CPU memory (currently used in ExecuteTest to lower memory pressure)
         JoinHashTableCacheInvalidator::invalidateCaches();
+        ResultCache::instance().clear();
       }
       break;
     }
@@ -1026,10 +1041,21 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
   const auto reduction_code =
       get_reduction_code(results_per_device, &compilation_queue_time);
 
-  for (size_t i = 1; i < results_per_device.size(); ++i) {
-    reduced_results->getStorage()->reduce(
-        *(results_per_device[i].first->getStorage()), {}, reduction_code);
+  auto clock_begin = timer_start();
+  if (ResultSetStorage::canReduceTree(query_mem_desc)) {
+    std::vector<const ResultSetStorage*> storages;
+    for (const auto& result : results_per_device) {
+      storages.push_back(result.first->getStorage());
+    }
+    CHECK_EQ(storages.front(), reduced_results->getStorage());
+    ResultSetStorage::reduceTree(storages, reduction_code);
+  } else {
+    for (size_t i = 1; i < results_per_device.size(); ++i) {
+      reduced_results->getStorage()->reduce(
+          *(results_per_device[i].first->getStorage()), {}, reduction_code);
+    }
   }
+  reduced_results->addReductionTime(timer_stop(clock_begin));
   reduced_results->addCompilationQueueTime(compilation_queue_time);
   return reduced_results;
 }
@@ -1548,7 +1574,21 @@ TemporaryTable Executor::executeWorkUnitImpl(
                                      render_info,
                                      available_gpus,
                                      available_cpus);
-        if (g_use_tbb_pool) {
+        if (g_enable_kernel_scheduler) {
+          // the kernel_priority and max_kernel_parallelism hints set the query's share
+          // of the scheduler workers
+          const auto& query_hint = ra_exe_unit.query_hint;
+          launchKernelsOnScheduler(
+              shared_context,
+              std::move(kernels),
+              eo.with_kernel_scheduling(
+                  query_hint.isHintRegistered(QueryHint::kKernelPriority)
+                      ? query_hint.kernel_priority
+                      : eo.kernel_priority,
+                  query_hint.isHintRegistered(QueryHint::kMaxKernelParallelism)
+                      ? query_hint.max_kernel_parallelism
+                      : eo.max_kernel_parallelism));
+        } else if (g_use_tbb_pool) {
 #ifdef HAVE_TBB
           VLOG(1) << "Using TBB thread pool for kernel dispatch.";
           launchKernels<threadpool::TbbThreadPool<void>>(shared_context,
@@ -1688,9 +1728,12 @@ void Executor::executeWorkUnitPerFragment(
   }
 
   {
-    auto clock_begin = timer_start();
-    std::lock_guard<std::mutex> kernel_lock(kernel_mutex_);
-    kernel_queue_time_ms_ += timer_stop(clock_begin);
+    std::unique_lock<std::mutex> kernel_lock(kernel_mutex_, std::defer_lock);
+    if (!g_enable_kernel_scheduler || co.device_type == ExecutorDeviceType::GPU) {
+      auto clock_begin = timer_start();
+      kernel_lock.lock();
+      kernel_queue_time_ms_ += timer_stop(clock_begin);
+    }
 
     for (auto fragment_index : fragment_indexes) {
       // We may want to consider in the future allowing this to execute on devices other
@@ -2030,7 +2073,7 @@ size_t permute_storage_columnar(const ResultSetStorage* input_storage,
                                 const ResultSetStorage* output_storage,
                                 size_t output_row_index,
                                 const QueryMemoryDescriptor& output_query_mem_desc,
-                                const std::vector<uint32_t>& top_permutation) {
+                                const Permutation& top_permutation) {
   const auto output_buffer = output_storage->getUnderlyingBuffer();
   const auto input_buffer = input_storage->getUnderlyingBuffer();
   for (const auto sorted_idx : top_permutation) {
@@ -2079,7 +2122,7 @@ size_t permute_storage_row_wise(const ResultSetStorage* input_storage,
                                 const ResultSetStorage* output_storage,
                                 size_t output_row_index,
                                 const QueryMemoryDescriptor& output_query_mem_desc,
-                                const std::vector<uint32_t>& top_permutation) {
+                                const Permutation& top_permutation) {
   const auto output_buffer = output_storage->getUnderlyingBuffer();
   const auto input_buffer = input_storage->getUnderlyingBuffer();
   for (const auto sorted_idx : top_permutation) {
@@ -2331,6 +2374,63 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
   thread_pool.join();
 }
 
+void Executor::launchKernelsOnScheduler(
+    SharedKernelContext& shared_context,
+    std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
+    const ExecutionOptions& eo) {
+  // GPU kernels still assume exclusive use of the devices' memory while they run, so
+  // only CPU-only launches are allowed to overlap with kernels of other queries.
+  const bool has_gpu_kernels =
+      std::any_of(kernels.begin(), kernels.end(), [](const auto& kernel) {
+        return kernel->getDeviceType() == ExecutorDeviceType::GPU;
+      });
+  std::unique_lock<std::mutex> kernel_lock(kernel_mutex_, std::defer_lock);
+  if (has_gpu_kernels) {
+    auto clock_begin = timer_start();
+    kernel_lock.lock();
+    kernel_queue_time_ms_ += timer_stop(clock_begin);
+  }
+
+  size_t max_parallelism = eo.max_kernel_parallelism;
+  if (g_kernel_scheduler_max_query_parallelism) {
+    max_parallelism = max_parallelism ? std::min(max_parallelism,
+                                                 g_kernel_scheduler_max_query_parallelism)
+                                      : g_kernel_scheduler_max_query_parallelism;
+  }
+  auto task_group = threadpool::KernelScheduler::instance().createTaskGroup(
+      eo.kernel_priority, max_parallelism);
+  VLOG(1) << "Scheduling " << kernels.size() << " kernels for query with priority "
+          << task_group->getPriority() << ".";
+  // the longest wait of a kernel for a scheduler worker is reported as queue time
+  std::atomic<int64_t> max_queue_time_ms{0};
+  const auto clock_begin = timer_start();
+  size_t kernel_idx = 1;
+  for (auto& kernel : kernels) {
+    task_group->spawn([this,
+                       &shared_context,
+                       &max_queue_time_ms,
+                       clock_begin,
+                       kernel = kernel.get(),
+                       crt_kernel_idx = kernel_idx++,
+                       parent_thread_id = logger::thread_id()] {
+      CHECK(kernel);
+      DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+      const int64_t queue_time_ms = timer_stop(clock_begin);
+      auto crt_max_queue_time_ms = max_queue_time_ms.load();
+      while (queue_time_ms > crt_max_queue_time_ms &&
+             !max_queue_time_ms.compare_exchange_weak(crt_max_queue_time_ms,
+                                                      queue_time_ms)) {
+      }
+      const size_t thread_idx = crt_kernel_idx % cpu_threads();
+      kernel->run(this, thread_idx, shared_context);
+    });
+  }
+  ScopeGuard queue_time_guard = [this, &max_queue_time_ms] {
+    kernel_queue_time_ms_ += max_queue_time_ms.load();
+  };
+  task_group->wait();
+}
+
 std::vector<size_t> Executor::getTableFragmentIndices(
     const RelAlgExecutionUnit& ra_exe_unit,
     const ExecutorDeviceType device_type,
@@ -3322,8 +3422,13 @@ int32_t Executor::executePlanWithGroupBy(
     return error_code;
   }
 
+  // the buffer shared by all the CPU kernels becomes a result set once they are all done
+  const bool kernels_share_memory =
+      device_type == ExecutorDeviceType::CPU &&
+      query_exe_context->query_mem_desc_.kernelsShareMemory();
   if (error_code != Executor::ERR_OVERFLOW_OR_UNDERFLOW &&
-      error_code != Executor::ERR_DIV_BY_ZERO && !render_allocator_map_ptr) {
+      error_code != Executor::ERR_DIV_BY_ZERO && !render_allocator_map_ptr &&
+      !kernels_share_memory) {
     results = query_exe_context->getRowSet(ra_exe_unit_copy,
                                            query_exe_context->query_mem_desc_);
     CHECK(results);
@@ -3865,6 +3970,50 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
   return skip_frag;
 }
 
+// Returns true iff the outer table fragment has no key in the range of the inner keys
+// of one of the inner hash joins, see HashJoin::getInnerKeyRange(). The hash tables
+// are built when the work unit is compiled, before the fragments are dispatched.
+bool Executor::skipFragmentJoinKeyRanges(
+    const InputDescriptor& table_desc,
+    const Fragmenter_Namespace::FragmentInfo& fragment) {
+  if (!g_enable_join_runtime_filters || !plan_state_) {
+    return false;
+  }
+  const int table_id = table_desc.getTableId();
+  for (const auto& hash_table : plan_state_->join_info_.join_hash_tables_) {
+    const auto key_range = hash_table->getInnerKeyRange();
+    if (!key_range || key_range->outer_col->get_table_id() != table_id) {
+      continue;
+    }
+    if (key_range->min > key_range->max) {
+      VLOG(2) << "Skipping fragment " << fragment.fragmentId
+              << " of an inner join with an empty inner table";
+      return true;
+    }
+    const auto col_id = key_range->outer_col->get_column_id();
+    const auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_id);
+    if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+      continue;
+    }
+    const auto& chunk_type = key_range->outer_col->get_type_info();
+    const auto chunk_min =
+        extract_min_stat(chunk_meta_it->second->chunkStats, chunk_type);
+    const auto chunk_max =
+        extract_max_stat(chunk_meta_it->second->chunkStats, chunk_type);
+    if (chunk_min > chunk_max) {
+      // invalid metadata range, do not skip fragment
+      continue;
+    }
+    if (chunk_max < key_range->min || chunk_min > key_range->max) {
+      VLOG(2) << "Skipping fragment " << fragment.fragmentId << " with keys in ["
+              << chunk_min << ", " << chunk_max << "] out of the inner key range ["
+              << key_range->min << ", " << key_range->max << "]";
+      return true;
+    }
+  }
+  return false;
+}
+
 AggregatedColRange Executor::computeColRangesCache(
     const std::unordered_set<PhysicalInput>& phys_inputs) {
   AggregatedColRange agg_col_range_cache;
@@ -608,6 +608,15 @@ class Executor {
   void launchKernels(SharedKernelContext& shared_context,
                      std::vector<std::unique_ptr<ExecutionKernel>>&& kernels);
 
+  /**
+   * Launches execution kernels on the process-wide kernel scheduler. CPU kernels of
+   * concurrent queries run side by side on the shared workers, without taking the
+   * global kernel lock.
+   */
+  void launchKernelsOnScheduler(SharedKernelContext& shared_context,
+                                std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
+                                const ExecutionOptions& eo);
+
   std::vector<size_t> getTableFragmentIndices(
       const RelAlgExecutionUnit& ra_exe_unit,
       const ExecutorDeviceType device_type,
@@ -835,6 +844,11 @@ class Executor {
                                    ExecutorDeviceType device_type,
                                    const std::vector<InputTableInfo>& input_table_infos);
 
+  void createBatchErrorCheckControlFlow(llvm::Function* query_func,
+                                        llvm::BasicBlock* batch_latch_bb,
+                                        const bool run_with_dynamic_watchdog,
+                                        const bool run_with_allowing_runtime_interrupt);
+
   void insertErrorCodeChecker(llvm::Function* query_func,
                               bool hoist_literals,
                               bool allow_runtime_query_interrupt);
@@ -917,6 +931,9 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  bool skipFragmentJoinKeyRanges(const InputDescriptor& table_desc,
+                                 const Fragmenter_Namespace::FragmentInfo& fragment);
+
   AggregatedColRange computeColRangesCache(
       const std::unordered_set<PhysicalInput>& phys_inputs);
   StringDictionaryGenerations computeStringDictionaryGenerations(
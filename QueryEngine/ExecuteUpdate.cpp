@@ -24,6 +24,7 @@
 #include "QueryEngine/TableOptimizer.h"
 
 extern bool g_enable_auto_metadata_update;
+extern bool g_enable_kernel_scheduler;
 
 UpdateLogForFragment::UpdateLogForFragment(FragmentInfoType const& fragment_info,
                                            size_t const fragment_index,
@@ -169,9 +170,12 @@ TableUpdateMetadata Executor::executeUpdate(
                                               /*render_info=*/nullptr,
                                               /*rowid_lookup_key=*/-1);
 
-      auto clock_begin = timer_start();
-      std::lock_guard<std::mutex> kernel_lock(kernel_mutex_);
-      kernel_queue_time_ms_ += timer_stop(clock_begin);
+      std::unique_lock<std::mutex> kernel_lock(kernel_mutex_, std::defer_lock);
+      if (!g_enable_kernel_scheduler) {
+        auto clock_begin = timer_start();
+        kernel_lock.lock();
+        kernel_queue_time_ms_ += timer_stop(clock_begin);
+      }
 
       current_fragment_kernel.run(this, 0, shared_context);
     }
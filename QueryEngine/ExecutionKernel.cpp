@@ -86,9 +86,34 @@ void SharedKernelContext::addDeviceResults(ResultSetPtr&& device_results,
 
 std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>&
 SharedKernelContext::getFragmentResults() {
+  if (shared_query_exe_context_) {
+    // all the kernels have inserted into the same buffer, no reduction is needed
+    CHECK(all_fragment_results_.empty());
+    auto device_results = shared_query_exe_context_->groupBufferToResults(0);
+    shared_query_exe_context_.reset();
+    addDeviceResults(std::move(device_results),
+                     shared_outer_table_id_,
+                     shared_outer_table_fragment_ids_);
+  }
   return all_fragment_results_;
 }
 
+QueryExecutionContext* SharedKernelContext::getSharedQueryExecutionContext(
+    const std::function<std::unique_ptr<QueryExecutionContext>()>& make_context,
+    int outer_table_id,
+    const std::vector<size_t>& outer_table_fragment_ids) {
+  std::lock_guard<std::mutex> lock(shared_query_exe_context_mutex_);
+  if (!shared_query_exe_context_) {
+    shared_query_exe_context_ = make_context();
+    shared_outer_table_id_ = outer_table_id;
+  }
+  CHECK_EQ(shared_outer_table_id_, outer_table_id);
+  shared_outer_table_fragment_ids_.insert(shared_outer_table_fragment_ids_.end(),
+                                          outer_table_fragment_ids.begin(),
+                                          outer_table_fragment_ids.end());
+  return shared_query_exe_context_.get();
+}
+
 void ExecutionKernel::run(Executor* executor,
                           const size_t thread_idx,
                           SharedKernelContext& shared_context) {
@@ -257,27 +282,36 @@ void ExecutionKernel::runImpl(Executor* executor,
     }
   }
 
+  QueryExecutionContext* query_exe_context{nullptr};
   if (eo.executor_type == ExecutorType::Native) {
+    auto make_query_exe_context = [&]() {
+      return query_mem_desc.getQueryExecutionContext(ra_exe_unit_,
+                                                     executor,
+                                                     chosen_device_type,
+                                                     kernel_dispatch_mode,
+                                                     chosen_device_id,
+                                                     total_num_input_rows,
+                                                     fetch_result.col_buffers,
+                                                     fetch_result.frag_offsets,
+                                                     executor->getRowSetMemoryOwner(),
+                                                     compilation_result.output_columnar,
+                                                     query_mem_desc.sortOnGpu(),
+                                                     thread_idx,
+                                                     do_render ? render_info_ : nullptr);
+    };
     try {
-      query_exe_context_owned =
-          query_mem_desc.getQueryExecutionContext(ra_exe_unit_,
-                                                  executor,
-                                                  chosen_device_type,
-                                                  kernel_dispatch_mode,
-                                                  chosen_device_id,
-                                                  total_num_input_rows,
-                                                  fetch_result.col_buffers,
-                                                  fetch_result.frag_offsets,
-                                                  executor->getRowSetMemoryOwner(),
-                                                  compilation_result.output_columnar,
-                                                  query_mem_desc.sortOnGpu(),
-                                                  thread_idx,
-                                                  do_render ? render_info_ : nullptr);
+      if (chosen_device_type == ExecutorDeviceType::CPU &&
+          query_mem_desc.kernelsShareMemory()) {
+        query_exe_context = shared_context.getSharedQueryExecutionContext(
+            make_query_exe_context, outer_table_id, outer_tab_frag_ids);
+      } else {
+        query_exe_context_owned = make_query_exe_context();
+        query_exe_context = query_exe_context_owned.get();
+      }
     } catch (const OutOfHostMemory& e) {
       throw QueryExecutionError(Executor::ERR_OUT_OF_CPU_MEM);
     }
   }
-  QueryExecutionContext* query_exe_context{query_exe_context_owned.get()};
   CHECK(query_exe_context);
   int32_t err{0};
   uint32_t start_rowid{0};
@@ -19,6 +19,7 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
+#include "QueryEngine/QueryExecutionContext.h"
 
 class SharedKernelContext {
  public:
@@ -33,6 +34,15 @@ class SharedKernelContext {
 
   std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& getFragmentResults();
 
+  // Returns the context whose group by buffer all the CPU kernels of the query insert
+  // into, see QueryMemoryDescriptor::kernelsShareMemory(). The first kernel to ask for
+  // it creates it and the buffer becomes the only fragment result once the kernels are
+  // done.
+  QueryExecutionContext* getSharedQueryExecutionContext(
+      const std::function<std::unique_ptr<QueryExecutionContext>()>& make_context,
+      int outer_table_id,
+      const std::vector<size_t>& outer_table_fragment_ids);
+
   const std::vector<InputTableInfo>& getQueryInfos() const { return query_infos_; }
 
   std::atomic_flag dynamic_watchdog_set = ATOMIC_FLAG_INIT;
@@ -41,6 +51,11 @@ class SharedKernelContext {
   std::mutex reduce_mutex_;
   std::vector<std::pair<ResultSetPtr, std::vector<size_t>>> all_fragment_results_;
 
+  std::mutex shared_query_exe_context_mutex_;
+  std::unique_ptr<QueryExecutionContext> shared_query_exe_context_;
+  int shared_outer_table_id_{-1};
+  std::vector<size_t> shared_outer_table_fragment_ids_;
+
   std::vector<uint64_t> all_frag_row_offsets_;
   std::mutex all_frag_row_offsets_mutex_;
   const std::vector<InputTableInfo>& query_infos_;
@@ -76,6 +91,8 @@ class ExecutionKernel {
            const size_t thread_idx,
            SharedKernelContext& shared_context);
 
+  ExecutorDeviceType getDeviceType() const { return chosen_device_type; }
+
  private:
   const RelAlgExecutionUnit& ra_exe_unit_;
   const ExecutorDeviceType chosen_device_type;
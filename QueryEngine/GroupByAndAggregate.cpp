@@ -1277,6 +1277,10 @@ GroupByAndAggregate::codegenMultiColumnBaselineHash(
   } else {
     func_args.push_back(LL_INT(row_size_quad));
   }
+  if (co.device_type == ExecutorDeviceType::CPU && query_mem_desc.kernelsShareMemory()) {
+    CHECK(!query_mem_desc.didOutputColumnar());
+    func_name += "_shared";
+  }
   if (co.with_dynamic_watchdog) {
     func_name += "_with_watchdog";
   }
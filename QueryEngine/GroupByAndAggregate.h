@@ -42,6 +42,8 @@
 #include <vector>
 
 extern bool g_enable_smem_group_by;
+extern bool g_enable_cpu_shared_group_by_buffer;
+extern size_t g_cpu_shared_group_by_buffer_min_entries;
 extern bool g_bigint_count;
 
 struct ColRangeInfo {
@@ -18,7 +18,11 @@
 
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
 #include <numeric>
+#include <thread>
 
 namespace {
 
@@ -265,6 +269,155 @@ TEST(SetGetTest, OneKeyAllCollisions) {
   ASSERT_EQ(gv, nullptr);
 }
 
+TEST(SharedSetGetTest, ManyThreads) {
+  const int32_t groups_buffer_entry_count{4096};
+  const int32_t key_qw_count{2};
+  // count, sum, max and min double slots after the key
+  const int32_t row_size_quad{key_qw_count + 4};
+  const double skip_val{-1};
+  const int64_t skip_val_bits = *reinterpret_cast<const int64_t*>(&skip_val);
+  // followed by a zeroed state byte per entry
+  std::vector<int64_t> gb(groups_buffer_entry_count * row_size_quad +
+                          groups_buffer_entry_count / sizeof(int64_t));
+  for (int32_t i = 0; i < groups_buffer_entry_count; ++i) {
+    auto row = &gb[i * row_size_quad];
+    std::fill(row, row + key_qw_count, EMPTY_KEY_64);
+    row[key_qw_count] = 0;
+    row[key_qw_count + 1] = 0;
+    row[key_qw_count + 2] = std::numeric_limits<int64_t>::min();
+    row[key_qw_count + 3] = skip_val_bits;
+  }
+  const int64_t row_count{100000};
+  auto make_key = [](const int64_t i) { return std::vector<int64_t>{i % 997, i % 3}; };
+  auto make_double = [skip_val](const int64_t i) {
+    return i % 11 ? static_cast<double>(i % 1013) : skip_val;
+  };
+  const size_t thread_count{8};
+  std::vector<std::thread> threads;
+  for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+    threads.emplace_back([&, thread_idx] {
+      for (int64_t i = thread_idx; i < row_count; i += thread_count) {
+        const auto key = make_key(i);
+        auto gv = get_group_value_shared(&gb[0],
+                                         groups_buffer_entry_count,
+                                         &key[0],
+                                         key_qw_count,
+                                         sizeof(int64_t),
+                                         row_size_quad);
+        ASSERT_NE(gv, nullptr);
+        agg_count_shared(reinterpret_cast<uint64_t*>(gv), 0);
+        agg_sum_shared(gv + 1, i);
+        agg_max_shared(gv + 2, i);
+        agg_min_double_skip_val_shared(gv + 3, make_double(i), skip_val);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  std::map<std::vector<int64_t>, std::vector<int64_t>> expected;
+  std::map<std::vector<int64_t>, double> expected_min;
+  for (int64_t i = 0; i < row_count; ++i) {
+    const auto key = make_key(i);
+    auto it = expected.emplace(key, std::vector<int64_t>{0, 0, 0}).first;
+    ++it->second[0];
+    it->second[1] += i;
+    it->second[2] = std::max(it->second[2], i);
+    auto min_it = expected_min.emplace(key, skip_val).first;
+    const auto val = make_double(i);
+    if (val != skip_val) {
+      min_it->second = min_it->second == skip_val ? val : std::min(min_it->second, val);
+    }
+  }
+  size_t group_count{0};
+  for (int32_t i = 0; i < groups_buffer_entry_count; ++i) {
+    const auto row = &gb[i * row_size_quad];
+    if (row[0] == EMPTY_KEY_64) {
+      continue;
+    }
+    ++group_count;
+    const std::vector<int64_t> key(row, row + key_qw_count);
+    const auto it = expected.find(key);
+    ASSERT_NE(it, expected.end());
+    ASSERT_EQ(row[key_qw_count], it->second[0]);
+    ASSERT_EQ(row[key_qw_count + 1], it->second[1]);
+    ASSERT_EQ(row[key_qw_count + 2], it->second[2]);
+    ASSERT_EQ(*reinterpret_cast<const double*>(&row[key_qw_count + 3]),
+              expected_min[key]);
+  }
+  ASSERT_EQ(group_count, expected.size());
+}
+
+// The empty key is a valid value for any component of a group key, the threads looking
+// up such a group must not wait for it to be written forever.
+template <typename T>
+void run_shared_empty_key_component(const uint32_t key_width) {
+  const int32_t groups_buffer_entry_count{1024};
+  const int32_t key_count{2};
+  const int32_t key_qw_count = (key_count * key_width + 7) / 8;
+  // count slot after the key
+  const int32_t row_size_quad{key_qw_count + 1};
+  std::vector<int64_t> gb(groups_buffer_entry_count * row_size_quad +
+                              groups_buffer_entry_count / sizeof(int64_t),
+                          0);
+  for (int32_t i = 0; i < groups_buffer_entry_count; ++i) {
+    auto key = reinterpret_cast<T*>(&gb[i * row_size_quad]);
+    std::fill(key, key + key_count, get_empty_key<T>());
+  }
+  const int64_t row_count{20000};
+  const auto max_val = std::numeric_limits<T>::max();
+  auto make_key = [max_val](const int64_t i) {
+    return std::vector<T>{static_cast<T>(i % 13), i % 2 ? max_val : T(1)};
+  };
+  const size_t thread_count{8};
+  std::vector<std::thread> threads;
+  for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+    threads.emplace_back([&, thread_idx] {
+      for (int64_t i = thread_idx; i < row_count; i += thread_count) {
+        auto key = make_key(i);
+        std::vector<int64_t> key_buff(key_qw_count);
+        memcpy(&key_buff[0], &key[0], key_count * sizeof(T));
+        auto gv = get_group_value_shared(&gb[0],
+                                         groups_buffer_entry_count,
+                                         &key_buff[0],
+                                         key_count,
+                                         key_width,
+                                         row_size_quad);
+        ASSERT_NE(gv, nullptr);
+        agg_count_shared(reinterpret_cast<uint64_t*>(gv), 0);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  std::map<std::vector<T>, int64_t> counts;
+  for (int32_t i = 0; i < groups_buffer_entry_count; ++i) {
+    const auto row = &gb[i * row_size_quad];
+    const auto key = reinterpret_cast<const T*>(row);
+    if (key[0] == get_empty_key<T>()) {
+      continue;
+    }
+    ASSERT_TRUE(counts.emplace(std::vector<T>(key, key + key_count), row[key_qw_count])
+                    .second);
+  }
+  ASSERT_EQ(counts.size(), size_t(26));
+  for (const auto& [key, count] : counts) {
+    ASSERT_LT(key[0], 13);
+    ASSERT_TRUE(key[1] == max_val || key[1] == 1);
+    int64_t expected{0};
+    for (int64_t i = 0; i < row_count; ++i) {
+      expected += make_key(i) == key;
+    }
+    ASSERT_EQ(count, expected);
+  }
+}
+
+TEST(SharedSetGetTest, EmptyKeyComponent) {
+  run_shared_empty_key_component<int32_t>(sizeof(int32_t));
+  run_shared_empty_key_component<int64_t>(sizeof(int64_t));
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/GroupBySpill.h"
+
+#include <boost/filesystem.hpp>
+
+#include "Analyzer/Analyzer.h"
+#include "Logger/Logger.h"
+#include "Parser/ParserNode.h"
+#include "QueryEngine/RelAlgExecutionUnit.h"
+#include "QueryEngine/ResultSet.h"
+#include "Shared/TargetInfo.h"
+
+extern bool g_bigint_count;
+
+bool g_enable_group_by_spill{false};
+bool g_force_group_by_spill{false};
+size_t g_group_by_spill_partitions{8};
+size_t g_group_by_spill_threshold_bytes{0};
+std::string g_spill_path;
+size_t g_spill_max_size_bytes{0};
+
+std::shared_ptr<Analyzer::Expr> get_spill_partition_key(
+    const RelAlgExecutionUnit& ra_exe_unit) {
+  if (ra_exe_unit.groupby_exprs.empty() || !ra_exe_unit.groupby_exprs.front() ||
+      ra_exe_unit.estimator || ra_exe_unit.union_all) {
+    return nullptr;
+  }
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    if (dynamic_cast<const Analyzer::WindowFunction*>(target_expr)) {
+      return nullptr;
+    }
+    // these targets point to memory of the pass which produced them, and transient
+    // string ids are only valid in the dictionary proxy of their pass
+    const auto target_info = get_target_info(target_expr, g_bigint_count);
+    const auto& ti = target_expr->get_type_info();
+    if (target_info.sql_type.is_varlen() || is_distinct_target(target_info) ||
+        target_info.agg_kind == kAPPROX_MEDIAN ||
+        (ti.is_string() && ti.get_comp_param() == TRANSIENT_DICT_ID)) {
+      return nullptr;
+    }
+  }
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    const auto& ti = groupby_expr->get_type_info();
+    if (ti.is_integer()) {
+      return groupby_expr;
+    }
+    if (ti.is_string() && ti.get_compression() == kENCODING_DICT &&
+        ti.get_comp_param() != TRANSIENT_DICT_ID) {
+      return makeExpr<Analyzer::KeyForStringExpr>(groupby_expr);
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<Analyzer::Expr> make_spill_partition_qual(
+    const std::shared_ptr<Analyzer::Expr>& partition_key,
+    const int64_t modulus,
+    const int64_t residue) {
+  CHECK_GT(modulus, 0);
+  CHECK_GE(residue, 0);
+  CHECK_LT(residue, modulus);
+  const auto make_bigint_constant = [](const int64_t value) {
+    Datum d;
+    d.bigintval = value;
+    return makeExpr<Analyzer::Constant>(kBIGINT, false, d);
+  };
+  const auto modulo = Parser::OperExpr::normalize(
+      kMODULO, kONE, partition_key, make_bigint_constant(modulus));
+  auto qual =
+      Parser::OperExpr::normalize(kEQ, kONE, modulo, make_bigint_constant(residue));
+  if (residue) {
+    // the remainder of a negative key is negative
+    qual = Parser::OperExpr::normalize(
+        kOR,
+        kONE,
+        qual,
+        Parser::OperExpr::normalize(
+            kEQ, kONE, modulo, make_bigint_constant(residue - modulus)));
+  } else if (!partition_key->get_type_info().get_notnull()) {
+    qual = Parser::OperExpr::normalize(
+        kOR, kONE, qual, makeExpr<Analyzer::UOper>(kBOOLEAN, kISNULL, partition_key));
+  }
+  return qual;
+}
+
+SpillFile::SpillFile() {
+  const auto dir = g_spill_path.empty() ? boost::filesystem::temp_directory_path()
+                                        : boost::filesystem::path(g_spill_path);
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(dir, ec);
+  if (ec) {
+    throw std::runtime_error("Could not create the spill directory " + dir.string() +
+                             ": " + ec.message());
+  }
+  path_ =
+      (dir / boost::filesystem::unique_path("omnisci_spill_%%%%-%%%%-%%%%-%%%%")).string();
+  file_.open(path_, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file_) {
+    throw std::runtime_error("Could not create the spill file " + path_);
+  }
+  VLOG(1) << "Spilling query results to " << path_;
+}
+
+SpillFile::~SpillFile() {
+  file_.close();
+  boost::system::error_code ec;
+  boost::filesystem::remove(path_, ec);
+  if (ec) {
+    LOG(WARNING) << "Could not remove the spill file " << path_ << ": " << ec.message();
+  }
+}
+
+SpillFile::Run SpillFile::write(const ResultSet& rows) {
+  const size_t offset = size_bytes_;
+  file_.seekp(offset);
+  const auto row_count = rows.writeRowWiseEntries(file_);
+  if (!file_) {
+    throw std::runtime_error("Could not write to the spill file " + path_);
+  }
+  size_bytes_ += row_count * rows.getQueryMemDesc().getRowSize();
+  if (g_spill_max_size_bytes && size_bytes_ > g_spill_max_size_bytes) {
+    throw std::runtime_error("Query spilled more than the maximum of " +
+                             std::to_string(g_spill_max_size_bytes) + " bytes");
+  }
+  return {offset, row_count};
+}
+
+void SpillFile::read(const Run& run, const size_t row_size, int8_t* buff) {
+  file_.seekg(run.offset);
+  if (!file_.read(reinterpret_cast<char*>(buff), run.row_count * row_size)) {
+    throw std::runtime_error("Could not read the spill file " + path_);
+  }
+}
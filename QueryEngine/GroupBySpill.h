@@ -0,0 +1,91 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Group by queries whose groups don't fit in memory can run in partitions, as long as
+ * one of their group keys is an integer or a dictionary encoded string. Every partition
+ * is a pass over the input which only keeps the rows whose key modulo the number of
+ * partitions is the residue of the partition, so that the partitions have disjoint
+ * groups. The rows of each partition are spilled to a scratch file right after its pass
+ * and read back once all the partitions are done. A partition which still doesn't fit is
+ * split in two by doubling its modulus.
+ *
+ * The runs of a top n query are merged one at a time, keeping only the first rows. The
+ * runs of an intermediate step become the fragments of its result, only the result of
+ * the last step of a query is read back as a whole.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+extern bool g_enable_group_by_spill;
+extern bool g_force_group_by_spill;
+extern size_t g_group_by_spill_partitions;
+// the most host memory in bytes the group by buffer of a CPU kernel can take when group
+// by spill is enabled, 0 means until allocations fail
+extern size_t g_group_by_spill_threshold_bytes;
+extern std::string g_spill_path;
+extern size_t g_spill_max_size_bytes;
+
+namespace Analyzer {
+class Expr;
+}  // namespace Analyzer
+
+class ResultSet;
+struct RelAlgExecutionUnit;
+
+// Returns the group key to partition the execution unit on, or nullptr if its result
+// can't be spilled.
+std::shared_ptr<Analyzer::Expr> get_spill_partition_key(
+    const RelAlgExecutionUnit& ra_exe_unit);
+
+// Returns the filter which selects the rows of `partition_key` modulo `modulus` equal to
+// `residue`. The rows of a null key belong to the partitions of residue 0.
+std::shared_ptr<Analyzer::Expr> make_spill_partition_qual(
+    const std::shared_ptr<Analyzer::Expr>& partition_key,
+    const int64_t modulus,
+    const int64_t residue);
+
+/**
+ * Scratch file holding the rows of the partitions of a query step, removed when the
+ * file object goes away. Writing more than `g_spill_max_size_bytes` (0 means unbounded)
+ * throws.
+ */
+class SpillFile {
+ public:
+  struct Run {
+    size_t offset;
+    size_t row_count;
+  };
+
+  SpillFile();
+  ~SpillFile();
+
+  Run write(const ResultSet& rows);
+
+  void read(const Run& run, const size_t row_size, int8_t* buff);
+
+  size_t getSizeBytes() const { return size_bytes_; }
+
+ private:
+  std::string path_;
+  std::fstream file_;
+  size_t size_bytes_{0};
+};
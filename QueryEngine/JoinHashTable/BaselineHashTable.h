@@ -23,6 +23,7 @@
 #include "QueryEngine/JoinHashTable/HashJoin.h"
 
 #include "QueryEngine/JoinHashTable/HashTable.h"
+#include "QueryEngine/JoinHashTable/JoinBloomFilter.h"
 
 class BaselineHashTable : public HashTable {
  public:
@@ -99,6 +100,18 @@ class BaselineHashTable : public HashTable {
   size_t getEntryCount() const override { return entry_count_; }
   size_t getEmittedKeysCount() const override { return emitted_keys_count_; }
 
+  size_t getCpuMemoryBytes() const override {
+    return getHashTableBufferSize(ExecutorDeviceType::CPU) +
+           (bloom_filter_ ? bloom_filter_->getSizeBytes() : 0);
+  }
+
+  // bloom filter of the keys of a CPU hash table, if worth building
+  const JoinBloomFilter* getBloomFilter() const { return bloom_filter_.get(); }
+
+  void setBloomFilter(std::unique_ptr<JoinBloomFilter> bloom_filter) {
+    bloom_filter_ = std::move(bloom_filter);
+  }
+
  private:
   std::vector<int8_t> cpu_hash_table_buff_;
   Data_Namespace::AbstractBuffer* gpu_hash_table_buff_;
@@ -111,4 +124,5 @@ class BaselineHashTable : public HashTable {
   HashType layout_;
   size_t entry_count_;         // number of keys in the hash table
   size_t emitted_keys_count_;  // number of keys emitted across all rows
+  std::unique_ptr<JoinBloomFilter> bloom_filter_;
 };
@@ -22,6 +22,7 @@
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/ExpressionRange.h"
 #include "QueryEngine/ExpressionRewrite.h"
 #include "QueryEngine/JoinHashTable/BaselineHashTable.h"
 #include "QueryEngine/JoinHashTable/Builders/BaselineHashTableBuilder.h"
@@ -570,6 +571,7 @@ int BaselineJoinHashTable::initHashTableForDevice(
     if (hash_table) {
       hash_tables_for_device_[device_id] = hash_table;
     } else {
+      auto clock_begin = timer_start();
       BaselineJoinHashTableBuilder builder(catalog_);
 
       const auto key_handler =
@@ -590,11 +592,32 @@ int BaselineJoinHashTable::initHashTableForDevice(
                                        join_type_,
                                        getKeyComponentWidth(),
                                        getKeyComponentCount());
-      hash_tables_for_device_[device_id] = builder.getHashTable();
+      auto cpu_hash_table = builder.getHashTable();
+      if (!err && memory_level_ == Data_Namespace::CPU_LEVEL &&
+          g_enable_join_runtime_filters && cpu_hash_table &&
+          cpu_hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU) >=
+              g_join_bloom_filter_min_hash_table_bytes) {
+        cpu_hash_table->setBloomFilter(JoinBloomFilter::fromBaselineHashTable(
+            cpu_hash_table.get(), getKeyComponentCount(), getKeyComponentWidth()));
+      }
+      // the keys left after deletes are usually a narrower range than the metadata one
+      if (!err && g_enable_join_runtime_filters && cpu_hash_table &&
+          inner_outer_pairs_.size() == 1 && getKeyComponentCount() == 1 &&
+          inner_outer_pairs_.front().first->get_type_info().is_integer()) {
+        const auto key_range = computeInnerKeyRange(
+            inner_outer_pairs_.front().first,
+            join_columns.front(),
+            get_inner_query_info(getInnerTableId(), query_infos_).info.fragments,
+            executor_,
+            &column_cache_);
+        cpu_hash_table->setKeyRange(key_range.first, key_range.second);
+      }
+      hash_tables_for_device_[device_id] = std::move(cpu_hash_table);
 
       if (!err) {
         if (getInnerTableId() > 0) {
-          putHashTableOnCpuToCache(cache_key, hash_tables_for_device_[device_id]);
+          putHashTableOnCpuToCache(
+              cache_key, hash_tables_for_device_[device_id], timer_stop(clock_begin));
         }
       }
     }
@@ -626,6 +649,9 @@ int BaselineJoinHashTable::initHashTableForDevice(
                   cpu_source_hash_table->getCpuBuffer(),
                   cpu_source_hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU),
                   device_id);
+      if (const auto& key_range = cpu_source_hash_table->getKeyRange()) {
+        gpu_target_hash_table->setKeyRange(key_range->first, key_range->second);
+      }
       hash_tables_for_device_[device_id] = std::move(gpu_target_hash_table);
 #else
       CHECK(false);
@@ -684,10 +710,15 @@ llvm::Value* BaselineJoinHashTable::codegenSlot(const CompilationOptions& co,
       LL_BUILDER.CreatePointerCast(key_buff_lv, llvm::Type::getInt8PtrTy(LL_CONTEXT));
   const auto key_size_lv = LL_INT(getKeyComponentCount() * key_component_width);
   const auto hash_table = getHashTableForDevice(size_t(0));
+  std::vector<llvm::Value*> args{
+      hash_ptr, key_ptr_lv, key_size_lv, LL_INT(hash_table->getEntryCount())};
+  const auto bloom_filter = codegenBloomFilterArgs(co);
+  args.insert(args.end(), bloom_filter.begin(), bloom_filter.end());
   return executor_->cgen_state_->emitExternalCall(
-      "baseline_hash_join_idx_" + std::to_string(key_component_width * 8),
+      std::string(bloom_filter.empty() ? "" : "bloom_filtered_") +
+          "baseline_hash_join_idx_" + std::to_string(key_component_width * 8),
       get_int_type(64, LL_CONTEXT),
-      {hash_ptr, key_ptr_lv, key_size_lv, LL_INT(hash_table->getEntryCount())});
+      args);
 }
 
 HashJoinMatchingSet BaselineJoinHashTable::codegenMatchingSet(
@@ -708,13 +739,17 @@ HashJoinMatchingSet BaselineJoinHashTable::codegenMatchingSet(
           ? LL_BUILDER.CreatePointerCast(hash_ptr, composite_dict_ptr_type)
           : LL_BUILDER.CreateIntToPtr(hash_ptr, composite_dict_ptr_type);
   const auto key_component_count = getKeyComponentCount();
+  std::vector<llvm::Value*> args{key_buff_lv,
+                                 LL_INT(key_component_count),
+                                 composite_key_dict,
+                                 LL_INT(hash_table->getEntryCount())};
+  const auto bloom_filter = codegenBloomFilterArgs(co);
+  args.insert(args.end(), bloom_filter.begin(), bloom_filter.end());
   const auto key = executor_->cgen_state_->emitExternalCall(
-      "get_composite_key_index_" + std::to_string(key_component_width * 8),
+      std::string(bloom_filter.empty() ? "" : "bloom_filtered_") +
+          "get_composite_key_index_" + std::to_string(key_component_width * 8),
       get_int_type(64, LL_CONTEXT),
-      {key_buff_lv,
-       LL_INT(key_component_count),
-       composite_key_dict,
-       LL_INT(hash_table->getEntryCount())});
+      args);
   auto one_to_many_ptr = hash_ptr;
   if (one_to_many_ptr->getType()->isPointerTy()) {
     one_to_many_ptr =
@@ -820,6 +855,24 @@ llvm::Value* BaselineJoinHashTable::codegenKey(const CompilationOptions& co) {
   return key_buff_lv;
 }
 
+std::vector<llvm::Value*> BaselineJoinHashTable::codegenBloomFilterArgs(
+    const CompilationOptions& co) {
+  if (co.device_type != ExecutorDeviceType::CPU) {
+    return {};
+  }
+  const auto hash_table =
+      dynamic_cast<const BaselineHashTable*>(getHashTableForDevice(size_t(0)));
+  const auto bloom_filter = hash_table ? hash_table->getBloomFilter() : nullptr;
+  if (!bloom_filter) {
+    return {};
+  }
+  // the filter is owned by the hash table, which outlives the kernels using it
+  const auto bits_lv = LL_BUILDER.CreateIntToPtr(
+      LL_INT(reinterpret_cast<int64_t>(bloom_filter->getBits())),
+      llvm::Type::getInt64PtrTy(LL_CONTEXT));
+  return {bits_lv, LL_INT(bloom_filter->getBitMask())};
+}
+
 llvm::Value* BaselineJoinHashTable::hashPtr(const size_t index) {
   AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
   auto hash_ptr = HashJoin::codegenHashTableLoad(index, executor_);
@@ -834,6 +887,32 @@ llvm::Value* BaselineJoinHashTable::hashPtr(const size_t index) {
 #undef LL_BUILDER
 #undef LL_CONTEXT
 
+std::optional<JoinKeyRange> BaselineJoinHashTable::getInnerKeyRange() const {
+  if (inner_outer_pairs_.size() != 1) {
+    return std::nullopt;
+  }
+  // prefer the keys of the built table, which leave out the deleted rows
+  const auto hash_table =
+      hash_tables_for_device_.empty() ? nullptr : getHashTableForDevice(size_t(0));
+  if (hash_table && hash_table->getKeyRange()) {
+    return makeInnerKeyRange(inner_outer_pairs_.front(),
+                             join_type_,
+                             condition_->get_optype(),
+                             hash_table->getKeyRange()->first,
+                             hash_table->getKeyRange()->second);
+  }
+  const auto inner_col = inner_outer_pairs_.front().first;
+  const auto col_range = getExpressionRange(inner_col, query_infos_, executor_);
+  if (col_range.getType() != ExpressionRangeType::Integer) {
+    return std::nullopt;
+  }
+  return makeInnerKeyRange(inner_outer_pairs_.front(),
+                           join_type_,
+                           condition_->get_optype(),
+                           col_range.getIntMin(),
+                           col_range.getIntMax());
+}
+
 int BaselineJoinHashTable::getInnerTableId() const noexcept {
   try {
     return getInnerTableId(inner_outer_pairs_);
@@ -877,7 +956,8 @@ std::shared_ptr<HashTable> BaselineJoinHashTable::initHashTableOnCpuFromCache(
 
 void BaselineJoinHashTable::putHashTableOnCpuToCache(
     const HashTableCacheKey& key,
-    std::shared_ptr<HashTable>& hash_table) {
+    std::shared_ptr<HashTable>& hash_table,
+    const size_t build_time_ms) {
   for (auto chunk_key : key.chunk_keys) {
     CHECK_GE(chunk_key.size(), size_t(2));
     if (chunk_key[1] < 0) {
@@ -885,7 +965,7 @@ void BaselineJoinHashTable::putHashTableOnCpuToCache(
     }
   }
   CHECK(hash_table_cache_);
-  hash_table_cache_->insert(key, hash_table);
+  hash_table_cache_->insert(key, hash_table, build_time_ms);
 }
 
 std::pair<std::optional<size_t>, size_t>
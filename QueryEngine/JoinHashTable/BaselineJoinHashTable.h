@@ -26,6 +26,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include <boost/functional/hash.hpp>
+
 #include "Analyzer/Analyzer.h"
 #include "DataMgr/MemoryLevel.h"
 #include "QueryEngine/ColumnarResults.h"
@@ -48,6 +50,14 @@ struct HashTableCacheKey {
     return num_elements == that.num_elements && chunk_keys == that.chunk_keys &&
            optype == that.optype && join_type == that.join_type;
   }
+
+  size_t hash() const {
+    size_t seed = boost::hash_value(chunk_keys);
+    boost::hash_combine(seed, num_elements);
+    boost::hash_combine(seed, static_cast<int>(optype));
+    boost::hash_combine(seed, static_cast<int>(join_type));
+    return seed;
+  }
 };
 
 class HashTypeCache {
@@ -117,6 +127,8 @@ class BaselineJoinHashTable : public HashJoin {
 
   std::string getHashJoinType() const final { return "Baseline"; }
 
+  std::optional<JoinKeyRange> getInnerKeyRange() const override;
+
   static auto getCacheInvalidator() -> std::function<void()> {
     return []() -> void {
       // TODO: make hash type cache part of the main cache
@@ -191,10 +203,14 @@ class BaselineJoinHashTable : public HashJoin {
 
   llvm::Value* hashPtr(const size_t index);
 
+  // the bloom filter and its bit mask for the probe functions, if the table has one
+  std::vector<llvm::Value*> codegenBloomFilterArgs(const CompilationOptions& co);
+
   std::shared_ptr<HashTable> initHashTableOnCpuFromCache(const HashTableCacheKey&);
 
   void putHashTableOnCpuToCache(const HashTableCacheKey&,
-                                std::shared_ptr<HashTable>& hash_table);
+                                std::shared_ptr<HashTable>& hash_table,
+                                const size_t build_time_ms);
 
   std::pair<std::optional<size_t>, size_t> getApproximateTupleCountFromCache(
       const HashTableCacheKey&) const;
@@ -16,6 +16,8 @@
 
 #include "QueryEngine/JoinHashTable/HashJoin.h"
 
+#include <limits>
+
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/EquiJoinCondition.h"
 #include "QueryEngine/Execute.h"
@@ -358,6 +360,95 @@ CompositeKeyInfo HashJoin::getCompositeKeyInfo(
   return {sd_inner_proxy_per_key, sd_outer_proxy_per_key, cache_key_chunks};
 }
 
+std::optional<JoinKeyRange> HashJoin::makeInnerKeyRange(const InnerOuter& inner_outer,
+                                                        const JoinType join_type,
+                                                        const SQLOps optype,
+                                                        const int64_t min,
+                                                        const int64_t max) {
+  // Nulls can match each other with IS NOT DISTINCT FROM, and they aren't part of the
+  // chunk stats the range is compared to.
+  if (join_type != JoinType::INNER || optype != kEQ) {
+    return std::nullopt;
+  }
+  const auto inner_col = inner_outer.first;
+  const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(inner_outer.second);
+  if (!outer_col || outer_col->get_rte_idx() != 0) {
+    return std::nullopt;
+  }
+  const auto& inner_ti = inner_col->get_type_info();
+  const auto& outer_ti = outer_col->get_type_info();
+  // the keys are compared to the stats of the outer column as they are, which requires
+  // the same logical representation on both sides
+  if (!(inner_ti.is_integer() || inner_ti.is_time()) ||
+      inner_ti.get_type() != outer_ti.get_type() ||
+      inner_ti.get_dimension() != outer_ti.get_dimension()) {
+    return std::nullopt;
+  }
+  return JoinKeyRange{outer_col, min, max};
+}
+
+std::pair<int64_t, int64_t> HashJoin::computeInnerKeyRange(
+    const Analyzer::ColumnVar* inner_col,
+    const JoinColumn& join_column,
+    const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
+    Executor* executor,
+    ColumnCacheMap* column_cache) {
+  const auto& ti = inner_col->get_type_info();
+  CHECK(ti.is_integer());
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
+  std::vector<std::shared_ptr<void>> malloc_owner;
+  std::optional<JoinColumn> deleted_column;
+  const auto catalog = executor->getCatalog();
+  const auto td = inner_col->get_table_id() > 0
+                      ? catalog->getMetadataForTable(inner_col->get_table_id())
+                      : nullptr;
+  const auto deleted_cd = td ? catalog->getDeletedColumnIfRowsDeleted(td) : nullptr;
+  if (deleted_cd) {
+    Analyzer::ColumnVar deleted_col(deleted_cd->columnType,
+                                    td->tableId,
+                                    deleted_cd->columnId,
+                                    inner_col->get_rte_idx());
+    deleted_column = fetchJoinColumn(&deleted_col,
+                                     fragments,
+                                     Data_Namespace::CPU_LEVEL,
+                                     /*device_id=*/0,
+                                     chunks_owner,
+                                     /*dev_buff_owner=*/nullptr,
+                                     malloc_owner,
+                                     executor,
+                                     column_cache);
+    CHECK_EQ(deleted_column->num_chunks, join_column.num_chunks);
+  }
+  const auto chunks = reinterpret_cast<const JoinChunk*>(join_column.col_chunks_buff);
+  const auto deleted_chunks =
+      deleted_column ? reinterpret_cast<const JoinChunk*>(deleted_column->col_chunks_buff)
+                     : nullptr;
+  const auto null_val = inline_fixed_encoding_null_val(ti);
+  std::pair<int64_t, int64_t> range{std::numeric_limits<int64_t>::max(),
+                                    std::numeric_limits<int64_t>::min()};
+  for (size_t chunk_idx = 0; chunk_idx < join_column.num_chunks; ++chunk_idx) {
+    const auto& chunk = chunks[chunk_idx];
+    const int8_t* deleted = nullptr;
+    if (deleted_chunks) {
+      CHECK_EQ(deleted_chunks[chunk_idx].num_elems, chunk.num_elems);
+      deleted = deleted_chunks[chunk_idx].col_buff;
+    }
+    for (size_t i = 0; i < chunk.num_elems; ++i) {
+      if (deleted && deleted[i] > 0) {
+        continue;
+      }
+      const auto key =
+          fixed_width_int_decode_noinline(chunk.col_buff, join_column.elem_sz, i);
+      if (key == null_val) {
+        continue;
+      }
+      range.first = std::min(range.first, key);
+      range.second = std::max(range.second, key);
+    }
+  }
+  return range;
+}
+
 std::shared_ptr<Analyzer::ColumnVar> getSyntheticColumnVar(std::string_view table,
                                                            std::string_view column,
                                                            int rte_idx,
@@ -18,6 +18,7 @@
 
 #include <llvm/IR/Value.h>
 #include <cstdint>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -29,6 +30,8 @@
 #include "QueryEngine/JoinHashTable/HashTable.h"
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
 
+extern bool g_enable_join_runtime_filters;
+
 class TooManyHashEntries : public std::runtime_error {
  public:
   TooManyHashEntries()
@@ -92,6 +95,17 @@ struct HashJoinMatchingSet {
   llvm::Value* slot;
 };
 
+/**
+ * Range of the inner table keys of an inner equijoin on a single integer column. Outer
+ * table fragments whose key column doesn't intersect it can't produce any match, see
+ * Executor::skipFragmentJoinKeyRanges().
+ */
+struct JoinKeyRange {
+  const Analyzer::ColumnVar* outer_col;
+  int64_t min;
+  int64_t max;  // less than `min` if the inner table is empty
+};
+
 struct CompositeKeyInfo {
   std::vector<const void*> sd_inner_proxy_per_key;
   std::vector<const void*> sd_outer_proxy_per_key;
@@ -158,6 +172,9 @@ class HashJoin {
 
   virtual std::string getHashJoinType() const = 0;
 
+  //! Range of the inner keys, if the join allows skipping outer fragments based on it.
+  virtual std::optional<JoinKeyRange> getInnerKeyRange() const { return std::nullopt; }
+
   JoinColumn fetchJoinColumn(
       const Analyzer::ColumnVar* hash_col,
       const std::vector<Fragmenter_Namespace::FragmentInfo>& fragment_info,
@@ -264,9 +281,25 @@ class HashJoin {
       const std::vector<InnerOuter>& inner_outer_pairs,
       const Executor* executor);
 
+  static std::optional<JoinKeyRange> makeInnerKeyRange(const InnerOuter& inner_outer,
+                                                       const JoinType join_type,
+                                                       const SQLOps optype,
+                                                       const int64_t min,
+                                                       const int64_t max);
+
  protected:
   virtual size_t getComponentBufferSize() const noexcept = 0;
 
+  //! Smallest and largest key of an integer inner column fetched on CPU, leaving out
+  //! the nulls and the deleted rows which the metadata range still covers. The largest
+  //! is less than the smallest if no key is left.
+  std::pair<int64_t, int64_t> computeInnerKeyRange(
+      const Analyzer::ColumnVar* inner_col,
+      const JoinColumn& join_column,
+      const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
+      Executor* executor,
+      ColumnCacheMap* column_cache);
+
   std::vector<std::shared_ptr<HashTable>> hash_tables_for_device_;
 };
 
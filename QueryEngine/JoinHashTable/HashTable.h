@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <optional>
+#include <utility>
+
 enum class HashType : int { OneToOne, OneToMany, ManyToMany };
 
 struct DecodedJoinHashBufferEntry {
@@ -46,6 +49,19 @@ class HashTable {
   virtual size_t getEntryCount() const = 0;
   virtual size_t getEmittedKeysCount() const = 0;
 
+  //! Host memory held by the table, charged against the hash table cache budget.
+  virtual size_t getCpuMemoryBytes() const {
+    return getHashTableBufferSize(ExecutorDeviceType::CPU);
+  }
+
+  //! Smallest and largest key of a table on one integer column, found in its entries
+  //! when built on CPU. The largest is less than the smallest if the table is empty.
+  const std::optional<std::pair<int64_t, int64_t>>& getKeyRange() const {
+    return key_range_;
+  }
+
+  void setKeyRange(const int64_t min, const int64_t max) { key_range_ = {min, max}; }
+
   //! Decode hash table into a std::set for easy inspection and validation.
   static DecodedJoinHashBufferSet toSet(
       size_t key_component_count,  // number of key parts
@@ -70,4 +86,7 @@ class HashTable {
       const int8_t* ptr4,              // payloads (rowids)
       size_t buffer_size,
       bool raw = false);
+
+ private:
+  std::optional<std::pair<int64_t, int64_t>> key_range_;
 };
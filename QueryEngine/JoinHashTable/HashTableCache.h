@@ -16,12 +16,57 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Logger/Logger.h"
+#include "QueryEngine/CompilationOptions.h"
 
+extern size_t g_hash_table_cache_max_size_bytes;
+extern bool g_hash_table_cache_cost_aware_eviction;
+
+namespace hash_table_cache {
+
+// Host memory charged against the cache budget for a cached value.
+template <class V>
+size_t entry_size(const V&) {
+  return sizeof(V);
+}
+
+template <class T>
+size_t entry_size(const std::shared_ptr<T>& hash_table) {
+  return hash_table ? hash_table->getCpuMemoryBytes() : 0;
+}
+
+template <class T>
+size_t entry_size(const std::pair<T, std::vector<double>>& value) {
+  return sizeof(value) + value.second.size() * sizeof(double);
+}
+
+}  // namespace hash_table_cache
+
+struct HashTableCacheStats {
+  size_t num_entries{0};
+  size_t size_bytes{0};
+  size_t hits{0};
+  size_t misses{0};
+  size_t evictions{0};
+};
+
+/**
+ * Cache of CPU join hash tables. Entries are indexed by `K::hash()`, which must be
+ * consistent with `K::operator==` but may ignore fields compared loosely, and are kept in
+ * least recently used order. Once the total size of the entries exceeds
+ * `g_hash_table_cache_max_size_bytes` (0 means unbounded), the least recently used entry
+ * is evicted or, with cost aware eviction, the one with the lowest build time per byte.
+ */
 template <class K, class V>
 class HashTableCache {
  public:
@@ -30,51 +75,160 @@ class HashTableCache {
   std::function<void()> getCacheInvalidator() {
     return [this]() -> void {
       std::lock_guard<std::mutex> guard(mutex_);
-      VLOG(1) << "Invalidating " << contents_.size() << " cached hash tables.";
-      contents_.clear();
+      VLOG(1) << "Invalidating " << lru_.size() << " cached hash tables.";
+      clearLocked();
     };
   }
 
+  // returns the cached entries in insertion order, for unit tests
   V getCachedHashTable(const size_t idx) {
     std::lock_guard<std::mutex> guard(mutex_);
-    CHECK_LT(idx, contents_.size());
-    return contents_.at(idx).second;
+    CHECK_LT(idx, lru_.size());
+    std::vector<const Entry*> entries;
+    for (const auto& entry : lru_) {
+      entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry* lhs, const Entry* rhs) {
+      return lhs->insertion_id < rhs->insertion_id;
+    });
+    return entries[idx]->value;
   }
 
   size_t getNumberOfCachedHashTables() {
     std::lock_guard<std::mutex> guard(mutex_);
-    return contents_.size();
+    return lru_.size();
+  }
+
+  HashTableCacheStats getStats() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return {lru_.size(), size_bytes_, hits_, misses_, evictions_};
   }
 
   void clear() {
     std::lock_guard<std::mutex> guard(mutex_);
-    contents_.clear();
+    clearLocked();
   }
 
-  void insert(const K& key, V& hash_table) {
+  void insert(const K& key, V& hash_table, const size_t build_time_ms = 0) {
     std::lock_guard<std::mutex> guard(mutex_);
-    for (auto& kv : contents_) {
-      if (kv.first == key) {
-        auto& cached_hash_table = kv.second;
-        cached_hash_table = hash_table;
+    const size_t entry_size = hash_table_cache::entry_size(hash_table);
+    if (auto it = findLocked(key)) {
+      auto& entry = **it;
+      size_bytes_ -= entry.size_bytes;
+      entry.value = hash_table;
+      entry.size_bytes = entry_size;
+      // re-inserting a table fetched from the cache doesn't know its build time
+      entry.build_time_ms = std::max(entry.build_time_ms, build_time_ms);
+      size_bytes_ += entry_size;
+      lru_.splice(lru_.begin(), lru_, *it);
+    } else {
+      const auto max_size_bytes = g_hash_table_cache_max_size_bytes;
+      if (max_size_bytes && entry_size > max_size_bytes) {
+        VLOG(1) << "Hash table of " << entry_size
+                << " bytes exceeds the hash table cache budget, not caching it.";
         return;
       }
+      lru_.push_front({key, hash_table, entry_size, build_time_ms, next_insertion_id_++});
+      index_.emplace(key.hash(), lru_.begin());
+      size_bytes_ += entry_size;
     }
-    contents_.emplace_back(key, hash_table);
+    evictLocked();
   }
 
   // makes a copy
   std::optional<V> get(const K& key) {
+    if (auto kv = getWithKey(key)) {
+      return kv->second;
+    }
+    return std::nullopt;
+  }
+
+  // makes a copy, also returning the cached key which may differ from `key` in the fields
+  // compared loosely
+  std::optional<std::pair<K, V>> getWithKey(const K& key) {
     std::lock_guard<std::mutex> guard(mutex_);
-    for (const auto& kv : contents_) {
-      if (kv.first == key) {
-        return kv.second;
-      }
+    if (auto it = findLocked(key)) {
+      ++hits_;
+      lru_.splice(lru_.begin(), lru_, *it);
+      return std::make_pair(lru_.front().key, lru_.front().value);
     }
+    ++misses_;
     return std::nullopt;
   }
 
  protected:
-  std::vector<std::pair<K, V>> contents_;
+  struct Entry {
+    K key;
+    V value;
+    size_t size_bytes;
+    size_t build_time_ms;
+    size_t insertion_id;
+  };
+  using EntryIterator = typename std::list<Entry>::iterator;
+
+  std::optional<EntryIterator> findLocked(const K& key) {
+    const auto range = index_.equal_range(key.hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->key == key) {
+        return it->second;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void eraseLocked(EntryIterator entry_it) {
+    const auto range = index_.equal_range(entry_it->key.hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == entry_it) {
+        index_.erase(it);
+        break;
+      }
+    }
+    size_bytes_ -= entry_it->size_bytes;
+    lru_.erase(entry_it);
+  }
+
+  void evictLocked() {
+    const auto max_size_bytes = g_hash_table_cache_max_size_bytes;
+    if (!max_size_bytes) {
+      return;
+    }
+    // the most recently used entry is never evicted, it was just inserted or updated
+    while (size_bytes_ > max_size_bytes && lru_.size() > 1) {
+      auto victim = std::prev(lru_.end());
+      if (g_hash_table_cache_cost_aware_eviction) {
+        // evict the entry that is cheapest to rebuild relative to the memory it holds,
+        // ties go to the least recently used one
+        const auto benefit_per_byte = [](const Entry& entry) {
+          return static_cast<double>(entry.build_time_ms + 1) /
+                 std::max(entry.size_bytes, size_t(1));
+        };
+        victim = std::next(lru_.begin());
+        for (auto it = victim; it != lru_.end(); ++it) {
+          if (benefit_per_byte(*it) <= benefit_per_byte(*victim)) {
+            victim = it;
+          }
+        }
+      }
+      VLOG(1) << "Evicting cached hash table of " << victim->size_bytes << " bytes.";
+      eraseLocked(victim);
+      ++evictions_;
+    }
+  }
+
+  void clearLocked() {
+    lru_.clear();
+    index_.clear();
+    size_bytes_ = 0;
+  }
+
+  // most recently used first
+  std::list<Entry> lru_;
+  std::unordered_multimap<size_t, EntryIterator> index_;
+  size_t size_bytes_{0};
+  size_t next_insertion_id_{0};
+  size_t hits_{0};
+  size_t misses_{0};
+  size_t evictions_{0};
   std::mutex mutex_;
 };
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/JoinHashTable/JoinBloomFilter.h"
+
+#include <future>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Logger/Logger.h"
+#include "QueryEngine/JoinHashTable/HashTable.h"
+#include "QueryEngine/JoinHashTable/Runtime/JoinBloomFilterImpl.h"
+#include "QueryEngine/MurmurHash.h"
+#include "QueryEngine/RuntimeFunctions.h"
+#include "Shared/thread_count.h"
+
+namespace {
+
+constexpr size_t kBitsPerKey{16};
+
+size_t get_bit_count(const size_t key_count) {
+  size_t bit_count = 64;
+  while (bit_count < key_count * kBitsPerKey) {
+    bit_count <<= 1;
+  }
+  return bit_count;
+}
+
+template <typename T>
+bool is_empty_key(const int8_t* key) {
+  return *reinterpret_cast<const T*>(key) ==
+         (sizeof(T) == sizeof(int32_t) ? EMPTY_KEY_32 : EMPTY_KEY_64);
+}
+
+}  // namespace
+
+JoinBloomFilter::JoinBloomFilter(const size_t key_count) {
+  const auto bit_count = get_bit_count(key_count);
+  bits_.resize(bit_count / 64, 0);
+  bit_mask_ = bit_count - 1;
+}
+
+std::unique_ptr<JoinBloomFilter> JoinBloomFilter::fromBaselineHashTable(
+    HashTable* hash_table,
+    const size_t key_component_count,
+    const size_t key_component_width) {
+  CHECK(hash_table);
+  CHECK(key_component_width == 4 || key_component_width == 8);
+  const auto entry_count = hash_table->getEntryCount();
+  const auto key_bytes = key_component_count * key_component_width;
+  // one to one tables store the payload next to the key, the other layouts have it in
+  // separate buffers
+  const auto entry_bytes = hash_table->getLayout() == HashType::OneToOne
+                               ? key_bytes + key_component_width
+                               : key_bytes;
+  const auto keys = hash_table->getCpuBuffer();
+  CHECK(keys);
+  // the hash table is at most half full
+  auto bloom_filter = std::make_unique<JoinBloomFilter>(entry_count / 2);
+  const size_t thread_count = cpu_threads();
+  std::vector<std::future<void>> add_threads;
+  for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+    add_threads.emplace_back(std::async(std::launch::async, [&, thread_idx] {
+      for (size_t i = thread_idx; i < entry_count; i += thread_count) {
+        const auto key = keys + i * entry_bytes;
+        if (key_component_width == 4 ? is_empty_key<int32_t>(key)
+                                     : is_empty_key<int64_t>(key)) {
+          continue;
+        }
+        bloom_filter->addHash(MurmurHash64A(key, key_bytes, 0));
+      }
+    }));
+  }
+  for (auto& add_thread : add_threads) {
+    add_thread.get();
+  }
+  return bloom_filter;
+}
+
+void JoinBloomFilter::add(const int8_t* key, const size_t key_bytes) {
+  addHash(MurmurHash64A(key, key_bytes, 0));
+}
+
+bool JoinBloomFilter::contains(const int8_t* key, const size_t key_bytes) const {
+  return join_bloom_filter_contains_hash(
+      bits_.data(), bit_mask_, MurmurHash64A(key, key_bytes, 0));
+}
+
+void JoinBloomFilter::addHash(const uint64_t key_hash) {
+  for (uint64_t i = 0; i < JOIN_BLOOM_FILTER_HASH_COUNT; ++i) {
+    const auto bit = get_join_bloom_filter_bit(key_hash, i, bit_mask_);
+    // the filter is built by several threads, which can set bits of the same word
+    const int64_t mask = int64_t(1) << (bit & 63);
+#ifdef _MSC_VER
+    _InterlockedOr64(reinterpret_cast<volatile __int64*>(&bits_[bit >> 6]), mask);
+#else
+    __sync_fetch_and_or(&bits_[bit >> 6], mask);
+#endif
+  }
+}
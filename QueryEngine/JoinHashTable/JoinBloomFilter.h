@@ -0,0 +1,63 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class HashTable;
+
+extern size_t g_join_bloom_filter_min_hash_table_bytes;
+
+/**
+ * Bloom filter of the keys of a CPU baseline join hash table, probed by the generated
+ * code before the hash table. With 16 bits per key it's a small fraction of the hash
+ * table, which is at most half full and also stores the payloads, so it stays in cache
+ * when the latter doesn't and rejects most probe keys missing from the inner table
+ * without a cache miss. The bit positions are computed by JoinBloomFilterImpl.h.
+ */
+class JoinBloomFilter {
+ public:
+  JoinBloomFilter(const size_t key_count);
+
+  /**
+   * Builds the filter from the keys of a CPU baseline hash table with the given key
+   * layout, in parallel.
+   */
+  static std::unique_ptr<JoinBloomFilter> fromBaselineHashTable(
+      HashTable* hash_table,
+      const size_t key_component_count,
+      const size_t key_component_width);
+
+  void add(const int8_t* key, const size_t key_bytes);
+
+  bool contains(const int8_t* key, const size_t key_bytes) const;
+
+  const int64_t* getBits() const { return bits_.data(); }
+
+  int64_t getBitMask() const { return bit_mask_; }
+
+  size_t getSizeBytes() const { return bits_.size() * sizeof(int64_t); }
+
+ private:
+  void addHash(const uint64_t key_hash);
+
+  std::vector<int64_t> bits_;
+  int64_t bit_mask_;
+};
@@ -1238,6 +1238,7 @@ std::shared_ptr<BaselineHashTable> OverlapsJoinHashTable::initHashTableOnCpu(
       OverlapsKeyHandler(key_component_count,
                          &join_columns[0],
                          join_bucket_info[0].inverse_bucket_sizes_for_dimension.data());
+  auto clock_begin = timer_start();
   const auto catalog = executor_->getCatalog();
   BaselineJoinHashTableBuilder builder(catalog);
   const auto err = builder.initHashTableOnCpu(&key_handler,
@@ -1261,7 +1262,7 @@ std::shared_ptr<BaselineHashTable> OverlapsJoinHashTable::initHashTableOnCpu(
     if (skip_hashtable_caching) {
       VLOG(1) << "Skip to cache overlaps join hashtable";
     } else {
-      putHashTableOnCpuToCache(cache_key, hash_table);
+      putHashTableOnCpuToCache(cache_key, hash_table, timer_stop(clock_begin));
     }
   }
   return hash_table;
@@ -1749,7 +1750,8 @@ OverlapsJoinHashTable::getApproximateTupleCountFromCache(
 
 void OverlapsJoinHashTable::putHashTableOnCpuToCache(
     const OverlapsHashTableCacheKey& key,
-    std::shared_ptr<HashTable> hash_table) {
+    std::shared_ptr<HashTable> hash_table,
+    const size_t build_time_ms) {
   for (auto chunk_key : key.chunk_keys) {
     CHECK_GE(chunk_key.size(), size_t(2));
     if (chunk_key[1] < 0) {
@@ -1757,5 +1759,5 @@ void OverlapsJoinHashTable::putHashTableOnCpuToCache(
     }
   }
   CHECK(hash_table_cache_);
-  hash_table_cache_->insert(key, hash_table);
+  hash_table_cache_->insert(key, hash_table, build_time_ms);
 }
@@ -44,6 +44,16 @@ struct OverlapsHashTableCacheKey {
            bucket_threshold == that.bucket_threshold;
   }
 
+  // skips the inverse bucket sizes, which are only compared approximately
+  size_t hash() const {
+    size_t seed = boost::hash_value(chunk_keys);
+    boost::hash_combine(seed, num_elements);
+    boost::hash_combine(seed, static_cast<int>(optype));
+    boost::hash_combine(seed, max_hashtable_size);
+    boost::hash_combine(seed, bucket_threshold);
+    return seed;
+  }
+
   OverlapsHashTableCacheKey(const size_t num_elements,
                             const std::vector<ChunkKey>& chunk_keys,
                             const SQLOps& optype,
@@ -71,18 +81,7 @@ struct OverlapsHashTableCacheKey {
 };
 
 template <class K, class V>
-class OverlapsHashTableCache : public HashTableCache<K, V> {
- public:
-  std::optional<std::pair<K, V>> getWithKey(const K& key) {
-    std::lock_guard<std::mutex> guard(this->mutex_);
-    for (const auto& kv : this->contents_) {
-      if (kv.first == key) {
-        return kv;
-      }
-    }
-    return std::nullopt;
-  }
-};
+using OverlapsHashTableCache = HashTableCache<K, V>;
 
 class OverlapsJoinHashTable : public HashJoin {
  public:
@@ -338,7 +337,8 @@ class OverlapsJoinHashTable : public HashJoin {
       const OverlapsHashTableCacheKey&);
 
   void putHashTableOnCpuToCache(const OverlapsHashTableCacheKey& key,
-                                std::shared_ptr<HashTable> hash_table);
+                                std::shared_ptr<HashTable> hash_table,
+                                const size_t build_time_ms);
 
   llvm::Value* codegenKey(const CompilationOptions&);
   std::vector<llvm::Value*> codegenManyKey(const CompilationOptions&);
@@ -509,9 +509,11 @@ int PerfectJoinHashTable::initHashTableForDevice(
     CHECK(!chunk_key.empty());
 
     auto hash_table = initHashTableOnCpuFromCache(chunk_key, join_column.num_elems, cols);
+    size_t build_time_ms{0};
     {
       std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
       if (!hash_table) {
+        auto clock_begin = timer_start();
         PerfectJoinHashTableBuilder builder(executor_->catalog_);
         if (layout == HashType::OneToOne) {
           builder.initOneToOneHashTableOnCpu(join_column,
@@ -534,6 +536,18 @@ int PerfectJoinHashTable::initHashTableForDevice(
                                               executor_);
           hash_table = builder.getHashTable();
         }
+        // the keys left after deletes are usually a narrower range than the metadata one
+        if (g_enable_join_runtime_filters && hash_table &&
+            inner_col->get_type_info().is_integer()) {
+          const auto key_range =
+              computeInnerKeyRange(inner_col,
+                                   join_column,
+                                   getInnerQueryInfo(inner_col).info.fragments,
+                                   executor_,
+                                   &column_cache_);
+          hash_table->setKeyRange(key_range.first, key_range.second);
+        }
+        build_time_ms = timer_stop(clock_begin);
       } else {
         if (layout == HashType::OneToOne &&
             hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU) >
@@ -545,7 +559,8 @@ int PerfectJoinHashTable::initHashTableForDevice(
       }
     }
     if (inner_col->get_table_id() > 0) {
-      putHashTableOnCpuToCache(chunk_key, join_column.num_elems, hash_table, cols);
+      putHashTableOnCpuToCache(
+          chunk_key, join_column.num_elems, hash_table, cols, build_time_ms);
     }
     // Transfer the hash table on the GPU if we've only built it on CPU
     // but the query runs on GPU (join on dictionary encoded columns).
@@ -668,7 +683,8 @@ std::shared_ptr<PerfectHashTable> PerfectJoinHashTable::initHashTableOnCpuFromCa
 void PerfectJoinHashTable::putHashTableOnCpuToCache(const ChunkKey& chunk_key,
                                                     const size_t num_elements,
                                                     HashTableCacheValue hash_table,
-                                                    const InnerOuter& cols) {
+                                                    const InnerOuter& cols,
+                                                    const size_t build_time_ms) {
   CHECK_GE(chunk_key.size(), size_t(2));
   if (chunk_key[1] < 0) {
     // Do not cache hash tables over intermediate results
@@ -684,7 +700,7 @@ void PerfectJoinHashTable::putHashTableOnCpuToCache(const ChunkKey& chunk_key,
                                   join_type_};
   CHECK(hash_table_cache_);
   CHECK(hash_table && !hash_table->getGpuBuffer());
-  hash_table_cache_->insert(cache_key, hash_table);
+  hash_table_cache_->insert(cache_key, hash_table, build_time_ms);
 }
 
 llvm::Value* PerfectJoinHashTable::codegenHashTableLoad(const size_t table_idx) {
@@ -987,3 +1003,26 @@ size_t PerfectJoinHashTable::shardCount() const {
 bool PerfectJoinHashTable::isBitwiseEq() const {
   return qual_bin_oper_->get_optype() == kBW_EQ;
 }
+
+std::optional<JoinKeyRange> PerfectJoinHashTable::getInnerKeyRange() const {
+  CHECK_EQ(inner_outer_pairs_.size(), size_t(1));
+  // the range of dictionary encoded strings is the one of the outer column
+  if (col_var_->get_type_info().is_string()) {
+    return std::nullopt;
+  }
+  // prefer the keys of the built table, which leave out the deleted rows
+  const auto hash_table =
+      hash_tables_for_device_.empty() ? nullptr : getHashTableForDevice(size_t(0));
+  if (hash_table && hash_table->getKeyRange()) {
+    return makeInnerKeyRange(inner_outer_pairs_.front(),
+                             join_type_,
+                             qual_bin_oper_->get_optype(),
+                             hash_table->getKeyRange()->first,
+                             hash_table->getKeyRange()->second);
+  }
+  return makeInnerKeyRange(inner_outer_pairs_.front(),
+                           join_type_,
+                           qual_bin_oper_->get_optype(),
+                           col_range_.getIntMin(),
+                           col_range_.getIntMax());
+}
@@ -40,6 +40,8 @@
 #ifdef HAVE_CUDA
 #include <cuda.h>
 #endif
+#include <boost/functional/hash.hpp>
+
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -98,6 +100,8 @@ class PerfectJoinHashTable : public HashJoin {
 
   std::string getHashJoinType() const final { return "Perfect"; }
 
+  std::optional<JoinKeyRange> getInnerKeyRange() const override;
+
   static auto getHashTableCache() { return hash_table_cache_.get(); }
 
   static auto getCacheInvalidator() -> std::function<void()> {
@@ -170,7 +174,8 @@ class PerfectJoinHashTable : public HashJoin {
   void putHashTableOnCpuToCache(const ChunkKey& chunk_key,
                                 const size_t num_elements,
                                 HashTableCacheValue hash_table,
-                                const InnerOuter& cols);
+                                const InnerOuter& cols,
+                                const size_t build_time_ms);
 
   const InputTableInfo& getInnerQueryInfo(const Analyzer::ColumnVar* inner_col) const;
 
@@ -217,6 +222,14 @@ class PerfectJoinHashTable : public HashJoin {
              chunk_key == that.chunk_key && optype == that.optype &&
              join_type == that.join_type;
     }
+
+    size_t hash() const {
+      size_t seed = boost::hash_value(chunk_key);
+      boost::hash_combine(seed, num_elements);
+      boost::hash_combine(seed, static_cast<int>(optype));
+      boost::hash_combine(seed, static_cast<int>(join_type));
+      return seed;
+    }
   };
 
   static std::unique_ptr<HashTableCache<JoinHashTableCacheKey, HashTableCacheValue>>
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Bit positions of a key in a join bloom filter, shared by the host code building the
+ * filter and the runtime functions probing it.
+ */
+
+#ifndef QUERYENGINE_JOINBLOOMFILTERIMPL_H
+#define QUERYENGINE_JOINBLOOMFILTERIMPL_H
+
+#include <cstdint>
+
+#include "../../../Shared/funcannotations.h"
+
+#define JOIN_BLOOM_FILTER_HASH_COUNT 3
+
+// Double hashing from the two halves of the 64-bit hash of the key, the filter has a
+// power of two number of bits.
+inline DEVICE uint64_t get_join_bloom_filter_bit(const uint64_t key_hash,
+                                                 const uint64_t i,
+                                                 const int64_t bit_mask) {
+  return ((key_hash & 0xffffffff) + i * (key_hash >> 32)) & bit_mask;
+}
+
+inline DEVICE bool join_bloom_filter_contains_hash(const int64_t* bloom_filter,
+                                                   const int64_t bit_mask,
+                                                   const uint64_t key_hash) {
+  for (uint64_t i = 0; i < JOIN_BLOOM_FILTER_HASH_COUNT; ++i) {
+    const auto bit = get_join_bloom_filter_bit(key_hash, i, bit_mask);
+    if (!(bloom_filter[bit >> 6] & (int64_t(1) << (bit & 63)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif  // QUERYENGINE_JOINBLOOMFILTERIMPL_H
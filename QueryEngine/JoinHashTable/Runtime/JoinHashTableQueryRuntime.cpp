@@ -20,6 +20,7 @@
 
 #include "Geospatial/CompressionRuntime.h"
 #include "QueryEngine/CompareKeysInl.h"
+#include "QueryEngine/JoinHashTable/Runtime/JoinBloomFilterImpl.h"
 #include "QueryEngine/MurmurHash.h"
 
 DEVICE bool compare_to_key(const int8_t* entry,
@@ -176,6 +177,78 @@ get_composite_key_index_64(const int64_t* key,
       key, key_component_count, composite_key_dict, entry_count);
 }
 
+// The variants below first probe the bloom filter of the inner keys, which is much
+// smaller than the hash table and rejects most keys missing from it without touching
+// the latter.
+
+FORCE_INLINE DEVICE bool join_bloom_filter_contains(const int64_t* bloom_filter,
+                                                    const int64_t bloom_filter_bit_mask,
+                                                    const void* key,
+                                                    const size_t key_bytes) {
+  return join_bloom_filter_contains_hash(
+      bloom_filter, bloom_filter_bit_mask, MurmurHash64A(key, key_bytes, 0));
+}
+
+extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t
+bloom_filtered_baseline_hash_join_idx_32(const int8_t* hash_buff,
+                                         const int8_t* key,
+                                         const size_t key_bytes,
+                                         const size_t entry_count,
+                                         const int64_t* bloom_filter,
+                                         const int64_t bloom_filter_bit_mask) {
+  if (!join_bloom_filter_contains(bloom_filter, bloom_filter_bit_mask, key, key_bytes)) {
+    return kNoMatch;
+  }
+  return baseline_hash_join_idx_impl<int32_t>(hash_buff, key, key_bytes, entry_count);
+}
+
+extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t
+bloom_filtered_baseline_hash_join_idx_64(const int8_t* hash_buff,
+                                         const int8_t* key,
+                                         const size_t key_bytes,
+                                         const size_t entry_count,
+                                         const int64_t* bloom_filter,
+                                         const int64_t bloom_filter_bit_mask) {
+  if (!join_bloom_filter_contains(bloom_filter, bloom_filter_bit_mask, key, key_bytes)) {
+    return kNoMatch;
+  }
+  return baseline_hash_join_idx_impl<int64_t>(hash_buff, key, key_bytes, entry_count);
+}
+
+extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t
+bloom_filtered_get_composite_key_index_32(const int32_t* key,
+                                          const size_t key_component_count,
+                                          const int32_t* composite_key_dict,
+                                          const size_t entry_count,
+                                          const int64_t* bloom_filter,
+                                          const int64_t bloom_filter_bit_mask) {
+  if (!join_bloom_filter_contains(bloom_filter,
+                                  bloom_filter_bit_mask,
+                                  key,
+                                  key_component_count * sizeof(int32_t))) {
+    return -1;
+  }
+  return get_composite_key_index_impl(
+      key, key_component_count, composite_key_dict, entry_count);
+}
+
+extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t
+bloom_filtered_get_composite_key_index_64(const int64_t* key,
+                                          const size_t key_component_count,
+                                          const int64_t* composite_key_dict,
+                                          const size_t entry_count,
+                                          const int64_t* bloom_filter,
+                                          const int64_t bloom_filter_bit_mask) {
+  if (!join_bloom_filter_contains(bloom_filter,
+                                  bloom_filter_bit_mask,
+                                  key,
+                                  key_component_count * sizeof(int64_t))) {
+    return -1;
+  }
+  return get_composite_key_index_impl(
+      key, key_component_count, composite_key_dict, entry_count);
+}
+
 extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int32_t insert_sorted(int32_t* arr,
                                                                     size_t elem_count,
                                                                     int32_t elem) {
@@ -20,6 +20,7 @@
 #include "GpuSharedMemoryUtils.h"
 #include "LLVMFunctionAttributesUtil.h"
 #include "OutputBufferInitialization.h"
+#include "PersistentCodeCache.h"
 #include "QueryTemplateGenerator.h"
 
 #include "CudaMgr/CudaMgr.h"
@@ -32,10 +33,12 @@
 static_assert(false, "LLVM Version >= 9 is required.");
 #endif
 
+#include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/MCJIT.h>
 #include <llvm/IR/Attributes.h>
+#include <llvm/IR/CFG.h>
 #include <llvm/IR/GlobalValue.h>
 #include <llvm/IR/InstIterator.h>
 #include <llvm/IR/IntrinsicInst.h>
@@ -53,6 +56,7 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_os_ostream.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
@@ -63,17 +67,23 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include <llvm/Transforms/Utils.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Vectorize.h>
 
 #if LLVM_VERSION_MAJOR >= 11
 #include <llvm/Support/Host.h>
 #endif
 
 float g_fraction_code_cache_to_evict = 0.2;
+bool g_enable_batch_cpu_codegen{false};
+size_t g_batch_cpu_codegen_size{1024};
 
 std::unique_ptr<llvm::Module> udf_gpu_module;
 std::unique_ptr<llvm::Module> udf_cpu_module;
 std::unique_ptr<llvm::Module> rt_udf_gpu_module;
 std::unique_ptr<llvm::Module> rt_udf_cpu_module;
+// fingerprints of the CPU UDF modules, see PersistentCodeCache::getModuleFingerprint()
+std::string udf_cpu_module_fingerprint;
+std::string rt_udf_cpu_module_fingerprint;
 
 extern std::unique_ptr<llvm::Module> g_rt_module;
 
@@ -311,6 +321,17 @@ void optimize_ir(llvm::Function* query_func,
                  llvm::legacy::PassManager& pass_manager,
                  const std::unordered_set<llvm::Function*>& live_funcs,
                  const CompilationOptions& co) {
+  // the vectorizer cost model needs the host target, which has to be registered ahead
+  // of the other passes and kept alive until they ran
+  const bool vectorize =
+      co.device_type == ExecutorDeviceType::CPU && g_enable_batch_cpu_codegen;
+  std::unique_ptr<llvm::TargetMachine> host_target_machine;
+  if (vectorize) {
+    host_target_machine.reset(llvm::EngineBuilder().selectTarget());
+    CHECK(host_target_machine);
+    pass_manager.add(llvm::createTargetTransformInfoWrapperPass(
+        host_target_machine->getTargetIRAnalysis()));
+  }
   pass_manager.add(llvm::createAlwaysInlinerLegacyPass());
   pass_manager.add(llvm::createPromoteMemoryToRegisterPass());
   pass_manager.add(llvm::createInstSimplifyLegacyPass());
@@ -318,6 +339,12 @@ void optimize_ir(llvm::Function* query_func,
   pass_manager.add(llvm::createGlobalOptimizerPass());
 
   pass_manager.add(llvm::createLICMPass());
+  if (vectorize) {
+    pass_manager.add(llvm::createLoopVectorizePass());
+    pass_manager.add(llvm::createSLPVectorizerPass());
+    pass_manager.add(llvm::createInstructionCombiningPass());
+    pass_manager.add(llvm::createCFGSimplificationPass());
+  }
   if (co.opt_level == ExecutorOptLevel::LoopStrengthReduction) {
     pass_manager.add(llvm::createLoopStrengthReducePass());
   }
@@ -411,17 +438,53 @@ std::string assemblyForCPU(ExecutionEngineWrapper& execution_engine,
   return "Assembly for the CPU:\n" + std::string(code_str.str()) + "\nEnd of assembly";
 }
 
+// The code of the modules linked into a CPU query module, which its code cache key leaves
+// out but its persisted object code depends on.
+std::string get_linked_modules_fingerprint(const bool needs_geos) {
+  static const auto rt_module_fingerprint =
+      PersistentCodeCache::getModuleFingerprint(*g_rt_module);
+  auto fingerprint = "rt:" + rt_module_fingerprint;
+  if (is_udf_module_present(true)) {
+    fingerprint += ";udf:" + udf_cpu_module_fingerprint;
+  }
+  if (is_rt_udf_module_present(true)) {
+    fingerprint += ";rt_udf:" + rt_udf_cpu_module_fingerprint;
+  }
+#ifdef ENABLE_GEOS
+  if (needs_geos) {
+    static const auto rt_geos_module_fingerprint =
+        PersistentCodeCache::getModuleFingerprint(*g_rt_geos_module);
+    fingerprint += ";geos:" + rt_geos_module_fingerprint;
+  }
+#endif
+  return fingerprint;
+}
+
 }  // namespace
 
 ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
     llvm::Function* func,
     const std::unordered_set<llvm::Function*>& live_funcs,
     const CompilationOptions& co) {
+  return generateNativeCPUCode(func, live_funcs, co, nullptr);
+}
+
+ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
+    llvm::Function* func,
+    const std::unordered_set<llvm::Function*>& live_funcs,
+    const CompilationOptions& co,
+    std::unique_ptr<PersistentObjectCache> object_cache) {
   auto module = func->getParent();
-  // run optimizations
+  if (object_cache) {
+    module->setModuleIdentifier(object_cache->getModuleId());
+  }
+  const bool use_cached_object = object_cache && object_cache->hasCachedObject();
+  // run optimizations, unless the engine is going to load the cached object instead
 #ifndef WITH_JIT_DEBUG
   llvm::legacy::PassManager pass_manager;
-  optimize_ir(func, module, pass_manager, live_funcs, co);
+  if (!use_cached_object) {
+    optimize_ir(func, module, pass_manager, live_funcs, co);
+  }
 #endif  // WITH_JIT_DEBUG
 
   auto init_err = llvm::InitializeNativeTarget();
@@ -452,7 +515,12 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
 
   ExecutionEngineWrapper execution_engine(eb.create(), co);
   CHECK(execution_engine.get());
-  LOG(ASM) << assemblyForCPU(execution_engine, module);
+  if (object_cache) {
+    execution_engine.setObjectCache(std::move(object_cache));
+  }
+  if (!use_cached_object) {
+    LOG(ASM) << assemblyForCPU(execution_engine, module);
+  }
 
   execution_engine->finalizeObject();
   return execution_engine;
@@ -464,13 +532,14 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
     const std::unordered_set<llvm::Function*>& live_funcs,
     const CompilationOptions& co) {
   auto module = multifrag_query_func->getParent();
-  CodeCacheKey key{serialize_llvm_object(query_func),
-                   serialize_llvm_object(cgen_state_->row_func_)};
+  CodeCacheKey key;
+  key.addLlvmObject(query_func);
+  key.addLlvmObject(cgen_state_->row_func_);
   if (cgen_state_->filter_func_) {
-    key.push_back(serialize_llvm_object(cgen_state_->filter_func_));
+    key.addLlvmObject(cgen_state_->filter_func_);
   }
   for (const auto helper : cgen_state_->helper_functions_) {
-    key.push_back(serialize_llvm_object(helper));
+    key.addLlvmObject(helper);
   }
   auto cached_code = getCodeFromCache(key, cpu_code_cache_);
   if (cached_code) {
@@ -502,8 +571,15 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
 #endif
   }
 
-  auto execution_engine =
-      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+  std::unique_ptr<PersistentObjectCache> object_cache;
+  if (auto persistent_code_cache = PersistentCodeCache::get()) {
+    object_cache = std::make_unique<PersistentObjectCache>(
+        persistent_code_cache,
+        persistent_code_cache->getModuleKey(
+            key, co, get_linked_modules_fingerprint(cgen_state_->needs_geos_)));
+  }
+  auto execution_engine = CodeGenerator::generateNativeCPUCode(
+      query_func, live_funcs, co, std::move(object_cache));
   auto cpu_compilation_context =
       std::make_shared<CpuCompilationContext>(std::move(execution_engine));
   cpu_compilation_context->setFunctionPointer(multifrag_query_func);
@@ -1174,13 +1250,14 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenGPU(
   auto module = multifrag_query_func->getParent();
 
   CHECK(cuda_mgr);
-  CodeCacheKey key{serialize_llvm_object(query_func),
-                   serialize_llvm_object(cgen_state_->row_func_)};
+  CodeCacheKey key;
+  key.addLlvmObject(query_func);
+  key.addLlvmObject(cgen_state_->row_func_);
   if (cgen_state_->filter_func_) {
-    key.push_back(serialize_llvm_object(cgen_state_->filter_func_));
+    key.addLlvmObject(cgen_state_->filter_func_);
   }
   for (const auto helper : cgen_state_->helper_functions_) {
-    key.push_back(serialize_llvm_object(helper));
+    key.addLlvmObject(helper);
   }
   auto cached_code = getCodeFromCache(key, gpu_code_cache_);
   if (cached_code) {
@@ -1730,6 +1807,7 @@ void read_udf_cpu_module(const std::string& udf_ir_filename) {
   if (!udf_cpu_module) {
     throw_parseIR_error(parse_error, udf_ir_filename);
   }
+  udf_cpu_module_fingerprint = PersistentCodeCache::getModuleFingerprint(*udf_cpu_module);
 }
 
 void read_rt_udf_gpu_module(const std::string& udf_ir_string) {
@@ -1766,6 +1844,8 @@ void read_rt_udf_cpu_module(const std::string& udf_ir_string) {
     LOG(IR) << "read_rt_udf_cpu_module:LLVM IR:\n" << udf_ir_string << "\nEnd of LLVM IR";
     throw_parseIR_error(parse_error);
   }
+  rt_udf_cpu_module_fingerprint =
+      PersistentCodeCache::getModuleFingerprint(*rt_udf_cpu_module);
 }
 
 std::unordered_set<llvm::Function*> CodeGenerator::markDeadRuntimeFuncs(
@@ -1857,6 +1937,24 @@ void Executor::createErrorCheckControlFlow(
     }
   }
 
+  llvm::BasicBlock* batch_latch_bb{nullptr};
+  for (auto& bb : *query_func) {
+    if (bb.getName() == ".batch.latch") {
+      batch_latch_bb = &bb;
+      break;
+    }
+  }
+  if (batch_latch_bb) {
+    // Batched CPU kernels check for errors once per batch instead, since leaving the
+    // row loop from within would keep it from being vectorized.
+    CHECK(device_type == ExecutorDeviceType::CPU);
+    createBatchErrorCheckControlFlow(query_func,
+                                     batch_latch_bb,
+                                     run_with_dynamic_watchdog,
+                                     run_with_allowing_runtime_interrupt);
+    return;
+  }
+
   llvm::Value* row_count = nullptr;
   if ((run_with_dynamic_watchdog || run_with_allowing_runtime_interrupt) &&
       device_type == ExecutorDeviceType::GPU) {
@@ -2081,6 +2179,73 @@ void Executor::createErrorCheckControlFlow(
   CHECK(done_splitting);
 }
 
+void Executor::createBatchErrorCheckControlFlow(
+    llvm::Function* query_func,
+    llvm::BasicBlock* batch_latch_bb,
+    const bool run_with_dynamic_watchdog,
+    const bool run_with_allowing_runtime_interrupt) {
+  AUTOMATIC_IR_METADATA(cgen_state_.get());
+
+  llvm::CallInst* row_func_call{nullptr};
+  for (auto& bb : *query_func) {
+    for (auto& inst : bb) {
+      auto call = llvm::dyn_cast<llvm::CallInst>(&inst);
+      if (call && call->getCalledFunction() &&
+          call->getCalledFunction()->getName() == "row_process") {
+        row_func_call = call;
+      }
+    }
+  }
+  CHECK(row_func_call);
+  auto row_bb = row_func_call->getParent();
+  auto err_type = row_func_call->getType();
+  auto no_err = llvm::ConstantInt::get(err_type, 0);
+
+  // carry an error code of the rows over the batch, an unsigned max is a reduction the
+  // loop vectorizer knows and it is non-zero as soon as one row failed
+  llvm::IRBuilder<> ir_builder(&row_bb->front());
+  auto batch_err = ir_builder.CreatePHI(err_type, 2, "batch_err");
+  ir_builder.SetInsertPoint(row_func_call->getNextNode());
+  auto batch_err_next =
+      ir_builder.CreateSelect(ir_builder.CreateICmpUGT(row_func_call, batch_err),
+                              row_func_call,
+                              batch_err,
+                              "batch_err_next");
+  for (auto pred_bb : llvm::predecessors(row_bb)) {
+    batch_err->addIncoming(pred_bb == row_bb ? batch_err_next : no_err, pred_bb);
+  }
+
+  // the watchdog and the interrupt flag are checked once per batch as well
+  auto batch_next_bb = batch_latch_bb->splitBasicBlock(batch_latch_bb->begin(),
+                                                       ".batch.next");
+  auto& br_instr = batch_latch_bb->back();
+  ir_builder.SetInsertPoint(&br_instr);
+  llvm::Value* err_lv = batch_err_next;
+  if (run_with_dynamic_watchdog) {
+    auto detected_timeout =
+        ir_builder.CreateCall(cgen_state_->module_->getFunction("dynamic_watchdog"), {});
+    err_lv = ir_builder.CreateSelect(
+        detected_timeout, cgen_state_->llInt(Executor::ERR_OUT_OF_TIME), err_lv);
+  } else if (run_with_allowing_runtime_interrupt) {
+    auto detected_interrupt =
+        ir_builder.CreateCall(cgen_state_->module_->getFunction("check_interrupt"), {});
+    err_lv = ir_builder.CreateSelect(
+        detected_interrupt, cgen_state_->llInt(Executor::ERR_INTERRUPTED), err_lv);
+  }
+  auto has_err = ir_builder.CreateICmpNE(err_lv, no_err);
+
+  auto error_bb = llvm::BasicBlock::Create(
+      cgen_state_->context_, ".error_exit", query_func, batch_next_bb);
+  const auto error_code_arg = get_arg_by_name(query_func, "error_code");
+  llvm::CallInst::Create(cgen_state_->module_->getFunction("record_error_code"),
+                         std::vector<llvm::Value*>{err_lv, error_code_arg},
+                         "",
+                         error_bb);
+  llvm::ReturnInst::Create(cgen_state_->context_, error_bb);
+  llvm::ReplaceInstWithInst(&br_instr,
+                            llvm::BranchInst::Create(error_bb, batch_next_bb, has_err));
+}
+
 std::vector<llvm::Value*> Executor::inlineHoistedLiterals() {
   AUTOMATIC_IR_METADATA(cgen_state_.get());
 
@@ -2288,6 +2453,18 @@ std::vector<llvm::Value*> Executor::inlineHoistedLiterals() {
 
 namespace {
 
+// Non-grouped aggregate kernels on CPU can run their scan loop over fixed size batches
+// of rows, which lets LLVM vectorize the inlined row function. Returns zero when the
+// query keeps the row at a time loop.
+size_t cpu_codegen_batch_size(const RelAlgExecutionUnit& ra_exe_unit,
+                              const CompilationOptions& co) {
+  if (!g_enable_batch_cpu_codegen || co.device_type != ExecutorDeviceType::CPU ||
+      ra_exe_unit.estimator) {
+    return 0;
+  }
+  return g_batch_cpu_codegen_size;
+}
+
 size_t get_shared_memory_size(const bool shared_mem_used,
                               const QueryMemoryDescriptor* query_mem_desc_ptr) {
   return shared_mem_used
@@ -2624,7 +2801,9 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
                                                           agg_slot_count,
                                                           co.hoist_literals,
                                                           !!ra_exe_unit.estimator,
-                                                          gpu_smem_context);
+                                                          gpu_smem_context,
+                                                          cpu_codegen_batch_size(
+                                                              ra_exe_unit, co));
   bind_pos_placeholders("pos_start", true, query_func, cgen_state_->module_);
   bind_pos_placeholders("group_buff_idx", false, query_func, cgen_state_->module_);
   bind_pos_placeholders("pos_step", false, query_func, cgen_state_->module_);
@@ -0,0 +1,271 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/PersistentCodeCache.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Host.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "Logger/Logger.h"
+#include "MapDRelease.h"
+
+bool g_enable_persistent_code_cache{false};
+std::string g_persistent_code_cache_path;
+size_t g_persistent_code_cache_max_size_bytes{size_t(1) << 30};
+
+namespace {
+
+const std::string kObjectFileMagic{"OMNISCI_OBJECT_CACHE_3"};
+const std::string kModuleIdPrefix{"omnisci_cached_"};
+
+void write_string(std::ostream& os, const std::string& str) {
+  const uint64_t size = str.size();
+  os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  os.write(str.data(), str.size());
+}
+
+bool read_string(std::istream& is, std::string& str) {
+  uint64_t size{0};
+  if (!is.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+    return false;
+  }
+  str.resize(size);
+  return static_cast<bool>(is.read(&str[0], size));
+}
+
+}  // namespace
+
+PersistentCodeCache::PersistentCodeCache(const std::string& path)
+    : path_(path), fingerprint_(getHostFingerprint()) {
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(path_, ec);
+  if (ec) {
+    LOG(WARNING) << "Could not create the persistent code cache directory " << path_
+                 << ": " << ec.message();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  evictLocked();
+}
+
+PersistentCodeCache* PersistentCodeCache::get() {
+  if (!g_enable_persistent_code_cache || g_persistent_code_cache_path.empty()) {
+    return nullptr;
+  }
+  static PersistentCodeCache cache(g_persistent_code_cache_path);
+  return &cache;
+}
+
+std::string PersistentCodeCache::getHostFingerprint() {
+  std::vector<std::string> features;
+  llvm::StringMap<bool> host_features;
+  if (llvm::sys::getHostCPUFeatures(host_features)) {
+    for (const auto& feature : host_features) {
+      features.push_back((feature.getValue() ? "+" : "-") + feature.getKey().str());
+    }
+    std::sort(features.begin(), features.end());
+  }
+  std::string fingerprint = MAPD_RELEASE + ";" + LLVM_VERSION_STRING + ";" +
+                            llvm::sys::getProcessTriple() + ";" +
+                            llvm::sys::getHostCPUName().str() + ";";
+  for (const auto& feature : features) {
+    fingerprint += feature + ",";
+  }
+  return fingerprint;
+}
+
+std::string PersistentCodeCache::getModuleFingerprint(const llvm::Module& module) {
+  CodeCacheKey key;
+  key.addLlvmObject(&module);
+  return key.toString();
+}
+
+CodeCacheKey PersistentCodeCache::getModuleKey(
+    const CodeCacheKey& key,
+    const CompilationOptions& co,
+    const std::string& linked_modules_fingerprint) const {
+  auto module_key = key;
+  module_key.push_back(fingerprint_);
+  module_key.push_back(std::to_string(static_cast<int>(co.opt_level)));
+  module_key.push_back(linked_modules_fingerprint);
+  return module_key;
+}
+
+std::string PersistentCodeCache::getModuleId(const CodeCacheKey& module_key) {
+  return kModuleIdPrefix + module_key.toString();
+}
+
+std::string PersistentCodeCache::getFilePath(const std::string& module_id) const {
+  return (boost::filesystem::path(path_) / (module_id + ".o")).string();
+}
+
+std::unique_ptr<llvm::MemoryBuffer> PersistentCodeCache::load(
+    const std::string& module_id,
+    const CodeCacheKey& module_key) {
+  const auto file_path = getFilePath(module_id);
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++misses_;
+    return nullptr;
+  }
+  std::string magic(kObjectFileMagic.size(), '\0');
+  std::string fingerprint;
+  std::string key_fingerprint;
+  std::string object;
+  if (!file.read(&magic[0], magic.size()) || magic != kObjectFileMagic ||
+      !read_string(file, fingerprint) || fingerprint != fingerprint_ ||
+      !read_string(file, key_fingerprint) || !read_string(file, object)) {
+    // stale or truncated, it'll be replaced once the module is compiled again
+    LOG(INFO) << "Discarding invalid persistent code cache entry " << file_path;
+    file.close();
+    std::remove(file_path.c_str());
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++misses_;
+    return nullptr;
+  }
+  if (key_fingerprint != module_key.toString()) {
+    // an entry stored under another identifier, keep it for the key it was stored with
+    VLOG(1) << "Persistent code cache key mismatch for " << module_id;
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++misses_;
+    return nullptr;
+  }
+  file.close();
+  boost::system::error_code ec;
+  boost::filesystem::last_write_time(file_path, std::time(nullptr), ec);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++hits_;
+  }
+  VLOG(1) << "Loaded " << object.size() << " bytes of cached object code for "
+          << module_id;
+  return llvm::MemoryBuffer::getMemBufferCopy(object, module_id);
+}
+
+void PersistentCodeCache::store(const std::string& module_id,
+                                const CodeCacheKey& module_key,
+                                llvm::MemoryBufferRef object) {
+  const auto file_path = getFilePath(module_id);
+  std::ostringstream tid;
+  tid << std::this_thread::get_id();
+  // concurrent writers of the same module each write their own file, the rename is atomic
+  const auto tmp_file_path = file_path + ".tmp." + tid.str();
+  {
+    std::ofstream file(tmp_file_path, std::ios::binary | std::ios::trunc);
+    file.write(kObjectFileMagic.data(), kObjectFileMagic.size());
+    write_string(file, fingerprint_);
+    write_string(file, module_key.toString());
+    write_string(file, object.getBuffer().str());
+    if (!file) {
+      LOG(WARNING) << "Could not write the persistent code cache entry " << file_path;
+      file.close();
+      std::remove(tmp_file_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_file_path.c_str(), file_path.c_str())) {
+    LOG(WARNING) << "Could not write the persistent code cache entry " << file_path;
+    std::remove(tmp_file_path.c_str());
+    return;
+  }
+  boost::system::error_code ec;
+  const auto file_size = boost::filesystem::file_size(file_path, ec);
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_entries_;
+  size_bytes_ += ec ? 0 : file_size;
+  if (g_persistent_code_cache_max_size_bytes &&
+      size_bytes_ > g_persistent_code_cache_max_size_bytes) {
+    evictLocked();
+  }
+}
+
+PersistentCodeCacheStats PersistentCodeCache::getStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {num_entries_, size_bytes_, hits_, misses_, evictions_};
+}
+
+void PersistentCodeCache::evictLocked() {
+  // (last write time, size, path) of the entries
+  std::vector<std::tuple<std::time_t, size_t, boost::filesystem::path>> entries;
+  size_t size_bytes{0};
+  boost::system::error_code ec;
+  for (boost::filesystem::directory_iterator it(path_, ec), end; !ec && it != end;
+       it.increment(ec)) {
+    const auto& entry_path = it->path();
+    if (entry_path.extension() != ".o") {
+      continue;
+    }
+    boost::system::error_code entry_ec;
+    const auto file_size = boost::filesystem::file_size(entry_path, entry_ec);
+    const auto write_time = boost::filesystem::last_write_time(entry_path, entry_ec);
+    if (entry_ec) {
+      // removed by another server meanwhile
+      continue;
+    }
+    size_bytes += file_size;
+    entries.emplace_back(write_time, file_size, entry_path);
+  }
+  std::sort(entries.begin(), entries.end());
+  size_t num_evicted{0};
+  const auto max_size_bytes = g_persistent_code_cache_max_size_bytes;
+  while (max_size_bytes && size_bytes > max_size_bytes && num_evicted < entries.size()) {
+    const auto& entry = entries[num_evicted];
+    boost::system::error_code entry_ec;
+    boost::filesystem::remove(std::get<2>(entry), entry_ec);
+    size_bytes -= std::get<1>(entry);
+    ++num_evicted;
+  }
+  if (num_evicted) {
+    VLOG(1) << "Evicted " << num_evicted << " persistent code cache entries";
+  }
+  evictions_ += num_evicted;
+  num_entries_ = entries.size() - num_evicted;
+  size_bytes_ = size_bytes;
+}
+
+PersistentObjectCache::PersistentObjectCache(PersistentCodeCache* code_cache,
+                                             CodeCacheKey module_key)
+    : code_cache_(code_cache)
+    , module_key_(std::move(module_key))
+    , module_id_(PersistentCodeCache::getModuleId(module_key_))
+    , cached_object_(code_cache_->load(module_id_, module_key_)) {}
+
+void PersistentObjectCache::notifyObjectCompiled(const llvm::Module* module,
+                                                 llvm::MemoryBufferRef object) {
+  if (module->getModuleIdentifier() == module_id_) {
+    code_cache_->store(module_id_, module_key_, object);
+  }
+}
+
+std::unique_ptr<llvm::MemoryBuffer> PersistentObjectCache::getObject(
+    const llvm::Module* module) {
+  if (cached_object_ && module->getModuleIdentifier() == module_id_) {
+    return std::move(cached_object_);
+  }
+  return nullptr;
+}
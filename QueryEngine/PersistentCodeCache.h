@@ -0,0 +1,130 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "QueryEngine/CodeCache.h"
+#include "QueryEngine/CompilationOptions.h"
+
+extern bool g_enable_persistent_code_cache;
+extern std::string g_persistent_code_cache_path;
+extern size_t g_persistent_code_cache_max_size_bytes;
+
+struct PersistentCodeCacheStats {
+  size_t num_entries{0};
+  size_t size_bytes{0};
+  size_t hits{0};
+  size_t misses{0};
+  size_t evictions{0};
+};
+
+/**
+ * On-disk cache of the object code MCJIT emits for CPU query kernels, so that a restarted
+ * server doesn't pay for optimizing and compiling the same modules again.
+ *
+ * A module is persisted under its code cache key extended with the compilation options,
+ * a fingerprint of the build, LLVM version and host CPU and a fingerprint of the modules
+ * linked into it (runtime functions, UDFs, GEOS), see getModuleKey(). Entries are named
+ * after the fingerprint of that key and store it, and it is compared on load.
+ *
+ * Loading an entry marks it as recently used. Least recently used entries are removed
+ * once the directory holds more than `g_persistent_code_cache_max_size_bytes` (0 means
+ * unbounded).
+ */
+class PersistentCodeCache {
+ public:
+  explicit PersistentCodeCache(const std::string& path);
+
+  /**
+   * Returns the process-wide cache under `g_persistent_code_cache_path`, or nullptr when
+   * the persistent code cache is disabled.
+   */
+  static PersistentCodeCache* get();
+
+  CodeCacheKey getModuleKey(const CodeCacheKey& key,
+                            const CompilationOptions& co,
+                            const std::string& linked_modules_fingerprint) const;
+
+  static std::string getModuleId(const CodeCacheKey& module_key);
+
+  /**
+   * Returns the cached object code for the module key, or nullptr if there's no valid
+   * entry. Invalid entries are removed.
+   */
+  std::unique_ptr<llvm::MemoryBuffer> load(const std::string& module_id,
+                                           const CodeCacheKey& module_key);
+
+  void store(const std::string& module_id,
+             const CodeCacheKey& module_key,
+             llvm::MemoryBufferRef object);
+
+  PersistentCodeCacheStats getStats();
+
+  // build, LLVM version, target triple and host CPU features the cached objects rely on
+  static std::string getHostFingerprint();
+
+  // identifies the code of a module linked into the cached ones
+  static std::string getModuleFingerprint(const llvm::Module& module);
+
+ private:
+  std::string getFilePath(const std::string& module_id) const;
+
+  // rescans the directory, which other servers may share, and evicts beyond the limit
+  void evictLocked();
+
+  const std::string path_;
+  const std::string fingerprint_;
+
+  std::mutex mutex_;
+  size_t num_entries_{0};
+  size_t size_bytes_{0};
+  size_t hits_{0};
+  size_t misses_{0};
+  size_t evictions_{0};
+};
+
+/**
+ * Object cache for the MCJIT engine of one module, named after its module identifier.
+ * Hands the persisted object code (if any) to the engine instead of compiling the module
+ * and persists the object code otherwise.
+ */
+class PersistentObjectCache : public llvm::ObjectCache {
+ public:
+  PersistentObjectCache(PersistentCodeCache* code_cache, CodeCacheKey module_key);
+
+  const std::string& getModuleId() const { return module_id_; }
+
+  bool hasCachedObject() const { return cached_object_ != nullptr; }
+
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef object) override;
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+ private:
+  PersistentCodeCache* code_cache_;
+  const CodeCacheKey module_key_;
+  const std::string module_id_;
+  std::unique_ptr<llvm::MemoryBuffer> cached_object_;
+};
@@ -32,6 +32,8 @@ enum QueryHint {
   kOverlapsAllowGpuBuild,
   kOverlapsNoCache,
   kOverlapsKeysPerBin,
+  kKernelPriority,
+  kMaxKernelParallelism,
   kHintCount,   // should be at the last elem before INVALID enum value to count #
                 // supported hints correctly
   kInvalidHint  // this should be the last elem of this enum
@@ -43,7 +45,9 @@ static const std::unordered_map<std::string, QueryHint> SupportedQueryHints = {
     {"overlaps_max_size", QueryHint::kOverlapsMaxSize},
     {"overlaps_allow_gpu_build", QueryHint::kOverlapsAllowGpuBuild},
     {"overlaps_no_cache", QueryHint::kOverlapsNoCache},
-    {"overlaps_keys_per_bin", QueryHint::kOverlapsKeysPerBin}};
+    {"overlaps_keys_per_bin", QueryHint::kOverlapsKeysPerBin},
+    {"kernel_priority", QueryHint::kKernelPriority},
+    {"max_kernel_parallelism", QueryHint::kMaxKernelParallelism}};
 
 class ExplainedQueryHint {
   // this class represents parsed query hint's specification
@@ -137,6 +141,8 @@ struct RegisteredQueryHint {
       , overlaps_allow_gpu_build(true)
       , overlaps_no_cache(false)
       , overlaps_keys_per_bin(g_overlaps_target_entries_per_bin)
+      , kernel_priority(1)
+      , max_kernel_parallelism(0)
       , registered_hint(QueryHint::kHintCount, false) {}
 
   RegisteredQueryHint& operator=(const RegisteredQueryHint& other) {
@@ -146,6 +152,8 @@ struct RegisteredQueryHint {
     overlaps_allow_gpu_build = other.overlaps_allow_gpu_build;
     overlaps_no_cache = other.overlaps_no_cache;
     overlaps_keys_per_bin = other.overlaps_keys_per_bin;
+    kernel_priority = other.kernel_priority;
+    max_kernel_parallelism = other.max_kernel_parallelism;
     registered_hint = other.registered_hint;
     return *this;
   }
@@ -157,11 +165,15 @@ struct RegisteredQueryHint {
     overlaps_allow_gpu_build = other.overlaps_allow_gpu_build;
     overlaps_no_cache = other.overlaps_no_cache;
     overlaps_keys_per_bin = other.overlaps_keys_per_bin;
+    kernel_priority = other.kernel_priority;
+    max_kernel_parallelism = other.max_kernel_parallelism;
     registered_hint = other.registered_hint;
   }
 
   // general query execution
   bool cpu_mode;
+  size_t kernel_priority;         // share of the kernel scheduler workers
+  size_t max_kernel_parallelism;  // 0 means bounded by the scheduler only
 
   // overlaps hash join
   double overlaps_bucket_threshold;  // defined in "OverlapsJoinHashTable.h"
@@ -19,6 +19,7 @@
 #include "Execute.h"
 #include "GpuInitGroups.h"
 #include "GpuMemUtils.h"
+#include "GroupBySpill.h"
 #include "Logger/Logger.h"
 #include "OutputBufferInitialization.h"
 #include "ResultSet.h"
@@ -251,15 +252,40 @@ QueryMemoryInitializer::QueryMemoryInitializer(
                                        query_mem_desc.hasKeylessHash()
                                    ? query_mem_desc.getEntryCount()
                                    : size_t(0);
+  // a buffer shared by the CPU kernels has a state byte per entry after its end, see
+  // get_group_value_shared()
+  const size_t entry_states_bytes =
+      device_type == ExecutorDeviceType::CPU && query_mem_desc.kernelsShareMemory()
+          ? query_mem_desc.getEntryCount()
+          : 0;
+  if (entry_states_bytes) {
+    CHECK_EQ(group_buffer_size,
+             query_mem_desc.getEntryCount() * query_mem_desc.getRowSize());
+  }
   const auto actual_group_buffer_size =
-      group_buffer_size + index_buffer_qw * sizeof(int64_t);
+      group_buffer_size + index_buffer_qw * sizeof(int64_t) + entry_states_bytes;
   CHECK_GE(actual_group_buffer_size, group_buffer_size);
+  if (g_enable_group_by_spill && g_group_by_spill_threshold_bytes &&
+      device_type == ExecutorDeviceType::CPU && !render_allocator_map &&
+      (query_mem_desc.getQueryDescriptionType() ==
+           QueryDescriptionType::GroupByPerfectHash ||
+       query_mem_desc.getQueryDescriptionType() ==
+           QueryDescriptionType::GroupByBaselineHash) &&
+      actual_group_buffer_size > g_group_by_spill_threshold_bytes) {
+    // spill the group by instead, see RelAlgExecutor::executeGroupByWithSpill()
+    throw OutOfHostMemory(actual_group_buffer_size);
+  }
 
   for (size_t i = 0; i < group_buffers_count; i += step) {
     auto group_by_buffer = alloc_group_by_buffer(actual_group_buffer_size,
                                                  render_allocator_map,
                                                  thread_idx_,
                                                  row_set_mem_owner_.get());
+    if (entry_states_bytes) {
+      memset(reinterpret_cast<int8_t*>(group_by_buffer) + group_buffer_size,
+             0,
+             entry_states_bytes);
+    }
     if (!query_mem_desc.lazyInitGroups(device_type)) {
       if (group_by_buffer_template) {
         memcpy(group_by_buffer + index_buffer_qw,
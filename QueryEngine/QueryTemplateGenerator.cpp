@@ -197,7 +197,8 @@ std::tuple<llvm::Function*, llvm::CallInst*> query_template_impl(
     const size_t aggr_col_count,
     const bool hoist_literals,
     const bool is_estimate_query,
-    const GpuSharedMemoryContext& gpu_smem_context) {
+    const GpuSharedMemoryContext& gpu_smem_context,
+    const size_t cpu_batch_size) {
   using namespace llvm;
 
   auto func_pos_start = pos_start<Attributes>(mod);
@@ -322,6 +323,15 @@ std::tuple<llvm::Function*, llvm::CallInst*> query_template_impl(
   auto bb_crit_edge =
       BasicBlock::Create(mod->getContext(), "._crit_edge", query_func_ptr, 0);
   auto bb_exit = BasicBlock::Create(mod->getContext(), ".exit", query_func_ptr, 0);
+  BasicBlock* bb_batch_head{nullptr};
+  BasicBlock* bb_batch_latch{nullptr};
+  if (cpu_batch_size) {
+    CHECK(!gpu_smem_context.isSharedMemoryUsed());
+    bb_batch_head = BasicBlock::Create(
+        mod->getContext(), ".batch.head", query_func_ptr, bb_forbody);
+    bb_batch_latch = BasicBlock::Create(
+        mod->getContext(), ".batch.latch", query_func_ptr, bb_crit_edge);
+  }
 
   // Block  (.entry)
   std::vector<Value*> result_ptr_vec;
@@ -396,13 +406,45 @@ std::tuple<llvm::Function*, llvm::CallInst*> query_template_impl(
   BranchInst::Create(bb_preheader, bb_exit, enter_or_not, bb_entry);
 
   // Block .loop.preheader
-  CastInst* pos_step_i64 = new SExtInst(pos_step, i64_type, "", bb_preheader);
-  BranchInst::Create(bb_forbody, bb_preheader);
+  Value* pos_step_i64{nullptr};
+  Value* loop_start{pos_start_i64};
+  Value* loop_end{row_count};
+  BasicBlock* bb_loop_entry{bb_preheader};
+  BasicBlock* bb_loop_exit{bb_crit_edge};
+  PHINode* batch_start{nullptr};
+  if (cpu_batch_size) {
+    // CPU kernels always step by one row (see pos_step_impl), a constant step gives the
+    // inner loop a computable trip count so that it can be vectorized
+    pos_step_i64 = ConstantInt::get(i64_type, 1);
+    BranchInst::Create(bb_batch_head, bb_preheader);
+
+    // Block .batch.head
+    batch_start = PHINode::Create(i64_type, 2, "batch_start", bb_batch_head);
+    batch_start->addIncoming(pos_start_i64, bb_preheader);
+    auto batch_end_unbounded = BinaryOperator::CreateNSW(
+        Instruction::Add,
+        batch_start,
+        ConstantInt::get(i64_type, cpu_batch_size),
+        "",
+        bb_batch_head);
+    auto batch_is_full = new ICmpInst(
+        *bb_batch_head, ICmpInst::ICMP_SLT, batch_end_unbounded, row_count, "");
+    loop_end = SelectInst::Create(
+        batch_is_full, batch_end_unbounded, row_count, "batch_end", bb_batch_head);
+    BranchInst::Create(bb_forbody, bb_batch_head);
+
+    loop_start = batch_start;
+    bb_loop_entry = bb_batch_head;
+    bb_loop_exit = bb_batch_latch;
+  } else {
+    pos_step_i64 = new SExtInst(pos_step, i64_type, "", bb_preheader);
+    BranchInst::Create(bb_forbody, bb_preheader);
+  }
 
   // Block  .forbody
   Argument* pos_inc_pre = new Argument(i64_type);
   PHINode* pos = PHINode::Create(i64_type, 2, "pos", bb_forbody);
-  pos->addIncoming(pos_start_i64, bb_preheader);
+  pos->addIncoming(loop_start, bb_loop_entry);
   pos->addIncoming(pos_inc_pre, bb_forbody);
 
   std::vector<Value*> row_process_params;
@@ -430,8 +472,27 @@ std::tuple<llvm::Function*, llvm::CallInst*> query_template_impl(
   BinaryOperator* pos_inc =
       BinaryOperator::CreateNSW(Instruction::Add, pos, pos_step_i64, "", bb_forbody);
   ICmpInst* loop_or_exit =
-      new ICmpInst(*bb_forbody, ICmpInst::ICMP_SLT, pos_inc, row_count, "");
-  BranchInst::Create(bb_forbody, bb_crit_edge, loop_or_exit, bb_forbody);
+      new ICmpInst(*bb_forbody, ICmpInst::ICMP_SLT, pos_inc, loop_end, "");
+  auto loop_br = BranchInst::Create(bb_forbody, bb_loop_exit, loop_or_exit, bb_forbody);
+
+  if (cpu_batch_size) {
+    // ask the loop vectorizer to work on the rows of a batch, the inlined row function
+    // is the loop body
+    auto& ctx = mod->getContext();
+    auto vectorize_enable =
+        MDNode::get(ctx,
+                    {MDString::get(ctx, "llvm.loop.vectorize.enable"),
+                     ConstantAsMetadata::get(ConstantInt::getTrue(ctx))});
+    auto loop_id = MDNode::getDistinct(ctx, {nullptr, vectorize_enable});
+    loop_id->replaceOperandWith(0, loop_id);
+    loop_br->setMetadata(LLVMContext::MD_loop, loop_id);
+
+    // Block .batch.latch
+    batch_start->addIncoming(loop_end, bb_batch_latch);
+    auto next_batch_or_exit =
+        new ICmpInst(*bb_batch_latch, ICmpInst::ICMP_SLT, loop_end, row_count, "");
+    BranchInst::Create(bb_batch_head, bb_crit_edge, next_batch_or_exit, bb_batch_latch);
+  }
 
   // Block ._crit_edge
   std::vector<Instruction*> result_vec_pre;
@@ -867,9 +928,14 @@ std::tuple<llvm::Function*, llvm::CallInst*> query_template(
     const size_t aggr_col_count,
     const bool hoist_literals,
     const bool is_estimate_query,
-    const GpuSharedMemoryContext& gpu_smem_context) {
-  return query_template_impl<llvm::AttributeList>(
-      module, aggr_col_count, hoist_literals, is_estimate_query, gpu_smem_context);
+    const GpuSharedMemoryContext& gpu_smem_context,
+    const size_t cpu_batch_size) {
+  return query_template_impl<llvm::AttributeList>(module,
+                                                  aggr_col_count,
+                                                  hoist_literals,
+                                                  is_estimate_query,
+                                                  gpu_smem_context,
+                                                  cpu_batch_size);
 }
 std::tuple<llvm::Function*, llvm::CallInst*> query_group_by_template(
     llvm::Module* module,
@@ -29,7 +29,8 @@ std::tuple<llvm::Function*, llvm::CallInst*> query_template(
     const size_t aggr_col_count,
     const bool hoist_literals,
     const bool is_estimate_query,
-    const GpuSharedMemoryContext& gpu_smem_context);
+    const GpuSharedMemoryContext& gpu_smem_context,
+    const size_t cpu_batch_size = 0);
 std::tuple<llvm::Function*, llvm::CallInst*> query_group_by_template(
     llvm::Module*,
     const bool hoist_literals,
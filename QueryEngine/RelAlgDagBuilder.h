@@ -1517,6 +1517,12 @@ class RelModify : public RelAlgNode {
         if (column_desc->columnType.is_varlen()) {
           varlen_update_required = true;
         }
+        // run length and differential encoded chunks can't be updated in place, they're
+        // rewritten like the variable length ones
+        if (column_desc->columnType.get_compression() == kENCODING_RL ||
+            column_desc->columnType.get_compression() == kENCODING_DIFF) {
+          varlen_update_required = true;
+        }
         if (column_desc->columnType.is_geometry()) {
           throw std::runtime_error("UPDATE of a geo column is unsupported.");
         }
@@ -1842,6 +1848,35 @@ class RelAlgDagBuilder : public boost::noncopyable {
           }
           break;
         }
+        case QueryHint::kKernelPriority: {
+          CHECK(target.getListOptions().size() == 1);
+          std::stringstream ss(target.getListOptions()[0]);
+          int kernel_priority;
+          ss >> kernel_priority;
+          if (kernel_priority > 0) {
+            query_hint_.registerHint(QueryHint::kKernelPriority);
+            query_hint_.kernel_priority = (size_t)kernel_priority;
+          } else {
+            VLOG(1) << "Skip the given query hint \"kernel_priority\" ("
+                    << kernel_priority << ") : the hint value should be larger than zero";
+          }
+          break;
+        }
+        case QueryHint::kMaxKernelParallelism: {
+          CHECK(target.getListOptions().size() == 1);
+          std::stringstream ss(target.getListOptions()[0]);
+          int max_kernel_parallelism;
+          ss >> max_kernel_parallelism;
+          if (max_kernel_parallelism > 0) {
+            query_hint_.registerHint(QueryHint::kMaxKernelParallelism);
+            query_hint_.max_kernel_parallelism = (size_t)max_kernel_parallelism;
+          } else {
+            VLOG(1) << "Skip the given query hint \"max_kernel_parallelism\" ("
+                    << max_kernel_parallelism
+                    << ") : the hint value should be larger than zero";
+          }
+          break;
+        }
         default:
           break;
       }
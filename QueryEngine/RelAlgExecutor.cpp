@@ -27,6 +27,7 @@
 #include "QueryEngine/ExtensionFunctionsBinding.h"
 #include "QueryEngine/ExternalExecutor.h"
 #include "QueryEngine/FromTableReordering.h"
+#include "QueryEngine/GroupBySpill.h"
 #include "QueryEngine/QueryPhysicalInputsCollector.h"
 #include "QueryEngine/RangeTableIndexVisitor.h"
 #include "QueryEngine/RelAlgDagBuilder.h"
@@ -34,6 +35,7 @@
 #include "QueryEngine/ResultSetBuilder.h"
 #include "QueryEngine/RexVisitor.h"
 #include "QueryEngine/TableOptimizer.h"
+#include "QueryEngine/Visitors/RexSubQueryIdCollector.h"
 #include "QueryEngine/WindowContext.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/measure.h"
@@ -44,12 +46,19 @@
 #include <boost/range/adaptor/reversed.hpp>
 
 #include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <functional>
+#include <future>
 #include <numeric>
+#include <queue>
+#include <sstream>
 
 bool g_skip_intermediate_count{true};
 bool g_enable_interop{false};
 bool g_enable_union{false};
+size_t g_concurrent_subquery_executors{0};
 
 extern bool g_enable_bump_allocator;
 
@@ -188,6 +197,7 @@ size_t RelAlgExecutor::getOuterFragmentCount(const CompilationOptions& co,
   }
 
   decltype(temporary_tables_)().swap(temporary_tables_);
+  result_cache_keys_.clear();
   decltype(target_exprs_owned_)().swap(target_exprs_owned_);
   executor_->catalog_ = &cat_;
   executor_->temporary_tables_ = &temporary_tables_;
@@ -444,19 +454,165 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
   timer_setup.stop();
 
   // Dispatch the subqueries first
-  for (auto subquery : getSubqueries()) {
+  executeSubqueries(co, eo);
+  return executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
+}
+
+namespace {
+
+// Helper executors of concurrent subqueries get ids which collide neither with the
+// dispatch queue workers nor with the helpers of queries running on other executors.
+constexpr Executor::ExecutorId kSubqueryExecutorIdBase{1 << 16};
+constexpr size_t kMaxSubqueryExecutors{256};
+
+Executor::ExecutorId get_subquery_executor_id(const Executor::ExecutorId parent_id,
+                                              const size_t slot) {
+  CHECK_LT(slot, kMaxSubqueryExecutors);
+  return kSubqueryExecutorIdBase + parent_id * kMaxSubqueryExecutors + slot;
+}
+
+}  // namespace
+
+void RelAlgExecutor::executeSubqueries(const CompilationOptions& co,
+                                       const ExecutionOptions& eo) {
+  std::vector<RexSubQuery*> subqueries;
+  for (auto& subquery : getSubqueries()) {
     const auto subquery_ra = subquery->getRelAlg();
     CHECK(subquery_ra);
-    if (subquery_ra->hasContextData()) {
-      continue;
+    if (!subquery_ra->hasContextData()) {
+      subqueries.push_back(subquery.get());
     }
+  }
+
+  auto execute_subquery = [this, &co, &eo](RexSubQuery* subquery, Executor* executor) {
     // Execute the subquery and cache the result.
-    RelAlgExecutor ra_executor(executor_, cat_, query_state_);
-    RaExecutionSequence subquery_seq(subquery_ra);
+    RelAlgExecutor ra_executor(executor, cat_, query_state_);
+    RaExecutionSequence subquery_seq(subquery->getRelAlg());
     auto result = ra_executor.executeRelAlgSeq(subquery_seq, co, eo, nullptr, 0);
     subquery->setExecutionResult(std::make_shared<ExecutionResult>(result));
+  };
+
+  if (subqueries.size() < 2 || g_concurrent_subquery_executors == 0) {
+    for (auto subquery : subqueries) {
+      execute_subquery(subquery, executor_);
+    }
+    return;
+  }
+  const auto helper_count = std::min(
+      {g_concurrent_subquery_executors, subqueries.size() - 1, kMaxSubqueryExecutors});
+
+  // A subquery can only start once the subqueries nested in it have their results, the
+  // registration order puts those first.
+  std::unordered_map<unsigned, size_t> subquery_index;
+  for (size_t i = 0; i < subqueries.size(); ++i) {
+    subquery_index.emplace(subqueries[i]->getId(), i);
+  }
+  std::vector<std::vector<size_t>> dependencies(subqueries.size());
+  for (size_t i = 0; i < subqueries.size(); ++i) {
+    for (const auto id :
+         RexSubQueryIdCollector::getLiveRexSubQueryIds(subqueries[i]->getRelAlg())) {
+      auto it = subquery_index.find(id);
+      if (it != subquery_index.end() && it->second != i) {
+        dependencies[i].push_back(it->second);
+      }
+    }
+  }
+
+  // The first slot runs on this executor, the others on helper executors set up with its
+  // caches. All of them run under the execute lock of this query, and interrupts and the
+  // watchdog apply to every executor running the query session.
+  std::vector<Executor*> executors{executor_};
+  for (size_t slot = 0; slot < helper_count; ++slot) {
+    auto executor =
+        Executor::getExecutor(get_subquery_executor_id(executor_->getExecutorId(), slot))
+            .get();
+    executor->setCatalog(&cat_);
+    // the results of a subquery keep the memory owner of its executor alive
+    executor->row_set_mem_owner_ = std::make_shared<RowSetMemoryOwner>(
+        Executor::getArenaBlockSize(), cpu_threads());
+    executor->row_set_mem_owner_->setDictionaryGenerations(
+        executor_->row_set_mem_owner_->getStringDictionaryGenerations());
+    executor->agg_col_range_cache_ = executor_->agg_col_range_cache_;
+    executor->table_generations_ = executor_->table_generations_;
+    executors.push_back(executor);
+  }
+  ScopeGuard cleanup_helpers = [&executors] {
+    for (size_t slot = 1; slot < executors.size(); ++slot) {
+      executors[slot]->row_set_mem_owner_ = nullptr;
+      executors[slot]->temporary_tables_ = nullptr;
+      executors[slot]->clearMetaInfoCache();
+    }
+  };
+  VLOG(1) << "Executing " << subqueries.size() << " subqueries on " << executors.size()
+          << " executors";
+
+  std::mutex completed_mutex;
+  std::condition_variable completed_cv;
+  std::queue<size_t> completed;
+  std::vector<std::future<void>> futures(subqueries.size());
+  std::vector<bool> launched(subqueries.size(), false);
+  std::vector<bool> finished(subqueries.size(), false);
+  std::vector<size_t> executor_slot(subqueries.size());
+  std::vector<size_t> free_slots(executors.size());
+  std::iota(free_slots.rbegin(), free_slots.rend(), 0);
+  size_t finished_count{0};
+  size_t running_count{0};
+  std::exception_ptr first_error;
+
+  while (finished_count < subqueries.size()) {
+    // stop launching subqueries after a failure, but wait for the running ones
+    for (size_t i = 0; i < subqueries.size() && !first_error && !free_slots.empty();
+         ++i) {
+      if (launched[i] ||
+          !std::all_of(dependencies[i].begin(),
+                       dependencies[i].end(),
+                       [&finished](const size_t dep) { return finished[dep]; })) {
+        continue;
+      }
+      launched[i] = true;
+      executor_slot[i] = free_slots.back();
+      free_slots.pop_back();
+      ++running_count;
+      futures[i] = std::async(
+          std::launch::async,
+          [&, i, executor = executors[executor_slot[i]]] {
+            ScopeGuard notify_completion = [&, i] {
+              {
+                std::lock_guard<std::mutex> lock(completed_mutex);
+                completed.push(i);
+              }
+              completed_cv.notify_one();
+            };
+            execute_subquery(subqueries[i], executor);
+          });
+    }
+    if (running_count == 0) {
+      CHECK(first_error);
+      break;
+    }
+
+    size_t i;
+    {
+      std::unique_lock<std::mutex> lock(completed_mutex);
+      completed_cv.wait(lock, [&completed] { return !completed.empty(); });
+      i = completed.front();
+      completed.pop();
+    }
+    try {
+      futures[i].get();
+    } catch (...) {
+      if (!first_error) {
+        first_error = std::current_exception();
+      }
+    }
+    finished[i] = true;
+    free_slots.push_back(executor_slot[i]);
+    --running_count;
+    ++finished_count;
+  }
+  if (first_error) {
+    std::rethrow_exception(first_error);
   }
-  return executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
 }
 
 AggregatedColRange RelAlgExecutor::computeColRangesCache() {
@@ -596,6 +752,7 @@ ExecutionResult RelAlgExecutor::executeRelAlgSeq(const RaExecutionSequence& seq,
   auto timer = DEBUG_TIMER(__func__);
   if (!with_existing_temp_tables) {
     decltype(temporary_tables_)().swap(temporary_tables_);
+    result_cache_keys_.clear();
   }
   decltype(target_exprs_owned_)().swap(target_exprs_owned_);
   executor_->catalog_ = &cat_;
@@ -720,6 +877,11 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
   // Notify foreign tables to load prior to execution
   prepare_foreign_table_for_execution(*body, cat_);
 
+  // Projections read by the next step are output columnar, ColumnarResults then uses
+  // their buffers directly instead of converting every row.
+  const bool columnar_intermediate_result = g_enable_columnar_intermediate_results &&
+                                            step_idx != seq.size() - 1 && !render_info;
+
   const auto compound = dynamic_cast<const RelCompound*>(body);
   if (compound) {
     if (compound->isDeleteViaSelect()) {
@@ -727,8 +889,15 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
     } else if (compound->isUpdateViaSelect()) {
       executeUpdate(compound, co, eo_work_unit, queue_time_ms);
     } else {
+      const bool output_columnar =
+          eo_work_unit.output_columnar_hint ||
+          (columnar_intermediate_result && !compound->isAggregate());
       exec_desc.setResult(
-          executeCompound(compound, co, eo_work_unit, render_info, queue_time_ms));
+          executeCompound(compound,
+                          co,
+                          eo_work_unit.with_output_columnar_hint(output_columnar),
+                          render_info,
+                          queue_time_ms));
       VLOG(3) << "Returned from executeCompound(), addTemporaryTable("
               << static_cast<int>(-compound->getId()) << ", ...)"
               << " exec_desc.getResult().getDataPtr()->rowCount()="
@@ -775,10 +944,13 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
       // For intermediate results we want to keep the result fragmented
       // to have higher parallelism on next steps.
       bool multifrag_result = g_enable_multifrag_rs && (step_idx != seq.size() - 1);
+      const bool output_columnar =
+          eo_work_unit.output_columnar_hint || columnar_intermediate_result;
       exec_desc.setResult(
           executeProject(project,
                          co,
-                         eo_work_unit.with_multifrag_result(multifrag_result),
+                         eo_work_unit.with_multifrag_result(multifrag_result)
+                             .with_output_columnar_hint(output_columnar),
                          render_info,
                          queue_time_ms,
                          prev_count));
@@ -2499,6 +2671,7 @@ ExecutionResult RelAlgExecutor::executeSimpleInsert(const Analyzer::Query& query
       table_descriptor->persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
     const_cast<Catalog_Namespace::Catalog&>(cat_).checkpointWithAutoRollback(table_id);
   }
+  ResultCache::instance().invalidateTable(cat_.getCurrentDB().dbId, table_id);
 
   auto rs = std::make_shared<ResultSet>(TargetInfoList{},
                                         ExecutorDeviceType::CPU,
@@ -2912,6 +3085,30 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
     return result;
   }
+
+  // sorted results aren't cached since executeSort() sorts them in place
+  std::optional<ResultCacheKey> result_cache_key;
+  if (g_enable_result_cache && !g_cluster && !render_info && !eo.just_explain &&
+      !eo.just_validate && eo.executor_type == ::ExecutorType::Native &&
+      eo.outer_fragment_indices.empty() &&
+      !is_window_execution_unit(work_unit.exe_unit) &&
+      work_unit.exe_unit.sort_info.order_entries.empty()) {
+    result_cache_key = ResultCache::makeKey(work_unit.exe_unit,
+                                            cat_,
+                                            co.device_type,
+                                            eo.output_columnar_hint,
+                                            result_cache_keys_);
+  }
+  if (result_cache_key) {
+    result_cache_keys_[-body->getId()] = *result_cache_key;
+    if (auto cached_result = ResultCache::instance().get(result_cache_key->key)) {
+      VLOG(1) << "Using the cached result of " << body->toString();
+      ExecutionResult result(std::move(*cached_result), targets_meta);
+      result.setQueueTime(queue_time_ms);
+      return result;
+    }
+  }
+
   const auto table_infos = get_table_infos(work_unit.exe_unit, executor_);
 
   auto ra_exe_unit = decide_approx_count_distinct_implementation(
@@ -2962,6 +3159,23 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     // Create a local copy so we can track those changes if we need to attempt a retry
     // due to OOM
     auto local_groups_buffer_entry_guess = max_groups_buffer_entry_guess_in;
+    const bool can_spill = g_enable_group_by_spill && !render_info && !eo.just_explain &&
+                           !eo.just_validate && get_spill_partition_key(ra_exe_unit);
+    if (can_spill && g_force_group_by_spill) {
+      if (auto spilled_result = executeGroupByWithSpill(
+              ra_exe_unit, table_infos, targets_meta, is_agg, co, eo, queue_time_ms)) {
+        return std::move(*spilled_result);
+      }
+    }
+    const auto execute_with_spill = [&]() -> std::optional<ExecutionResult> {
+      if (!can_spill) {
+        return std::nullopt;
+      }
+      LOG(WARNING) << "Query ran out of memory on CPU, retrying with the group by "
+                      "spilled to disk.";
+      return executeGroupByWithSpill(
+          ra_exe_unit, table_infos, targets_meta, is_agg, co, eo, queue_time_ms);
+    };
     try {
       return {executor_->executeWorkUnit(local_groups_buffer_entry_guess,
                                          is_agg,
@@ -2975,6 +3189,11 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
                                          column_cache),
               targets_meta};
     } catch (const QueryExecutionError& e) {
+      if (e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM) {
+        if (auto spilled_result = execute_with_spill()) {
+          return std::move(*spilled_result);
+        }
+      }
       handlePersistentError(e.getErrorCode());
       return handleOutOfMemoryRetry(
           {ra_exe_unit, work_unit.body, local_groups_buffer_entry_guess},
@@ -2985,6 +3204,12 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
           render_info,
           e.wasMultifragKernelLaunch(),
           queue_time_ms);
+    } catch (const std::bad_alloc&) {
+      // failed allocations out of the kernels, e.g. in the reduction
+      if (auto spilled_result = execute_with_spill()) {
+        return std::move(*spilled_result);
+      }
+      throw;
     }
   };
 
@@ -3018,6 +3243,9 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
   }
 
   result.setQueueTime(queue_time_ms);
+  if (result_cache_key) {
+    ResultCache::instance().put(*result_cache_key, result.getTable());
+  }
   if (render_info) {
     build_render_targets(*render_info, work_unit.exe_unit.target_exprs, targets_meta);
     if (render_info->isPotentialInSituRender()) {
@@ -3203,6 +3431,23 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   VLOG(1) << "Resetting max groups buffer entry guess.";
   max_groups_buffer_entry_guess = 0;
 
+  // the last resort for a group by which doesn't fit in CPU memory either
+  const auto execute_with_spill = [&]() -> std::optional<ExecutionResult> {
+    if (!g_enable_group_by_spill || render_info ||
+        !get_spill_partition_key(ra_exe_unit_in)) {
+      return std::nullopt;
+    }
+    LOG(WARNING) << "Query ran out of memory on CPU, retrying with the group by "
+                    "spilled to disk.";
+    return executeGroupByWithSpill(ra_exe_unit_in,
+                                   table_infos,
+                                   targets_meta,
+                                   is_agg,
+                                   co_cpu,
+                                   eo_no_multifrag,
+                                   queue_time_ms);
+  };
+
   int iteration_ctr = -1;
   while (true) {
     iteration_ctr++;
@@ -3231,6 +3476,9 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
         // Only allow two iterations of increasingly large entry guesses up to a maximum
         // of 512MB per column per kernel
         if (g_enable_watchdog || iteration_ctr > 1) {
+          if (auto spilled_result = execute_with_spill()) {
+            return std::move(*spilled_result);
+          }
           throw std::runtime_error("Query ran out of output slots in the result");
         }
         max_groups_buffer_entry_guess *= 2;
@@ -3239,6 +3487,11 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
                         "guess equal to "
                      << max_groups_buffer_entry_guess;
       } else {
+        if (e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM) {
+          if (auto spilled_result = execute_with_spill()) {
+            return std::move(*spilled_result);
+          }
+        }
         handlePersistentError(e.getErrorCode());
       }
       continue;
@@ -3249,6 +3502,203 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   return result;
 }
 
+std::optional<ExecutionResult> RelAlgExecutor::executeGroupByWithSpill(
+    const RelAlgExecutionUnit& ra_exe_unit_in,
+    const std::vector<InputTableInfo>& table_infos,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const bool is_agg,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const int64_t queue_time_ms) {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto partition_key = get_spill_partition_key(ra_exe_unit_in);
+  CHECK(partition_key);
+  auto co_cpu = CompilationOptions::makeCpuOnly(co);
+  co_cpu.allow_lazy_fetch = false;
+  auto eo_cpu = eo.with_output_columnar_hint(false).with_multifrag_result(false);
+  eo_cpu.allow_multifrag = false;
+
+  std::deque<std::pair<int64_t, int64_t>> partitions;  // (modulus, residue)
+  const auto num_partitions =
+      static_cast<int64_t>(std::max(g_group_by_spill_partitions, size_t(1)));
+  for (int64_t residue = 0; residue < num_partitions; ++residue) {
+    partitions.emplace_back(num_partitions, residue);
+  }
+  constexpr int64_t max_modulus{1 << 16};
+  const auto groups_upper_bound = groups_approx_upper_bound(table_infos);
+
+  // every partition gets its own memory owner, released once its rows are spilled
+  const auto row_set_mem_owner = executor_->row_set_mem_owner_;
+  ScopeGuard restore_row_set_mem_owner = [this, row_set_mem_owner] {
+    executor_->row_set_mem_owner_ = row_set_mem_owner;
+  };
+
+  const auto& sort_info = ra_exe_unit_in.sort_info;
+  SpillFile spill_file;
+  std::vector<SpillFile::Run> runs;
+  std::optional<QueryMemoryDescriptor> query_mem_desc;
+  std::vector<TargetInfo> targets;
+  ResultSetPtr empty_rows;
+  while (!partitions.empty()) {
+    const auto [modulus, residue] = partitions.front();
+    partitions.pop_front();
+    auto ra_exe_unit = ra_exe_unit_in;
+    ra_exe_unit.use_bump_allocator = false;
+    ra_exe_unit.quals.push_back(
+        make_spill_partition_qual(partition_key, modulus, residue));
+    executor_->row_set_mem_owner_ = std::make_shared<RowSetMemoryOwner>(
+        Executor::getArenaBlockSize(), cpu_threads());
+    executor_->row_set_mem_owner_->setDictionaryGenerations(
+        row_set_mem_owner->getStringDictionaryGenerations());
+    // the groups of a partition are about its share of the input rows, a partition with
+    // more groups runs out of slots and gets split
+    size_t max_groups_buffer_entry_guess{
+        std::max(groups_upper_bound / static_cast<size_t>(modulus), size_t(1))};
+    ColumnCacheMap column_cache;
+    ResultSetPtr rows;
+    int32_t error_code{0};
+    try {
+      auto result = executor_->executeWorkUnit(max_groups_buffer_entry_guess,
+                                               is_agg,
+                                               table_infos,
+                                               ra_exe_unit,
+                                               co_cpu,
+                                               eo_cpu,
+                                               cat_,
+                                               nullptr,
+                                               true,
+                                               column_cache);
+      CHECK_EQ(result.getFragCount(), 1);
+      rows = result[0];
+    } catch (const QueryExecutionError& e) {
+      error_code = e.getErrorCode();
+    } catch (const std::bad_alloc&) {
+      // failed allocations out of the kernels, e.g. in the reduction
+      error_code = Executor::ERR_OUT_OF_CPU_MEM;
+    }
+    if (error_code) {
+      // only running out of slots or memory is fixed by smaller partitions
+      if ((error_code >= 0 && error_code != Executor::ERR_OUT_OF_CPU_MEM) ||
+          2 * modulus > max_modulus) {
+        handlePersistentError(error_code);
+      }
+      LOG(INFO) << "Partition " << residue << " modulo " << modulus
+                << " of the group by doesn't fit, splitting it in two.";
+      partitions.emplace_front(2 * modulus, residue + modulus);
+      partitions.emplace_front(2 * modulus, residue);
+      continue;
+    }
+    CHECK(rows);
+    if (!rows->getStorage() || rows->definitelyHasNoRows()) {
+      empty_rows = rows;
+      continue;
+    }
+    const auto& rows_query_mem_desc = rows->getQueryMemDesc();
+    if (!query_mem_desc) {
+      if (rows_query_mem_desc.didOutputColumnar() ||
+          rows_query_mem_desc.hasKeylessHash() || rows->isTruncated()) {
+        VLOG(1) << "The group by result layout can't be spilled.";
+        return std::nullopt;
+      }
+      query_mem_desc = rows_query_mem_desc;
+      targets = rows->getTargetInfos();
+    } else if (rows_query_mem_desc.didOutputColumnar() ||
+               rows_query_mem_desc.hasKeylessHash() ||
+               rows_query_mem_desc.getQueryDescriptionType() !=
+                   query_mem_desc->getQueryDescriptionType() ||
+               rows_query_mem_desc.getEffectiveKeyWidth() !=
+                   query_mem_desc->getEffectiveKeyWidth() ||
+               rows_query_mem_desc.getRowSize() != query_mem_desc->getRowSize()) {
+      throw std::runtime_error(
+          "Partitions of the group by have different layouts, unable to spill them");
+    }
+    if (!sort_info.order_entries.empty() && sort_info.limit) {
+      // only the first rows of a partition can make it to the final result
+      rows->sort(sort_info.order_entries, sort_info.limit + sort_info.offset, executor_);
+    }
+    runs.push_back(spill_file.write(*rows));
+  }
+  VLOG(1) << "Spilled " << runs.size() << " group by partitions, "
+          << spill_file.getSizeBytes() << " bytes.";
+
+  if (!query_mem_desc) {
+    CHECK(empty_rows);
+    ExecutionResult result{empty_rows, targets_meta};
+    result.setQueueTime(queue_time_ms);
+    return result;
+  }
+
+  const auto row_size = query_mem_desc->getRowSize();
+  const auto make_rows = [&](const size_t row_count,
+                             std::shared_ptr<RowSetMemoryOwner> mem_owner) {
+    auto rows_query_mem_desc = *query_mem_desc;
+    rows_query_mem_desc.setEntryCount(row_count);
+    auto rows = std::make_shared<ResultSet>(targets,
+                                            ExecutorDeviceType::CPU,
+                                            rows_query_mem_desc,
+                                            mem_owner,
+                                            executor_->getCatalog(),
+                                            executor_->blockSize(),
+                                            executor_->gridSize());
+    rows->allocateStorage();
+    return rows;
+  };
+  std::vector<ResultSetPtr> results;
+  try {
+    if (!sort_info.order_entries.empty() && sort_info.limit) {
+      // merge the sorted runs one at a time, only the first rows of the merged ones are
+      // kept in memory
+      const auto top_n = sort_info.limit + sort_info.offset;
+      std::string top_rows;
+      size_t top_row_count{0};
+      for (const auto& run : runs) {
+        auto merge_mem_owner = std::make_shared<RowSetMemoryOwner>(
+            Executor::getArenaBlockSize(), cpu_threads());
+        merge_mem_owner->setDictionaryGenerations(
+            row_set_mem_owner->getStringDictionaryGenerations());
+        executor_->row_set_mem_owner_ = merge_mem_owner;
+        auto merged_rows = make_rows(top_row_count + run.row_count, merge_mem_owner);
+        auto buff = merged_rows->getStorage()->getUnderlyingBuffer();
+        std::memcpy(buff, top_rows.data(), top_rows.size());
+        spill_file.read(run, row_size, buff + top_rows.size());
+        merged_rows->sort(sort_info.order_entries, top_n, executor_);
+        std::ostringstream top_rows_stream;
+        top_row_count = merged_rows->writeRowWiseEntries(top_rows_stream);
+        top_rows = top_rows_stream.str();
+      }
+      auto rows = make_rows(top_row_count, row_set_mem_owner);
+      std::memcpy(
+          rows->getStorage()->getUnderlyingBuffer(), top_rows.data(), top_rows.size());
+      results.push_back(rows);
+    } else if (eo.multifrag_result) {
+      // the next step reads the runs as the fragments of its input
+      for (const auto& run : runs) {
+        auto rows = make_rows(run.row_count, row_set_mem_owner);
+        spill_file.read(run, row_size, rows->getStorage()->getUnderlyingBuffer());
+        results.push_back(rows);
+      }
+    } else {
+      // the result set of the last step is the whole result
+      size_t row_count{0};
+      for (const auto& run : runs) {
+        row_count += run.row_count;
+      }
+      auto rows = make_rows(row_count, row_set_mem_owner);
+      auto buff = rows->getStorage()->getUnderlyingBuffer();
+      for (const auto& run : runs) {
+        spill_file.read(run, row_size, buff);
+        buff += run.row_count * row_size;
+      }
+      results.push_back(rows);
+    }
+  } catch (const std::bad_alloc&) {
+    handlePersistentError(Executor::ERR_OUT_OF_CPU_MEM);
+  }
+  ExecutionResult result{TemporaryTable(std::move(results)), targets_meta};
+  result.setQueueTime(queue_time_ms);
+  return result;
+}
+
 void RelAlgExecutor::handlePersistentError(const int32_t error_code) {
   LOG(ERROR) << "Query execution failed with error "
              << getErrorMessageFromCode(error_code);
@@ -24,6 +24,7 @@
 #include "QueryEngine/JoinFilterPushDown.h"
 #include "QueryEngine/QueryRewrite.h"
 #include "QueryEngine/RelAlgDagBuilder.h"
+#include "QueryEngine/ResultCache.h"
 #include "QueryEngine/SpeculativeTopN.h"
 #include "QueryEngine/StreamingTopN.h"
 #include "Shared/scope.h"
@@ -159,6 +160,13 @@ class RelAlgExecutor : private StorageIOFacility {
                                             const bool just_explain_plan,
                                             RenderInfo* render_info);
 
+  /**
+   * Executes the uncorrelated subqueries and stores their results. With
+   * g_concurrent_subquery_executors set, subqueries which don't depend on each other run
+   * concurrently on that many helper executors in addition to this one.
+   */
+  void executeSubqueries(const CompilationOptions& co, const ExecutionOptions& eo);
+
   void executeRelAlgStep(const RaExecutionSequence& seq,
                          const size_t step_idx,
                          const CompilationOptions&,
@@ -300,6 +308,19 @@ class RelAlgExecutor : private StorageIOFacility {
                                          const bool was_multifrag_kernel_launch,
                                          const int64_t queue_time_ms);
 
+  // Runs the group by of the execution unit on CPU in partitions which are spilled to
+  // disk, see GroupBySpill.h. Only valid if get_spill_partition_key() returns a key for
+  // the execution unit. Returns std::nullopt if the layout of its result can't be
+  // spilled.
+  std::optional<ExecutionResult> executeGroupByWithSpill(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& table_infos,
+      const std::vector<TargetMetaInfo>& targets_meta,
+      const bool is_agg,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      const int64_t queue_time_ms);
+
   // Allows an out of memory error through if CPU retry is enabled. Otherwise, throws an
   // appropriate exception corresponding to the query error code.
   static void handlePersistentError(const int32_t error_code);
@@ -371,6 +392,8 @@ class RelAlgExecutor : private StorageIOFacility {
   time_t now_;
   std::vector<std::shared_ptr<Analyzer::Expr>> target_exprs_owned_;  // TODO(alex): remove
   std::unordered_map<unsigned, AggregatedResult> leaf_results_;
+  // result cache keys of the temporary tables of this query, by temporary table id
+  std::unordered_map<int, ResultCacheKey> result_cache_keys_;
   int64_t queue_time_ms_;
   static SpeculativeTopNBlacklist speculative_topn_blacklist_;
   static const size_t max_groups_buffer_entry_default_guess{16384};
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/ResultCache.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "Catalog/Catalog.h"
+#include "Logger/Logger.h"
+#include "QueryEngine/RelAlgExecutionUnit.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryEngine/ScalarExprVisitor.h"
+
+bool g_enable_result_cache{false};
+size_t g_result_cache_max_size_bytes{1UL << 30};
+
+namespace {
+
+// Array literals don't print their values, so they can't be part of a cache key.
+class ArrayLiteralFinder : public ScalarExprVisitor<bool> {
+ protected:
+  bool visitConstant(const Analyzer::Constant* constant) const override {
+    return constant->get_type_info().is_array();
+  }
+
+  bool visitAggExpr(const Analyzer::AggExpr* agg) const override {
+    return agg->get_arg() && visit(agg->get_arg());
+  }
+
+  bool aggregateResult(const bool& aggregate, const bool& next_result) const override {
+    return aggregate || next_result;
+  }
+
+  bool defaultResult() const override { return false; }
+};
+
+template <class EXPRS>
+bool has_array_literal(const EXPRS& exprs) {
+  const ArrayLiteralFinder finder{};
+  return std::any_of(exprs.begin(), exprs.end(), [&finder](const auto& expr) {
+    return expr && finder.visit(&*expr);
+  });
+}
+
+bool has_array_literal(const RelAlgExecutionUnit& ra_exe_unit) {
+  if (has_array_literal(ra_exe_unit.simple_quals) ||
+      has_array_literal(ra_exe_unit.quals) ||
+      has_array_literal(ra_exe_unit.groupby_exprs) ||
+      has_array_literal(ra_exe_unit.target_exprs)) {
+    return true;
+  }
+  for (const auto& join_condition : ra_exe_unit.join_quals) {
+    if (has_array_literal(join_condition.quals)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Transient string ids are only valid in the dictionary proxy of the query which
+// produced them, while the next step of another query would decode them with its own.
+bool is_transient_string(const Analyzer::Expr* target_expr) {
+  const auto& ti = target_expr->get_type_info();
+  return ti.is_string() && ti.get_compression() == kENCODING_DICT &&
+         ti.get_comp_param() == TRANSIENT_DICT_ID;
+}
+
+}  // namespace
+
+ResultCache& ResultCache::instance() {
+  static ResultCache cache;
+  return cache;
+}
+
+std::optional<ResultCacheKey> ResultCache::makeKey(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const Catalog_Namespace::Catalog& cat,
+    const ExecutorDeviceType device_type,
+    const bool output_columnar,
+    const std::unordered_map<int, ResultCacheKey>& temporary_table_keys) {
+  if (ra_exe_unit.estimator || has_array_literal(ra_exe_unit)) {
+    return std::nullopt;
+  }
+  const int db_id = cat.getCurrentDB().dbId;
+  ResultCacheKey key;
+  std::ostringstream os;
+  os << "db=" << db_id << ",device=" << static_cast<int>(device_type)
+     << ",columnar=" << output_columnar << "|"
+     << ra_exec_unit_desc_for_caching(ra_exe_unit) << "|targets=";
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    CHECK(target_expr);
+    if (is_transient_string(target_expr)) {
+      return std::nullopt;
+    }
+    os << target_expr->get_type_info().to_string() << ",";
+    const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+    if (agg_expr && agg_expr->get_error_rate()) {
+      os << agg_expr->get_error_rate()->toString() << ",";
+    }
+  }
+  const auto& sort_info = ra_exe_unit.sort_info;
+  os << "|sort=";
+  for (const auto& order_entry : sort_info.order_entries) {
+    os << order_entry.toString() << ",";
+  }
+  os << static_cast<int>(sort_info.algorithm) << "," << sort_info.limit << ","
+     << sort_info.offset;
+  if (ra_exe_unit.union_all) {
+    os << "|union_all=" << *ra_exe_unit.union_all;
+  }
+  os << "|inputs=";
+  for (const auto& input_desc : ra_exe_unit.input_descs) {
+    const int table_id = input_desc.getTableId();
+    os << "(" << table_id << "," << input_desc.getNestLevel() << ",";
+    if (table_id < 0) {
+      const auto it = temporary_table_keys.find(table_id);
+      if (it == temporary_table_keys.end()) {
+        return std::nullopt;
+      }
+      os << it->second.key;
+      key.input_tables.insert(key.input_tables.end(),
+                              it->second.input_tables.begin(),
+                              it->second.input_tables.end());
+    } else {
+      const auto td = cat.getMetadataForTable(table_id, false);
+      // in-memory tables don't have epochs and foreign tables change behind our back
+      if (!td || td->isView || td->isTemporaryTable() || !td->storageType.empty()) {
+        return std::nullopt;
+      }
+      for (const auto physical_td : cat.getPhysicalTablesDescriptors(td, false)) {
+        os << "epoch=" << cat.getDataMgr().getTableEpoch(db_id, physical_td->tableId)
+           << ",";
+      }
+      key.input_tables.emplace_back(db_id, table_id);
+    }
+    os << ")";
+  }
+  key.key = os.str();
+  return key;
+}
+
+std::optional<TemporaryTable> ResultCache::get(const std::string& key) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  const auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++misses_;
+    return std::nullopt;
+  }
+  ++hits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  const auto& cached = it->second->result;
+  std::vector<ResultSetPtr> copies;
+  for (int frag_id = 0; frag_id < cached.getFragCount(); ++frag_id) {
+    copies.push_back(ResultSet::shallowCopy(cached[frag_id]));
+    CHECK(copies.back());
+  }
+  return TemporaryTable(std::move(copies));
+}
+
+void ResultCache::put(const ResultCacheKey& key, const TemporaryTable& result) {
+  std::vector<ResultSetPtr> copies;
+  size_t size_bytes = key.key.size();
+  for (int frag_id = 0; frag_id < result.getFragCount(); ++frag_id) {
+    // don't hold on to the rest of the memory of the query
+    auto copy = result[frag_id]->detachedCopy();
+    if (!copy) {
+      return;
+    }
+    size_bytes += copy->getBufferSizeBytes(ExecutorDeviceType::CPU);
+    copies.push_back(std::move(copy));
+  }
+  if (copies.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  const auto max_size_bytes = g_result_cache_max_size_bytes;
+  if (max_size_bytes && size_bytes > max_size_bytes) {
+    VLOG(1) << "Result of " << size_bytes
+            << " bytes exceeds the result cache budget, not caching it.";
+    return;
+  }
+  const auto it = index_.find(key.key);
+  if (it != index_.end()) {
+    eraseLocked(it->second);
+  }
+  lru_.push_front(
+      {key.key, TemporaryTable(std::move(copies)), key.input_tables, size_bytes});
+  index_.emplace(key.key, lru_.begin());
+  size_bytes_ += size_bytes;
+  while (max_size_bytes && size_bytes_ > max_size_bytes) {
+    CHECK(!lru_.empty());
+    eraseLocked(std::prev(lru_.end()));
+    ++evictions_;
+  }
+}
+
+void ResultCache::invalidateTable(const int db_id, const int table_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  const std::pair<int, int> table{db_id, table_id};
+  for (auto it = lru_.begin(); it != lru_.end();) {
+    const auto& input_tables = it->input_tables;
+    if (std::find(input_tables.begin(), input_tables.end(), table) !=
+        input_tables.end()) {
+      eraseLocked(it++);
+      ++invalidations_;
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ResultCache::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  VLOG(1) << "Clearing " << lru_.size() << " cached query results.";
+  invalidations_ += lru_.size();
+  lru_.clear();
+  index_.clear();
+  size_bytes_ = 0;
+}
+
+ResultCacheStats ResultCache::getStats() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return {lru_.size(), size_bytes_, hits_, misses_, evictions_, invalidations_};
+}
+
+void ResultCache::eraseLocked(std::list<Entry>::iterator it) {
+  CHECK_GE(size_bytes_, it->size_bytes);
+  size_bytes_ -= it->size_bytes;
+  index_.erase(it->key);
+  lru_.erase(it);
+}
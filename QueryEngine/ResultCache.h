@@ -0,0 +1,113 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "QueryEngine/CompilationOptions.h"
+#include "QueryEngine/InputMetadata.h"
+
+extern bool g_enable_result_cache;
+extern size_t g_result_cache_max_size_bytes;
+
+namespace Catalog_Namespace {
+class Catalog;
+}  // namespace Catalog_Namespace
+
+struct RelAlgExecutionUnit;
+
+struct ResultCacheKey {
+  std::string key;
+  // (database id, logical table id) of the tables the result is computed from, directly
+  // or through the temporary tables it reads
+  std::vector<std::pair<int, int>> input_tables;
+};
+
+struct ResultCacheStats {
+  size_t num_entries{0};
+  size_t size_bytes{0};
+  size_t hits{0};
+  size_t misses{0};
+  size_t evictions{0};
+  size_t invalidations{0};
+};
+
+/**
+ * Process-wide cache of the results of query steps, enabled with
+ * `g_enable_result_cache`. The key of a step describes its execution unit, the epoch of
+ * every physical table it reads and, for the temporary tables it reads, the keys of the
+ * steps which produced them. Loading data into a table checkpoints it and bumps its
+ * epoch, so a stale entry is never found; the writers also invalidate the entries of the
+ * table right away to release their memory.
+ *
+ * Entries are kept in least recently used order and evicted once their total size
+ * exceeds `g_result_cache_max_size_bytes` (0 means unbounded). Only results which don't
+ * point to other memory of their query are cached, as copies owning their storage. The
+ * cache hands out shallow copies of those, so that callers can iterate and truncate
+ * them independently.
+ */
+class ResultCache {
+ public:
+  static ResultCache& instance();
+
+  /**
+   * Returns the cache key of the execution unit, or std::nullopt if its result can't be
+   * cached. `temporary_table_keys` maps the ids of the temporary tables produced by the
+   * previous steps of the query to their keys.
+   */
+  static std::optional<ResultCacheKey> makeKey(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const Catalog_Namespace::Catalog& cat,
+      const ExecutorDeviceType device_type,
+      const bool output_columnar,
+      const std::unordered_map<int, ResultCacheKey>& temporary_table_keys);
+
+  std::optional<TemporaryTable> get(const std::string& key);
+
+  void put(const ResultCacheKey& key, const TemporaryTable& result);
+
+  void invalidateTable(const int db_id, const int table_id);
+
+  void clear();
+
+  ResultCacheStats getStats();
+
+ private:
+  struct Entry {
+    std::string key;
+    TemporaryTable result;
+    std::vector<std::pair<int, int>> input_tables;
+    size_t size_bytes;
+  };
+
+  void eraseLocked(std::list<Entry>::iterator it);
+
+  std::mutex mutex_;
+  std::list<Entry> lru_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  size_t size_bytes_{0};
+  size_t hits_{0};
+  size_t misses_{0};
+  size_t evictions_{0};
+  size_t invalidations_{0};
+};
@@ -41,11 +41,13 @@
 #include <bitset>
 #include <future>
 #include <numeric>
+#include <ostream>
 
 extern bool g_use_tbb_pool;
 
 size_t g_parallel_top_min = 100e3;
 size_t g_parallel_top_max = 20e6;  // In effect only with g_enable_watchdog.
+size_t g_parallel_sort_min = 100e3;
 
 void ResultSet::keepFirstN(const size_t n) {
   CHECK_EQ(-1, cached_row_count_);
@@ -228,6 +230,114 @@ const ResultSetStorage* ResultSet::allocateStorage(
   return storage_.get();
 }
 
+std::shared_ptr<ResultSet> ResultSet::shallowCopy(
+    const std::shared_ptr<const ResultSet>& source) {
+  CHECK(source);
+  if (!source->canCopyStorage()) {
+    return nullptr;
+  }
+  auto copy = source->copyWithStorage(
+      source->storage_->buff_, /*buff_is_provided=*/true, source->row_set_mem_owner_);
+  copy->shallow_copy_source_ = source;
+  return copy;
+}
+
+std::shared_ptr<ResultSet> ResultSet::detachedCopy() const {
+  if (!canCopyStorage() || query_mem_desc_.interleavedBins(device_type_)) {
+    return nullptr;
+  }
+  for (const auto& target_info : targets_) {
+    // these targets point to memory of the row set memory owner
+    if (target_info.sql_type.is_varlen() || is_distinct_target(target_info) ||
+        target_info.agg_kind == kAPPROX_MEDIAN) {
+      return nullptr;
+    }
+  }
+  const auto buffer_size = getBufferSizeBytes(device_type_);
+  auto buff = reinterpret_cast<int8_t*>(checked_malloc(buffer_size));
+  memcpy(buff, storage_->buff_, buffer_size);
+  return copyWithStorage(
+      buff,
+      /*buff_is_provided=*/false,
+      row_set_mem_owner_ ? row_set_mem_owner_->cloneStrDictDataOnly() : nullptr);
+}
+
+bool ResultSet::canCopyStorage() const {
+  if (!storage_ || !appended_storage_.empty() || estimator_ || just_explain_ ||
+      separate_varlen_storage_valid_) {
+    return false;
+  }
+  for (const auto& col_lazy_fetch : lazy_fetch_info_) {
+    if (col_lazy_fetch.is_lazily_fetched) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<ResultSet> ResultSet::copyWithStorage(
+    int8_t* buff,
+    const bool buff_is_provided,
+    const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner) const {
+  auto copy = std::make_shared<ResultSet>(targets_,
+                                          device_type_,
+                                          query_mem_desc_,
+                                          row_set_mem_owner,
+                                          catalog_,
+                                          block_size_,
+                                          grid_size_);
+  copy->storage_.reset(
+      new ResultSetStorage(targets_, query_mem_desc_, buff, buff_is_provided));
+  copy->storage_->target_init_vals_ = storage_->target_init_vals_;
+  copy->storage_->count_distinct_sets_mapping_ = storage_->count_distinct_sets_mapping_;
+  copy->drop_first_ = drop_first_;
+  copy->keep_first_ = keep_first_;
+  copy->permutation_ = permutation_;
+  copy->outer_table_id_ = outer_table_id_;
+  copy->for_validation_only_ = for_validation_only_;
+  copy->cached_row_count_ = cached_row_count_.load();
+  copy->geo_return_type_ = geo_return_type_;
+  return copy;
+}
+
+size_t ResultSet::writeRowWiseEntries(std::ostream& out) const {
+  CHECK(storage_);
+  CHECK(appended_storage_.empty());
+  CHECK(!query_mem_desc_.didOutputColumnar());
+  // the key of a keyless entry is its index, which doesn't survive compaction
+  CHECK(!query_mem_desc_.hasKeylessHash());
+  const auto row_size = query_mem_desc_.getRowSize();
+  const auto buff = storage_->getUnderlyingBuffer();
+  constexpr size_t max_batch_bytes{1 << 20};
+  std::vector<char> batch;
+  size_t row_count{0};
+  const auto flush = [&out, &batch] {
+    out.write(batch.data(), batch.size());
+    batch.clear();
+  };
+  const auto write_row = [&](const size_t entry_idx) {
+    const auto row_ptr = reinterpret_cast<const char*>(buff + entry_idx * row_size);
+    batch.insert(batch.end(), row_ptr, row_ptr + row_size);
+    ++row_count;
+    if (batch.size() >= max_batch_bytes) {
+      flush();
+    }
+  };
+  if (permutation_.empty()) {
+    for (size_t entry_idx = 0; entry_idx < query_mem_desc_.getEntryCount(); ++entry_idx) {
+      if (!storage_->isEmptyEntry(entry_idx)) {
+        write_row(entry_idx);
+      }
+    }
+  } else {
+    for (const auto entry_idx : permutation_) {
+      write_row(entry_idx);
+    }
+  }
+  flush();
+  return row_count;
+}
+
 size_t ResultSet::getCurrentRowBufferIndex() const {
   if (crt_row_buff_idx_ == 0) {
     throw std::runtime_error("current row buffer iteration index is undefined");
@@ -449,6 +559,10 @@ void ResultSet::addCompilationQueueTime(const int64_t compilation_queue_time) {
   timings_.compilation_queue_time += compilation_queue_time;
 }
 
+void ResultSet::addReductionTime(const int64_t reduction_time) {
+  timings_.reduction_time += reduction_time;
+}
+
 int64_t ResultSet::getQueueTime() const {
   return timings_.executor_queue_time + timings_.kernel_queue_time +
          timings_.compilation_queue_time;
@@ -458,6 +572,10 @@ int64_t ResultSet::getRenderTime() const {
   return timings_.render_time;
 }
 
+int64_t ResultSet::getReductionTime() const {
+  return timings_.reduction_time;
+}
+
 void ResultSet::moveToBegin() const {
   crt_row_buff_idx_ = 0;
   fetched_so_far_ = 0;
@@ -523,14 +641,9 @@ void ResultSet::sort(const std::list<Analyzer::OrderEntry>& order_entries,
     }
     return;
   }
-  // This check isn't strictly required, but allows the index buffer to be 32-bit.
-  if (query_mem_desc_.getEntryCount() > std::numeric_limits<uint32_t>::max()) {
-    throw RowSortException("Sorting more than 4B elements not supported");
-  }
-
   CHECK(permutation_.empty());
 
-  if (top_n && g_parallel_top_min < entryCount()) {
+  if (top_n && top_n < entryCount() && g_parallel_top_min < entryCount()) {
     if (g_enable_watchdog && g_parallel_top_max < entryCount()) {
       throw WatchdogException("Sorting the result would be too slow");
     }
@@ -539,6 +652,10 @@ void ResultSet::sort(const std::list<Analyzer::OrderEntry>& order_entries,
     if (g_enable_watchdog && Executor::baseline_threshold < entryCount()) {
       throw WatchdogException("Sorting the result would be too slow");
     }
+    if (g_parallel_sort_min < entryCount()) {
+      parallelSort(order_entries, top_n, executor);
+      return;
+    }
     permutation_.resize(query_mem_desc_.getEntryCount());
     // PermutationView is used to share common API with parallelTop().
     PermutationView pv(permutation_.data(), 0, permutation_.size());
@@ -635,6 +752,167 @@ void ResultSet::parallelTop(const std::list<Analyzer::OrderEntry>& order_entries
   permutation_.shrink_to_fit();
 }
 
+namespace {
+
+// Sorts values[0, size) on up to nthreads threads. Every thread sorts a chunk, then the
+// sorted runs are merged pairwise in rounds. Each merge is split at evenly spaced
+// elements of its left run, so that every round keeps all the threads busy.
+template <typename T, typename COMPARE>
+void parallel_merge_sort(T* const values,
+                         const size_t size,
+                         const COMPARE& compare,
+                         const size_t nthreads) {
+  // The std algorithms copy their comparator, which can be expensive.
+  const auto less = [&compare](const T& lhs, const T& rhs) { return compare(lhs, rhs); };
+  std::vector<size_t> run_bounds{0};
+  threadpool::FuturesThreadPool<void> sort_threads;
+  for (auto interval : makeIntervals<size_t>(0, size, nthreads)) {
+    sort_threads.spawn(
+        [values, &less](const size_t begin, const size_t end) {
+          std::sort(values + begin, values + end, less);
+        },
+        interval.begin,
+        interval.end);
+    run_bounds.push_back(interval.end);
+  }
+  sort_threads.join();
+  if (run_bounds.size() <= 2) {
+    return;
+  }
+
+  std::vector<T> buffer(size);
+  T* src = values;
+  T* dst = buffer.data();
+  while (run_bounds.size() > 2) {
+    const size_t num_runs = run_bounds.size() - 1;
+    const size_t pieces_per_merge = std::max(size_t(1), nthreads / (num_runs / 2));
+    std::vector<size_t> merged_bounds{0};
+    threadpool::FuturesThreadPool<void> merge_threads;
+    for (size_t run = 0; run < num_runs; run += 2) {
+      const size_t begin = run_bounds[run];
+      const size_t mid = run_bounds[run + 1];
+      if (run + 1 == num_runs) {
+        // The odd run out is carried over to the next round.
+        merge_threads.spawn(
+            [src, dst, begin, mid] { std::copy(src + begin, src + mid, dst + begin); });
+        merged_bounds.push_back(mid);
+        continue;
+      }
+      const size_t end = run_bounds[run + 2];
+      // The part of the right run ordered before the first element of the next piece
+      // of the left run goes with the current piece.
+      const auto right_bound = [src, mid, end, &less](const size_t left_idx) {
+        if (left_idx == mid) {
+          return end;
+        }
+        const auto it = std::lower_bound(src + mid, src + end, src[left_idx], less);
+        return static_cast<size_t>(it - src);
+      };
+      for (auto piece : makeIntervals<size_t>(begin, mid, pieces_per_merge)) {
+        merge_threads.spawn(
+            [src, dst, begin, mid, &less, right_bound](const size_t left_begin,
+                                                       const size_t left_end) {
+              const size_t right_begin = left_begin == begin ? mid
+                                                             : right_bound(left_begin);
+              const size_t right_end = right_bound(left_end);
+              std::merge(src + left_begin,
+                         src + left_end,
+                         src + right_begin,
+                         src + right_end,
+                         dst + left_begin + (right_begin - mid),
+                         less);
+            },
+            piece.begin,
+            piece.end);
+      }
+      merged_bounds.push_back(end);
+    }
+    merge_threads.join();
+    run_bounds = std::move(merged_bounds);
+    std::swap(src, dst);
+  }
+  if (src != values) {
+    std::copy(src, src + size, values);
+  }
+}
+
+}  // namespace
+
+// Full sort of the non-empty entries on all the CPU threads, then truncation to top_n.
+void ResultSet::parallelSort(const std::list<Analyzer::OrderEntry>& order_entries,
+                             const size_t top_n,
+                             const Executor* executor) {
+  auto timer = DEBUG_TIMER(__func__);
+  if (query_mem_desc_.didOutputColumnar()) {
+    doParallelSort<ColumnWiseTargetAccessor>(order_entries, executor);
+  } else {
+    doParallelSort<RowWiseTargetAccessor>(order_entries, executor);
+  }
+  if (top_n && top_n < permutation_.size()) {
+    permutation_.resize(top_n);
+  }
+  permutation_.shrink_to_fit();
+}
+
+template <typename BUFFER_ITERATOR_TYPE>
+void ResultSet::doParallelSort(const std::list<Analyzer::OrderEntry>& order_entries,
+                               const Executor* executor) {
+  const size_t nthreads = cpu_threads();
+
+  // Collect the non-empty entries of nthreads subranges and left-copy them together.
+  permutation_.resize(query_mem_desc_.getEntryCount());
+  std::vector<PermutationView> permutation_views(nthreads);
+  threadpool::FuturesThreadPool<void> init_threads;
+  for (auto interval : makeIntervals<PermutationIdx>(0, permutation_.size(), nthreads)) {
+    init_threads.spawn(
+        [this, &permutation_views](const auto interval) {
+          PermutationView pv(permutation_.data() + interval.begin, 0, interval.size());
+          permutation_views[interval.index] =
+              initPermutationBuffer(pv, interval.begin, interval.end);
+        },
+        interval);
+  }
+  init_threads.join();
+  auto end = permutation_.begin() + permutation_views.front().size();
+  for (size_t i = 1; i < nthreads; ++i) {
+    std::copy(permutation_views[i].begin(), permutation_views[i].end(), end);
+    end += permutation_views[i].size();
+  }
+  permutation_.resize(end - permutation_.begin());
+
+  PermutationView pv(permutation_.data(), permutation_.size());
+  const ResultSetComparator<BUFFER_ITERATOR_TYPE> compare(
+      order_entries, this, pv, executor, false);
+  if (!compare.hasNormalizedKey()) {
+    parallel_merge_sort(permutation_.data(), permutation_.size(), compare, nthreads);
+    return;
+  }
+
+  // Sort (key, index) pairs instead, so that most comparisons don't touch the storage.
+  using SortKey = std::pair<uint64_t, PermutationIdx>;
+  std::vector<SortKey> sort_keys(permutation_.size());
+  threadpool::FuturesThreadPool<void> key_threads;
+  for (auto interval : makeIntervals<size_t>(0, permutation_.size(), nthreads)) {
+    key_threads.spawn(
+        [this, &sort_keys, &compare](const size_t begin, const size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            sort_keys[i] = {compare.normalizedKey(permutation_[i]), permutation_[i]};
+          }
+        },
+        interval.begin,
+        interval.end);
+  }
+  key_threads.join();
+  const auto compare_keys = [&compare](const SortKey& lhs, const SortKey& rhs) {
+    return lhs.first != rhs.first ? lhs.first < rhs.first
+                                  : compare(lhs.second, rhs.second);
+  };
+  parallel_merge_sort(sort_keys.data(), sort_keys.size(), compare_keys, nthreads);
+  for (size_t i = 0; i < sort_keys.size(); ++i) {
+    permutation_[i] = sort_keys[i].second;
+  }
+}
+
 std::pair<size_t, size_t> ResultSet::getStorageIndex(const size_t entry_idx) const {
   size_t fixedup_entry_idx = entry_idx;
   auto entry_count = storage_->query_mem_desc_.getEntryCount();
@@ -786,22 +1064,7 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
     CHECK_GE(order_entry.tle_no, 1);
     const auto& agg_info = result_set_->targets_[order_entry.tle_no - 1];
     const auto entry_ti = get_compact_type(agg_info);
-    bool float_argument_input = takes_float_argument(agg_info);
-    // Need to determine if the float value has been stored as float
-    // or if it has been compacted to a different (often larger 8 bytes)
-    // in distributed case the floats are actually 4 bytes
-    // TODO the above takes_float_argument() is widely used wonder if this problem
-    // exists elsewhere
-    if (entry_ti.get_type() == kFLOAT) {
-      const auto is_col_lazy =
-          !result_set_->lazy_fetch_info_.empty() &&
-          result_set_->lazy_fetch_info_[order_entry.tle_no - 1].is_lazily_fetched;
-      if (result_set_->query_mem_desc_.getPaddedSlotWidthBytes(order_entry.tle_no - 1) ==
-          sizeof(float)) {
-        float_argument_input =
-            result_set_->query_mem_desc_.didOutputColumnar() ? !is_col_lazy : true;
-      }
-    }
+    const bool float_argument_input = isFloatArgumentInput(order_entry);
 
     if (UNLIKELY(is_distinct_target(agg_info))) {
       CHECK_LT(materialized_count_distinct_buffer_idx,
@@ -916,6 +1179,85 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
   return false;
 }
 
+template <typename BUFFER_ITERATOR_TYPE>
+bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::isFloatArgumentInput(
+    const Analyzer::OrderEntry& order_entry) const {
+  const auto& agg_info = result_set_->targets_[order_entry.tle_no - 1];
+  const auto entry_ti = get_compact_type(agg_info);
+  bool float_argument_input = takes_float_argument(agg_info);
+  // Need to determine if the float value has been stored as float
+  // or if it has been compacted to a different (often larger 8 bytes)
+  // in distributed case the floats are actually 4 bytes
+  // TODO the above takes_float_argument() is widely used wonder if this problem
+  // exists elsewhere
+  if (entry_ti.get_type() == kFLOAT) {
+    const auto is_col_lazy =
+        !result_set_->lazy_fetch_info_.empty() &&
+        result_set_->lazy_fetch_info_[order_entry.tle_no - 1].is_lazily_fetched;
+    if (result_set_->query_mem_desc_.getPaddedSlotWidthBytes(order_entry.tle_no - 1) ==
+        sizeof(float)) {
+      float_argument_input =
+          result_set_->query_mem_desc_.didOutputColumnar() ? !is_col_lazy : true;
+    }
+  }
+  return float_argument_input;
+}
+
+template <typename BUFFER_ITERATOR_TYPE>
+bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::hasNormalizedKey() const {
+  if (order_entries_.empty()) {
+    return false;
+  }
+  const auto& order_entry = order_entries_.front();
+  CHECK_GE(order_entry.tle_no, 1);
+  const auto& agg_info = result_set_->targets_[order_entry.tle_no - 1];
+  if (is_distinct_target(agg_info) || agg_info.agg_kind == kAPPROX_MEDIAN ||
+      agg_info.agg_kind == kAVG) {
+    return false;
+  }
+  // Dictionary encoded strings compare by their values, not by their ids.
+  const auto entry_ti = get_compact_type(agg_info);
+  return entry_ti.is_integer() || entry_ti.is_decimal() || entry_ti.is_boolean() ||
+         entry_ti.is_time() || entry_ti.is_fp();
+}
+
+template <typename BUFFER_ITERATOR_TYPE>
+uint64_t ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::normalizedKey(
+    const PermutationIdx idx) const {
+  constexpr uint64_t sign_bit = uint64_t(1) << 63;
+  const auto& order_entry = order_entries_.front();
+  const auto& agg_info = result_set_->targets_[order_entry.tle_no - 1];
+  const auto entry_ti = get_compact_type(agg_info);
+  const bool float_argument_input = isFloatArgumentInput(order_entry);
+  const auto storage_lookup_result = result_set_->findStorage(idx);
+  const auto value =
+      buffer_itr_.getColumnInternal(storage_lookup_result.storage_ptr->buff_,
+                                    storage_lookup_result.fixedup_entry_idx,
+                                    order_entry.tle_no - 1,
+                                    storage_lookup_result);
+  CHECK(value.isInt());
+  // Ties with a null are broken by operator(), which knows which values are nulls.
+  if (isNull(entry_ti, value, float_argument_input)) {
+    return order_entry.nulls_first ? 0 : std::numeric_limits<uint64_t>::max();
+  }
+  uint64_t key;
+  if (entry_ti.is_fp()) {
+    double dval =
+        float_argument_input
+            ? double(*reinterpret_cast<const float*>(may_alias_ptr(&value.i1)))
+            : *reinterpret_cast<const double*>(may_alias_ptr(&value.i1));
+    if (dval == 0) {
+      dval = 0;  // -0.0 and 0.0 compare equal
+    }
+    key = *reinterpret_cast<const uint64_t*>(may_alias_ptr(&dval));
+    // Negative values order by their magnitude in reverse.
+    key = (key & sign_bit) ? ~key : key | sign_bit;
+  } else {
+    key = static_cast<uint64_t>(value.i1) ^ sign_bit;
+  }
+  return order_entry.is_desc ? ~key : key;
+}
+
 // Partial sort permutation into top(least by compare) n elements.
 // If permutation.size() <= n then sort entire permutation by compare.
 // Return PermutationView with new size() = min(n, permutation.size()).
@@ -34,6 +34,7 @@
 
 #include <atomic>
 #include <functional>
+#include <iosfwd>
 #include <list>
 
 /*
@@ -149,7 +150,7 @@ class TSerializedRows;
 class ResultSetBuilder;
 
 using AppendedStorage = std::vector<std::unique_ptr<ResultSetStorage>>;
-using PermutationIdx = uint32_t;
+using PermutationIdx = uint64_t;
 using Permutation = std::vector<PermutationIdx>;
 using PermutationView = VectorView<PermutationIdx>;
 using Comparator = std::function<bool(const PermutationIdx, const PermutationIdx)>;
@@ -226,6 +227,19 @@ class ResultSet {
 
   const ResultSetStorage* allocateStorage(const std::vector<int64_t>&) const;
 
+  // Returns a result set which shares the storage of `source` but has its own iteration
+  // state, limit and permutation, or nullptr if `source` can't be shared this way.
+  static std::shared_ptr<ResultSet> shallowCopy(
+      const std::shared_ptr<const ResultSet>& source);
+
+  // Returns a copy which owns its storage and only keeps the string dictionaries of the
+  // row set memory owner, or nullptr if the storage points to other memory of the owner.
+  std::shared_ptr<ResultSet> detachedCopy() const;
+
+  // Writes the row-wise entries which aren't empty to `out`, in the order of the
+  // permutation if the result set has been sorted. Returns the number of rows written.
+  size_t writeRowWiseEntries(std::ostream& out) const;
+
   void updateStorageEntryCount(const size_t new_entry_count) {
     CHECK(query_mem_desc_.getQueryDescriptionType() == QueryDescriptionType::Projection);
     query_mem_desc_.setEntryCount(new_entry_count);
@@ -302,14 +316,17 @@ class ResultSet {
     int64_t render_time{0};
     int64_t compilation_queue_time{0};
     int64_t kernel_queue_time{0};
+    int64_t reduction_time{0};
   };
 
   void setQueueTime(const int64_t queue_time);
   void setKernelQueueTime(const int64_t kernel_queue_time);
   void addCompilationQueueTime(const int64_t compilation_queue_time);
+  void addReductionTime(const int64_t reduction_time);
 
   int64_t getQueueTime() const;
   int64_t getRenderTime() const;
+  int64_t getReductionTime() const;
 
   void moveToBegin() const;
 
@@ -438,6 +455,13 @@ class ResultSet {
   std::vector<TargetValue> getNextRowImpl(const bool translate_strings,
                                           const bool decimal_to_double) const;
 
+  bool canCopyStorage() const;
+
+  std::shared_ptr<ResultSet> copyWithStorage(
+      int8_t* buff,
+      const bool buff_is_provided,
+      const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner) const;
+
   std::vector<TargetValue> getNextRowUnlocked(const bool translate_strings,
                                               const bool decimal_to_double) const;
 
@@ -655,6 +679,15 @@ class ResultSet {
 
     bool operator()(const PermutationIdx lhs, const PermutationIdx rhs) const;
 
+    // Whether normalizedKey() can be used for the first order entry.
+    bool hasNormalizedKey() const;
+
+    // Maps the value of the first order entry to a key which compares as unsigned the
+    // same way as operator() does, except that equal keys may still order differently.
+    uint64_t normalizedKey(const PermutationIdx idx) const;
+
+    bool isFloatArgumentInput(const Analyzer::OrderEntry& order_entry) const;
+
     const std::list<Analyzer::OrderEntry>& order_entries_;
     const ResultSet* result_set_;
     const PermutationView permutation_;
@@ -697,6 +730,14 @@ class ResultSet {
                    const size_t top_n,
                    const Executor* executor);
 
+  void parallelSort(const std::list<Analyzer::OrderEntry>& order_entries,
+                    const size_t top_n,
+                    const Executor* executor);
+
+  template <typename BUFFER_ITERATOR_TYPE>
+  void doParallelSort(const std::list<Analyzer::OrderEntry>& order_entries,
+                      const Executor* executor);
+
   void baselineSort(const std::list<Analyzer::OrderEntry>& order_entries,
                     const size_t top_n,
                     const Executor* executor);
@@ -778,6 +819,9 @@ class ResultSet {
   // only used by geo
   mutable GeoReturnType geo_return_type_;
 
+  // keeps the storage of a shallow copy alive
+  std::shared_ptr<const ResultSet> shallow_copy_source_;
+
   friend class ResultSetManager;
   friend class ResultSetRowIterator;
   friend class ColumnarResults;
@@ -30,6 +30,7 @@
 #include "RuntimeFunctions.h"
 #include "Shared/SqlTypesLayout.h"
 #include "Shared/likely.h"
+#include "Shared/measure.h"
 #include "Shared/thread_count.h"
 
 #include <llvm/ExecutionEngine/GenericValue.h>
@@ -39,6 +40,7 @@
 #include <numeric>
 
 extern bool g_enable_dynamic_watchdog;
+extern bool g_enable_parallel_reduction;
 
 namespace {
 
@@ -205,7 +207,8 @@ void result_set::fill_empty_key(void* key_ptr,
 // Reduces the entries of `that` into the buffer of this ResultSetStorage object.
 void ResultSetStorage::reduce(const ResultSetStorage& that,
                               const std::vector<std::string>& serialized_varlen_buffer,
-                              const ReductionCode& reduction_code) const {
+                              const ReductionCode& reduction_code,
+                              const bool allow_multithreading) const {
   auto entry_count = query_mem_desc_.getEntryCount();
   CHECK_GT(entry_count, size_t(0));
   if (query_mem_desc_.didOutputColumnar()) {
@@ -235,7 +238,7 @@ void ResultSetStorage::reduce(const ResultSetStorage& that,
           "Projection of variable length targets with baseline hash group by is not yet "
           "supported in Distributed mode");
     }
-    if (use_multithreaded_reduction(that_entry_count)) {
+    if (allow_multithreading && use_multithreaded_reduction(that_entry_count)) {
       const size_t thread_count = cpu_threads();
       std::vector<std::future<void>> reduction_threads;
       for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
@@ -297,7 +300,7 @@ void ResultSetStorage::reduce(const ResultSetStorage& that,
     }
     return;
   }
-  if (use_multithreaded_reduction(entry_count)) {
+  if (allow_multithreading && use_multithreaded_reduction(entry_count)) {
     const size_t thread_count = cpu_threads();
     std::vector<std::future<void>> reduction_threads;
     for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
@@ -375,6 +378,61 @@ void ResultSetStorage::reduce(const ResultSetStorage& that,
   }
 }
 
+bool ResultSetStorage::canReduceTree(const QueryMemoryDescriptor& query_mem_desc) {
+  if (!g_enable_parallel_reduction) {
+    return false;
+  }
+  switch (query_mem_desc.getQueryDescriptionType()) {
+    case QueryDescriptionType::GroupByPerfectHash:
+    case QueryDescriptionType::NonGroupedAggregate:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void ResultSetStorage::reduceTree(const std::vector<const ResultSetStorage*>& storages,
+                                  const ReductionCode& reduction_code) {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK(!storages.empty());
+  const size_t thread_count = cpu_threads();
+  for (size_t stride = 1; stride < storages.size(); stride *= 2) {
+    std::vector<std::pair<const ResultSetStorage*, const ResultSetStorage*>> pairs;
+    for (size_t i = 0; i + stride < storages.size(); i += 2 * stride) {
+      CHECK(storages[i] && storages[i + stride]);
+      pairs.emplace_back(storages[i], storages[i + stride]);
+    }
+    // Once there are enough pairs to keep all the threads busy, each pair is reduced
+    // on a single thread; the last levels split every pair across threads instead.
+    const bool allow_multithreading = pairs.size() < thread_count;
+    const size_t worker_count = std::min(pairs.size(), thread_count);
+    std::vector<std::future<void>> reduction_threads;
+    for (size_t worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
+      reduction_threads.emplace_back(std::async(
+          std::launch::async,
+          [&pairs,
+           &reduction_code,
+           allow_multithreading,
+           worker_idx,
+           worker_count,
+           parent_thread_id = logger::thread_id()] {
+            DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+            for (size_t pair_idx = worker_idx; pair_idx < pairs.size();
+                 pair_idx += worker_count) {
+              pairs[pair_idx].first->reduce(
+                  *pairs[pair_idx].second, {}, reduction_code, allow_multithreading);
+            }
+          }));
+    }
+    for (auto& reduction_thread : reduction_threads) {
+      reduction_thread.wait();
+    }
+    for (auto& reduction_thread : reduction_threads) {
+      reduction_thread.get();
+    }
+  }
+}
+
 namespace {
 
 ALWAYS_INLINE void check_watchdog() {
@@ -1107,6 +1165,18 @@ ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets) {
                                       result_rs->getTargetInfos(),
                                       result_rs->getTargetInitVals());
   auto reduction_code = reduction_jit.codegen();
+  auto clock_begin = timer_start();
+  if (serialized_varlen_buffer.empty() &&
+      ResultSetStorage::canReduceTree(result_rs->getQueryMemDesc())) {
+    std::vector<const ResultSetStorage*> storages;
+    for (const auto result_set : result_sets) {
+      storages.push_back(result_set->storage_.get());
+    }
+    CHECK_EQ(storages.front(), result);
+    ResultSetStorage::reduceTree(storages, reduction_code);
+    result_rs->addReductionTime(timer_stop(clock_begin));
+    return result_rs;
+  }
   size_t ctr = 1;
   for (auto result_it = result_sets.begin() + 1; result_it != result_sets.end();
        ++result_it) {
@@ -1117,6 +1187,7 @@ ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets) {
       result->reduce(*((*result_it)->storage_), {}, reduction_code);
     }
   }
+  result_rs->addReductionTime(timer_stop(clock_begin));
   return result_rs;
 }
 
@@ -30,6 +30,7 @@
 #include "../Shared/thread_count.h"
 
 #include <future>
+#include <limits>
 
 std::unique_ptr<CudaMgr_Namespace::CudaMgr> g_cuda_mgr;  // for unit tests only
 
@@ -89,7 +90,8 @@ void ResultSet::doBaselineSort(const ExecutorDeviceType device_type,
   const auto key_bytewidth = query_mem_desc_.getEffectiveKeyWidth();
   if (step > 1) {
     std::vector<std::future<void>> top_futures;
-    std::vector<Permutation> strided_permutations(step);
+    // baseline_sort() returns 32-bit indices, see canUseFastBaselineSort()
+    std::vector<std::vector<uint32_t>> strided_permutations(step);
     for (size_t start = 0; start < step; ++start) {
       top_futures.emplace_back(std::async(
           std::launch::async,
@@ -146,12 +148,13 @@ void ResultSet::doBaselineSort(const ExecutorDeviceType device_type,
     }
     return;
   } else {
-    permutation_ =
+    const auto permutation =
         (key_bytewidth == 4)
             ? baseline_sort<int32_t>(
                   device_type, 0, data_mgr, groupby_buffer, pod_oe, layout, top_n, 0, 1)
             : baseline_sort<int64_t>(
                   device_type, 0, data_mgr, groupby_buffer, pod_oe, layout, top_n, 0, 1);
+    permutation_.assign(permutation.begin(), permutation.end());
   }
 }
 
@@ -159,7 +162,8 @@ bool ResultSet::canUseFastBaselineSort(
     const std::list<Analyzer::OrderEntry>& order_entries,
     const size_t top_n) {
   if (order_entries.size() != 1 || query_mem_desc_.hasKeylessHash() ||
-      query_mem_desc_.sortOnGpu() || query_mem_desc_.didOutputColumnar()) {
+      query_mem_desc_.sortOnGpu() || query_mem_desc_.didOutputColumnar() ||
+      query_mem_desc_.getEntryCount() > std::numeric_limits<uint32_t>::max()) {
     return false;
   }
   const auto& order_entry = order_entries.front();
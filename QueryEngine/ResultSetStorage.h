@@ -98,7 +98,19 @@ class ResultSetStorage {
  public:
   void reduce(const ResultSetStorage& that,
               const std::vector<std::string>& serialized_varlen_buffer,
-              const ReductionCode& reduction_code) const;
+              const ReductionCode& reduction_code,
+              const bool allow_multithreading = true) const;
+
+  /**
+   * Reduces all the storages into the first one as a pairwise tree: every level of the
+   * tree reduces its pairs concurrently, so the depth of the reduction is logarithmic in
+   * the number of storages. Requires the same entry count for all storages, which rules
+   * out the baseline hash layout.
+   */
+  static void reduceTree(const std::vector<const ResultSetStorage*>& storages,
+                         const ReductionCode& reduction_code);
+
+  static bool canReduceTree(const QueryMemoryDescriptor& query_mem_desc);
 
   void rewriteAggregateBufferOffsets(
       const std::vector<std::string>& serialized_varlen_buffer) const;
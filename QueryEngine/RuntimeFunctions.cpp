@@ -753,47 +753,125 @@ extern "C" ALWAYS_INLINE int64_t decimal_ceil(const int64_t x, const int64_t sca
   return decimal_floor(x, scale) + (x % scale ? scale : 0);
 }
 
-// Shared memory aggregators. Should never be called,
-// real implementations are in cuda_mapd_rt.cu.
-#define DEF_SHARED_AGG_RET_STUBS(base_agg_func)                                     \
-  extern "C" GPU_RT_STUB uint64_t base_agg_func##_shared(uint64_t* agg,             \
-                                                         const int64_t val) {       \
-    return 0;                                                                       \
-  }                                                                                 \
-                                                                                    \
-  extern "C" GPU_RT_STUB uint64_t base_agg_func##_skip_val_shared(                  \
-      uint64_t* agg, const int64_t val, const int64_t skip_val) {                   \
-    return 0;                                                                       \
-  }                                                                                 \
-  extern "C" GPU_RT_STUB uint32_t base_agg_func##_int32_shared(uint32_t* agg,       \
-                                                               const int32_t val) { \
-    return 0;                                                                       \
-  }                                                                                 \
-                                                                                    \
-  extern "C" GPU_RT_STUB uint32_t base_agg_func##_int32_skip_val_shared(            \
-      uint32_t* agg, const int32_t val, const int32_t skip_val) {                   \
-    return 0;                                                                       \
-  }                                                                                 \
-                                                                                    \
-  extern "C" GPU_RT_STUB uint64_t base_agg_func##_double_shared(uint64_t* agg,      \
-                                                                const double val) { \
-    return 0;                                                                       \
-  }                                                                                 \
-                                                                                    \
-  extern "C" GPU_RT_STUB uint64_t base_agg_func##_double_skip_val_shared(           \
-      uint64_t* agg, const double val, const double skip_val) {                     \
-    return 0;                                                                       \
-  }                                                                                 \
-  extern "C" GPU_RT_STUB uint32_t base_agg_func##_float_shared(uint32_t* agg,       \
-                                                               const float val) {   \
-    return 0;                                                                       \
-  }                                                                                 \
-                                                                                    \
-  extern "C" GPU_RT_STUB uint32_t base_agg_func##_float_skip_val_shared(            \
-      uint32_t* agg, const float val, const float skip_val) {                       \
-    return 0;                                                                       \
+// Shared memory aggregators. On GPU the real implementations are in cuda_mapd_rt.cu,
+// on CPU they are used when all the kernels of a query insert into the same group by
+// buffer, see QueryMemoryDescriptor::kernelsShareMemory(). The buffer is only read
+// once the kernels are done, so the updates don't need any ordering.
+
+template <typename T, typename UPDATE>
+ALWAYS_INLINE T atomic_update_shared(T* agg, UPDATE update) {
+  T old = __atomic_load_n(agg, __ATOMIC_RELAXED);
+  while (true) {
+    const T desired = update(old);
+    if (desired == old) {
+      return old;
+    }
+    const T current = __sync_val_compare_and_swap(agg, old, desired);
+    if (current == old) {
+      return old;
+    }
+    old = current;
+  }
+}
+
+template <typename T>
+ALWAYS_INLINE T add_shared(const T lhs, const T rhs) {
+  return lhs + rhs;
+}
+
+#define DEF_SHARED_AGG_COUNT(suffix, ADDR_T, DATA_T)                             \
+  extern "C" ALWAYS_INLINE ADDR_T agg_count##suffix##_shared(ADDR_T* agg,        \
+                                                             const DATA_T val) { \
+    return __sync_fetch_and_add(agg, ADDR_T(1));                                 \
+  }                                                                              \
+                                                                                 \
+  extern "C" ALWAYS_INLINE ADDR_T agg_count##suffix##_skip_val_shared(           \
+      ADDR_T* agg, const DATA_T val, const DATA_T skip_val) {                    \
+    if (val != skip_val) {                                                       \
+      return agg_count##suffix##_shared(agg, val);                               \
+    }                                                                            \
+    return *agg;                                                                 \
+  }
+
+DEF_SHARED_AGG_COUNT(, uint64_t, int64_t)
+DEF_SHARED_AGG_COUNT(_int32, uint32_t, int32_t)
+DEF_SHARED_AGG_COUNT(_double, uint64_t, double)
+DEF_SHARED_AGG_COUNT(_float, uint32_t, float)
+#undef DEF_SHARED_AGG_COUNT
+
+#define DEF_SHARED_AGG_SUM_INT(suffix, T)                                    \
+  extern "C" ALWAYS_INLINE T agg_sum##suffix##_shared(T* agg, const T val) { \
+    return __sync_fetch_and_add(agg, val);                                   \
+  }                                                                          \
+                                                                             \
+  extern "C" ALWAYS_INLINE T agg_sum##suffix##_skip_val_shared(              \
+      T* agg, const T val, const T skip_val) {                               \
+    if (val != skip_val) {                                                   \
+      return atomic_update_shared(agg, [val, skip_val](const T old) {        \
+        return old != skip_val ? add_shared(old, val) : val;                 \
+      });                                                                    \
+    }                                                                        \
+    return *agg;                                                             \
   }
 
+DEF_SHARED_AGG_SUM_INT(, int64_t)
+DEF_SHARED_AGG_SUM_INT(_int32, int32_t)
+#undef DEF_SHARED_AGG_SUM_INT
+
+#define DEF_SHARED_AGG_INT(base_agg_func, combine, T)                            \
+  extern "C" ALWAYS_INLINE void base_agg_func##_shared(T* agg, const T val) {    \
+    atomic_update_shared(agg, [val](const T old) { return combine(old, val); }); \
+  }                                                                              \
+                                                                                 \
+  extern "C" ALWAYS_INLINE void base_agg_func##_skip_val_shared(                 \
+      T* agg, const T val, const T skip_val) {                                   \
+    if (val != skip_val) {                                                       \
+      atomic_update_shared(agg, [val, skip_val](const T old) {                   \
+        return old != skip_val ? combine(old, val) : val;                        \
+      });                                                                        \
+    }                                                                            \
+  }
+
+DEF_SHARED_AGG_INT(agg_max, std::max, int64_t)
+DEF_SHARED_AGG_INT(agg_min, std::min, int64_t)
+DEF_SHARED_AGG_INT(agg_max_int32, std::max, int32_t)
+DEF_SHARED_AGG_INT(agg_min_int32, std::min, int32_t)
+#undef DEF_SHARED_AGG_INT
+
+#define DEF_SHARED_AGG_FP(base_agg_func, combine, ADDR_T, DATA_T)                        \
+  extern "C" ALWAYS_INLINE void base_agg_func##_shared(ADDR_T* agg,                      \
+                                                       const DATA_T val) {               \
+    atomic_update_shared(agg, [val](const ADDR_T old) {                                  \
+      const DATA_T r =                                                                   \
+          combine(*reinterpret_cast<const DATA_T*>(may_alias_ptr(&old)), val);           \
+      return *reinterpret_cast<const ADDR_T*>(may_alias_ptr(&r));                        \
+    });                                                                                  \
+  }                                                                                      \
+                                                                                         \
+  extern "C" ALWAYS_INLINE void base_agg_func##_skip_val_shared(                         \
+      ADDR_T* agg, const DATA_T val, const DATA_T skip_val) {                            \
+    if (val != skip_val) {                                                               \
+      const auto skip_bits = *reinterpret_cast<const ADDR_T*>(may_alias_ptr(&skip_val)); \
+      atomic_update_shared(agg, [val, skip_bits](const ADDR_T old) {                     \
+        const DATA_T r =                                                                 \
+            old != skip_bits                                                             \
+                ? combine(*reinterpret_cast<const DATA_T*>(may_alias_ptr(&old)), val)    \
+                : val;                                                                   \
+        return *reinterpret_cast<const ADDR_T*>(may_alias_ptr(&r));                      \
+      });                                                                                \
+    }                                                                                    \
+  }
+
+DEF_SHARED_AGG_FP(agg_sum_double, add_shared, int64_t, double)
+DEF_SHARED_AGG_FP(agg_max_double, std::max, int64_t, double)
+DEF_SHARED_AGG_FP(agg_min_double, std::min, int64_t, double)
+DEF_SHARED_AGG_FP(agg_sum_float, add_shared, int32_t, float)
+DEF_SHARED_AGG_FP(agg_max_float, std::max, int32_t, float)
+DEF_SHARED_AGG_FP(agg_min_float, std::min, int32_t, float)
+#undef DEF_SHARED_AGG_FP
+
+// The remaining shared memory aggregators are only used on GPU and should never be
+// called, real implementations are in cuda_mapd_rt.cu.
 #define DEF_SHARED_AGG_STUBS(base_agg_func)                                              \
   extern "C" GPU_RT_STUB void base_agg_func##_shared(int64_t* agg, const int64_t val) {} \
                                                                                          \
@@ -820,9 +898,6 @@ extern "C" ALWAYS_INLINE int64_t decimal_ceil(const int64_t x, const int64_t sca
   extern "C" GPU_RT_STUB void base_agg_func##_float_skip_val_shared(                     \
       int32_t* agg, const float val, const float skip_val) {}
 
-DEF_SHARED_AGG_RET_STUBS(agg_count)
-DEF_SHARED_AGG_STUBS(agg_max)
-DEF_SHARED_AGG_STUBS(agg_min)
 DEF_SHARED_AGG_STUBS(agg_id)
 
 extern "C" GPU_RT_STUB int32_t checked_single_agg_id_shared(int64_t* agg,
@@ -880,35 +955,13 @@ extern "C" GPU_RT_STUB void agg_min_int8_skip_val_shared(int8_t* agg,
 
 extern "C" GPU_RT_STUB void agg_id_double_shared_slow(int64_t* agg, const double* val) {}
 
-extern "C" GPU_RT_STUB int64_t agg_sum_shared(int64_t* agg, const int64_t val) {
-  return 0;
-}
-
-extern "C" GPU_RT_STUB int64_t agg_sum_skip_val_shared(int64_t* agg,
-                                                       const int64_t val,
-                                                       const int64_t skip_val) {
-  return 0;
-}
-extern "C" GPU_RT_STUB int32_t agg_sum_int32_shared(int32_t* agg, const int32_t val) {
-  return 0;
-}
-
-extern "C" GPU_RT_STUB int32_t agg_sum_int32_skip_val_shared(int32_t* agg,
-                                                             const int32_t val,
-                                                             const int32_t skip_val) {
-  return 0;
-}
+extern "C" GPU_RT_STUB void agg_max_int16_shared(int16_t* agg, const int16_t val) {}
 
-extern "C" GPU_RT_STUB void agg_sum_double_shared(int64_t* agg, const double val) {}
+extern "C" GPU_RT_STUB void agg_max_int8_shared(int8_t* agg, const int8_t val) {}
 
-extern "C" GPU_RT_STUB void agg_sum_double_skip_val_shared(int64_t* agg,
-                                                           const double val,
-                                                           const double skip_val) {}
-extern "C" GPU_RT_STUB void agg_sum_float_shared(int32_t* agg, const float val) {}
+extern "C" GPU_RT_STUB void agg_min_int16_shared(int16_t* agg, const int16_t val) {}
 
-extern "C" GPU_RT_STUB void agg_sum_float_skip_val_shared(int32_t* agg,
-                                                          const float val,
-                                                          const float skip_val) {}
+extern "C" GPU_RT_STUB void agg_min_int8_shared(int8_t* agg, const int8_t val) {}
 
 extern "C" GPU_RT_STUB void force_sync() {}
 
@@ -1078,6 +1131,74 @@ extern "C" ALWAYS_INLINE int64_t* get_matching_group_value(int64_t* groups_buffe
   return nullptr;
 }
 
+// Version of get_matching_group_value for a buffer shared by all the CPU kernels of a
+// query. Every entry has a state byte after the end of the buffer, see
+// QueryMemoryInitializer. The entry is claimed with a compare and swap on its state, the
+// thread which claimed it writes the key and then publishes it, and threads looking up
+// the same entry wait for the key to be published before comparing it. Key components
+// can have any value, including the empty key.
+constexpr int8_t SHARED_ENTRY_EMPTY{0};
+constexpr int8_t SHARED_ENTRY_WRITING{1};
+constexpr int8_t SHARED_ENTRY_PUBLISHED{2};
+
+template <typename T>
+ALWAYS_INLINE int64_t* get_matching_group_value_shared(int64_t* groups_buffer,
+                                                       int8_t* entry_states,
+                                                       const uint32_t h,
+                                                       const T* key,
+                                                       const uint32_t key_count,
+                                                       const uint32_t row_size_quad) {
+  auto row_ptr =
+      reinterpret_cast<T*>(groups_buffer + static_cast<size_t>(h) * row_size_quad);
+  auto state_ptr = entry_states + h;
+  auto state = __atomic_load_n(state_ptr, __ATOMIC_ACQUIRE);
+  if (state == SHARED_ENTRY_EMPTY) {
+    if (__atomic_compare_exchange_n(state_ptr,
+                                    &state,
+                                    SHARED_ENTRY_WRITING,
+                                    false,
+                                    __ATOMIC_ACQUIRE,
+                                    __ATOMIC_ACQUIRE)) {
+      memcpy(row_ptr, key, key_count * sizeof(T));
+      __atomic_store_n(state_ptr, SHARED_ENTRY_PUBLISHED, __ATOMIC_RELEASE);
+      auto row_ptr_i8 = reinterpret_cast<int8_t*>(row_ptr + key_count);
+      return reinterpret_cast<int64_t*>(align_to_int64(row_ptr_i8));
+    }
+  }
+  while (state != SHARED_ENTRY_PUBLISHED) {
+    state = __atomic_load_n(state_ptr, __ATOMIC_ACQUIRE);
+  }
+  if (memcmp(row_ptr, key, key_count * sizeof(T))) {
+    return nullptr;
+  }
+  auto row_ptr_i8 = reinterpret_cast<int8_t*>(row_ptr + key_count);
+  return reinterpret_cast<int64_t*>(align_to_int64(row_ptr_i8));
+}
+
+extern "C" ALWAYS_INLINE int64_t* get_matching_group_value_shared(
+    int64_t* groups_buffer,
+    int8_t* entry_states,
+    const uint32_t h,
+    const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t key_width,
+    const uint32_t row_size_quad) {
+  switch (key_width) {
+    case 4:
+      return get_matching_group_value_shared(groups_buffer,
+                                             entry_states,
+                                             h,
+                                             reinterpret_cast<const int32_t*>(key),
+                                             key_count,
+                                             row_size_quad);
+    case 8:
+      return get_matching_group_value_shared(
+          groups_buffer, entry_states, h, key, key_count, row_size_quad);
+    default:;
+  }
+  return nullptr;
+}
+
 template <typename T>
 ALWAYS_INLINE int32_t get_matching_group_value_columnar_slot(int64_t* groups_buffer,
                                                              const uint32_t entry_count,
@@ -1209,6 +1330,57 @@ extern "C" ALWAYS_INLINE void set_matching_group_value_perfect_hash_columnar(
 #include "GroupByRuntime.cpp"
 #include "JoinHashTable/Runtime/JoinHashTableQueryRuntime.cpp"
 
+extern "C" NEVER_INLINE int64_t* get_group_value_shared(
+    int64_t* groups_buffer,
+    const uint32_t groups_buffer_entry_count,
+    const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t key_width,
+    const uint32_t row_size_quad) {
+  const uint32_t h = key_hash(key, key_count, key_width) % groups_buffer_entry_count;
+  auto entry_states = reinterpret_cast<int8_t*>(
+      groups_buffer + static_cast<size_t>(groups_buffer_entry_count) * row_size_quad);
+  uint32_t h_probe = h;
+  do {
+    const auto matching_group = get_matching_group_value_shared(
+        groups_buffer, entry_states, h_probe, key, key_count, key_width, row_size_quad);
+    if (matching_group) {
+      return matching_group;
+    }
+    h_probe = (h_probe + 1) % groups_buffer_entry_count;
+  } while (h_probe != h);
+  return NULL;
+}
+
+extern "C" NEVER_INLINE int64_t* get_group_value_shared_with_watchdog(
+    int64_t* groups_buffer,
+    const uint32_t groups_buffer_entry_count,
+    const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t key_width,
+    const uint32_t row_size_quad) {
+  const uint32_t h = key_hash(key, key_count, key_width) % groups_buffer_entry_count;
+  auto entry_states = reinterpret_cast<int8_t*>(
+      groups_buffer + static_cast<size_t>(groups_buffer_entry_count) * row_size_quad);
+  uint32_t watchdog_countdown = 100;
+  uint32_t h_probe = h;
+  do {
+    const auto matching_group = get_matching_group_value_shared(
+        groups_buffer, entry_states, h_probe, key, key_count, key_width, row_size_quad);
+    if (matching_group) {
+      return matching_group;
+    }
+    h_probe = (h_probe + 1) % groups_buffer_entry_count;
+    if (--watchdog_countdown == 0) {
+      if (dynamic_watchdog()) {
+        return NULL;
+      }
+      watchdog_countdown = 100;
+    }
+  } while (h_probe != h);
+  return NULL;
+}
+
 extern "C" ALWAYS_INLINE int64_t* get_group_value_fast_keyless(
     int64_t* groups_buffer,
     const int64_t key,
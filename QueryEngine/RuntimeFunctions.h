@@ -37,6 +37,16 @@ extern "C" void agg_max_double(int64_t* agg, const double val);
 
 extern "C" void agg_min_double(int64_t* agg, const double val);
 
+extern "C" uint64_t agg_count_shared(uint64_t* agg, const int64_t val);
+
+extern "C" int64_t agg_sum_shared(int64_t* agg, const int64_t val);
+
+extern "C" void agg_max_shared(int64_t* agg, const int64_t val);
+
+extern "C" void agg_min_double_skip_val_shared(int64_t* agg,
+                                               const double val,
+                                               const double skip_val);
+
 extern "C" int32_t agg_sum_int32_skip_val(int32_t* agg,
                                           const int32_t val,
                                           const int32_t skip_val);
@@ -144,6 +154,13 @@ extern "C" RUNTIME_EXPORT int64_t* get_group_value_with_watchdog(
     const uint32_t key_width,
     const uint32_t row_size_quad);
 
+extern "C" int64_t* get_group_value_shared(int64_t* groups_buffer,
+                                           const uint32_t groups_buffer_entry_count,
+                                           const int64_t* key,
+                                           const uint32_t key_count,
+                                           const uint32_t key_width,
+                                           const uint32_t row_size_quad);
+
 extern "C" RUNTIME_EXPORT int64_t* get_group_value_columnar(
     int64_t* groups_buffer,
     const uint32_t groups_buffer_entry_count,
@@ -264,6 +281,14 @@ extern "C" int64_t fixed_width_small_date_decode_noinline(const int8_t* byte_str
                                                           const int64_t ret_null_val,
                                                           const int64_t pos);
 
+extern "C" int64_t run_length_int_decode_noinline(const int8_t* byte_stream,
+                                                  const int32_t entry_width,
+                                                  const int64_t pos);
+
+extern "C" int64_t diff_block_int_decode_noinline(const int8_t* byte_stream,
+                                                  const int64_t null_val,
+                                                  const int64_t pos);
+
 extern "C" int8_t* extract_str_ptr_noinline(const uint64_t str_and_len);
 
 extern "C" int32_t extract_str_len_noinline(const uint64_t str_and_len);
@@ -24,6 +24,7 @@
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ExternalCacheInvalidators.h"
 #include "QueryEngine/InputMetadata.h"
+#include "QueryEngine/ResultCache.h"
 #include "QueryEngine/TargetMetaInfo.h"
 #include "Shared/UpdelRoll.h"
 #include "Shared/likely.h"
@@ -137,6 +138,8 @@ class StorageIOFacility {
         // to ensure that epochs are uniformly incremented in distributed mode.
         catalog.checkpointWithAutoRollback(table_descriptor_->tableId);
       }
+      ResultCache::instance().invalidateTable(catalog.getCurrentDB().dbId,
+                                              table_descriptor_->tableId);
     }
 
     auto tableIsTemporary() const { return table_is_temporary_; }
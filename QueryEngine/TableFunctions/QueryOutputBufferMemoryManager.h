@@ -46,6 +46,11 @@
   destroyed (when leaving launchCpuCode). The buffers of output
   columns are now owned by the ResultSet instance.
 
+  Parallel table functions (exe_unit.table_func.isParallel()) do not
+  register output Column instances. launchCpuCode allocates the output
+  buffers up front and passes each thread a pointer into every output
+  column buffer at the start of the thread's output slice.
+
 */
 
 struct QueryOutputBufferMemoryManager {
@@ -91,6 +96,13 @@ struct QueryOutputBufferMemoryManager {
   // Return the number of rows of output columns.
   size_t get_nrows() const { return output_num_rows_; }
 
+  // Return the buffer of output column, available after allocate_output_buffers
+  int64_t* get_output_column_buffer(size_t index) const {
+    CHECK_LT(index, get_ncols());
+    CHECK(output_col_buf_ptrs[index]);
+    return output_col_buf_ptrs[index];
+  }
+
   // Store the pointer to output Column instance
   void set_output_column(int32_t index, int8_t* ptr) {
     CHECK(index >= 0 && index < static_cast<int32_t>(get_ncols()));
@@ -140,9 +152,12 @@ struct QueryOutputBufferMemoryManager {
     CHECK(group_by_buffers_ptr);
     auto output_buffers_ptr = reinterpret_cast<int64_t*>(group_by_buffers_ptr[0]);
     for (size_t i = 0; i < num_out_columns; i++) {
-      Column* col = reinterpret_cast<Column*>(output_column_ptrs[i]);
-      CHECK(col);
       output_col_buf_ptrs[i] = output_buffers_ptr + i * output_num_rows_;
+      Column* col = reinterpret_cast<Column*>(output_column_ptrs[i]);
+      if (!col) {
+        CHECK(exe_unit_.table_func.isParallel());
+        continue;
+      }
       // set the members of output Column instances:
       col->ptr = reinterpret_cast<int8_t*>(output_col_buf_ptrs[i]);
       col->size = output_num_rows_;
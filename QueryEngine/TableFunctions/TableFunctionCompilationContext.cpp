@@ -333,6 +333,10 @@ void TableFunctionCompilationContext::generateEntryPoint(
           ti.get_type_name());
     }
   }
+  // Parallel table functions are called once per input slice on CPU, so
+  // their output buffers are passed in by the caller as on GPU instead
+  // of being allocated by set_output_row_size.
+  const bool use_output_buffers_arg = is_gpu || exe_unit.table_func.isParallel();
   std::vector<llvm::Value*> output_col_args;
   for (size_t i = 0; i < exe_unit.target_exprs.size(); i++) {
     auto output_load = cgen_state->ir_builder_.CreateLoad(
@@ -346,12 +350,13 @@ void TableFunctionCompilationContext::generateEntryPoint(
         std::string("output_col.") + std::to_string(i),
         i,
         ti,
-        (is_gpu ? output_load : nullptr),  // CPU: set_output_row_size will set the output
-                                           // Column ptr member
+        (use_output_buffers_arg ? output_load
+                                : nullptr),  // CPU: set_output_row_size will set the
+                                             // output Column ptr member
         output_row_count_ptr,
         ctx,
         cgen_state_->ir_builder_);
-    if (!is_gpu) {
+    if (!use_output_buffers_arg) {
       cgen_state->emitExternalCall(
           "register_output_column",
           llvm::Type::getVoidTy(ctx),
@@ -366,7 +371,8 @@ void TableFunctionCompilationContext::generateEntryPoint(
 
   // output column members must be set before loading column when
   // column instances are passed by value
-  if (!exe_unit.table_func.hasTableFunctionSpecifiedParameter() && !is_gpu) {
+  if (!exe_unit.table_func.hasTableFunctionSpecifiedParameter() &&
+      !use_output_buffers_arg) {
     cgen_state->emitExternalCall(
         "set_output_row_size",
         llvm::Type::getVoidTy(ctx),
@@ -22,7 +22,11 @@
 #include "QueryEngine/GpuMemUtils.h"
 #include "QueryEngine/TableFunctions/QueryOutputBufferMemoryManager.h"
 #include "QueryEngine/TableFunctions/TableFunctionCompilationContext.h"
+#include "Shared/Intervals.h"
 #include "Shared/funcannotations.h"
+#include "Shared/thread_count.h"
+
+extern size_t g_parallel_table_function_rows_per_thread;
 
 namespace {
 
@@ -237,6 +241,10 @@ ResultSetPtr TableFunctionExecutionContext::launchCpuCode(
     std::vector<int64_t>& col_sizes,
     const size_t elem_count,
     Executor* executor) {
+  if (exe_unit.table_func.isParallel()) {
+    return launchParallelCpuCode(
+        exe_unit, compilation_context, col_buf_ptrs, col_sizes, elem_count, executor);
+  }
   int64_t output_row_count = 0;
 
   // mgr will allocate output buffers on output column resize
@@ -301,6 +309,150 @@ ResultSetPtr TableFunctionExecutionContext::launchCpuCode(
   return mgr->query_buffers->getResultSetOwned(0);
 }
 
+/*
+  Runs a parallel table function on CPU. The input rows are split into
+  contiguous slices, one per thread, and every thread calls the table
+  function with the column arguments offset to the start of its slice.
+  The output buffers are allocated once for all input rows and each
+  slice writes to the part of every output column that corresponds to
+  its input rows. When the slices return fewer rows than allocated,
+  the slices are moved down in place to make the output rows
+  contiguous, otherwise the buffers are handed to the ResultSet as is.
+*/
+ResultSetPtr TableFunctionExecutionContext::launchParallelCpuCode(
+    const TableFunctionExecutionUnit& exe_unit,
+    const TableFunctionCompilationContext* compilation_context,
+    std::vector<const int8_t*>& col_buf_ptrs,
+    std::vector<int64_t>& col_sizes,
+    const size_t elem_count,
+    Executor* executor) {
+  CHECK(exe_unit.table_func.getOutputRowSizeType() ==
+        table_functions::OutputBufferSizeType::kUserSpecifiedRowMultiplier);
+  auto mgr = std::make_unique<QueryOutputBufferMemoryManager>(
+      exe_unit, executor, col_buf_ptrs, row_set_mem_owner_);
+  const size_t allocated_row_count = get_output_row_count(exe_unit, elem_count);
+  mgr->allocate_output_buffers(allocated_row_count);
+  const auto num_out_columns = exe_unit.target_exprs.size();
+
+  const size_t num_slices =
+      std::max(std::min(static_cast<size_t>(cpu_threads()),
+                        elem_count / std::max(g_parallel_table_function_rows_per_thread,
+                                              size_t(1))),
+               size_t(1));
+
+  struct Slice {
+    std::vector<const int8_t*> col_buf_ptrs;
+    std::vector<int64_t> col_sizes;
+    // holds the offset column pointers of ColumnList arguments
+    std::vector<std::vector<const int8_t*>> col_lists;
+    std::vector<int64_t*> output_buffers;
+    size_t allocated_row_count{0};
+    int64_t output_row_count{0};
+  };
+  std::vector<Slice> slices;
+  slices.reserve(num_slices);
+  for (auto const& interval : makeIntervals(size_t(0), elem_count, num_slices)) {
+    slices.emplace_back();
+    auto& slice = slices.back();
+    if (num_slices == 1) {
+      // the input may be empty, elem_count is at least one
+      slice.col_buf_ptrs = col_buf_ptrs;
+      slice.col_sizes = col_sizes;
+    } else {
+      slice.col_lists.reserve(col_buf_ptrs.size());
+      for (size_t i = 0; i < col_buf_ptrs.size(); i++) {
+        const auto& ti = exe_unit.input_exprs[i]->get_type_info();
+        if (ti.is_column()) {
+          CHECK_EQ(static_cast<size_t>(col_sizes[i]), elem_count);
+          const auto elem_size = ti.get_elem_type().get_size();
+          slice.col_buf_ptrs.push_back(col_buf_ptrs[i] + interval.begin * elem_size);
+          slice.col_sizes.push_back(interval.size());
+        } else if (ti.is_column_list()) {
+          CHECK_EQ(static_cast<size_t>(col_sizes[i]), elem_count);
+          const auto elem_size = ti.get_elem_type().get_size();
+          const auto col_list = reinterpret_cast<const int8_t* const*>(col_buf_ptrs[i]);
+          slice.col_lists.emplace_back();
+          for (int j = 0; j < ti.get_dimension(); j++) {
+            slice.col_lists.back().push_back(col_list[j] + interval.begin * elem_size);
+          }
+          slice.col_buf_ptrs.push_back(
+              reinterpret_cast<const int8_t*>(slice.col_lists.back().data()));
+          slice.col_sizes.push_back(interval.size());
+        } else {
+          // scalar arguments are shared by all slices
+          slice.col_buf_ptrs.push_back(col_buf_ptrs[i]);
+          slice.col_sizes.push_back(col_sizes[i]);
+        }
+      }
+    }
+    slice.allocated_row_count = num_slices == 1
+                                    ? allocated_row_count
+                                    : get_output_row_count(exe_unit, interval.size());
+    // the output capacity of the slice, replaced by its output row count
+    slice.output_row_count = slice.allocated_row_count;
+    const auto output_offset = get_output_row_count(exe_unit, interval.begin);
+    for (size_t i = 0; i < num_out_columns; i++) {
+      slice.output_buffers.push_back(mgr->get_output_column_buffer(i) + output_offset);
+    }
+  }
+  CHECK_EQ(slices.size(), num_slices);
+
+  // execute
+  auto timer = DEBUG_TIMER(__func__);
+  const auto run_slice = [compilation_context](Slice& slice) {
+    return compilation_context->getFuncPtr()(
+        reinterpret_cast<const int8_t**>(slice.col_buf_ptrs.data()),
+        slice.col_sizes.data(),
+        slice.output_buffers.data(),
+        &slice.output_row_count);
+  };
+  std::vector<int32_t> errors(num_slices, 0);
+  if (num_slices == 1) {
+    errors[0] = run_slice(slices[0]);
+  } else {
+    std::vector<std::future<void>> slice_threads;
+    for (size_t i = 0; i < num_slices; i++) {
+      slice_threads.push_back(std::async(std::launch::async, [&, i] {
+        errors[i] = run_slice(slices[i]);
+      }));
+    }
+    for (auto& child : slice_threads) {
+      child.get();
+    }
+  }
+  for (const auto err : errors) {
+    if (err) {
+      throw std::runtime_error("Error executing table function: " +
+                               std::to_string(err));
+    }
+  }
+
+  // move the output rows of each slice right after those of the
+  // previous slice, the output columns are compacted on the way
+  auto output_buffers_ptr = mgr->get_output_column_buffer(0);
+  size_t output_row_count = 0;
+  for (auto& slice : slices) {
+    if (slice.output_row_count < 0 ||
+        static_cast<size_t>(slice.output_row_count) > slice.allocated_row_count) {
+      slice.output_row_count = slice.allocated_row_count;
+    }
+    output_row_count += slice.output_row_count;
+  }
+  for (size_t i = 0; i < num_out_columns; i++) {
+    auto dst = output_buffers_ptr + i * output_row_count;
+    for (const auto& slice : slices) {
+      const auto src = slice.output_buffers[i];
+      if (src != dst && slice.output_row_count) {
+        memmove(dst, src, slice.output_row_count * sizeof(int64_t));
+      }
+      dst += slice.output_row_count;
+    }
+  }
+  mgr->query_buffers->getResultSet(0)->updateStorageEntryCount(output_row_count);
+
+  return mgr->query_buffers->getResultSetOwned(0);
+}
+
 namespace {
 enum {
   ERROR_BUFFER,
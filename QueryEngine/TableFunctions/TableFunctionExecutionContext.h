@@ -48,6 +48,13 @@ class TableFunctionExecutionContext {
                              std::vector<int64_t>& col_sizes,
                              const size_t elem_count,
                              Executor* executor);
+  ResultSetPtr launchParallelCpuCode(
+      const TableFunctionExecutionUnit& exe_unit,
+      const TableFunctionCompilationContext* compilation_context,
+      std::vector<const int8_t*>& col_buf_ptrs,
+      std::vector<int64_t>& col_sizes,
+      const size_t elem_count,
+      Executor* executor);
   ResultSetPtr launchGpuCode(const TableFunctionExecutionUnit& exe_unit,
                              const TableFunctionCompilationContext* compilation_context,
                              std::vector<const int8_t*>& col_buf_ptrs,
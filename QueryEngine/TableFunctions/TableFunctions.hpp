@@ -18,7 +18,7 @@
 #include "../../Shared/funcannotations.h"
 
 /*
-  UDTF: row_copier(Column<double>, RowMultiplier) -> Column<double>
+  UDTF: row_copier(Column<double>, RowMultiplier) -> Column<double> | parallel
 */
 EXTENSION_NOINLINE int32_t row_copier(const Column<double>& input_col,
                                       int copy_multiplier,
@@ -51,9 +51,11 @@ EXTENSION_NOINLINE int32_t row_copier(const Column<double>& input_col,
   return output_row_count;
 }
 
+// clang-format off
 /*
-  UDTF: row_adder(RowMultiplier<1>, Cursor<ColumnDouble, ColumnDouble>) -> ColumnDouble
+  UDTF: row_adder(RowMultiplier<1>, Cursor<ColumnDouble, ColumnDouble>) -> ColumnDouble | parallel
 */
+// clang-format on
 EXTENSION_NOINLINE int32_t row_adder(const int copy_multiplier,
                                      const Column<double>& input_col1,
                                      const Column<double>& input_col2,
@@ -92,7 +94,7 @@ EXTENSION_NOINLINE int32_t row_adder(const int copy_multiplier,
 
 // clang-format off
 /*
-  UDTF: row_addsub(RowMultiplier, Cursor<double, double>) -> Column<double>, Column<double>
+  UDTF: row_addsub(RowMultiplier, Cursor<double, double>) -> Column<double>, Column<double> | parallel
 */
 // clang-format on
 EXTENSION_NOINLINE int32_t row_addsub(const int copy_multiplier,
@@ -167,7 +169,7 @@ EXTENSION_NOINLINE int32_t get_max_with_row_offset(const Column<int>& input_col,
 
 // clang-format off
 /*
-  UDTF: column_list_get__cpu_(ColumnList<double>, int, RowMultiplier) -> Column<double>
+  UDTF: column_list_get__cpu_(ColumnList<double>, int, RowMultiplier) -> Column<double> | parallel
 */
 // clang-format on
 EXTENSION_NOINLINE int32_t column_list_get__cpu_(const ColumnList<double>& col_list,
@@ -181,7 +183,7 @@ EXTENSION_NOINLINE int32_t column_list_get__cpu_(const ColumnList<double>& col_l
 // clang-format off
 /*
   UDTF: column_list_first_last(ColumnList<double>, RowMultiplier) -> Column<double>,
-  Column<double>
+  Column<double> | parallel
 */
 // clang-format on
 EXTENSION_NOINLINE int32_t column_list_first_last(const ColumnList<double>& col_list,
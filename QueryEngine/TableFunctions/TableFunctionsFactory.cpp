@@ -198,8 +198,10 @@ void TableFunctionsFactory::add(const std::string& name,
                                 const std::vector<ExtArgumentType>& input_args,
                                 const std::vector<ExtArgumentType>& output_args,
                                 const std::vector<ExtArgumentType>& sql_args,
-                                bool is_runtime) {
-  auto tf = TableFunction(name, sizer, input_args, output_args, sql_args, is_runtime);
+                                bool is_runtime,
+                                bool is_parallel) {
+  auto tf = TableFunction(
+      name, sizer, input_args, output_args, sql_args, is_runtime, is_parallel);
   auto sig = tf.getSignature();
   for (auto it = functions_.begin(); it != functions_.end();) {
     if (it->second.getName() == name) {
@@ -238,7 +240,8 @@ void TableFunctionsFactory::add(const std::string& name,
                              input_args2,
                              output_args,
                              sql_args2,
-                             is_runtime);
+                             is_runtime,
+                             is_parallel);
     auto sig = tf2.getSignature();
     for (auto it = functions_.begin(); it != functions_.end();) {
       if (sig == it->second.getSignature() &&
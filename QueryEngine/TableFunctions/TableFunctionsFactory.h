@@ -127,13 +127,21 @@ class TableFunction {
                 const std::vector<ExtArgumentType>& input_args,
                 const std::vector<ExtArgumentType>& output_args,
                 const std::vector<ExtArgumentType>& sql_args,
-                bool is_runtime)
+                bool is_runtime,
+                bool is_parallel = false)
       : name_(name)
       , output_sizer_(output_sizer)
       , input_args_(input_args)
       , output_args_(output_args)
       , sql_args_(sql_args)
-      , is_runtime_(is_runtime) {}
+      , is_runtime_(is_runtime)
+      , is_parallel_(is_parallel) {
+    if (is_parallel_ &&
+        output_sizer_.type != OutputBufferSizeType::kUserSpecifiedRowMultiplier) {
+      throw std::runtime_error("Parallel table function " + name_ +
+                               " must use a RowMultiplier sizer");
+    }
+  }
 
   std::vector<ExtArgumentType> getArgs(const bool ensure_column = false) const {
     std::vector<ExtArgumentType> args;
@@ -214,6 +222,16 @@ class TableFunction {
 
   bool isRuntime() const { return is_runtime_; }
 
+  /*
+    A parallel table function computes the output rows of any
+    contiguous slice of its input rows from that slice alone. On CPU,
+    the input rows are split across threads and every thread runs the
+    function on its slice, writing to its own part of the output
+    buffers, see TableFunctionExecutionContext::launchCpuCode. Scalar
+    arguments are passed unchanged to every slice.
+  */
+  bool isParallel() const { return is_parallel_; }
+
   inline bool isGPU() const {
     return (name_.find("_cpu_", name_.find("__")) == std::string::npos);
   }
@@ -235,6 +253,7 @@ class TableFunction {
     result += "], sql_args=[";
     result += ExtensionFunctionsWhitelist::toString(sql_args_);
     result += "], is_runtime=" + std::string((is_runtime_ ? "true" : "false"));
+    result += ", is_parallel=" + std::string((is_parallel_ ? "true" : "false"));
     result += ", sizer=" + ::toString(output_sizer_);
     result += ")";
     return result;
@@ -256,6 +275,7 @@ class TableFunction {
   const std::vector<ExtArgumentType> output_args_;
   const std::vector<ExtArgumentType> sql_args_;
   const bool is_runtime_;
+  const bool is_parallel_;
 };
 
 class TableFunctionsFactory {
@@ -265,7 +285,8 @@ class TableFunctionsFactory {
                   const std::vector<ExtArgumentType>& input_args,
                   const std::vector<ExtArgumentType>& output_args,
                   const std::vector<ExtArgumentType>& sql_args,
-                  bool is_runtime = false);
+                  bool is_runtime = false,
+                  bool is_parallel = false);
 
   static std::vector<TableFunction> get_table_funcs(const std::string& name,
                                                     const bool is_gpu);
@@ -373,3 +373,35 @@ EXTENSION_NOINLINE int32_t ct_udtf_default_sizer4b__cpu_2(const int32_t multipli
   out[0] = 1000 + 99 + 9 * multiplier + x;
   return 1;
 }
+
+/*
+ Test function for parallel execution: returns fewer rows than allocated
+ so that the output slices of the threads must be moved together.
+*/
+
+// clang-format off
+/*
+  UDTF: ct_parallel_filter__cpu_(Cursor<int64_t, ColumnList<int64_t>>, int32_t, RowMultiplier) -> Column<int64_t>, Column<int64_t> | parallel
+*/
+// clang-format on
+EXTENSION_NOINLINE int32_t ct_parallel_filter__cpu_(const Column<int64_t>& input1,
+                                                    const ColumnList<int64_t>& input2,
+                                                    const int32_t threshold,
+                                                    const int32_t multiplier,
+                                                    Column<int64_t>& out0,
+                                                    Column<int64_t>& out1) {
+  int32_t output_row_count = 0;
+  for (int64_t i = 0; i < input1.size(); i++) {
+    if (input1[i] < threshold) {
+      continue;
+    }
+    int64_t sum = input1[i];
+    for (int j = 0; j < input2.numCols(); j++) {
+      sum += input2[j][i];
+    }
+    out0[output_row_count] = input1[i];
+    out1[output_row_count] = sum;
+    output_row_count++;
+  }
+  return output_row_count;
+}
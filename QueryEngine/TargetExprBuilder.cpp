@@ -438,8 +438,10 @@ void TargetExprCodegen::codegenAggregate(
         agg_args.push_back(null_lv);
       }
       if (!target_info.is_distinct) {
-        if (co.device_type == ExecutorDeviceType::GPU &&
-            query_mem_desc.threadsShareMemory()) {
+        if ((co.device_type == ExecutorDeviceType::GPU &&
+             query_mem_desc.threadsShareMemory()) ||
+            (co.device_type == ExecutorDeviceType::CPU &&
+             query_mem_desc.kernelsShareMemory())) {
           agg_fname += "_shared";
           if (needs_unnest_double_patch) {
             agg_fname = patch_agg_fname(agg_fname);
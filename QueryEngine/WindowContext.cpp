@@ -16,6 +16,7 @@
 
 #include "QueryEngine/WindowContext.h"
 
+#include <algorithm>
 #include <numeric>
 
 #include "QueryEngine/Descriptors/CountDistinctDescriptor.h"
@@ -24,8 +25,19 @@
 #include "QueryEngine/ResultSetBufferAccessors.h"
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryEngine/TypePunning.h"
+#include "Shared/Intervals.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/funcannotations.h"
+#include "Shared/thread_count.h"
+#include "Shared/threadpool.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+extern bool g_enable_parallel_window_partition_compute;
+extern size_t g_parallel_window_partition_compute_threshold;
+extern size_t g_parallel_window_partition_sort_threshold;
 
 WindowFunctionContext::WindowFunctionContext(
     const Analyzer::WindowFunction* window_func,
@@ -267,20 +279,31 @@ void apply_last_value_to_partition(const int32_t* original_indices,
       original_indices, original_indices + partition_size, output_for_partition_buff);
 }
 
+// Partitions are computed concurrently and the ones next to each other can share a byte
+// of the bitmap, hence the atomic update.
+void set_partition_end_bit(const int8_t* partition_end, const int64_t pos) {
+  auto byte_ptr = const_cast<int8_t*>(partition_end) + (pos >> 3);
+  const int8_t mask = 1 << (pos & 7);
+#ifdef _MSC_VER
+  _InterlockedOr8(reinterpret_cast<volatile char*>(byte_ptr), mask);
+#else
+  __sync_fetch_and_or(byte_ptr, mask);
+#endif
+}
+
 void index_to_partition_end(
     const int8_t* partition_end,
     const size_t off,
     const int64_t* index,
     const size_t index_size,
     const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator) {
-  int64_t partition_end_handle = reinterpret_cast<int64_t>(partition_end);
   for (size_t i = 0; i < index_size; ++i) {
     if (advance_current_rank(comparator, index, i)) {
-      agg_count_distinct_bitmap(&partition_end_handle, off + i - 1, 0);
+      set_partition_end_bit(partition_end, off + i - 1);
     }
   }
   CHECK(index_size);
-  agg_count_distinct_bitmap(&partition_end_handle, off + index_size - 1, 0);
+  set_partition_end_bit(partition_end, off + index_size - 1);
 }
 
 bool pos_is_set(const int64_t bitset, const int64_t pos) {
@@ -403,6 +426,46 @@ bool window_function_requires_peer_handling(const Analyzer::WindowFunction* wind
   }
 }
 
+namespace {
+
+// Sorts chunks of the range on separate threads and merges them pairwise, also in
+// parallel, until the whole range is sorted.
+template <class Comparator>
+void parallel_sort(int64_t* begin,
+                   int64_t* end,
+                   const Comparator& comparator,
+                   const size_t thread_count) {
+  const size_t size = end - begin;
+  std::vector<size_t> bounds;
+  threadpool::FuturesThreadPool<void> sort_threads;
+  for (auto interval : makeIntervals<size_t>(0, size, thread_count)) {
+    bounds.push_back(interval.begin);
+    sort_threads.spawn([begin, interval, &comparator] {
+      std::sort(begin + interval.begin, begin + interval.end, comparator);
+    });
+  }
+  bounds.push_back(size);
+  sort_threads.join();
+  while (bounds.size() > 2) {
+    std::vector<size_t> merged_bounds;
+    threadpool::FuturesThreadPool<void> merge_threads;
+    for (size_t i = 0; i + 1 < bounds.size(); i += 2) {
+      merged_bounds.push_back(bounds[i]);
+      if (i + 2 < bounds.size()) {
+        merge_threads.spawn([begin, first = bounds[i], middle = bounds[i + 1],
+                             last = bounds[i + 2], &comparator] {
+          std::inplace_merge(begin + first, begin + middle, begin + last, comparator);
+        });
+      }
+    }
+    merged_bounds.push_back(size);
+    merge_threads.join();
+    bounds.swap(merged_bounds);
+  }
+}
+
+}  // namespace
+
 void WindowFunctionContext::compute() {
   CHECK(!output_);
   output_ = static_cast<int8_t*>(row_set_mem_owner_->allocate(
@@ -415,11 +478,23 @@ void WindowFunctionContext::compute() {
     }
   }
   std::unique_ptr<int64_t[]> scratchpad(new int64_t[elem_count_]);
+  const size_t partition_count = partitionCount();
+  // value and aggregate functions address their partition's rows by this offset
+  std::vector<int64_t> partition_offsets(partition_count);
   int64_t off = 0;
-  for (size_t i = 0; i < partitionCount(); ++i) {
+  for (size_t i = 0; i < partition_count; ++i) {
+    partition_offsets[i] = off;
+    off += counts()[i];
+  }
+  if (window_function_is_value(window_func_->getKind()) ||
+      window_function_is_aggregate(window_func_->getKind())) {
+    CHECK_EQ(static_cast<size_t>(off), elem_count_);
+  }
+  const auto compute_partition = [this, &scratchpad, &partition_offsets](
+                                     const size_t i, const size_t sort_thread_count) {
     auto partition_size = counts()[i];
     if (partition_size == 0) {
-      continue;
+      return;
     }
     auto output_for_partition_buff = scratchpad.get() + offsets()[i];
     std::iota(output_for_partition_buff,
@@ -457,22 +532,77 @@ void WindowFunctionContext::compute() {
       }
       return false;
     };
-    std::sort(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              col_tuple_comparator);
+    if (sort_thread_count > 1) {
+      parallel_sort(output_for_partition_buff,
+                    output_for_partition_buff + partition_size,
+                    col_tuple_comparator,
+                    sort_thread_count);
+    } else {
+      std::sort(output_for_partition_buff,
+                output_for_partition_buff + partition_size,
+                col_tuple_comparator);
+    }
     computePartition(output_for_partition_buff,
                      partition_size,
-                     off,
+                     partition_offsets[i],
                      window_func_,
                      col_tuple_comparator);
-    if (window_function_is_value(window_func_->getKind()) ||
-        window_function_is_aggregate(window_func_->getKind())) {
-      off += partition_size;
+  };
+  const size_t thread_count = cpu_threads();
+  if (!g_enable_parallel_window_partition_compute ||
+      elem_count_ < g_parallel_window_partition_compute_threshold || thread_count < 2) {
+    for (size_t i = 0; i < partition_count; ++i) {
+      compute_partition(i, 1);
+    }
+  } else {
+    // Partitions big enough to keep all threads busy are sorted in parallel, one at a
+    // time. The others are split into contiguous groups of about the same number of
+    // rows, one group per thread.
+    std::vector<size_t> large_partitions;
+    size_t small_partitions_elem_count{0};
+    for (size_t i = 0; i < partition_count; ++i) {
+      if (static_cast<size_t>(counts()[i]) >= g_parallel_window_partition_sort_threshold) {
+        large_partitions.push_back(i);
+      } else {
+        small_partitions_elem_count += counts()[i];
+      }
+    }
+    if (small_partitions_elem_count) {
+      const size_t group_elem_count =
+          (small_partitions_elem_count + thread_count - 1) / thread_count;
+      threadpool::FuturesThreadPool<void> compute_threads;
+      std::vector<size_t> group;
+      size_t group_size{0};
+      const auto spawn_group = [&compute_threads, &compute_partition](
+                                   std::vector<size_t> partitions) {
+        compute_threads.spawn([partitions = std::move(partitions), &compute_partition] {
+          for (const auto i : partitions) {
+            compute_partition(i, 1);
+          }
+        });
+      };
+      for (size_t i = 0; i < partition_count; ++i) {
+        const size_t partition_size = counts()[i];
+        if (!partition_size ||
+            partition_size >= g_parallel_window_partition_sort_threshold) {
+          continue;
+        }
+        group.push_back(i);
+        group_size += partition_size;
+        if (group_size >= group_elem_count) {
+          spawn_group(std::move(group));
+          group.clear();
+          group_size = 0;
+        }
+      }
+      if (!group.empty()) {
+        spawn_group(std::move(group));
+      }
+      compute_threads.join();
+    }
+    for (const auto i : large_partitions) {
+      compute_partition(i, thread_count);
     }
-  }
-  if (window_function_is_value(window_func_->getKind()) ||
-      window_function_is_aggregate(window_func_->getKind())) {
-    CHECK_EQ(static_cast<size_t>(off), elem_count_);
   }
   auto output_i64 = reinterpret_cast<int64_t*>(output_);
   if (window_function_is_aggregate(window_func_->getKind())) {
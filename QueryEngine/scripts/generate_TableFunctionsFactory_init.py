@@ -30,6 +30,13 @@ In addition, the following equivalents are suppored:
   T == ColumnT for output column types
   RowMultiplier == RowMultiplier<i> where i is the one-based position of the sizer argument
   when no sizer argument is provided, Constant<1> is assumed
+
+A UDTF that uses a RowMultiplier sizer and whose output rows for any
+contiguous slice of the input rows depend only on that slice can be
+marked for multi-threaded CPU execution by appending `| parallel` to
+its specification:
+
+  UDTF: function_name(<arguments>) -> <output column types> | parallel
 """
 # Author: Pearu Peterson
 # Created: January 2021
@@ -134,6 +141,9 @@ for input_file in sys.argv[1:-1]:
             continue
         last_line = None
         line = line[5:]
+        is_parallel = line.endswith('|parallel')
+        if is_parallel:
+            line = line[:-len('|parallel')]
         i = line.find('(')
         j = line.find(')')
         if i == -1 or j == -1:
@@ -213,10 +223,16 @@ for input_file in sys.argv[1:-1]:
         if sizer is None:
             sizer = 'TableFunctionOutputRowSizer{OutputBufferSizeType::kTableFunctionSpecifiedParameter, 1}'
 
+        if is_parallel:
+            assert 'kUserSpecifiedRowMultiplier' in sizer, 'Parallel UDTF requires a RowMultiplier sizer: `%s`' % (line)
+
         input_types = 'std::vector<ExtArgumentType>{%s}' % (', '.join(input_types))
         output_types = 'std::vector<ExtArgumentType>{%s}' % (', '.join(output_types))
         sql_types = 'std::vector<ExtArgumentType>{%s}' % (', '.join(sql_types)) 
-        add = 'TableFunctionsFactory::add("%s", %s, %s, %s, %s);' % (name, sizer, input_types, output_types, sql_types)
+        if is_parallel:
+            add = 'TableFunctionsFactory::add("%s", %s, %s, %s, %s, /*is_runtime=*/false, /*is_parallel=*/true);' % (name, sizer, input_types, output_types, sql_types)
+        else:
+            add = 'TableFunctionsFactory::add("%s", %s, %s, %s, %s);' % (name, sizer, input_types, output_types, sql_types)
         add_stmts.append(add)
 
 content = '''
@@ -149,6 +149,12 @@ inline int64_t inline_fixed_encoding_null_val(const SQL_TYPE_INFO& ti) {
   if (ti.get_compression() == kENCODING_NONE) {
     return inline_int_null_val(ti);
   }
+  if (ti.get_compression() == kENCODING_RL || ti.get_compression() == kENCODING_DIFF) {
+    // run length and differential encoded chunks decode to the logical values
+    auto logical_ti = ti;
+    logical_ti.set_compression(kENCODING_NONE);
+    return inline_int_null_val(logical_ti);
+  }
   if (ti.get_compression() == kENCODING_DATE_IN_DAYS) {
     switch (ti.get_comp_param()) {
       case 0:
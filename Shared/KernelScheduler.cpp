@@ -0,0 +1,183 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/KernelScheduler.h"
+
+#include <algorithm>
+
+#include "Logger/Logger.h"
+#include "Shared/thread_count.h"
+
+namespace threadpool {
+
+KernelScheduler::TaskGroup::TaskGroup(KernelScheduler* scheduler,
+                                      const size_t priority,
+                                      const size_t max_parallelism)
+    : scheduler_(scheduler)
+    , priority_(std::max(priority, size_t(1)))
+    , max_parallelism_(max_parallelism) {
+  CHECK(scheduler_);
+}
+
+void KernelScheduler::TaskGroup::spawn(Task task) {
+  {
+    std::lock_guard<std::mutex> lock(scheduler_->mutex_);
+    if (error_) {
+      // the group already failed, no point in running more of its work
+      return;
+    }
+    pending_.push_back(std::move(task));
+    if (!active_) {
+      scheduler_->activateLocked(shared_from_this());
+    }
+  }
+  scheduler_->work_cv_.notify_one();
+}
+
+void KernelScheduler::TaskGroup::wait() {
+  auto self = shared_from_this();
+  std::unique_lock<std::mutex> lock(scheduler_->mutex_);
+  while (true) {
+    if (canRunLocked()) {
+      scheduler_->runTaskLocked(lock, self);
+      continue;
+    }
+    if (pending_.empty() && running_ == 0) {
+      break;
+    }
+    done_cv_.wait(lock);
+  }
+  if (error_) {
+    auto error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+KernelScheduler::KernelScheduler(const size_t num_workers) {
+  CHECK_GT(num_workers, size_t(0));
+  workers_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_.emplace_back(&KernelScheduler::worker, this);
+  }
+}
+
+KernelScheduler::~KernelScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    should_exit_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+KernelScheduler& KernelScheduler::instance() {
+  static KernelScheduler scheduler(static_cast<size_t>(cpu_threads()));
+  return scheduler;
+}
+
+std::shared_ptr<KernelScheduler::TaskGroup> KernelScheduler::createTaskGroup(
+    const size_t priority,
+    const size_t max_parallelism) {
+  return std::make_shared<TaskGroup>(this, priority, max_parallelism);
+}
+
+void KernelScheduler::worker() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    std::shared_ptr<TaskGroup> group;
+    work_cv_.wait(lock, [this, &group] {
+      if (should_exit_) {
+        return true;
+      }
+      group = pickGroupLocked();
+      return group != nullptr;
+    });
+    if (should_exit_) {
+      return;
+    }
+    runTaskLocked(lock, group);
+  }
+}
+
+std::shared_ptr<KernelScheduler::TaskGroup> KernelScheduler::pickGroupLocked() {
+  std::shared_ptr<TaskGroup> best;
+  for (const auto& group : active_groups_) {
+    if (group->canRunLocked() && (!best || group->pass_ < best->pass_)) {
+      best = group;
+    }
+  }
+  return best;
+}
+
+void KernelScheduler::runTaskLocked(std::unique_lock<std::mutex>& lock,
+                                    const std::shared_ptr<TaskGroup>& group) {
+  CHECK(group->canRunLocked());
+  auto task = std::move(group->pending_.front());
+  group->pending_.pop_front();
+  ++group->running_;
+  group->pass_ += 1.0 / group->priority_;
+  virtual_time_ = std::max(virtual_time_, group->pass_);
+  if (group->pending_.empty()) {
+    deactivateLocked(group.get());
+  }
+
+  lock.unlock();
+  std::exception_ptr error;
+  try {
+    task();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  lock.lock();
+
+  if (error && !group->error_) {
+    group->error_ = error;
+    group->pending_.clear();
+    deactivateLocked(group.get());
+  }
+  --group->running_;
+  // wakes the waiter either to finish or to run a task freed up by the parallelism cap
+  group->done_cv_.notify_all();
+  if (group->canRunLocked()) {
+    work_cv_.notify_one();
+  }
+}
+
+void KernelScheduler::activateLocked(const std::shared_ptr<TaskGroup>& group) {
+  CHECK(!group->active_);
+  // a group returning from idle must not claim the workers until it catches up with the
+  // service the others have received in the meantime
+  group->pass_ = std::max(group->pass_, virtual_time_);
+  group->active_ = true;
+  active_groups_.push_back(group);
+}
+
+void KernelScheduler::deactivateLocked(TaskGroup* group) {
+  if (!group->active_) {
+    return;
+  }
+  group->active_ = false;
+  active_groups_.erase(
+      std::remove_if(active_groups_.begin(),
+                     active_groups_.end(),
+                     [group](const auto& active_group) { return active_group.get() == group; }),
+      active_groups_.end());
+}
+
+}  // namespace threadpool
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace threadpool {
+
+/**
+ * Process-wide scheduler for execution kernels. Every query submits its kernels into its
+ * own TaskGroup and all groups are served by a single set of worker threads. An idle
+ * worker takes the next task from the runnable group which has received the least
+ * service relative to its priority (stride scheduling), so concurrent queries share the
+ * cores fairly instead of serializing behind one another. A group may also cap the
+ * number of its tasks running at once. The thread waiting on a group helps execute that
+ * group's pending tasks rather than blocking.
+ */
+class KernelScheduler {
+ public:
+  using Task = std::function<void()>;
+
+  class TaskGroup : public std::enable_shared_from_this<TaskGroup> {
+   public:
+    TaskGroup(KernelScheduler* scheduler,
+              const size_t priority,
+              const size_t max_parallelism);
+
+    void spawn(Task task);
+
+    /**
+     * Blocks until every task spawned into the group has finished, running pending tasks
+     * on the calling thread while it waits. Rethrows the first exception raised by a task
+     * of this group; tasks still pending after a failure are discarded.
+     */
+    void wait();
+
+    size_t getPriority() const { return priority_; }
+    size_t getMaxParallelism() const { return max_parallelism_; }
+
+   private:
+    bool canRunLocked() const {
+      return !pending_.empty() && (!max_parallelism_ || running_ < max_parallelism_);
+    }
+
+    KernelScheduler* scheduler_;
+    const size_t priority_;
+    const size_t max_parallelism_;
+
+    // all members below are guarded by the scheduler mutex
+    std::deque<Task> pending_;
+    size_t running_{0};
+    double pass_{0};
+    bool active_{false};
+    std::exception_ptr error_;
+    std::condition_variable done_cv_;
+
+    friend class KernelScheduler;
+  };
+
+  explicit KernelScheduler(const size_t num_workers);
+
+  ~KernelScheduler();
+
+  /**
+   * Returns the shared scheduler, sized with `cpu_threads()` workers on first use.
+   */
+  static KernelScheduler& instance();
+
+  /**
+   * Creates a task group. A higher priority gets a proportionally larger share of the
+   * workers when several groups are runnable; a `max_parallelism` of 0 means the group is
+   * only bounded by the number of workers.
+   */
+  std::shared_ptr<TaskGroup> createTaskGroup(const size_t priority = 1,
+                                             const size_t max_parallelism = 0);
+
+  size_t getWorkerCount() const { return workers_.size(); }
+
+ private:
+  void worker();
+
+  std::shared_ptr<TaskGroup> pickGroupLocked();
+
+  void runTaskLocked(std::unique_lock<std::mutex>& lock,
+                     const std::shared_ptr<TaskGroup>& group);
+
+  void activateLocked(const std::shared_ptr<TaskGroup>& group);
+
+  void deactivateLocked(TaskGroup* group);
+
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::vector<std::shared_ptr<TaskGroup>> active_groups_;
+  // virtual time of the last dispatched task, used to start newly active groups
+  double virtual_time_{0};
+  bool should_exit_{false};
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace threadpool
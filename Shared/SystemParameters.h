@@ -71,6 +71,7 @@ struct SystemParameters {
   size_t calcite_timeout =
       5000;  // calcite send/receive timeout (connect timeout hard coded to 2s)
   size_t calcite_keepalive = false;  // calcite keepalive connection
+  size_t calcite_plan_cache_size = 0;  // number of query plans cached, 0 to disable
   int num_executors = 1;
   int num_sessions = -1;  // maximum number of user sessions
 
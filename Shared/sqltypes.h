@@ -776,7 +776,8 @@ class SQLTypeInfo {
             return comp_param / 8;
           case kENCODING_RL:
           case kENCODING_DIFF:
-            break;
+            // logical size, the chunks are stored compressed
+            return sizeof(int16_t);
           default:
             assert(false);
         }
@@ -791,7 +792,8 @@ class SQLTypeInfo {
             return comp_param / 8;
           case kENCODING_RL:
           case kENCODING_DIFF:
-            break;
+            // logical size, the chunks are stored compressed
+            return sizeof(int32_t);
           default:
             assert(false);
         }
@@ -807,7 +809,8 @@ class SQLTypeInfo {
             return comp_param / 8;
           case kENCODING_RL:
           case kENCODING_DIFF:
-            break;
+            // logical size, the chunks are stored compressed
+            return sizeof(int64_t);
           default:
             assert(false);
         }
@@ -855,6 +858,7 @@ class SQLTypeInfo {
             return comp_param / 8;
           case kENCODING_RL:
           case kENCODING_DIFF:
+            return sizeof(int64_t);
           case kENCODING_SPARSE:
             assert(false);
             break;
@@ -916,7 +920,8 @@ int64_t convert_decimal_value_to_scale(const int64_t decimal_value,
 
 inline SQLTypeInfo get_logical_type_info(const SQLTypeInfo& type_info) {
   EncodingType encoding = type_info.get_compression();
-  if (encoding == kENCODING_DATE_IN_DAYS ||
+  if (encoding == kENCODING_DATE_IN_DAYS || encoding == kENCODING_RL ||
+      encoding == kENCODING_DIFF ||
       (encoding == kENCODING_FIXED && type_info.get_type() != kARRAY)) {
     encoding = kENCODING_NONE;
   }
@@ -18,9 +18,12 @@
 #define DICTIONARY_CACHE_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <list>
+#include <map>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 template <typename key_t, typename value_t>
 class DictionaryCache {
@@ -57,4 +60,68 @@ class DictionaryCache {
   std::unordered_map<key_t, std::shared_ptr<value_t>> cache_items;
 };
 
+/**
+ * LRU cache of the ids of the strings matching a pattern, bounded by the bytes taken by
+ * the ids. Not thread safe.
+ */
+template <typename key_t>
+class StringIdsCache {
+ public:
+  StringIdsCache(const size_t max_bytes) : max_bytes_(max_bytes) {}
+
+  const std::vector<int32_t>* get(const key_t& key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return &it->second->second;
+  }
+
+  void put(const key_t& key, const std::vector<int32_t>& ids) {
+    const auto it = index_.find(key);
+    if (it != index_.end()) {
+      evict(it->second);
+    }
+    const auto entry_bytes = getEntryBytes(ids);
+    if (entry_bytes > max_bytes_) {
+      return;
+    }
+    while (bytes_ + entry_bytes > max_bytes_) {
+      evict(std::prev(entries_.end()));
+    }
+    entries_.emplace_front(key, ids);
+    index_.emplace(key, entries_.begin());
+    bytes_ += entry_bytes;
+  }
+
+  bool empty() const { return entries_.empty(); }
+
+  size_t bytes() const { return bytes_; }
+
+  void clear() {
+    entries_.clear();
+    index_.clear();
+    bytes_ = 0;
+  }
+
+ private:
+  using entry_list_t = std::list<std::pair<key_t, std::vector<int32_t>>>;
+
+  static size_t getEntryBytes(const std::vector<int32_t>& ids) {
+    return sizeof(typename entry_list_t::value_type) + ids.size() * sizeof(int32_t);
+  }
+
+  void evict(typename entry_list_t::iterator entry_it) {
+    bytes_ -= getEntryBytes(entry_it->second);
+    index_.erase(entry_it->first);
+    entries_.erase(entry_it);
+  }
+
+  const size_t max_bytes_;
+  size_t bytes_{0};
+  entry_list_t entries_;
+  std::map<key_t, typename entry_list_t::iterator> index_;
+};
+
 #endif  // DICTIONARY_CACHE_HPP
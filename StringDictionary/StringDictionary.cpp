@@ -20,6 +20,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/sort/spreadsort/string_sort.hpp>
+#include <fstream>
 #include <future>
 #include <iostream>
 #include <string_view>
@@ -36,6 +37,7 @@
 #include "OSDependent/omnisci_fs.h"
 #include "Shared/sqltypes.h"
 #include "Shared/thread_count.h"
+#include "StringDictionary/TrigramIndex.h"
 #include "StringDictionaryClient.h"
 #include "Utils/Regexp.h"
 #include "Utils/StringLike.h"
@@ -85,9 +87,25 @@ string_dict_hash_t hash_string(const std::string_view& str) {
   }
   return str_hash;
 }
+
+constexpr uint64_t kHashTableFileVersion{1};
+
+// Header of the persisted hash table, followed by the table and the hashes of the
+// strings if they're materialized. The string count and payload size it was written
+// at tell whether the storage has grown since.
+struct HashTableFileHeader {
+  uint64_t version;
+  uint64_t str_count;
+  uint64_t payload_size;
+  uint64_t hash_table_size;
+  uint64_t hash_cache_size;
+};
 }  // namespace
 
 bool g_enable_stringdict_parallel{false};
+bool g_enable_stringdict_trigram_index{false};
+bool g_enable_stringdict_hash_table_persistence{true};
+size_t g_stringdict_pattern_cache_max_bytes{size_t(64) << 20};
 constexpr int32_t StringDictionary::INVALID_STR_ID;
 constexpr size_t StringDictionary::MAX_STRLEN;
 constexpr size_t StringDictionary::MAX_STRCOUNT;
@@ -126,6 +144,13 @@ StringDictionary::StringDictionary(const std::string& folder,
     offset_fd_ = checked_open(offsets_path_.c_str(), recover);
     payload_file_size_ = omnisci::file_size(payload_fd_);
     offset_file_size_ = omnisci::file_size(offset_fd_);
+    hash_table_path_ = (storage_path / boost::filesystem::path("DictHashTable")).string();
+    if (!recover) {
+      // the storage was just truncated, the hash table of its previous strings could
+      // match a dictionary grown again to the same size
+      boost::system::error_code ec;
+      boost::filesystem::remove(hash_table_path_, ec);
+    }
   }
   bool storage_is_empty = false;
   if (payload_file_size_ == 0) {
@@ -148,6 +173,11 @@ StringDictionary::StringDictionary(const std::string& folder,
       const uint64_t str_count =
           storage_is_empty ? 0 : getNumStringsFromStorage(bytes / sizeof(StringIdxEntry));
       collisions_ = 0;
+      if (str_count != 0 && loadHashTable(str_count)) {
+        VLOG(1) << "Loaded string dictionary " << folder << " # Strings: " << str_count_
+                << " Hash table size: " << string_id_string_dict_hash_table_.size();
+        return;
+      }
       // at this point we know the size of the StringDict we need to load
       // so lets reallocate the vector to the correct size
       const uint64_t max_entries =
@@ -231,6 +261,78 @@ void StringDictionary::processDictionaryFutures(
   dictionary_futures.clear();
 }
 
+bool StringDictionary::loadHashTable(const size_t str_count) {
+  std::ifstream hash_table_file(hash_table_path_, std::ios::binary);
+  if (!hash_table_file) {
+    return false;
+  }
+  const auto last_str = getStringFromStorage(str_count - 1);
+  CHECK(!last_str.canary);
+  const uint64_t payload_size = (last_str.c_str_ptr - payload_map_) + last_str.size;
+  HashTableFileHeader header;
+  if (!hash_table_file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      header.version != kHashTableFileVersion || header.str_count != str_count ||
+      header.payload_size != payload_size ||
+      (header.hash_table_size & (header.hash_table_size - 1)) != 0 ||
+      header.hash_table_size <= 2 * str_count ||
+      (materialize_hashes_ && header.hash_cache_size != str_count)) {
+    LOG(INFO) << "Persisted hash table of string dictionary " << folder_
+              << " is stale, rebuilding it";
+    return false;
+  }
+  std::vector<int32_t> hash_table(header.hash_table_size);
+  hash_table_file.read(reinterpret_cast<char*>(hash_table.data()),
+                       hash_table.size() * sizeof(int32_t));
+  std::vector<string_dict_hash_t> hash_cache;
+  if (materialize_hashes_) {
+    hash_cache.resize(hash_table.size() / 2);
+    hash_table_file.read(reinterpret_cast<char*>(hash_cache.data()),
+                         str_count * sizeof(string_dict_hash_t));
+  }
+  if (!hash_table_file) {
+    LOG(WARNING) << "Persisted hash table of string dictionary " << folder_
+                 << " is truncated, rebuilding it";
+    return false;
+  }
+  string_id_string_dict_hash_table_.swap(hash_table);
+  hash_cache_.swap(hash_cache);
+  str_count_ = str_count;
+  payload_file_off_ = payload_size;
+  persisted_hash_table_str_count_ = str_count;
+  return true;
+}
+
+void StringDictionary::persistHashTable() const noexcept {
+  const auto tmp_path = hash_table_path_ + ".tmp";
+  const HashTableFileHeader header{kHashTableFileVersion,
+                                   str_count_,
+                                   payload_file_off_,
+                                   string_id_string_dict_hash_table_.size(),
+                                   materialize_hashes_ ? str_count_ : 0};
+  std::ofstream hash_table_file(tmp_path, std::ios::binary | std::ios::trunc);
+  hash_table_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  hash_table_file.write(
+      reinterpret_cast<const char*>(string_id_string_dict_hash_table_.data()),
+      string_id_string_dict_hash_table_.size() * sizeof(int32_t));
+  if (materialize_hashes_) {
+    hash_table_file.write(reinterpret_cast<const char*>(hash_cache_.data()),
+                          str_count_ * sizeof(string_dict_hash_t));
+  }
+  hash_table_file.close();
+  boost::system::error_code ec;
+  if (!hash_table_file) {
+    LOG(WARNING) << "Could not persist the hash table of string dictionary " << folder_;
+    boost::filesystem::remove(tmp_path, ec);
+    return;
+  }
+  // a crash while writing leaves the previous table in place
+  boost::filesystem::rename(tmp_path, hash_table_path_, ec);
+  if (ec) {
+    LOG(WARNING) << "Could not persist the hash table of string dictionary " << folder_
+                 << ": " << ec.message();
+  }
+}
+
 /**
  * Method to retrieve number of strings in storage via a binary search for the first
  * canary
@@ -276,6 +378,10 @@ StringDictionary::~StringDictionary() noexcept {
   if (payload_map_) {
     if (!isTemp_) {
       CHECK(offset_map_);
+      if (g_enable_stringdict_hash_table_persistence &&
+          str_count_ != persisted_hash_table_str_count_) {
+        persistHashTable();
+      }
       omnisci::checked_munmap(payload_map_, payload_file_size_);
       omnisci::checked_munmap(offset_map_, offset_file_size_);
       CHECK_GE(payload_fd_, 0);
@@ -629,6 +735,47 @@ bool is_like(const std::string& str,
                                         escape));
 }
 
+// Ids of the strings for which `is_match` holds, among the `id_count` first ones or the
+// candidates, in increasing order. The strings are tested in blocks on the TBB workers.
+template <typename IS_MATCH>
+std::vector<int32_t> find_matching_ids(const size_t id_count,
+                                       const std::vector<int32_t>* candidates,
+                                       const IS_MATCH& is_match) {
+  constexpr size_t kBlockSize{4096};
+  const size_t block_count = (id_count + kBlockSize - 1) / kBlockSize;
+  std::vector<std::vector<int32_t>> block_results(block_count);
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, block_count),
+      [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t block_idx = r.begin(); block_idx != r.end(); ++block_idx) {
+          const auto block_end = std::min(id_count, (block_idx + 1) * kBlockSize);
+          for (size_t i = block_idx * kBlockSize; i < block_end; ++i) {
+            const int32_t string_id = candidates ? (*candidates)[i] : i;
+            if (is_match(string_id)) {
+              block_results[block_idx].push_back(string_id);
+            }
+          }
+        }
+      });
+  std::vector<int32_t> result;
+  for (const auto& block_result : block_results) {
+    result.insert(result.end(), block_result.begin(), block_result.end());
+  }
+  return result;
+}
+
+template <typename IS_MATCH>
+std::vector<int32_t> find_matching_ids(const size_t generation,
+                                       const IS_MATCH& is_match) {
+  return find_matching_ids(generation, nullptr, is_match);
+}
+
+template <typename IS_MATCH>
+std::vector<int32_t> find_matching_ids(const std::vector<int32_t>& candidates,
+                                       const IS_MATCH& is_match) {
+  return find_matching_ids(candidates.size(), &candidates, is_match);
+}
+
 }  // namespace
 
 std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
@@ -636,52 +783,55 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
                                                const bool is_simple,
                                                const char escape,
                                                const size_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
     return client_->get_like(pattern, icase, is_simple, escape, generation);
   }
-  const auto cache_key = std::make_tuple(pattern, icase, is_simple, escape);
-  const auto it = like_cache_.find(cache_key);
-  if (it != like_cache_.end()) {
-    return it->second;
+  const like_cache_key_t cache_key{pattern, icase, is_simple, escape};
+  {
+    std::lock_guard<std::mutex> cache_lock(pattern_cache_mutex_);
+    const auto cached_result = pattern_cache_.get(cache_key);
+    if (cached_result) {
+      return *cached_result;
+    }
   }
-  std::vector<int32_t> result;
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          icase,
-                          is_simple,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_like(str, pattern, icase, is_simple, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
-      }
-    });
+  const auto is_match = [&](const int32_t string_id) {
+    return is_like(getStringUnlocked(string_id), pattern, icase, is_simple, escape);
+  };
+  const auto candidates = getLikeCandidates(pattern, is_simple, escape, generation);
+  const auto result = candidates ? find_matching_ids(*candidates, is_match)
+                                 : find_matching_ids(generation, is_match);
+  // place result into cache for reuse if similar query
+  std::lock_guard<std::mutex> cache_lock(pattern_cache_mutex_);
+  pattern_cache_.put(cache_key, result);
+  return result;
+}
+
+std::optional<std::vector<int32_t>> StringDictionary::getLikeCandidates(
+    const std::string& pattern,
+    const bool is_simple,
+    const char escape,
+    const size_t generation) const {
+  if (!g_enable_stringdict_trigram_index) {
+    return std::nullopt;
   }
-  for (auto& worker : workers) {
-    worker.join();
+  {
+    mapd_shared_lock<mapd_shared_mutex> index_read_lock(trigram_index_mutex_);
+    if (trigram_index_ && trigram_index_->size() >= generation) {
+      return trigram_index_->getCandidates(pattern, is_simple, escape, generation);
+    }
   }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
+  mapd_lock_guard<mapd_shared_mutex> index_write_lock(trigram_index_mutex_);
+  if (!trigram_index_) {
+    trigram_index_ = std::make_unique<TrigramIndex>();
   }
-  // place result into cache for reuse if similar query
-  const auto it_ok = like_cache_.insert(std::make_pair(cache_key, result));
-
-  CHECK(it_ok.second);
-
-  return result;
+  // strings are only appended under the exclusive lock of the dictionary, which is held
+  // shared here, so the index catches up with the strings added since its last use
+  for (size_t string_id = trigram_index_->size(); string_id < str_count_; ++string_id) {
+    trigram_index_->add(getStringUnlocked(string_id), string_id);
+  }
+  return trigram_index_->getCandidates(pattern, is_simple, escape, generation);
 }
 
 std::vector<int32_t> StringDictionary::getEquals(std::string pattern,
@@ -908,47 +1058,24 @@ bool is_regexp_like(const std::string& str,
 std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
                                                      const char escape,
                                                      const size_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
     return client_->get_regexp_like(pattern, escape, generation);
   }
-  const auto cache_key = std::make_pair(pattern, escape);
-  const auto it = regex_cache_.find(cache_key);
-  if (it != regex_cache_.end()) {
-    return it->second;
+  const regex_cache_key_t cache_key{pattern, escape};
+  {
+    std::lock_guard<std::mutex> cache_lock(pattern_cache_mutex_);
+    const auto cached_result = pattern_cache_.get(cache_key);
+    if (cached_result) {
+      return *cached_result;
+    }
   }
-  std::vector<int32_t> result;
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_regexp_like(str, pattern, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
-      }
-    });
-  }
-  for (auto& worker : workers) {
-    worker.join();
-  }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
-  }
-  const auto it_ok = regex_cache_.insert(std::make_pair(cache_key, result));
-  CHECK(it_ok.second);
-
+  const auto result = find_matching_ids(generation, [&](const int32_t string_id) {
+    return is_regexp_like(getStringUnlocked(string_id), pattern, escape);
+  });
+  std::lock_guard<std::mutex> cache_lock(pattern_cache_mutex_);
+  pattern_cache_.put(cache_key, result);
   return result;
 }
 
@@ -1371,11 +1498,9 @@ void* StringDictionary::addMemoryCapacity(void* addr,
 }
 
 void StringDictionary::invalidateInvertedIndex() noexcept {
-  if (!like_cache_.empty()) {
-    decltype(like_cache_)().swap(like_cache_);
-  }
-  if (!regex_cache_.empty()) {
-    decltype(regex_cache_)().swap(regex_cache_);
+  {
+    std::lock_guard<std::mutex> cache_lock(pattern_cache_mutex_);
+    pattern_cache_.clear();
   }
   if (!equal_cache_.empty()) {
     decltype(equal_cache_)().swap(equal_cache_);
@@ -24,13 +24,20 @@
 
 #include <future>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <tuple>
+#include <variant>
 #include <vector>
 
 extern bool g_enable_stringdict_parallel;
+extern bool g_enable_stringdict_trigram_index;
+extern bool g_enable_stringdict_hash_table_persistence;
+extern size_t g_stringdict_pattern_cache_max_bytes;
 
 class StringDictionaryClient;
+class TrigramIndex;
 
 class DictPayloadUnavailable : public std::runtime_error {
  public:
@@ -141,6 +148,11 @@ class StringDictionary {
       std::vector<std::future<std::vector<std::pair<string_dict_hash_t, unsigned int>>>>&
           dictionary_futures);
   size_t getNumStringsFromStorage(const size_t storage_slots) const noexcept;
+  // The hash table is saved next to the payload when the dictionary is closed, so that
+  // reopening it doesn't rehash every string. It's loaded only if no string has been
+  // added since.
+  bool loadHashTable(const size_t str_count);
+  void persistHashTable() const noexcept;
   bool fillRateIsHigh(const size_t num_strings) const noexcept;
   void increaseHashTableCapacity() noexcept;
   template <class String>
@@ -194,6 +206,10 @@ class StringDictionary {
                           size_t& mem_size,
                           const size_t min_capacity_requested = 0) noexcept;
   void invalidateInvertedIndex() noexcept;
+  std::optional<std::vector<int32_t>> getLikeCandidates(const std::string& pattern,
+                                                        const bool is_simple,
+                                                        const char escape,
+                                                        const size_t generation) const;
   std::vector<int32_t> getEquals(std::string pattern,
                                  std::string comp_operator,
                                  size_t generation);
@@ -212,6 +228,8 @@ class StringDictionary {
   bool isTemp_;
   bool materialize_hashes_;
   std::string offsets_path_;
+  std::string hash_table_path_;
+  size_t persisted_hash_table_str_count_{0};
   int payload_fd_;
   int offset_fd_;
   StringIdxEntry* offset_map_;
@@ -220,9 +238,15 @@ class StringDictionary {
   size_t payload_file_size_;
   size_t payload_file_off_;
   mutable mapd_shared_mutex rw_mutex_;
-  mutable std::map<std::tuple<std::string, bool, bool, char>, std::vector<int32_t>>
-      like_cache_;
-  mutable std::map<std::pair<std::string, char>, std::vector<int32_t>> regex_cache_;
+  // LIKE and REGEXP run concurrently under the shared lock, their cache has its own.
+  // Both kinds of patterns share one cache so that they share one byte budget.
+  using like_cache_key_t = std::tuple<std::string, bool, bool, char>;
+  using regex_cache_key_t = std::pair<std::string, char>;
+  mutable std::mutex pattern_cache_mutex_;
+  mutable StringIdsCache<std::variant<like_cache_key_t, regex_cache_key_t>>
+      pattern_cache_{g_stringdict_pattern_cache_max_bytes};
+  mutable mapd_shared_mutex trigram_index_mutex_;
+  mutable std::unique_ptr<TrigramIndex> trigram_index_;
   mutable std::map<std::string, int32_t> equal_cache_;
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
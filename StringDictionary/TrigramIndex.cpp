@@ -0,0 +1,126 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StringDictionary/TrigramIndex.h"
+
+#include <algorithm>
+
+#include "Logger/Logger.h"
+
+namespace {
+
+// same as the LIKE runtime, ILIKE patterns are lowercase already
+char lowercase(const char c) {
+  return 'A' <= c && c <= 'Z' ? 'a' + (c - 'A') : c;
+}
+
+uint32_t get_trigram(const char* str) {
+  return (static_cast<uint32_t>(static_cast<uint8_t>(lowercase(str[0]))) << 16) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(lowercase(str[1]))) << 8) |
+         static_cast<uint32_t>(static_cast<uint8_t>(lowercase(str[2])));
+}
+
+// The runs of characters of a LIKE pattern which must appear as they are in the strings
+// it matches, broken by wildcards and character classes.
+std::vector<std::string> get_literal_runs(const std::string& pattern,
+                                          const bool is_simple,
+                                          const char escape) {
+  if (is_simple) {
+    // the wildcards and escapes have been removed already
+    return {pattern};
+  }
+  std::vector<std::string> runs(1);
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    if (c == escape && i + 1 < pattern.size()) {
+      runs.back() += pattern[++i];
+    } else if (c == '%' || c == '_' || c == '[') {
+      if (c == '[') {
+        while (i < pattern.size() && pattern[i] != ']') {
+          ++i;
+        }
+      }
+      if (!runs.back().empty()) {
+        runs.emplace_back();
+      }
+    } else {
+      runs.back() += c;
+    }
+  }
+  return runs;
+}
+
+}  // namespace
+
+void TrigramIndex::add(const std::string_view str, const int32_t string_id) {
+  CHECK_EQ(static_cast<size_t>(string_id), indexed_count_);
+  for (size_t i = 0; i + 3 <= str.size(); ++i) {
+    auto& string_ids = string_ids_by_trigram_[get_trigram(str.data() + i)];
+    if (string_ids.empty() || string_ids.back() != string_id) {
+      string_ids.push_back(string_id);
+    }
+  }
+  ++indexed_count_;
+}
+
+std::optional<std::vector<int32_t>> TrigramIndex::getCandidates(
+    const std::string& pattern,
+    const bool is_simple,
+    const char escape,
+    const size_t generation) const {
+  CHECK_LE(generation, indexed_count_);
+  std::vector<uint32_t> trigrams;
+  for (const auto& run : get_literal_runs(pattern, is_simple, escape)) {
+    for (size_t i = 0; i + 3 <= run.size(); ++i) {
+      trigrams.push_back(get_trigram(run.data() + i));
+    }
+  }
+  if (trigrams.empty()) {
+    return std::nullopt;
+  }
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+  std::vector<const std::vector<int32_t>*> string_id_lists;
+  for (const auto trigram : trigrams) {
+    const auto it = string_ids_by_trigram_.find(trigram);
+    if (it == string_ids_by_trigram_.end()) {
+      return std::vector<int32_t>{};
+    }
+    string_id_lists.push_back(&it->second);
+  }
+  // intersect starting from the shortest list to keep the intermediate results small
+  std::sort(string_id_lists.begin(),
+            string_id_lists.end(),
+            [](const std::vector<int32_t>* lhs, const std::vector<int32_t>* rhs) {
+              return lhs->size() < rhs->size();
+            });
+  const auto& shortest = *string_id_lists.front();
+  std::vector<int32_t> candidates(
+      shortest.begin(),
+      std::lower_bound(
+          shortest.begin(), shortest.end(), static_cast<int32_t>(generation)));
+  std::vector<int32_t> intersection;
+  for (size_t i = 1; i < string_id_lists.size() && !candidates.empty(); ++i) {
+    intersection.clear();
+    std::set_intersection(candidates.begin(),
+                          candidates.end(),
+                          string_id_lists[i]->begin(),
+                          string_id_lists[i]->end(),
+                          std::back_inserter(intersection));
+    candidates.swap(intersection);
+  }
+  return candidates;
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STRINGDICTIONARY_TRIGRAMINDEX_H
+#define STRINGDICTIONARY_TRIGRAMINDEX_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Inverted index from the trigrams of the strings of a dictionary, lowercased, to the
+ * ids of the strings which contain them. The candidates for a LIKE or ILIKE pattern with
+ * a literal run of at least three characters are the strings containing all the trigrams
+ * of its literal runs, a superset of the matches which the pattern is then tested on.
+ */
+class TrigramIndex {
+ public:
+  // strings must be added in increasing id order
+  void add(const std::string_view str, const int32_t string_id);
+
+  // number of strings indexed, the next id to add
+  size_t size() const { return indexed_count_; }
+
+  // sorted ids below `generation` of the candidates for the pattern, none if the pattern
+  // has no literal run long enough to narrow them
+  std::optional<std::vector<int32_t>> getCandidates(const std::string& pattern,
+                                                    const bool is_simple,
+                                                    const char escape,
+                                                    const size_t generation) const;
+
+ private:
+  std::unordered_map<uint32_t, std::vector<int32_t>> string_ids_by_trigram_;
+  size_t indexed_count_{0};
+};
+
+#endif  // STRINGDICTIONARY_TRIGRAMINDEX_H
@@ -16,6 +16,7 @@
 
 #include "TestHelpers.h"
 
+#include <arrow/api.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
@@ -27,11 +28,14 @@
 #include "Archive/PosixFileArchive.h"
 #include "Catalog/Catalog.h"
 #include "DataMgr/ForeignStorage/ArrowForeignStorage.h"
+#include "DataMgr/ForeignStorage/ForeignStorageInterface.h"
+#include "Fragmenter/FragmentDefaultValues.h"
 #include "Geospatial/Types.h"
 #include "ImportExport/Importer.h"
 #include "Parser/parser.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/ArrowUtil.h"
 #include "Shared/scope.h"
 
 #ifndef BASE_PATH
@@ -524,6 +528,130 @@ TEST(NullValuesTest, NullTextColumn) {
                "SELECT COUNT(col3) FROM fsi_nulls_text WHERE col3 IS NOT NULL;")));
 }
 
+TEST(NullValuesTest, NullFragments) {
+  // fragments over the converted and the zero copied parts of the columns
+  for (auto fragment_size : {4, 1000}) {
+    const auto table_name = "fsi_nulls_frag" + std::to_string(fragment_size);
+    run_ddl_statement(
+        "CREATE DATAFRAME " + table_name +
+        " (int4 INTEGER, int8 BIGINT, fp4 FLOAT, fp8 DOUBLE) from "
+        "'CSV:../../Tests/Import/datafiles/null_values_fragments.csv' WITH "
+        "(fragment_size=" +
+        std::to_string(fragment_size) + ");");
+    for (auto col : {"int4", "int8", "fp4", "fp8"}) {
+      CHECK_EQ(9,
+               v<int64_t>(run_simple_agg("SELECT COUNT(" + std::string(col) +
+                                         ") FROM " + table_name + ";")));
+      CHECK_EQ(45.0,
+               v<double>(run_simple_agg("SELECT SUM(CAST(" + std::string(col) +
+                                        " AS DOUBLE)) FROM " + table_name + ";")));
+    }
+    run_ddl_statement("DROP TABLE " + table_name + ";");
+  }
+}
+
+std::shared_ptr<arrow::Array> make_int64_array(int64_t first, int64_t length) {
+  arrow::Int64Builder builder;
+  for (int64_t i = first; i < first + length; i++) {
+    ARROW_THROW_NOT_OK(builder.Append(i));
+  }
+  std::shared_ptr<arrow::Array> array;
+  ARROW_THROW_NOT_OK(builder.Finish(&array));
+  return array;
+}
+
+// creates a table over the Arrow table the same way DBEngine::importArrowTable does
+void create_arrow_table(const std::string& table_name,
+                        const std::shared_ptr<arrow::Table>& table,
+                        size_t fragment_size) {
+  setArrowTable(table_name, table);
+  ScopeGuard release_table = [&table_name] { releaseArrowTable(table_name); };
+  TableDescriptor td;
+  td.tableName = table_name;
+  td.userId = QR::get()->getSession()->get_currentUser().userId;
+  td.storageType = "ARROW:" + table_name;
+  td.persistenceLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
+  td.isView = false;
+  td.fragmenter = nullptr;
+  td.fragType = Fragmenter_Namespace::FragmenterType::INSERT_ORDER;
+  td.maxFragRows = fragment_size;
+  td.maxChunkSize = DEFAULT_MAX_CHUNK_SIZE;
+  td.fragPageSize = DEFAULT_PAGE_SIZE;
+  td.maxRows = DEFAULT_MAX_ROWS;
+  td.keyMetainfo = "[]";
+  std::list<ColumnDescriptor> cols;
+  std::vector<Parser::SharedDictionaryDef> dictionaries;
+  QR::get()->getCatalog()->createTable(td, cols, dictionaries, false);
+}
+
+const int8_t* zero_copy_fragment(const std::string& table_name,
+                                 const std::string& column_name,
+                                 int fragment_id,
+                                 size_t num_rows) {
+  auto catalog = QR::get()->getCatalog();
+  auto td = catalog->getMetadataForTable(table_name);
+  CHECK(td);
+  auto cd = catalog->getMetadataForColumn(td->tableId, column_name);
+  CHECK(cd);
+  const size_t num_bytes = num_rows * cd->columnType.get_size();
+  auto buffer = dynamic_cast<ForeignStorageBuffer*>(catalog->getDataMgr().getChunkBuffer(
+      {catalog->getCurrentDB().dbId, td->tableId, cd->columnId, fragment_id},
+      Data_Namespace::MemoryLevel::DISK_LEVEL,
+      0,
+      num_bytes));
+  CHECK(buffer);
+  return buffer->tryZeroCopy(num_bytes);
+}
+
+const int8_t* array_values(const std::shared_ptr<arrow::Array>& array, int64_t row) {
+  return reinterpret_cast<const int8_t*>(array->data()->GetValues<int64_t>(1) + row);
+}
+
+TEST(ZeroCopyTest, SingleChunkFragments) {
+  // record batches have their own buffers, so every batch starts a fragment
+  arrow::ArrayVector batches{
+      make_int64_array(0, 3), make_int64_array(3, 4), make_int64_array(7, 10)};
+  auto table = arrow::Table::Make(arrow::schema({arrow::field("a", arrow::int64())}),
+                                  {std::make_shared<arrow::ChunkedArray>(batches)});
+  create_arrow_table("fsi_zero_copy_batches", table, 8);
+  ScopeGuard drop_table = [] { run_ddl_statement("DROP TABLE fsi_zero_copy_batches;"); };
+
+  // the last batch is longer than a fragment and is split in two
+  const std::vector<std::tuple<int, size_t, const int8_t*>> fragments{
+      {0, 3, array_values(batches[0], 0)},
+      {1, 4, array_values(batches[1], 0)},
+      {2, 8, array_values(batches[2], 0)},
+      {3, 2, array_values(batches[2], 8)}};
+  for (const auto& [fragment_id, num_rows, data] : fragments) {
+    EXPECT_EQ(data,
+              zero_copy_fragment("fsi_zero_copy_batches", "a", fragment_id, num_rows));
+  }
+  ASSERT_EQ(int64_t(17),
+            v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM fsi_zero_copy_batches;")));
+  ASSERT_EQ(int64_t(136),
+            v<int64_t>(run_simple_agg("SELECT SUM(a) FROM fsi_zero_copy_batches;")));
+}
+
+TEST(ZeroCopyTest, MultiChunkFragment) {
+  // the chunks of "a" are slices of one buffer, "b" is not chunked at the same rows
+  auto a = make_int64_array(0, 8);
+  auto b = make_int64_array(8, 8);
+  arrow::ArrayVector a_chunks{a->Slice(0, 4), a->Slice(4, 4)};
+  arrow::ArrayVector b_chunks{b};
+  auto schema = arrow::schema(
+      {arrow::field("a", arrow::int64()), arrow::field("b", arrow::int64())});
+  auto table = arrow::Table::Make(schema,
+                                  {std::make_shared<arrow::ChunkedArray>(a_chunks),
+                                   std::make_shared<arrow::ChunkedArray>(b_chunks)});
+  create_arrow_table("fsi_zero_copy_slices", table, 8);
+  ScopeGuard drop_table = [] { run_ddl_statement("DROP TABLE fsi_zero_copy_slices;"); };
+
+  EXPECT_EQ(array_values(a, 0), zero_copy_fragment("fsi_zero_copy_slices", "a", 0, 8));
+  EXPECT_EQ(array_values(b, 0), zero_copy_fragment("fsi_zero_copy_slices", "b", 0, 8));
+  ASSERT_EQ(int64_t(120),
+            v<int64_t>(run_simple_agg("SELECT SUM(a + b) FROM fsi_zero_copy_slices;")));
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
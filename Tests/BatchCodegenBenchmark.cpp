@@ -0,0 +1,152 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+
+#include "../ImportExport/Importer.h"
+#include "../Logger/Logger.h"
+#include "../QueryEngine/ResultSet.h"
+#include "../QueryRunner/QueryRunner.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+extern bool g_enable_batch_cpu_codegen;
+
+using QR = QueryRunner::QueryRunner;
+
+std::once_flag setup_flag;
+void global_setup() {
+  TestHelpers::init_logger_stderr_only();
+  QR::init(BASE_PATH);
+}
+
+inline void run_ddl_statement(const std::string& create_table_stmt) {
+  QR::get()->runDDLStatement(create_table_stmt);
+}
+
+TargetValue run_simple_agg(const std::string& query_str) {
+  auto rows = QR::get()->runSQL(query_str, ExecutorDeviceType::CPU);
+  auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size()) << query_str;
+  return crt_row[0];
+}
+
+//! Loads state.range(0) rows into a table with integer and floating point columns. The
+//! second argument of every benchmark selects the code generation mode: 0 runs the row
+//! at a time loop, 1 runs the batched loop with the loop vectorizer.
+class BatchCodegenFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const ::benchmark::State& state) override {
+    std::call_once(setup_flag, global_setup);
+
+    run_ddl_statement("DROP TABLE IF EXISTS batch_codegen_bench;");
+    run_ddl_statement(
+        "CREATE TABLE batch_codegen_bench (x INT, y BIGINT, z DOUBLE) WITH "
+        "(FRAGMENT_SIZE=4000000);");
+
+    auto cat = QR::get()->getCatalog();
+    const auto td = cat->getMetadataForTable("batch_codegen_bench");
+    CHECK(td);
+    auto loader = QR::get()->getLoader(td);
+    CHECK(loader);
+
+    auto col_descs = loader->get_column_descs();
+    std::vector<std::unique_ptr<import_export::TypedImportBuffer>> import_buffers;
+    for (auto cd : col_descs) {
+      import_buffers.push_back(std::unique_ptr<import_export::TypedImportBuffer>(
+          new import_export::TypedImportBuffer(cd, loader->getStringDict(cd))));
+    }
+
+    for (int64_t i = 0; i < state.range(0); i++) {
+      std::vector<std::string> values{std::to_string(i % 1000),
+                                      std::to_string(i),
+                                      std::to_string(0.5 * (i % 10000))};
+      size_t index = 0;
+      for (auto cd : col_descs) {
+        CHECK_LT(index, values.size());
+        CHECK_LT(index, import_buffers.size());
+        import_buffers[index]->add_value(cd,
+                                         values[index],
+                                         /*is_null=*/false,
+                                         import_export::CopyParams());
+        index++;
+      }
+    }
+
+    loader->load(import_buffers, state.range(0), nullptr);
+
+    g_enable_batch_cpu_codegen = state.range(1);
+    CHECK_EQ(static_cast<int64_t>(state.range(0)),
+             TestHelpers::v<int64_t>(
+                 run_simple_agg("SELECT COUNT(*) FROM batch_codegen_bench;")));
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    g_enable_batch_cpu_codegen = false;
+    run_ddl_statement("DROP TABLE IF EXISTS batch_codegen_bench;");
+  }
+};
+
+void run_benchmark_query(benchmark::State& state, const std::string& query_str) {
+  // compile outside of the timed loop
+  run_simple_agg(query_str);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(run_simple_agg(query_str));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//! Unfiltered aggregates over every column
+BENCHMARK_DEFINE_F(BatchCodegenFixture, SumNoFilter)(benchmark::State& state) {
+  run_benchmark_query(state, "SELECT SUM(x), SUM(y), SUM(z) FROM batch_codegen_bench;");
+}
+
+//! Filter which about half the rows pass
+BENCHMARK_DEFINE_F(BatchCodegenFixture, CountFilter)(benchmark::State& state) {
+  run_benchmark_query(state, "SELECT COUNT(*) FROM batch_codegen_bench WHERE x < 500;");
+}
+
+//! Filter and an arithmetic expression on the aggregated value
+BENCHMARK_DEFINE_F(BatchCodegenFixture, SumExprFilter)(benchmark::State& state) {
+  run_benchmark_query(
+      state, "SELECT SUM(y * 2 + x) FROM batch_codegen_bench WHERE z > 1000.0;");
+}
+
+//! Min and max without a filter
+BENCHMARK_DEFINE_F(BatchCodegenFixture, MinMax)(benchmark::State& state) {
+  run_benchmark_query(state,
+                      "SELECT MIN(y), MAX(y), MIN(z), MAX(z) FROM batch_codegen_bench;");
+}
+
+#define REGISTER_BATCH_CODEGEN_BENCHMARK(name)    \
+  BENCHMARK_REGISTER_F(BatchCodegenFixture, name) \
+      ->RangeMultiplier(4)                        \
+      ->Ranges({{1 << 20, 1 << 24}, {0, 1}})      \
+      ->MeasureProcessCPUTime()                   \
+      ->UseRealTime()                             \
+      ->Unit(benchmark::kMillisecond);
+
+REGISTER_BATCH_CODEGEN_BENCHMARK(SumNoFilter)
+REGISTER_BATCH_CODEGEN_BENCHMARK(CountFilter)
+REGISTER_BATCH_CODEGEN_BENCHMARK(SumExprFilter)
+REGISTER_BATCH_CODEGEN_BENCHMARK(MinMax)
+
+BENCHMARK_MAIN();
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
+#include "TestHelpers.h"
+
+using namespace Buffer_Namespace;
+
+namespace {
+
+constexpr size_t kPageSize{512};
+constexpr size_t kSlabPages{16};
+
+std::unique_ptr<CpuBufferMgr> make_buffer_mgr(const size_t num_slabs = 1) {
+  return std::make_unique<CpuBufferMgr>(0,
+                                        num_slabs * kSlabPages * kPageSize,
+                                        nullptr,
+                                        kSlabPages * kPageSize,
+                                        kSlabPages * kPageSize,
+                                        kPageSize);
+}
+
+AbstractBuffer* alloc_pages(CpuBufferMgr& buffer_mgr, const size_t num_pages) {
+  return buffer_mgr.alloc(num_pages * kPageSize);
+}
+
+size_t count_free_segments(CpuBufferMgr& buffer_mgr) {
+  size_t free_segments{0};
+  for (const auto& slab : buffer_mgr.getSlabSegments()) {
+    for (const auto& segment : slab) {
+      free_segments += segment.mem_status == FREE;
+    }
+  }
+  return free_segments;
+}
+
+}  // namespace
+
+TEST(BufferMgr, BestFit) {
+  auto buffer_mgr = make_buffer_mgr();
+  auto a = alloc_pages(*buffer_mgr, 4);
+  auto b = alloc_pages(*buffer_mgr, 1);
+  auto c = alloc_pages(*buffer_mgr, 2);
+  auto d = alloc_pages(*buffer_mgr, 1);
+  const auto c_mem = c->getMemoryPtr();
+  buffer_mgr->free(a);
+  buffer_mgr->free(c);
+  // free segments of 4, 2 and 8 pages
+  EXPECT_EQ(size_t(3), count_free_segments(*buffer_mgr));
+
+  auto e = alloc_pages(*buffer_mgr, 2);
+  EXPECT_EQ(c_mem, e->getMemoryPtr());
+  EXPECT_EQ(size_t(2), count_free_segments(*buffer_mgr));
+
+  // freeing merges the adjacent free segments
+  buffer_mgr->free(b);
+  buffer_mgr->free(e);
+  EXPECT_EQ(size_t(2), count_free_segments(*buffer_mgr));
+  buffer_mgr->free(d);
+  EXPECT_EQ(size_t(1), count_free_segments(*buffer_mgr));
+  EXPECT_EQ(size_t(0), buffer_mgr->getInUseSize());
+}
+
+TEST(BufferMgr, NewSlab) {
+  auto buffer_mgr = make_buffer_mgr(2);
+  auto a = alloc_pages(*buffer_mgr, 12);
+  auto b = alloc_pages(*buffer_mgr, 8);
+  EXPECT_EQ(size_t(2), buffer_mgr->getSlabSegments().size());
+  // fits in the remainder of the first slab
+  auto c = alloc_pages(*buffer_mgr, 4);
+  EXPECT_EQ(a->getMemoryPtr() + 12 * kPageSize, c->getMemoryPtr());
+  EXPECT_EQ(size_t(1), count_free_segments(*buffer_mgr));
+  for (auto buffer : {a, b, c}) {
+    buffer_mgr->free(buffer);
+  }
+  EXPECT_EQ(size_t(2), count_free_segments(*buffer_mgr));
+}
+
+TEST(BufferMgr, Reserve) {
+  auto buffer_mgr = make_buffer_mgr();
+  auto a = alloc_pages(*buffer_mgr, 2);
+  const auto a_mem = a->getMemoryPtr();
+  // grows into the free segment which follows it
+  a->reserve(kSlabPages * kPageSize);
+  EXPECT_EQ(a_mem, a->getMemoryPtr());
+  EXPECT_EQ(size_t(0), count_free_segments(*buffer_mgr));
+  buffer_mgr->free(a);
+  EXPECT_EQ(size_t(1), count_free_segments(*buffer_mgr));
+}
+
+TEST(BufferMgr, EvictLeastRecentlyTouched) {
+  auto buffer_mgr = make_buffer_mgr();
+  std::vector<AbstractBuffer*> buffers;
+  for (size_t i = 0; i < 4; ++i) {
+    buffers.push_back(alloc_pages(*buffer_mgr, 4));
+  }
+  buffers[0]->unPin();
+  buffers[2]->unPin();
+  buffers[3]->unPin();
+
+  // the first buffer is the oldest unpinned one
+  auto a = alloc_pages(*buffer_mgr, 4);
+  EXPECT_EQ(buffers[0]->getMemoryPtr(), a->getMemoryPtr());
+
+  // the second buffer is pinned, the last two are the only run large enough
+  const auto evict_start = buffers[2]->getMemoryPtr();
+  auto b = alloc_pages(*buffer_mgr, 8);
+  EXPECT_EQ(evict_start, b->getMemoryPtr());
+
+  // everything is pinned
+  EXPECT_THROW(alloc_pages(*buffer_mgr, 4), OutOfMemory);
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
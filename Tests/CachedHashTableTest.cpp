@@ -29,11 +29,13 @@
 #include "DataMgr/DataMgr.h"
 #include "Logger/Logger.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/JoinHashTable/HashTableCache.h"
 #include "QueryEngine/MurmurHash1Inl.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryEngine/UDFCompiler.h"
 #include "QueryRunner/QueryRunner.h"
 #include "Shared/SystemParameters.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
 namespace po = boost::program_options;
@@ -824,6 +826,86 @@ TEST(Delete, JoinCacheInvalidationTest_DropTable) {
   }
 }
 
+namespace {
+
+struct FakeCacheKey {
+  int id;
+
+  bool operator==(const FakeCacheKey& that) const { return id == that.id; }
+
+  size_t hash() const { return std::hash<int>()(id); }
+};
+
+struct FakeHashTable {
+  size_t size;
+
+  size_t getHashTableBufferSize(const ExecutorDeviceType) const { return size; }
+};
+
+using FakeHashTableCache = HashTableCache<FakeCacheKey, std::shared_ptr<FakeHashTable>>;
+
+void insert_fake_table(FakeHashTableCache& cache,
+                       const int id,
+                       const size_t size,
+                       const size_t build_time_ms = 0) {
+  auto table = std::make_shared<FakeHashTable>(FakeHashTable{size});
+  cache.insert({id}, table, build_time_ms);
+}
+
+}  // namespace
+
+TEST(HashTableCache, EvictsLeastRecentlyUsed) {
+  ScopeGuard reset = [orig = g_hash_table_cache_max_size_bytes] {
+    g_hash_table_cache_max_size_bytes = orig;
+  };
+  g_hash_table_cache_max_size_bytes = 300;
+
+  FakeHashTableCache cache;
+  insert_fake_table(cache, 1, 100);
+  insert_fake_table(cache, 2, 100);
+  insert_fake_table(cache, 3, 100);
+  ASSERT_TRUE(cache.get({1}));
+  insert_fake_table(cache, 4, 100);
+
+  EXPECT_TRUE(cache.get({1}));
+  EXPECT_FALSE(cache.get({2}));
+  EXPECT_TRUE(cache.get({3}));
+  EXPECT_TRUE(cache.get({4}));
+
+  // larger than the whole budget, never cached
+  insert_fake_table(cache, 5, 400);
+  EXPECT_FALSE(cache.get({5}));
+
+  const auto stats = cache.getStats();
+  EXPECT_EQ(stats.num_entries, size_t(3));
+  EXPECT_EQ(stats.size_bytes, size_t(300));
+  EXPECT_EQ(stats.evictions, size_t(1));
+  EXPECT_EQ(stats.hits, size_t(4));
+  EXPECT_EQ(stats.misses, size_t(2));
+}
+
+TEST(HashTableCache, CostAwareEviction) {
+  ScopeGuard reset = [orig_size = g_hash_table_cache_max_size_bytes,
+                      orig_cost_aware = g_hash_table_cache_cost_aware_eviction] {
+    g_hash_table_cache_max_size_bytes = orig_size;
+    g_hash_table_cache_cost_aware_eviction = orig_cost_aware;
+  };
+  g_hash_table_cache_max_size_bytes = 300;
+  g_hash_table_cache_cost_aware_eviction = true;
+
+  FakeHashTableCache cache;
+  insert_fake_table(cache, 1, 100, 1000);
+  insert_fake_table(cache, 2, 100, 10);
+  insert_fake_table(cache, 3, 100, 1000);
+  // the least recently used table is the most expensive to rebuild, the cheap one goes
+  insert_fake_table(cache, 4, 100, 1000);
+
+  EXPECT_TRUE(cache.get({1}));
+  EXPECT_FALSE(cache.get({2}));
+  EXPECT_TRUE(cache.get({3}));
+  EXPECT_TRUE(cache.get({4}));
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -31,6 +31,7 @@
 #include "gen-cpp/CalciteServer.h"
 
 #include "Shared/Restriction.h"
+#include "Shared/scope.h"
 
 using QR = QueryRunner::QueryRunner;
 
@@ -181,6 +182,62 @@ TEST_F(ViewObject, Restrict) {
   }
 }
 
+TEST_F(ViewObject, PlanCache) {
+  auto session = QR::get()->getSession();
+  CHECK(session);
+
+  g_calcite->setPlanCacheSize(16);
+  ScopeGuard reset_cache = [] { g_calcite->setPlanCacheSize(0); };
+
+  auto plan = [&session](const std::string& query) {
+    auto qs = QR::create_query_state(session, query);
+    return g_calcite
+        ->process(
+            qs->createQueryStateProxy(), qs->getQueryStr(), {}, true, false, true, true)
+        .plan_result;
+  };
+  auto expect_hits_and_misses = [](const size_t hits, const size_t misses) {
+    EXPECT_EQ(hits, g_calcite->getPlanCacheHits());
+    EXPECT_EQ(misses, g_calcite->getPlanCacheMisses());
+  };
+
+  // formatting differences share a plan
+  const auto tresult = plan("select i1 from table1");
+  expect_hits_and_misses(0, 1);
+  EXPECT_EQ(tresult, plan("  select i1\n  from table1 ;"));
+  expect_hits_and_misses(1, 1);
+  EXPECT_NE(tresult, plan("select i2 from table1"));
+  expect_hits_and_misses(1, 2);
+
+  // literals are part of the key
+  plan("select i1 from table1 where i1 = 1");
+  plan("select i1 from table1 where i1 = 2");
+  expect_hits_and_misses(1, 4);
+  plan("select i1 from table1 where i1 = 1");
+  expect_hits_and_misses(2, 4);
+
+  // table changes invalidate the cached plans
+  const auto star_result = plan("select * from table1");
+  EXPECT_EQ(star_result, plan("select * from table1"));
+  expect_hits_and_misses(3, 5);
+  run_ddl_statement("ALTER TABLE table1 ADD COLUMN i3 INTEGER;");
+  EXPECT_NE(star_result, plan("select * from table1"));
+  expect_hits_and_misses(3, 6);
+}
+
+TEST_F(ViewObject, PlanCacheDisabledByDefault) {
+  auto session = QR::get()->getSession();
+  CHECK(session);
+
+  for (int i = 0; i < 2; ++i) {
+    auto qs = QR::create_query_state(session, "select i1 from table1");
+    g_calcite->process(
+        qs->createQueryStateProxy(), qs->getQueryStr(), {}, true, false, true, true);
+  }
+  EXPECT_EQ(size_t(0), g_calcite->getPlanCacheHits());
+  EXPECT_EQ(size_t(0), g_calcite->getPlanCacheMisses());
+}
+
 int main(int argc, char* argv[]) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -22,11 +22,16 @@
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/raw_os_ostream.h>
 
+#include <boost/filesystem.hpp>
+
+#include <ctime>
+
 #include "Analyzer/Analyzer.h"
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/IRCodegenUtils.h"
 #include "QueryEngine/LLVMGlobalContext.h"
+#include "QueryEngine/PersistentCodeCache.h"
 #include "TestHelpers.h"
 
 TEST(CodeGeneratorTest, IntegerConstant) {
@@ -137,6 +142,89 @@ TEST(CodeGeneratorTest, IntegerExpr) {
   ASSERT_EQ(out, 100);
 }
 
+TEST(CodeCacheKeyTest, Equality) {
+  const CodeCacheKey key{"ab", "c"};
+  const CodeCacheKey same_key{"ab", "c"};
+  EXPECT_EQ(key, same_key);
+  EXPECT_EQ(key.hash(), same_key.hash());
+  EXPECT_EQ(CodeCacheKeyHash()(key), CodeCacheKeyHash()(same_key));
+  // the same text split differently
+  EXPECT_NE(key, (CodeCacheKey{"a", "bc"}));
+  EXPECT_NE(key, (CodeCacheKey{"abc"}));
+  EXPECT_NE(key, (CodeCacheKey{"ab", "d"}));
+  EXPECT_NE(key, (CodeCacheKey{"ab"}));
+  EXPECT_EQ(key.toString().size(), size_t(32));
+  EXPECT_NE(key.toString(), (CodeCacheKey{"a", "bc"}).toString());
+}
+
+TEST(CodeCacheKeyTest, PersistentEntryVerification) {
+  const auto path = boost::filesystem::temp_directory_path() /
+                    boost::filesystem::unique_path("omnisci_code_cache_%%%%-%%%%");
+  {
+    PersistentCodeCache code_cache(path.string());
+    const auto co = CompilationOptions::defaults(ExecutorDeviceType::CPU);
+    const auto module_key = code_cache.getModuleKey({"ab", "c"}, co, "");
+    const auto module_id = PersistentCodeCache::getModuleId(module_key);
+    EXPECT_FALSE(code_cache.load(module_id, module_key));
+    code_cache.store(module_id, module_key, llvm::MemoryBufferRef("object", module_id));
+    const auto object = code_cache.load(module_id, module_key);
+    ASSERT_TRUE(object);
+    EXPECT_EQ(object->getBuffer().str(), "object");
+    // an entry found under the identifier of another key
+    const auto other_key = code_cache.getModuleKey({"a", "bc"}, co, "");
+    EXPECT_FALSE(code_cache.load(module_id, other_key));
+    // the entry is kept for the key it was stored with
+    EXPECT_TRUE(code_cache.load(module_id, module_key));
+  }
+  boost::filesystem::remove_all(path);
+}
+
+TEST(CodeCacheKeyTest, PersistentEntryEviction) {
+  const auto path = boost::filesystem::temp_directory_path() /
+                    boost::filesystem::unique_path("omnisci_code_cache_%%%%-%%%%");
+  const auto max_size_bytes = g_persistent_code_cache_max_size_bytes;
+  {
+    PersistentCodeCache code_cache(path.string());
+    const auto co = CompilationOptions::defaults(ExecutorDeviceType::CPU);
+    const std::string object(1000, 'x');
+    std::vector<CodeCacheKey> module_keys;
+    std::vector<std::string> module_ids;
+    for (const auto& query : {"q0", "q1", "q2"}) {
+      module_keys.push_back(code_cache.getModuleKey({query}, co, ""));
+      module_ids.push_back(PersistentCodeCache::getModuleId(module_keys.back()));
+      code_cache.store(module_ids.back(),
+                       module_keys.back(),
+                       llvm::MemoryBufferRef(object, module_ids.back()));
+      // entries written in order, a second apart
+      const auto write_time = std::time(nullptr) - 100 + std::time_t(module_ids.size());
+      boost::filesystem::last_write_time(path / (module_ids.back() + ".o"), write_time);
+    }
+    auto stats = code_cache.getStats();
+    EXPECT_EQ(stats.num_entries, size_t(3));
+    EXPECT_EQ(stats.evictions, size_t(0));
+    // using the first entry makes the second one the least recently used
+    EXPECT_TRUE(code_cache.load(module_ids[0], module_keys[0]));
+
+    g_persistent_code_cache_max_size_bytes = stats.size_bytes;
+    const auto module_key = code_cache.getModuleKey({"q3"}, co, "");
+    const auto module_id = PersistentCodeCache::getModuleId(module_key);
+    code_cache.store(module_id, module_key, llvm::MemoryBufferRef(object, module_id));
+    stats = code_cache.getStats();
+    EXPECT_EQ(stats.num_entries, size_t(3));
+    EXPECT_EQ(stats.evictions, size_t(1));
+    EXPECT_LE(stats.size_bytes, g_persistent_code_cache_max_size_bytes);
+    EXPECT_FALSE(code_cache.load(module_ids[1], module_keys[1]));
+    EXPECT_TRUE(code_cache.load(module_ids[0], module_keys[0]));
+    EXPECT_TRUE(code_cache.load(module_id, module_key));
+    // a UDF linked into the module changed
+    const auto udf_module_key = code_cache.getModuleKey({"q3"}, co, "udf:1");
+    EXPECT_FALSE(code_cache.load(PersistentCodeCache::getModuleId(udf_module_key),
+                                 udf_module_key));
+  }
+  g_persistent_code_cache_max_size_bytes = max_size_bytes;
+  boost::filesystem::remove_all(path);
+}
+
 #ifdef HAVE_CUDA
 void free_param_pointers(const std::vector<void*>& param_ptrs,
                          CudaMgr_Namespace::CudaMgr* cuda_mgr) {
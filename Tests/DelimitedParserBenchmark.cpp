@@ -0,0 +1,93 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string_view>
+
+#include "ImportExport/DelimitedParserUtils.h"
+
+using namespace import_export;
+
+namespace {
+
+// Rows of integer, decimal, short text and quoted text columns, with some quoted
+// delimiters and escaped quotes.
+std::string make_csv(const size_t size, const bool quoted) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int64_t> int_dist(0, 1'000'000'000);
+  std::string csv;
+  while (csv.size() < size) {
+    csv += std::to_string(int_dist(gen)) + ",";
+    csv += std::to_string(int_dist(gen) / 1000.0) + ",";
+    csv += "text_" + std::to_string(int_dist(gen) % 1000) + ",";
+    if (quoted) {
+      csv += "\"quoted, text with \"\"escaped\"\" quotes " +
+             std::to_string(int_dist(gen)) + "\"";
+    } else {
+      csv += "plain text without quotes " + std::to_string(int_dist(gen));
+    }
+    csv += "\n";
+  }
+  return csv;
+}
+
+constexpr size_t kBufferSize{8 << 20};
+
+void find_end(benchmark::State& state, const bool quoted) {
+  const auto csv = make_csv(kBufferSize, quoted);
+  CopyParams copy_params;
+  copy_params.quoted = quoted;
+  for (auto _ : state) {
+    unsigned int num_rows{0};
+    bool in_quote{false};
+    benchmark::DoNotOptimize(delimited_parser::find_end(
+        csv.data(), csv.size(), copy_params, num_rows, 0, in_quote, 0));
+  }
+  state.SetBytesProcessed(state.iterations() * csv.size());
+}
+
+void get_rows(benchmark::State& state, const bool quoted) {
+  const auto csv = make_csv(kBufferSize, quoted);
+  CopyParams copy_params;
+  copy_params.quoted = quoted;
+  std::vector<std::string_view> row;
+  std::vector<std::unique_ptr<char[]>> tmp_buffers;
+  for (auto _ : state) {
+    const char* p = csv.data();
+    const char* const end = csv.data() + csv.size();
+    while (p < end) {
+      row.clear();
+      tmp_buffers.clear();
+      bool try_single_thread{false};
+      p = delimited_parser::get_row(
+          p, end, end, copy_params, nullptr, row, tmp_buffers, try_single_thread, true);
+      ++p;
+      benchmark::DoNotOptimize(row.data());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * csv.size());
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(find_end, unquoted, false);
+BENCHMARK_CAPTURE(find_end, quoted, true);
+BENCHMARK_CAPTURE(get_rows, unquoted, false);
+BENCHMARK_CAPTURE(get_rows, quoted, true);
+
+BENCHMARK_MAIN();
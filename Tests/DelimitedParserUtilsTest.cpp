@@ -0,0 +1,303 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string_view>
+
+#include "ImportExport/DelimitedParserUtils.h"
+#include "TestHelpers.h"
+
+using namespace import_export;
+
+namespace {
+
+// Byte at a time row end search, which the block based one must match.
+size_t find_end_reference(const std::string& buffer,
+                          const CopyParams& copy_params,
+                          unsigned int& num_rows,
+                          bool& in_quote) {
+  size_t last_line_delim_pos = 0;
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    const auto c = buffer[i];
+    if (!copy_params.quoted) {
+      if (c == copy_params.line_delim) {
+        last_line_delim_pos = i;
+        ++num_rows;
+      }
+    } else if (!in_quote) {
+      if (c == copy_params.line_delim) {
+        last_line_delim_pos = i;
+        ++num_rows;
+      } else if (c == copy_params.quote) {
+        in_quote = true;
+      }
+    } else if (c == copy_params.escape && i + 1 < buffer.size() &&
+               buffer[i + 1] == copy_params.quote) {
+      ++i;
+    } else if (c == copy_params.quote) {
+      in_quote = false;
+    }
+  }
+  return last_line_delim_pos + 1;
+}
+
+// Byte at a time row parser, which the one skipping to the special characters must
+// match. Returns the position the row ends at.
+size_t get_row_reference(const std::string& csv,
+                         const CopyParams& copy_params,
+                         const bool* is_array,
+                         const bool filter_empty_lines,
+                         std::vector<std::string>& row,
+                         bool& try_single_thread) {
+  const auto is_eol = [&copy_params](const char c) {
+    return c == copy_params.line_delim || c == '\n' || c == '\r';
+  };
+  size_t field_begin = 0;
+  bool in_quote = false;
+  bool in_array = false;
+  bool has_escape = false;
+  bool strip_quotes = false;
+  size_t i = 0;
+  for (; i < csv.size(); ++i) {
+    const auto c = csv[i];
+    if (c == copy_params.escape && i + 1 < csv.size() &&
+        csv[i + 1] == copy_params.quote) {
+      ++i;
+      has_escape = true;
+    } else if (copy_params.quoted && c == copy_params.quote) {
+      in_quote = !in_quote;
+      strip_quotes = strip_quotes || in_quote;
+    } else if (!in_quote && is_array && c == copy_params.array_begin &&
+               is_array[row.size()]) {
+      in_array = true;
+      while (i + 1 < csv.size()) {
+        if (csv[++i] == copy_params.array_end) {
+          in_array = false;
+          break;
+        }
+      }
+    } else if (!in_quote && (c == copy_params.delimiter || is_eol(c))) {
+      std::string field;
+      for (size_t j = field_begin; j < i; ++j) {
+        if (has_escape && csv[j] == copy_params.escape &&
+            csv[j + 1] == copy_params.quote) {
+          field.push_back(copy_params.quote);
+          ++j;
+        } else {
+          field.push_back(csv[j]);
+        }
+      }
+      const auto last = field.find_last_not_of(" \r");
+      field.erase(last == std::string::npos ? 0 : last + 1);
+      field.erase(0, field.find_first_not_of(" \r"));
+      if ((has_escape || strip_quotes) && copy_params.quoted) {
+        if (!field.empty() && field.front() == copy_params.quote) {
+          field.erase(0, 1);
+        }
+        if (!field.empty() && field.back() == copy_params.quote) {
+          field.pop_back();
+        }
+      }
+      row.push_back(field);
+      field_begin = i + 1;
+      has_escape = false;
+      strip_quotes = false;
+      if (is_eol(c)) {
+        while (filter_empty_lines && i + 1 < csv.size() && is_eol(csv[i + 1])) {
+          ++i;
+        }
+        break;
+      }
+    }
+  }
+  try_single_thread = in_quote || in_array;
+  return i;
+}
+
+std::string random_csv(std::mt19937& gen, const size_t size, const std::string& chars) {
+  std::uniform_int_distribution<size_t> dist(0, chars.size() - 1);
+  std::string csv;
+  for (size_t i = 0; i < size; ++i) {
+    csv.push_back(chars[dist(gen)]);
+  }
+  return csv;
+}
+
+std::vector<std::string_view> parse_row(const std::string& csv,
+                                        const CopyParams& copy_params,
+                                        std::vector<std::unique_ptr<char[]>>& tmp_buffers,
+                                        const bool* is_array = nullptr) {
+  std::vector<std::string_view> row;
+  bool try_single_thread{false};
+  delimited_parser::get_row(csv.data(),
+                            csv.data() + csv.size(),
+                            csv.data() + csv.size(),
+                            copy_params,
+                            is_array,
+                            row,
+                            tmp_buffers,
+                            try_single_thread,
+                            false);
+  EXPECT_FALSE(try_single_thread);
+  return row;
+}
+
+}  // namespace
+
+TEST(FindEnd, MatchesReference) {
+  std::mt19937 gen(17);
+  for (const auto& [quoted, escape] :
+       std::vector<std::pair<bool, char>>{{false, '"'}, {true, '"'}, {true, '\\'}}) {
+    CopyParams copy_params;
+    copy_params.quoted = quoted;
+    copy_params.escape = escape;
+    for (size_t i = 0; i < 200; ++i) {
+      auto csv = random_csv(gen, 1 + i * 7, "ab,\"\\\n");
+      csv.push_back('\n');
+      unsigned int num_rows{0};
+      bool in_quote{false};
+      unsigned int expected_num_rows{0};
+      bool expected_in_quote{false};
+      const auto expected_end =
+          find_end_reference(csv, copy_params, expected_num_rows, expected_in_quote);
+      if (expected_end == 1) {
+        continue;
+      }
+      EXPECT_EQ(expected_end,
+                delimited_parser::find_end(
+                    csv.data(), csv.size(), copy_params, num_rows, 0, in_quote, 0))
+          << csv;
+      EXPECT_EQ(expected_num_rows, num_rows) << csv;
+      EXPECT_EQ(expected_in_quote, in_quote) << csv;
+    }
+  }
+}
+
+TEST(FindEnd, ResumesInQuote) {
+  CopyParams copy_params;
+  const std::string csv = std::string(100, 'a') + "\n" + std::string(100, 'b') + "\"\n";
+  unsigned int num_rows{0};
+  bool in_quote{true};
+  // the first newline is quoted, the quote which started the region was in the part of
+  // the buffer scanned before
+  EXPECT_EQ(csv.size(),
+            delimited_parser::find_end(
+                csv.data(), csv.size(), copy_params, num_rows, 0, in_quote, 0));
+  EXPECT_EQ(1u, num_rows);
+  EXPECT_FALSE(in_quote);
+}
+
+TEST(GetRow, LongFields) {
+  CopyParams copy_params;
+  const auto long_field = std::string(100, 'x');
+  const auto csv = long_field + ",\"" + long_field + ",\"\"y\"\"\", " + long_field +
+                   " ,\"a\nb\"\n" + long_field + "\n";
+  std::vector<std::unique_ptr<char[]>> tmp_buffers;
+  const auto row = parse_row(csv, copy_params, tmp_buffers);
+  ASSERT_EQ(4u, row.size());
+  EXPECT_EQ(long_field, row[0]);
+  EXPECT_EQ(long_field + ",\"y\"", row[1]);
+  EXPECT_EQ(long_field, row[2]);
+  EXPECT_EQ("a\nb", row[3]);
+}
+
+TEST(GetRow, Arrays) {
+  CopyParams copy_params;
+  const auto csv = std::string(70, 'x') + ",{1,2,3}," + std::string(70, 'y') + "\n";
+  const bool is_array[] = {false, true, false};
+  std::vector<std::unique_ptr<char[]>> tmp_buffers;
+  const auto row = parse_row(csv, copy_params, tmp_buffers, is_array);
+  ASSERT_EQ(3u, row.size());
+  EXPECT_EQ(std::string(70, 'x'), row[0]);
+  EXPECT_EQ("{1,2,3}", row[1]);
+  EXPECT_EQ(std::string(70, 'y'), row[2]);
+}
+
+TEST(GetRow, TabDelimited) {
+  CopyParams copy_params;
+  copy_params.delimiter = '\t';
+  copy_params.quoted = false;
+  std::string csv;
+  for (size_t i = 0; i < 40; ++i) {
+    csv += std::to_string(i) + (i == 39 ? "\n" : "\t");
+  }
+  std::vector<std::unique_ptr<char[]>> tmp_buffers;
+  const auto row = parse_row(csv, copy_params, tmp_buffers);
+  ASSERT_EQ(40u, row.size());
+  for (size_t i = 0; i < row.size(); ++i) {
+    EXPECT_EQ(std::to_string(i), row[i]);
+  }
+}
+
+TEST(GetRow, MatchesReference) {
+  std::mt19937 gen(23);
+  // every other column is an array, for rows with more fields than that too
+  bool is_array[1024];
+  for (size_t i = 0; i < sizeof(is_array); ++i) {
+    is_array[i] = i % 2;
+  }
+  for (const auto& [quoted, escape] :
+       std::vector<std::pair<bool, char>>{{false, '"'}, {true, '"'}, {true, '\\'}}) {
+    CopyParams copy_params;
+    copy_params.quoted = quoted;
+    copy_params.escape = escape;
+    for (size_t i = 0; i < 400; ++i) {
+      auto csv = random_csv(gen, 1 + i * 3, "ab ,\"\\{}\r\n");
+      csv += "\r\n";
+      const bool* row_is_array = i % 3 ? is_array : nullptr;
+      const bool filter_empty_lines = i % 2;
+      std::vector<std::string> expected_row;
+      bool expected_try_single_thread{false};
+      const auto expected_end = get_row_reference(csv,
+                                                  copy_params,
+                                                  row_is_array,
+                                                  filter_empty_lines,
+                                                  expected_row,
+                                                  expected_try_single_thread);
+      std::vector<std::string> row;
+      std::vector<std::unique_ptr<char[]>> tmp_buffers;
+      bool try_single_thread{false};
+      const auto end = delimited_parser::get_row(csv.data(),
+                                                 csv.data() + csv.size(),
+                                                 csv.data() + csv.size(),
+                                                 copy_params,
+                                                 row_is_array,
+                                                 row,
+                                                 tmp_buffers,
+                                                 try_single_thread,
+                                                 filter_empty_lines);
+      EXPECT_EQ(expected_end, size_t(end - csv.data())) << csv;
+      EXPECT_EQ(expected_row, row) << csv;
+      EXPECT_EQ(expected_try_single_thread, try_single_thread) << csv;
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
@@ -23,6 +23,7 @@
 #include <boost/filesystem.hpp>
 
 #include "DataMgr/AbstractBuffer.h"
+#include "DataMgr/CompressedIntEncoding.h"
 #include "DataMgr/Encoder.h"
 #include "DataMgr/MemoryLevel.h"
 #include "Shared/DatumFetchers.h"
@@ -763,6 +764,169 @@ TYPED_TEST(FixedLengthArrayNoneEncoderUpdateStatsTest, TypedTest) {
   TestFixture::runTest();
 }
 
+class MemoryBuffer : public TestBuffer {
+ public:
+  MemoryBuffer(const SQLTypeInfo sql_type) : TestBuffer(sql_type) {}
+
+  void read(int8_t* const dst,
+            const size_t num_bytes,
+            const size_t offset,
+            const MemoryLevel dst_buffer_type,
+            const int dst_device_id) override {
+    CHECK_LE(offset + num_bytes, size_);
+    std::memcpy(dst, data_.data() + offset, num_bytes);
+  }
+
+  void write(int8_t* src,
+             const size_t num_bytes,
+             const size_t offset,
+             const MemoryLevel src_buffer_type,
+             const int src_device_id) override {
+    if (offset + num_bytes > data_.size()) {
+      data_.resize(offset + num_bytes);
+    }
+    std::memcpy(data_.data() + offset, src, num_bytes);
+    size_ = std::max(size_, offset + num_bytes);
+  }
+
+  void append(int8_t* src,
+              const size_t num_bytes,
+              const MemoryLevel src_buffer_type,
+              const int device_id) override {
+    write(src, num_bytes, size_, src_buffer_type, device_id);
+  }
+
+  int8_t* getMemoryPtr() override { return data_.data(); }
+
+ private:
+  std::vector<int8_t> data_;
+};
+
+class CompressedIntEncoderTest : public testing::Test {
+ protected:
+  template <typename T>
+  void appendAndCheck(const SQLTypeInfo& ti,
+                      const std::vector<std::vector<T>>& batches) {
+    MemoryBuffer buffer(ti);
+    std::vector<T> expected;
+    for (const auto& batch : batches) {
+      auto src = reinterpret_cast<int8_t*>(const_cast<T*>(batch.data()));
+      buffer.getEncoder()->appendData(src, batch.size(), ti);
+      expected.insert(expected.end(), batch.begin(), batch.end());
+    }
+    ASSERT_EQ(buffer.getEncoder()->getNumElems(), expected.size());
+    ASSERT_EQ(buffer.size(),
+              get_compressed_int_encoded_size(
+                  ti, buffer.getMemoryPtr(), expected.size()));
+    std::vector<T> decoded(expected.size());
+    decode_compressed_ints(ti,
+                           buffer.getMemoryPtr(),
+                           expected.size(),
+                           reinterpret_cast<int8_t*>(decoded.data()));
+    ASSERT_EQ(decoded, expected);
+
+    const auto reencoded = encode_compressed_ints(
+        ti, reinterpret_cast<const int8_t*>(expected.data()), expected.size());
+    ASSERT_EQ(reencoded.size(), buffer.size());
+
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    buffer.getEncoder()->getMetadata(chunk_metadata);
+    const auto null_val = inline_int_null_value<T>();
+    const bool has_nulls =
+        std::find(expected.begin(), expected.end(), null_val) != expected.end();
+    ASSERT_EQ(chunk_metadata->chunkStats.has_nulls, has_nulls);
+  }
+};
+
+TEST_F(CompressedIntEncoderTest, RunLength) {
+  SQLTypeInfo ti(kINT, false, kENCODING_RL);
+  const auto null_val = inline_int_null_value<int32_t>();
+  appendAndCheck<int32_t>(ti, {{1, 1, 1, 2, 2, null_val, null_val, 3}});
+  // appends extending the last run of the chunk and starting new ones
+  appendAndCheck<int32_t>(ti, {{5, 5}, {5, 5, 7}, {7}, {null_val, 8}});
+
+  SQLTypeInfo bigint_ti(kBIGINT, false, kENCODING_RL);
+  appendAndCheck<int64_t>(
+      bigint_ti,
+      {{std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::max(), 0},
+       {0, -1}});
+}
+
+TEST_F(CompressedIntEncoderTest, RunLengthFewRuns) {
+  SQLTypeInfo ti(kSMALLINT, false, kENCODING_RL);
+  std::vector<int16_t> values(10000);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = i / 1000;
+  }
+  MemoryBuffer buffer(ti);
+  auto src = reinterpret_cast<int8_t*>(values.data());
+  buffer.getEncoder()->appendData(src, values.size(), ti);
+  // ten runs of (int32 end, int32 value) after the run count
+  ASSERT_EQ(buffer.size(), sizeof(int64_t) + 10 * 2 * sizeof(int32_t));
+  appendAndCheck<int16_t>(ti, {values});
+}
+
+TEST_F(CompressedIntEncoderTest, Diff) {
+  SQLTypeInfo ti(kBIGINT, false, kENCODING_DIFF);
+  ti.set_comp_param(8);
+  std::vector<int64_t> values(3000);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = 1000000000000 + static_cast<int64_t>(i % 100);
+  }
+  values[17] = inline_int_null_value<int64_t>();
+  appendAndCheck<int64_t>(ti, {values});
+
+  MemoryBuffer buffer(ti);
+  auto src = reinterpret_cast<int8_t*>(values.data());
+  buffer.getEncoder()->appendData(src, values.size(), ti);
+  // one byte deltas in three blocks
+  ASSERT_EQ(buffer.size(),
+            2 * sizeof(int32_t) + 3 * sizeof(int64_t) + values.size() * sizeof(int8_t));
+}
+
+TEST_F(CompressedIntEncoderTest, DiffWidening) {
+  SQLTypeInfo ti(kINT, false, kENCODING_DIFF);
+  ti.set_comp_param(8);
+  const auto null_val = inline_int_null_value<int32_t>();
+  // the later batches need wider deltas, re-encoding what's already in the chunk
+  appendAndCheck<int32_t>(ti,
+                          {{10, 11, null_val, 12},
+                           {500, -500},
+                           {std::numeric_limits<int32_t>::max(), null_val},
+                           {std::numeric_limits<int32_t>::min() + 1}});
+  std::vector<int32_t> values(2500);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = i * 3;
+  }
+  appendAndCheck<int32_t>(
+      ti,
+      {std::vector<int32_t>(values.begin(), values.begin() + 1000),
+       std::vector<int32_t>(values.begin() + 1000, values.begin() + 1030),
+       std::vector<int32_t>(values.begin() + 1030, values.end())});
+}
+
+TEST_F(CompressedIntEncoderTest, Overwrite) {
+  SQLTypeInfo ti(kINT, false, kENCODING_RL);
+  MemoryBuffer buffer(ti);
+  std::vector<int32_t> values{1, 1, 2};
+  auto src = reinterpret_cast<int8_t*>(values.data());
+  buffer.getEncoder()->appendData(src, values.size(), ti);
+  src = reinterpret_cast<int8_t*>(values.data());
+  ASSERT_THROW(buffer.getEncoder()->appendData(src, 1, ti, false, 1),
+               std::runtime_error);
+  // rewriting the whole chunk replaces it
+  std::vector<int32_t> new_values{4, 4, 4, 4};
+  src = reinterpret_cast<int8_t*>(new_values.data());
+  buffer.getEncoder()->appendData(src, new_values.size(), ti, false, 0);
+  ASSERT_EQ(buffer.getEncoder()->getNumElems(), new_values.size());
+  std::vector<int32_t> decoded(new_values.size());
+  decode_compressed_ints(ti,
+                         buffer.getMemoryPtr(),
+                         decoded.size(),
+                         reinterpret_cast<int8_t*>(decoded.data()));
+  ASSERT_EQ(decoded, new_values);
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -21,6 +21,7 @@
 #include "../QueryEngine/ArrowResultSet.h"
 #include "../QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
 #include "../QueryEngine/Execute.h"
+#include "../QueryEngine/ResultCache.h"
 #include "../QueryEngine/ResultSetReductionJIT.h"
 #include "../QueryRunner/QueryRunner.h"
 #include "../Shared/DateConverters.h"
@@ -59,12 +60,29 @@ extern unsigned g_trivial_loop_join_threshold;
 extern bool g_enable_overlaps_hashjoin;
 extern double g_gpu_mem_limit_percent;
 extern size_t g_parallel_top_min;
+extern size_t g_parallel_sort_min;
+extern bool g_enable_cpu_shared_group_by_buffer;
+extern size_t g_cpu_shared_group_by_buffer_min_entries;
+extern bool g_enable_group_by_spill;
+extern bool g_force_group_by_spill;
+extern size_t g_group_by_spill_partitions;
+extern size_t g_group_by_spill_threshold_bytes;
+extern bool g_enable_multifrag_rs;
 
 extern bool g_enable_window_functions;
+extern size_t g_parallel_window_partition_compute_threshold;
+extern size_t g_parallel_window_partition_sort_threshold;
 extern bool g_enable_calcite_view_optimize;
 extern bool g_enable_bump_allocator;
 extern bool g_enable_interop;
 extern bool g_enable_union;
+extern size_t g_concurrent_subquery_executors;
+extern bool g_enable_columnar_intermediate_results;
+extern bool g_enable_batch_cpu_codegen;
+extern size_t g_batch_cpu_codegen_size;
+extern bool g_enable_runtime_query_interrupt;
+extern double g_running_query_interrupt_freq;
+extern unsigned g_pending_query_interrupt_freq;
 
 extern size_t g_leaf_count;
 extern bool g_cluster;
@@ -6315,6 +6333,147 @@ TEST(Select, OverflowAndUnderFlow) {
   }
 }
 
+TEST(Select, BatchCpuCodegen) {
+  auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
+  ScopeGuard reset = [orig_enable = g_enable_batch_cpu_codegen,
+                      orig_batch_size = g_batch_cpu_codegen_size,
+                      orig_interrupt = g_enable_runtime_query_interrupt,
+                      orig_running_freq = g_running_query_interrupt_freq,
+                      orig_pending_freq = g_pending_query_interrupt_freq] {
+    g_enable_batch_cpu_codegen = orig_enable;
+    g_batch_cpu_codegen_size = orig_batch_size;
+    g_enable_runtime_query_interrupt = orig_interrupt;
+    g_running_query_interrupt_freq = orig_running_freq;
+    g_pending_query_interrupt_freq = orig_pending_freq;
+  };
+  g_enable_batch_cpu_codegen = true;
+  const auto dt = ExecutorDeviceType::CPU;
+  // batches smaller than a fragment, not dividing it, and larger than it
+  for (size_t batch_size : {1, 7, 1024}) {
+    g_batch_cpu_codegen_size = batch_size;
+    // filters
+    c("SELECT COUNT(*) FROM test WHERE x > 6 AND x < 8;", dt);
+    c("SELECT SUM(x + y), MIN(z), MAX(t) FROM test WHERE x <> 7 OR z > 101;", dt);
+    c("SELECT SUM(ff), MAX(d) FROM test WHERE y > 42 AND t < 1002;", dt);
+    c("SELECT COUNT(*) FROM test WHERE x + y + z + t = 1151;", dt);
+    // nulls
+    c("SELECT COUNT(smallint_nulls), COUNT(*), COUNT(fn) FROM test;", dt);
+    c("SELECT SUM(fn), MIN(fn), MAX(ofq) FROM test;", dt);
+    c("SELECT COUNT(*) FROM test WHERE smallint_nulls IS NULL;", dt);
+    c("SELECT SUM(smallint_nulls + x) FROM test WHERE fn IS NOT NULL;", dt);
+    // overflow checks, the error of a row is reported at the end of its batch
+    c("SELECT COUNT(*) FROM test WHERE z + 32666 > 0;", dt);
+    EXPECT_THROW(
+        run_multiple_agg("SELECT COUNT(*) FROM test WHERE x + 2147483640 > 0;", dt),
+        std::runtime_error);
+    EXPECT_THROW(run_multiple_agg(
+                     "SELECT COUNT(*) FROM test WHERE t + 9223372036854775000 > 0;", dt),
+                 std::runtime_error);
+    EXPECT_THROW(run_multiple_agg("SELECT COUNT(*) FROM test WHERE ofq + 1 > 0;", dt),
+                 std::runtime_error);
+    // the interrupt flag is checked once per batch, a query which isn't interrupted
+    // has to give the same result
+    executor->enableRuntimeQueryInterrupt(g_running_query_interrupt_freq,
+                                          g_pending_query_interrupt_freq);
+    const auto query = "SELECT COUNT(*), SUM(x) FROM test WHERE y > 42;";
+    const auto rows = QR::get()->runSQLWithAllowingInterrupt(
+        query, generate_random_string(32), dt);
+    ASSERT_EQ(size_t(1), rows->rowCount());
+    const auto crt_row = rows->getNextRow(true, true);
+    ASSERT_EQ(size_t(2), crt_row.size());
+    const auto expected_rows = run_multiple_agg(query, dt);
+    const auto expected_row = expected_rows->getNextRow(true, true);
+    EXPECT_EQ(v<int64_t>(expected_row[0]), v<int64_t>(crt_row[0]));
+    EXPECT_EQ(v<int64_t>(expected_row[1]), v<int64_t>(crt_row[1]));
+    g_enable_runtime_query_interrupt = false;
+  }
+}
+
+namespace {
+
+std::string compressed_int_test_row(const int i) {
+  const auto null_or = [](const bool is_null, const std::string& value) {
+    return is_null ? std::string("NULL") : value;
+  };
+  // runs of 4 and 10 values, deltas which outgrow DIFF(8) and DIFF(16) partway
+  const int64_t diff_i = i < 20 ? i % 7 : int64_t(100000) * i - 3;
+  const int64_t diff_b = i < 40 ? -5 * i : (int64_t(1) << 40) + i;
+  return "(" + std::to_string(i) + ", " + null_or(i % 11 == 10, std::to_string(i / 4)) +
+         ", " + std::to_string(int64_t(10000000000) * (i / 10)) + ", " +
+         null_or(i % 9 == 4, std::to_string(diff_i)) + ", " + std::to_string(diff_b) +
+         ", " + null_or(i % 13 == 0, std::to_string(i) + ".25") + ")";
+}
+
+// a table with RL and DIFF encoded columns spanning several fragments, and its sqlite
+// copy with the same rows
+void create_compressed_int_test(const std::string& table_name,
+                                const int num_rows,
+                                const ExecutorDeviceType dt) {
+  run_ddl_statement("DROP TABLE IF EXISTS " + table_name + ";");
+  g_sqlite_comparator.query("DROP TABLE IF EXISTS " + table_name + ";");
+  run_ddl_statement(build_create_table_statement(
+      "id INT, rl_i INT ENCODING RL, rl_b BIGINT ENCODING RL, diff_i INT ENCODING "
+      "DIFF(8), diff_b BIGINT ENCODING DIFF(16), diff_d DECIMAL(10,2) ENCODING DIFF",
+      table_name,
+      {"", 0},
+      {},
+      16,
+      g_use_temporary_tables,
+      true,
+      false));
+  g_sqlite_comparator.query(
+      "CREATE TABLE " + table_name +
+      "(id INT, rl_i INT, rl_b BIGINT, diff_i INT, diff_b BIGINT, diff_d "
+      "DECIMAL(10,2));");
+  for (int i = 0; i < num_rows; ++i) {
+    const auto insert_query =
+        "INSERT INTO " + table_name + " VALUES " + compressed_int_test_row(i) + ";";
+    run_multiple_agg(insert_query, dt);
+    g_sqlite_comparator.query(insert_query);
+  }
+}
+
+}  // namespace
+
+TEST(Select, RunLengthAndDiffEncodings) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    const std::string table_name{"compressed_int_test"};
+    create_compressed_int_test(table_name, 0, dt);
+    ScopeGuard drop_table = [&table_name] {
+      run_ddl_statement("DROP TABLE IF EXISTS " + table_name + ";");
+      g_sqlite_comparator.query("DROP TABLE IF EXISTS " + table_name + ";");
+    };
+    const std::string select_all{"SELECT id, rl_i, rl_b, diff_i, diff_b, diff_d FROM " +
+                                 table_name + " ORDER BY id;"};
+
+    // the chunks are read between the appends, which extend the last run of a RL chunk
+    // and widen the deltas of a DIFF chunk
+    for (int i = 0; i < 45; ++i) {
+      const auto insert_query =
+          "INSERT INTO " + table_name + " VALUES " + compressed_int_test_row(i) + ";";
+      run_multiple_agg(insert_query, dt);
+      g_sqlite_comparator.query(insert_query);
+      if (i % 3 == 2) {
+        c(select_all, dt);
+      }
+    }
+    c("SELECT COUNT(*), SUM(rl_i), MIN(rl_b), MAX(diff_i), SUM(diff_b), SUM(diff_d) "
+      "FROM compressed_int_test;",
+      dt);
+    c("SELECT rl_i, COUNT(*), MAX(diff_i) FROM compressed_int_test WHERE rl_i IS NOT "
+      "NULL GROUP BY rl_i ORDER BY rl_i;",
+      dt);
+    c("SELECT COUNT(*) FROM compressed_int_test WHERE diff_i > 1000 AND rl_i < 9 AND "
+      "diff_d IS NOT NULL;",
+      dt);
+    c("SELECT id FROM compressed_int_test WHERE rl_b = 20000000000 AND diff_b < -110 "
+      "ORDER BY id;",
+      dt);
+  }
+}
+
 TEST(Select, BooleanColumn) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -8195,6 +8354,164 @@ TEST(Select, SpeculativeTopNSort) {
   }
 }
 
+TEST(Select, ParallelSort) {
+  ScopeGuard reset = [orig = g_parallel_sort_min] { g_parallel_sort_min = orig; };
+  size_t test_values[]{size_t(0), g_parallel_sort_min};
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (auto parallel_sort_min : test_values) {
+      g_parallel_sort_min = parallel_sort_min;
+      c("SELECT x, y, z FROM test ORDER BY x DESC, y, z;", dt);
+      c("SELECT d, x FROM test ORDER BY d, x;", dt);
+      c("SELECT f, x FROM test ORDER BY f DESC, x;", dt);
+      c("SELECT fn FROM test ORDER BY fn ASC NULLS FIRST;",
+        "SELECT fn FROM test ORDER BY fn ASC;",
+        dt);
+      c("SELECT str, x FROM test ORDER BY str DESC, x;", dt);
+      c("SELECT x, COUNT(*) AS val FROM gpu_sort_test GROUP BY x ORDER BY val DESC, x;",
+        dt);
+      c("SELECT y, COUNT(*) AS val FROM gpu_sort_test GROUP BY y ORDER BY val, y LIMIT "
+        "100;",
+        dt);
+    }
+  }
+}
+
+TEST(Select, GroupBySharedBufferMaxKey) {
+  ScopeGuard reset = [orig_enable = g_enable_cpu_shared_group_by_buffer,
+                      orig_min_entries = g_cpu_shared_group_by_buffer_min_entries] {
+    g_enable_cpu_shared_group_by_buffer = orig_enable;
+    g_cpu_shared_group_by_buffer_min_entries = orig_min_entries;
+  };
+  g_enable_cpu_shared_group_by_buffer = true;
+  g_cpu_shared_group_by_buffer_min_entries = 0;
+  const auto dt = ExecutorDeviceType::CPU;
+  run_ddl_statement("DROP TABLE IF EXISTS shared_gb_max_key;");
+  run_ddl_statement(
+      "CREATE TABLE shared_gb_max_key (x INT, y INT, z BIGINT) WITH "
+      "(fragment_size=2);");
+  // the maximum values of the last key component are the empty keys of the buffer
+  for (size_t i = 0; i < 4; ++i) {
+    run_multiple_agg(
+        "INSERT INTO shared_gb_max_key VALUES(0, 2147483647, 9223372036854775807);", dt);
+    run_multiple_agg(
+        "INSERT INTO shared_gb_max_key VALUES(1000000000, 2147483647, 0);", dt);
+    run_multiple_agg("INSERT INTO shared_gb_max_key VALUES(0, 0, 0);", dt);
+  }
+  const auto check_rows = [](const auto& rows,
+                             const std::vector<std::vector<int64_t>>& expected) {
+    ASSERT_EQ(rows->rowCount(), expected.size());
+    for (const auto& expected_row : expected) {
+      const auto row = rows->getNextRow(true, true);
+      ASSERT_EQ(row.size(), expected_row.size());
+      for (size_t i = 0; i < row.size(); ++i) {
+        ASSERT_EQ(v<int64_t>(row[i]), expected_row[i]);
+      }
+    }
+  };
+  check_rows(run_multiple_agg("SELECT x, y, COUNT(*) FROM shared_gb_max_key GROUP BY "
+                              "x, y ORDER BY x, y;",
+                              dt),
+             {{0, 0, 4}, {0, 2147483647, 4}, {1000000000, 2147483647, 4}});
+  check_rows(run_multiple_agg("SELECT x, z, COUNT(*) FROM shared_gb_max_key GROUP BY "
+                              "x, z ORDER BY x, z;",
+                              dt),
+             {{0, 0, 4}, {0, 9223372036854775807, 4}, {1000000000, 0, 4}});
+  run_ddl_statement("DROP TABLE shared_gb_max_key;");
+}
+
+TEST(Select, GroupBySpill) {
+  ScopeGuard reset = [orig_enable = g_enable_group_by_spill,
+                      orig_force = g_force_group_by_spill,
+                      orig_partitions = g_group_by_spill_partitions] {
+    g_enable_group_by_spill = orig_enable;
+    g_force_group_by_spill = orig_force;
+    g_group_by_spill_partitions = orig_partitions;
+  };
+  g_enable_group_by_spill = true;
+  g_force_group_by_spill = true;
+  const auto dt = ExecutorDeviceType::CPU;
+  for (size_t partitions : {1, 3, 8}) {
+    g_group_by_spill_partitions = partitions;
+    c("SELECT x, d, COUNT(*) FROM test GROUP BY x, d ORDER BY x, d;", dt);
+    c("SELECT y, t, SUM(x), MIN(z) FROM test GROUP BY y, t ORDER BY y, t;", dt);
+    c("SELECT str, d, MAX(x) FROM test GROUP BY str, d ORDER BY str, d;", dt);
+    c("SELECT x, d, COUNT(*) AS n FROM test GROUP BY x, d ORDER BY n DESC, x, d "
+      "LIMIT 2;",
+      dt);
+    c("SELECT y, COUNT(*) FROM test GROUP BY y ORDER BY y;", dt);
+  }
+}
+
+TEST(Select, GroupBySpillOutOfMemory) {
+  ScopeGuard reset = [orig_enable = g_enable_group_by_spill,
+                      orig_force = g_force_group_by_spill,
+                      orig_partitions = g_group_by_spill_partitions,
+                      orig_threshold = g_group_by_spill_threshold_bytes,
+                      orig_multifrag_rs = g_enable_multifrag_rs] {
+    g_enable_group_by_spill = orig_enable;
+    g_force_group_by_spill = orig_force;
+    g_group_by_spill_partitions = orig_partitions;
+    g_group_by_spill_threshold_bytes = orig_threshold;
+    g_enable_multifrag_rs = orig_multifrag_rs;
+  };
+  const auto dt = ExecutorDeviceType::CPU;
+  run_ddl_statement("DROP TABLE IF EXISTS spill_oom;");
+  run_ddl_statement("CREATE TABLE spill_oom (k BIGINT, v INT);");
+  // keys too far apart for perfect hash, spread evenly over the residues of any modulus
+  const int64_t key_step{10000000001};
+  const int64_t row_count{64};
+  for (int64_t i = 0; i < row_count; ++i) {
+    run_multiple_agg("INSERT INTO spill_oom VALUES (" + std::to_string(i * key_step) +
+                         ", " + std::to_string(i) + ");",
+                     dt);
+  }
+  g_enable_group_by_spill = true;
+  g_force_group_by_spill = false;
+  // a single initial partition doesn't fit either and gets split until the buffers of
+  // its parts fit
+  g_group_by_spill_partitions = 1;
+  g_group_by_spill_threshold_bytes = 256;
+
+  {
+    const auto rows = run_multiple_agg(
+        "SELECT k, SUM(v), COUNT(*) FROM spill_oom GROUP BY k ORDER BY k;", dt);
+    ASSERT_EQ(rows->rowCount(), size_t(row_count));
+    for (int64_t i = 0; i < row_count; ++i) {
+      const auto row = rows->getNextRow(true, true);
+      ASSERT_EQ(row.size(), size_t(3));
+      ASSERT_EQ(v<int64_t>(row[0]), i * key_step);
+      ASSERT_EQ(v<int64_t>(row[1]), i);
+      ASSERT_EQ(v<int64_t>(row[2]), 1);
+    }
+  }
+  {
+    // top n, merged from the runs
+    const auto rows = run_multiple_agg(
+        "SELECT k, SUM(v) AS s FROM spill_oom GROUP BY k ORDER BY s DESC LIMIT 3 "
+        "OFFSET 1;",
+        dt);
+    ASSERT_EQ(rows->rowCount(), size_t(3));
+    for (int64_t i = row_count - 2; i > row_count - 5; --i) {
+      const auto row = rows->getNextRow(true, true);
+      ASSERT_EQ(v<int64_t>(row[0]), i * key_step);
+      ASSERT_EQ(v<int64_t>(row[1]), i);
+    }
+  }
+  for (const bool multifrag_rs : {false, true}) {
+    // the runs are the fragments of an intermediate result
+    g_enable_multifrag_rs = multifrag_rs;
+    const auto rows = run_multiple_agg(
+        "SELECT COUNT(*), SUM(s) FROM (SELECT k, SUM(v) AS s FROM spill_oom GROUP BY k);",
+        dt);
+    const auto row = rows->getNextRow(true, true);
+    ASSERT_EQ(row.size(), size_t(2));
+    ASSERT_EQ(v<int64_t>(row[0]), row_count);
+    ASSERT_EQ(v<int64_t>(row[1]), row_count * (row_count - 1) / 2);
+  }
+  run_ddl_statement("DROP TABLE spill_oom;");
+}
+
 TEST(Select, GroupByPerfectHash) {
   const auto default_bigint_flag = g_bigint_count;
   ScopeGuard reset = [default_bigint_flag] { g_bigint_count = default_bigint_flag; };
@@ -8803,6 +9120,140 @@ TEST(Select, Subqueries) {
   }
 }
 
+TEST(Select, ConcurrentSubqueries) {
+  const auto concurrent_subquery_executors = g_concurrent_subquery_executors;
+  ScopeGuard reset = [concurrent_subquery_executors] {
+    g_concurrent_subquery_executors = concurrent_subquery_executors;
+  };
+  for (size_t executors : {1, 3}) {
+    g_concurrent_subquery_executors = executors;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT COUNT(*) FROM test WHERE x > (SELECT MIN(x) FROM test) AND y < (SELECT "
+        "MAX(y) FROM test) AND z <> (SELECT MIN(z) FROM test_inner);",
+        dt);
+      c("SELECT COUNT(*) FROM test WHERE x IN (SELECT x FROM test WHERE y > 42) AND y "
+        "NOT IN (SELECT y FROM test WHERE x = 8) AND x IN (SELECT x FROM join_test);",
+        dt);
+      c("SELECT (SELECT COUNT(*) FROM test), (SELECT MAX(x) FROM test_inner), (SELECT "
+        "SUM(y) FROM test WHERE x > 7) FROM test LIMIT 1;",
+        dt);
+      // nested subqueries wait for the subqueries they contain
+      c("SELECT x FROM test WHERE x = (SELECT MIN(X) m FROM test GROUP BY x HAVING x <= "
+        "(SELECT MIN(x) FROM test)) AND y > (SELECT MIN(y) FROM test);",
+        dt);
+      c("SELECT COUNT(*) FROM subquery_test WHERE x NOT IN (SELECT x + 1 FROM "
+        "subquery_test GROUP BY x) AND x < (SELECT MAX(x) FROM subquery_test);",
+        dt);
+    }
+  }
+}
+
+TEST(Select, ColumnarIntermediateResults) {
+  const auto columnar_intermediate_results = g_enable_columnar_intermediate_results;
+  ScopeGuard reset = [columnar_intermediate_results] {
+    g_enable_columnar_intermediate_results = columnar_intermediate_results;
+  };
+  g_enable_columnar_intermediate_results = true;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT MIN(yy), MAX(yy) FROM (SELECT AVG(y) as yy FROM test GROUP BY x);", dt);
+    c("SELECT * FROM (SELECT x, y FROM test WHERE y > 41) ORDER BY x, y;", dt);
+    c("SELECT SUM(x2), COUNT(*) FROM (SELECT x * 2 AS x2, y FROM test WHERE z > 100) "
+      "WHERE y < 43;",
+      dt);
+    c("SELECT str, COUNT(*) FROM (SELECT str, x FROM test WHERE x > 7) GROUP BY str "
+      "ORDER BY str;",
+      dt);
+    c("SELECT test.z, SUM(test.y) s FROM test JOIN (SELECT x FROM test_inner) b ON "
+      "test.x = b.x GROUP BY test.z ORDER BY s;",
+      dt);
+    c("SELECT AVG(y) FROM (SELECT * FROM test ORDER BY z LIMIT 5);", dt);
+    c("select sum(x) from (select distinct * from subquery_test);", dt);
+  }
+}
+
+TEST(Select, ResultCache) {
+  SKIP_ALL_ON_AGGREGATOR();
+  const auto enable_result_cache = g_enable_result_cache;
+  ScopeGuard reset = [enable_result_cache] {
+    g_enable_result_cache = enable_result_cache;
+    ResultCache::instance().clear();
+    run_ddl_statement("DROP TABLE IF EXISTS result_cache_test;");
+  };
+  g_enable_result_cache = true;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    run_ddl_statement("DROP TABLE IF EXISTS result_cache_test;");
+    run_ddl_statement(
+        "CREATE TABLE result_cache_test (x INT, y BIGINT) WITH (vacuum='delayed');");
+    run_multiple_agg("INSERT INTO result_cache_test VALUES (1, 10);", dt);
+    run_multiple_agg("INSERT INTO result_cache_test VALUES (2, 20);", dt);
+
+    const std::string sum_query{"SELECT SUM(y) FROM result_cache_test WHERE x > 0;"};
+    ASSERT_EQ(int64_t(30), v<int64_t>(run_simple_agg(sum_query, dt)));
+    auto stats = ResultCache::instance().getStats();
+    ASSERT_EQ(int64_t(30), v<int64_t>(run_simple_agg(sum_query, dt)));
+    EXPECT_EQ(stats.hits + 1, ResultCache::instance().getStats().hits);
+
+    // the intermediate result is cached too
+    const std::string nested_query{
+        "SELECT MAX(s) FROM (SELECT x, SUM(y) AS s FROM result_cache_test GROUP BY x);"};
+    ASSERT_EQ(int64_t(20), v<int64_t>(run_simple_agg(nested_query, dt)));
+    stats = ResultCache::instance().getStats();
+    ASSERT_EQ(int64_t(20), v<int64_t>(run_simple_agg(nested_query, dt)));
+    EXPECT_LE(stats.hits + 1, ResultCache::instance().getStats().hits);
+    EXPECT_EQ(stats.misses, ResultCache::instance().getStats().misses);
+
+    stats = ResultCache::instance().getStats();
+    run_multiple_agg("INSERT INTO result_cache_test VALUES (3, 30);", dt);
+    EXPECT_LT(stats.invalidations, ResultCache::instance().getStats().invalidations);
+    ASSERT_EQ(int64_t(60), v<int64_t>(run_simple_agg(sum_query, dt)));
+    ASSERT_EQ(int64_t(30), v<int64_t>(run_simple_agg(nested_query, dt)));
+
+    run_multiple_agg("UPDATE result_cache_test SET y = 5 WHERE x = 1;", dt);
+    ASSERT_EQ(int64_t(55), v<int64_t>(run_simple_agg(sum_query, dt)));
+    run_multiple_agg("DELETE FROM result_cache_test WHERE x = 3;", dt);
+    ASSERT_EQ(int64_t(25), v<int64_t>(run_simple_agg(sum_query, dt)));
+    ASSERT_EQ(int64_t(20), v<int64_t>(run_simple_agg(nested_query, dt)));
+
+    const std::string count_query{"SELECT COUNT(*) FROM result_cache_test;"};
+    ASSERT_EQ(int64_t(2), v<int64_t>(run_simple_agg(count_query, dt)));
+    run_ddl_statement("TRUNCATE TABLE result_cache_test;");
+    ASSERT_EQ(int64_t(0), v<int64_t>(run_simple_agg(count_query, dt)));
+  }
+}
+
+TEST(Select, ResultCacheEviction) {
+  SKIP_ALL_ON_AGGREGATOR();
+  const auto enable_result_cache = g_enable_result_cache;
+  const auto result_cache_max_size_bytes = g_result_cache_max_size_bytes;
+  ScopeGuard reset = [enable_result_cache, result_cache_max_size_bytes] {
+    g_enable_result_cache = enable_result_cache;
+    g_result_cache_max_size_bytes = result_cache_max_size_bytes;
+    ResultCache::instance().clear();
+  };
+  g_enable_result_cache = true;
+  ResultCache::instance().clear();
+  g_result_cache_max_size_bytes = 1;
+  const auto stats = ResultCache::instance().getStats();
+  c("SELECT COUNT(*) FROM test WHERE x > 7;", ExecutorDeviceType::CPU);
+  EXPECT_EQ(size_t(0), ResultCache::instance().getStats().num_entries);
+  EXPECT_EQ(stats.hits, ResultCache::instance().getStats().hits);
+
+  g_result_cache_max_size_bytes = 0;
+  for (int i = 0; i < 4; ++i) {
+    c("SELECT SUM(x + " + std::to_string(i) + ") FROM test;", ExecutorDeviceType::CPU);
+  }
+  const auto size_bytes = ResultCache::instance().getStats().size_bytes;
+  ASSERT_EQ(size_t(4), ResultCache::instance().getStats().num_entries);
+  // room for two of the four entries, which are about the same size
+  g_result_cache_max_size_bytes = size_bytes / 2 + 1;
+  c("SELECT SUM(x + 4) FROM test;", ExecutorDeviceType::CPU);
+  EXPECT_GE(size_t(2), ResultCache::instance().getStats().num_entries);
+  EXPECT_LE(size_t(3), ResultCache::instance().getStats().evictions - stats.evictions);
+}
+
 TEST(Select, Export_Via_Query_Having_Scalar_Subquery) {
   // EXPORT stmt needs "validation_query" to gather some info from the query
   // before doing the actual data export
@@ -15925,6 +16376,54 @@ TEST(Update, MultiColumnInteger) {
   }
 }
 
+TEST(Update, RunLengthAndDiffEncodings) {
+  SKIP_ALL_ON_AGGREGATOR();
+  SKIP_WITH_TEMP_TABLES();
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    const std::string table_name{"compressed_int_test"};
+    create_compressed_int_test(table_name, 45, dt);
+    ScopeGuard drop_table = [&table_name] {
+      run_ddl_statement("DROP TABLE IF EXISTS " + table_name + ";");
+      g_sqlite_comparator.query("DROP TABLE IF EXISTS " + table_name + ";");
+    };
+    const std::string select_all{"SELECT id, rl_i, rl_b, diff_i, diff_b, diff_d FROM " +
+                                 table_name + " ORDER BY id;"};
+
+    auto run_both = [dt](const std::string& query) {
+      run_multiple_agg(query, dt);
+      g_sqlite_comparator.query(query);
+    };
+    // splits and merges runs
+    run_both("UPDATE " + table_name + " SET rl_i = rl_i + 1 WHERE id % 3 = 0;");
+    c(select_all, dt);
+    // values which don't fit the delta width of their chunk
+    run_both("UPDATE " + table_name +
+             " SET diff_i = diff_i * 1000000, diff_d = diff_d * 1000 WHERE id < 5;");
+    c(select_all, dt);
+    run_both("UPDATE " + table_name + " SET rl_b = NULL, diff_b = id WHERE id > 30;");
+    c(select_all, dt);
+    c("SELECT rl_b, COUNT(*) FROM compressed_int_test WHERE rl_b IS NOT NULL GROUP BY "
+      "rl_b ORDER BY rl_b;",
+      dt);
+
+    // vacuum re-encodes the kept rows
+    run_both("DELETE FROM " + table_name + " WHERE id % 4 = 1;");
+    run_ddl_statement("OPTIMIZE TABLE " + table_name + " WITH (VACUUM='true');");
+    c(select_all, dt);
+    c("SELECT COUNT(*), SUM(rl_i), MIN(diff_i), MAX(diff_b) FROM compressed_int_test;",
+      dt);
+    // appends after the vacuum
+    for (int i = 45; i < 50; ++i) {
+      run_both("INSERT INTO " + table_name + " VALUES " + compressed_int_test_row(i) +
+               ";");
+    }
+    c(select_all, dt);
+  }
+}
+
 TEST(Update, TimestampUpdate) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -19085,6 +19584,47 @@ TEST(Select, WindowFunctionSum) {
   c(query + " NULLS FIRST;", query + ";", dt);
 }
 
+TEST(Select, WindowFunctionParallelPartitions) {
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  ScopeGuard reset_thresholds =
+      [orig_compute_threshold = g_parallel_window_partition_compute_threshold,
+       orig_sort_threshold = g_parallel_window_partition_sort_threshold] {
+        g_parallel_window_partition_compute_threshold = orig_compute_threshold;
+        g_parallel_window_partition_sort_threshold = orig_sort_threshold;
+      };
+  // computes every partition in parallel and sorts the larger ones in parallel as well
+  g_parallel_window_partition_compute_threshold = 0;
+  g_parallel_window_partition_sort_threshold = 3;
+  {
+    std::string part1 =
+        "SELECT x, y, ROW_NUMBER() OVER (PARTITION BY y ORDER BY x ASC) r1, RANK() OVER "
+        "(PARTITION BY y ORDER BY x ASC) r2, DENSE_RANK() OVER (PARTITION BY y ORDER BY "
+        "x DESC) r3 FROM test_window_func ORDER BY x ASC";
+    std::string part2 = ", y ASC, r1 ASC, r2 ASC, r3 ASC;";
+    c(part1 + " NULLS FIRST" + part2, part1 + part2, dt);
+  }
+  {
+    std::string part1 =
+        "SELECT x, y, CUME_DIST() OVER (PARTITION BY y ORDER BY x ASC) c FROM "
+        "test_window_func ORDER BY x ASC";
+    std::string part2 = ", y ASC, c ASC;";
+    c(part1 + " NULLS FIRST" + part2, part1 + part2, dt);
+  }
+  {
+    std::string query =
+        "SELECT total FROM (SELECT SUM(x) OVER (PARTITION BY y) AS total FROM (SELECT x, "
+        "y FROM test_window_func)) ORDER BY total ASC";
+    c(query + " NULLS FIRST;", query + ";", dt);
+  }
+  {
+    std::string part1 =
+        "SELECT x, y, MAX(t) OVER (PARTITION BY y ORDER BY x ASC) m FROM "
+        "test_window_func ORDER BY x ASC";
+    std::string part2 = ", y ASC, m ASC;";
+    c(part1 + " NULLS FIRST" + part2, part1 + part2, dt);
+  }
+}
+
 TEST(Select, WindowFunctionComplexExpressions) {
   const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
   {
@@ -20,6 +20,7 @@
  */
 
 #include <fstream>
+#include <future>
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
@@ -1207,6 +1208,130 @@ TEST_F(FileMgrUnitTest, InitializeWithUncheckpointedAppendPages) {
   ASSERT_EQ(buffer->pageCount(), 1U);
 }
 
+TEST_F(FileMgrUnitTest, ConcurrentPageReads) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  ::registerArrowForeignStorage(fsi);
+  ::registerArrowCsvForeignStorage(fsi);
+  std::vector<int8_t> data(page_size_ * 500);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<int8_t>(i % 127);
+  }
+  {
+    File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+    auto buffer = gfm.createBuffer({1, 1, 1, 1});
+    buffer->append(data.data(), data.size());
+    gfm.checkpoint(1, 1);
+  }
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  auto buffer = gfm.getBuffer({1, 1, 1, 1});
+  ASSERT_EQ(data.size(), buffer->size());
+  std::vector<std::future<void>> readers;
+  for (size_t i = 0; i < 8; ++i) {
+    readers.emplace_back(std::async(std::launch::async, [&, i] {
+      // reads starting in the middle of a page and spanning many of them
+      const size_t offset = i * 37;
+      std::vector<int8_t> read_data(data.size() - offset);
+      buffer->read(read_data.data(), read_data.size(), offset);
+      EXPECT_TRUE(std::equal(read_data.begin(), read_data.end(), data.begin() + offset));
+    }));
+  }
+  for (auto& reader : readers) {
+    reader.get();
+  }
+}
+
+TEST_F(FileMgrUnitTest, InitializeFromChunkIndexSnapshot) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  ::registerArrowForeignStorage(fsi);
+  ::registerArrowCsvForeignStorage(fsi);
+  std::vector<int8_t> data(page_size_ * 20);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<int8_t>(i % 127);
+  }
+  std::string snapshot_path;
+  {
+    File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+    auto buffer = gfm.createBuffer({1, 1, 1, 1});
+    buffer->append(data.data(), data.size());
+    gfm.checkpoint(1, 1);
+    auto fm = dynamic_cast<File_Namespace::FileMgr*>(gfm.getFileMgr(1, 1));
+    snapshot_path =
+        fm->getFilePath(File_Namespace::FileMgr::CHUNK_INDEX_SNAPSHOT_FILENAME).string();
+    // only written once the table is closed
+    EXPECT_FALSE(bf::exists(snapshot_path));
+  }
+  ASSERT_TRUE(bf::exists(snapshot_path));
+  {
+    File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+    auto buffer = gfm.getBuffer({1, 1, 1, 1});
+    ASSERT_EQ(data.size(), buffer->size());
+    std::vector<int8_t> read_data(data.size());
+    buffer->read(read_data.data(), read_data.size());
+    EXPECT_EQ(data, read_data);
+    // the uncheckpointed pages have to be freed by the page header scan
+    buffer->append(data.data(), data.size());
+    EXPECT_FALSE(bf::exists(snapshot_path));
+  }
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  auto buffer = gfm.getBuffer({1, 1, 1, 1});
+  ASSERT_EQ(data.size(), buffer->size());
+}
+
+TEST_F(FileMgrUnitTest, IgnoreStaleChunkIndexSnapshot) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  ::registerArrowForeignStorage(fsi);
+  ::registerArrowCsvForeignStorage(fsi);
+  std::vector<int8_t> data(page_size_ * 20, 7);
+  std::string snapshot_path;
+  {
+    File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+    auto buffer = gfm.createBuffer({1, 1, 1, 1});
+    buffer->append(data.data(), data.size());
+    gfm.checkpoint(1, 1);
+    auto fm = dynamic_cast<File_Namespace::FileMgr*>(gfm.getFileMgr(1, 1));
+    snapshot_path =
+        fm->getFilePath(File_Namespace::FileMgr::CHUNK_INDEX_SNAPSHOT_FILENAME).string();
+  }
+  bf::copy_file(snapshot_path, snapshot_path + ".old");
+  {
+    File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+    auto buffer = gfm.getBuffer({1, 1, 1, 1});
+    buffer->append(data.data(), data.size());
+    gfm.checkpoint(1, 1);
+  }
+  ASSERT_TRUE(bf::exists(snapshot_path));
+  // snapshot of the previous checkpoint
+  bf::remove(snapshot_path);
+  bf::rename(snapshot_path + ".old", snapshot_path);
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  auto buffer = gfm.getBuffer({1, 1, 1, 1});
+  ASSERT_EQ(2 * data.size(), buffer->size());
+  EXPECT_FALSE(bf::exists(snapshot_path));
+}
+
+TEST_F(FileMgrUnitTest, NoChunkIndexSnapshotForUncheckpointedWrites) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  ::registerArrowForeignStorage(fsi);
+  ::registerArrowCsvForeignStorage(fsi);
+  std::vector<int8_t> data(page_size_ * 20, 7);
+  std::string snapshot_path;
+  {
+    File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+    auto buffer = gfm.createBuffer({1, 1, 1, 1});
+    buffer->append(data.data(), data.size());
+    gfm.checkpoint(1, 1);
+    // written after the checkpoint, the pages have to be rolled back at startup
+    buffer->append(data.data(), data.size());
+    auto fm = dynamic_cast<File_Namespace::FileMgr*>(gfm.getFileMgr(1, 1));
+    snapshot_path =
+        fm->getFilePath(File_Namespace::FileMgr::CHUNK_INDEX_SNAPSHOT_FILENAME).string();
+  }
+  EXPECT_FALSE(bf::exists(snapshot_path));
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  auto buffer = gfm.getBuffer({1, 1, 1, 1});
+  ASSERT_EQ(data.size(), buffer->size());
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
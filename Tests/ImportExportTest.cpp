@@ -31,6 +31,14 @@
 #include <boost/program_options.hpp>
 #include <boost/range/combine.hpp>
 
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#ifdef ENABLE_IMPORT_PARQUET
+#include <parquet/arrow/reader.h>
+#include <parquet/exception.h>
+#endif
+
 #include "Archive/PosixFileArchive.h"
 #include "Catalog/Catalog.h"
 #ifdef HAVE_AWS_S3
@@ -2173,6 +2181,82 @@ class ExportTest : public ::testing::Test {
     ASSERT_NO_THROW(run_ddl_statement("DROP TABLE query_export_test;"));
   }
 
+  void doCreateAndInsertScalars() {
+    ASSERT_NO_THROW(run_ddl_statement(
+        "CREATE TABLE query_export_test (col_int INTEGER, col_big BIGINT, col_double "
+        "DOUBLE, col_text TEXT ENCODING DICT(32), col_date DATE, col_ts TIMESTAMP(3)) "
+        "WITH (FRAGMENT_SIZE=2);"));
+    for (int i = 0; i < 5; i++) {
+      auto const i_str = std::to_string(i);
+      ASSERT_NO_THROW(run_ddl_statement(
+          "INSERT INTO query_export_test VALUES (" + i_str + ", " + i_str + "000, " +
+          i_str + ".5, " + (i % 2 ? "'odd'" : "'even'") +
+          ", '2021-01-0" + std::to_string(i + 1) + "', '2021-01-01 00:00:0" + i_str +
+          ".123');"));
+    }
+  }
+
+  // checks the schema of a Parquet or Arrow export of doCreateAndInsertScalars()
+  void doCompareScalarsSchema(const std::shared_ptr<arrow::Schema>& schema) {
+    ASSERT_EQ(schema->num_fields(), 6);
+    ASSERT_EQ(schema->field(0)->name(), "col_int");
+    ASSERT_EQ(schema->field(0)->type()->id(), arrow::Type::INT32);
+    ASSERT_EQ(schema->field(1)->type()->id(), arrow::Type::INT64);
+    ASSERT_EQ(schema->field(2)->type()->id(), arrow::Type::DOUBLE);
+    ASSERT_EQ(schema->field(3)->type()->id(), arrow::Type::DICTIONARY);
+    ASSERT_EQ(schema->field(4)->type()->id(), arrow::Type::DATE32);
+    ASSERT_EQ(schema->field(5)->type()->id(), arrow::Type::TIMESTAMP);
+  }
+
+  // checks the values of a Parquet or Arrow export of doCreateAndInsertScalars(), the
+  // chunks of a column may each carry their own dictionary
+  void doCompareScalarsValues(const std::shared_ptr<arrow::Table>& table) {
+    ASSERT_EQ(table->num_columns(), 6);
+    auto const& ts_type =
+        static_cast<const arrow::TimestampType&>(*table->schema()->field(5)->type());
+    ASSERT_EQ(ts_type.unit(), arrow::TimeUnit::MILLI);
+    // returns the chunk holding the row of the column, and the row within the chunk
+    auto locate = [&table](const int col, int64_t row) {
+      auto const& column = table->column(col);
+      int chunk = 0;
+      while (row >= column->chunk(chunk)->length()) {
+        row -= column->chunk(chunk++)->length();
+      }
+      return std::make_pair(column->chunk(chunk), row);
+    };
+    std::vector<bool> seen(5, false);
+    for (int64_t row = 0; row < table->num_rows(); row++) {
+      auto const [col_int, int_row] = locate(0, row);
+      auto const i = static_cast<const arrow::Int32Array&>(*col_int).Value(int_row);
+      ASSERT_GE(i, 0);
+      ASSERT_LT(i, 5);
+      ASSERT_FALSE(seen[i]);
+      seen[i] = true;
+      auto const [col_big, big_row] = locate(1, row);
+      ASSERT_EQ(static_cast<const arrow::Int64Array&>(*col_big).Value(big_row),
+                i * int64_t(1000));
+      auto const [col_double, double_row] = locate(2, row);
+      ASSERT_EQ(static_cast<const arrow::DoubleArray&>(*col_double).Value(double_row),
+                i + 0.5);
+      auto const [col_text, text_row] = locate(3, row);
+      auto const& text = static_cast<const arrow::DictionaryArray&>(*col_text);
+      ASSERT_FALSE(text.IsNull(text_row));
+      auto const text_id =
+          static_cast<const arrow::Int32Array&>(*text.indices()).Value(text_row);
+      ASSERT_EQ(static_cast<const arrow::StringArray&>(*text.dictionary())
+                    .GetString(text_id),
+                i % 2 ? "odd" : "even");
+      // days and milliseconds since the epoch for 2021-01-01
+      auto const [col_date, date_row] = locate(4, row);
+      ASSERT_EQ(static_cast<const arrow::Date32Array&>(*col_date).Value(date_row),
+                18628 + i);
+      auto const [col_ts, ts_row] = locate(5, row);
+      ASSERT_EQ(static_cast<const arrow::TimestampArray&>(*col_ts).Value(ts_row),
+                (int64_t(1609459200) + i) * 1000 + 123);
+    }
+    ASSERT_EQ(std::count(seen.begin(), seen.end(), true), 5);
+  }
+
   constexpr static bool WITH_ARRAYS = true;
   constexpr static bool NO_ARRAYS = false;
   constexpr static bool INVALID_SRID = true;
@@ -2693,6 +2777,113 @@ TEST_F(ExportTest, Array_Null_Handling_NullField) {
                               ", array_null_handling='nullfield'"));
 }
 
+TEST_F(ExportTest, Arrow) {
+  SKIP_ALL_ON_AGGREGATOR();
+  doCreateAndInsertScalars();
+  std::string exp_file = "query_export_test_arrow.arrow";
+  ASSERT_NO_THROW(run_ddl_statement(
+      "COPY (SELECT * FROM query_export_test) TO '" + exp_file +
+      "' WITH (file_type='Arrow');"));
+  {
+    auto infile = arrow::io::ReadableFile::Open(BASE_PATH "/mapd_export/" + exp_file);
+    ASSERT_TRUE(infile.ok());
+    auto reader = arrow::ipc::RecordBatchFileReader::Open(*infile);
+    ASSERT_TRUE(reader.ok());
+    doCompareScalarsSchema((*reader)->schema());
+    // one record batch per fragment
+    ASSERT_EQ((*reader)->num_record_batches(), 3);
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    for (int i = 0; i < (*reader)->num_record_batches(); i++) {
+      auto batch = (*reader)->ReadRecordBatch(i);
+      ASSERT_TRUE(batch.ok());
+      // all the batches share one dictionary
+      if (i > 0) {
+        auto const& dictionary =
+            static_cast<const arrow::DictionaryArray&>(*(*batch)->column(3)).dictionary();
+        auto const& first_dictionary =
+            static_cast<const arrow::DictionaryArray&>(*batches[0]->column(3))
+                .dictionary();
+        ASSERT_TRUE(dictionary->Equals(first_dictionary));
+      }
+      batches.push_back(*batch);
+    }
+    auto table = arrow::Table::FromRecordBatches(batches);
+    ASSERT_TRUE(table.ok());
+    ASSERT_EQ((*table)->num_rows(), 5);
+    doCompareScalarsValues(*table);
+  }
+  removeExportedFile(exp_file);
+}
+
+TEST_F(ExportTest, Arrow_InvalidName) {
+  SKIP_ALL_ON_AGGREGATOR();
+  doCreateAndInsertScalars();
+  EXPECT_THROW(run_ddl_statement("COPY (SELECT * FROM query_export_test) TO "
+                                 "'query_export_test_arrow.csv' WITH "
+                                 "(file_type='Arrow');"),
+               std::runtime_error);
+}
+
+TEST_F(ExportTest, Arrow_GZip_Unimplemented) {
+  SKIP_ALL_ON_AGGREGATOR();
+  doCreateAndInsertScalars();
+  EXPECT_THROW(run_ddl_statement("COPY (SELECT * FROM query_export_test) TO "
+                                 "'query_export_test_arrow.arrow' WITH "
+                                 "(file_type='Arrow', file_compression='GZip');"),
+               std::runtime_error);
+}
+
+TEST_F(ExportTest, Arrow_RejectArrayColumns) {
+  SKIP_ALL_ON_AGGREGATOR();
+  doCreateAndImport();
+  EXPECT_THROW(doExport("query_export_test_arrow.arrow",
+                        "Arrow",
+                        "",
+                        "point",
+                        WITH_ARRAYS,
+                        DEFAULT_SRID),
+               std::runtime_error);
+}
+
+#ifdef ENABLE_IMPORT_PARQUET
+TEST_F(ExportTest, Parquet) {
+  SKIP_ALL_ON_AGGREGATOR();
+  doCreateAndInsertScalars();
+  auto run_test = [&](const std::string& file_compression) {
+    std::string exp_file = "query_export_test_parquet.parquet";
+    ASSERT_NO_THROW(run_ddl_statement(
+        "COPY (SELECT * FROM query_export_test) TO '" + exp_file +
+        "' WITH (file_type='Parquet', file_compression='" + file_compression + "');"));
+    {
+      auto infile = arrow::io::ReadableFile::Open(BASE_PATH "/mapd_export/" + exp_file);
+      ASSERT_TRUE(infile.ok());
+      std::unique_ptr<parquet::arrow::FileReader> reader;
+      PARQUET_THROW_NOT_OK(
+          parquet::arrow::OpenFile(*infile, arrow::default_memory_pool(), &reader));
+      // one row group per fragment
+      ASSERT_EQ(reader->num_row_groups(), 3);
+      std::shared_ptr<arrow::Table> table;
+      PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
+      doCompareScalarsSchema(table->schema());
+      ASSERT_EQ(table->num_rows(), 5);
+      doCompareScalarsValues(table);
+    }
+    removeExportedFile(exp_file);
+  };
+  run_test("None");
+  run_test("GZip");
+}
+
+TEST_F(ExportTest, Parquet_Zip_Unimplemented) {
+  SKIP_ALL_ON_AGGREGATOR();
+  doCreateAndInsertScalars();
+  EXPECT_THROW(run_ddl_statement("COPY (SELECT * FROM query_export_test) TO "
+                                 "'query_export_test_parquet.parquet' WITH "
+                                 "(file_type='Parquet', file_compression='Zip');"),
+               std::runtime_error);
+}
+#endif  // ENABLE_IMPORT_PARQUET
+
 }  // namespace
 
 int main(int argc, char** argv) {
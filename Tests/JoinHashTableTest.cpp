@@ -31,10 +31,13 @@
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/ExternalCacheInvalidators.h"
+#include "QueryEngine/JoinHashTable/BaselineHashTable.h"
+#include "QueryEngine/JoinHashTable/JoinBloomFilter.h"
 #include "QueryEngine/JoinHashTable/OverlapsJoinHashTable.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryEngine/UDFCompiler.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
 #include "Shared/thread_count.h"
 #include "TestHelpers.h"
 
@@ -70,6 +73,13 @@ inline auto sql(std::string_view sql_stmts) {
   return QR::get()->runMultipleStatements(std::string(sql_stmts), g_device_type);
 }
 
+int64_t count(const std::string& query) {
+  auto rows = QR::get()->runSQL(query, g_device_type);
+  auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size()) << query;
+  return v<int64_t>(crt_row[0]);
+}
+
 int deviceCount(const Catalog_Namespace::Catalog* catalog,
                 const ExecutorDeviceType device_type) {
   if (device_type == ExecutorDeviceType::GPU) {
@@ -953,6 +963,184 @@ TEST(Other, Regression) {
     )");
 }
 
+TEST(RuntimeFilter, BloomFilter) {
+  JoinBloomFilter bloom_filter(1000);
+  for (int64_t key = 0; key < 1000; ++key) {
+    bloom_filter.add(reinterpret_cast<const int8_t*>(&key), sizeof(key));
+  }
+  for (int64_t key = 0; key < 1000; ++key) {
+    EXPECT_TRUE(
+        bloom_filter.contains(reinterpret_cast<const int8_t*>(&key), sizeof(key)));
+  }
+  size_t false_positives{0};
+  for (int64_t key = 1000; key < 11000; ++key) {
+    false_positives +=
+        bloom_filter.contains(reinterpret_cast<const int8_t*>(&key), sizeof(key));
+  }
+  EXPECT_LT(false_positives, size_t(200));
+}
+
+TEST(RuntimeFilter, KeyedBloomFilter) {
+  const auto min_hash_table_bytes = g_join_bloom_filter_min_hash_table_bytes;
+  ScopeGuard reset_min_hash_table_bytes = [min_hash_table_bytes] {
+    g_join_bloom_filter_min_hash_table_bytes = min_hash_table_bytes;
+  };
+  g_join_bloom_filter_min_hash_table_bytes = 0;
+
+  auto catalog = QR::get()->getCatalog();
+  CHECK(catalog);
+
+  auto executor = Executor::getExecutor(catalog->getCurrentDB().dbId);
+  CHECK(executor);
+  executor->setCatalog(catalog.get());
+
+  g_device_type = ExecutorDeviceType::CPU;
+  JoinHashTableCacheInvalidator::invalidateCaches();
+
+  sql(R"(
+    drop table if exists table1;
+    drop table if exists table2;
+
+    create table table1 (a1 integer, a2 integer) with (fragment_size = 2);
+    create table table2 (b1 integer, b2 integer);
+
+    insert into table1 values (1, 11);
+    insert into table1 values (2, 12);
+    insert into table1 values (3, 13);
+    insert into table1 values (4, 14);
+    insert into table1 values (5, 15);
+
+    insert into table2 values (1, 11);
+    insert into table2 values (3, 13);
+    insert into table2 values (4, 0);
+  )");
+
+  auto a1 = getSyntheticColumnVar("table1", "a1", 0, executor.get());
+  auto a2 = getSyntheticColumnVar("table1", "a2", 0, executor.get());
+  auto b1 = getSyntheticColumnVar("table2", "b1", 1, executor.get());
+  auto b2 = getSyntheticColumnVar("table2", "b2", 1, executor.get());
+
+  using VE = std::vector<std::shared_ptr<Analyzer::Expr>>;
+  auto et1 = std::make_shared<Analyzer::ExpressionTuple>(VE{a1, a2});
+  auto et2 = std::make_shared<Analyzer::ExpressionTuple>(VE{b1, b2});
+
+  // a1 = b1 and a2 = b2
+  auto op = std::make_shared<Analyzer::BinOper>(kBOOLEAN, kEQ, kONE, et1, et2);
+  auto hash_table = buildKeyed(op);
+  auto baseline_hash_table =
+      dynamic_cast<BaselineHashTable*>(hash_table->getHashTableForDevice(0));
+  ASSERT_TRUE(baseline_hash_table);
+  const auto bloom_filter = baseline_hash_table->getBloomFilter();
+  ASSERT_TRUE(bloom_filter);
+  // the bloom filter counts against the hash table cache budget
+  EXPECT_EQ(BaselineJoinHashTable::getHashTableCache()->getStats().size_bytes,
+            baseline_hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU) +
+                bloom_filter->getSizeBytes());
+  for (const auto& entry : hash_table->toSet(g_device_type, 0)) {
+    std::vector<int32_t> key(entry.key.begin(), entry.key.end());
+    EXPECT_TRUE(bloom_filter->contains(reinterpret_cast<const int8_t*>(key.data()),
+                                       key.size() * sizeof(int32_t)));
+  }
+
+  // the generated code probes the bloom filter before the hash table
+  EXPECT_EQ(int64_t(2),
+            count("select count(*) from table1, table2 where a1 = b1 and a2 = b2;"));
+
+  sql(R"(
+    drop table if exists table1;
+    drop table if exists table2;
+  )");
+}
+
+TEST(RuntimeFilter, KeyRangeFragmentSkipping) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    g_device_type = dt;
+
+    JoinHashTableCacheInvalidator::invalidateCaches();
+
+    sql(R"(
+      drop table if exists table1;
+      drop table if exists table2;
+
+      create table table1 (nums1 integer) with (fragment_size = 2);
+      create table table2 (nums2 integer);
+
+      insert into table1 values (1);
+      insert into table1 values (2);
+      insert into table1 values (3);
+      insert into table1 values (4);
+      insert into table1 values (5);
+      insert into table1 values (null);
+
+      insert into table2 values (4);
+      insert into table2 values (5);
+    )");
+
+    auto hash_table = buildPerfect("table1", "nums1", "table2", "nums2");
+    const auto key_range = hash_table->getInnerKeyRange();
+    ASSERT_TRUE(key_range);
+    EXPECT_EQ(key_range->min, 4);
+    EXPECT_EQ(key_range->max, 5);
+
+    // the first fragment has no key in the inner range and is skipped
+    const std::string join_count{
+        "select count(*) from table1, table2 where nums1 = nums2;"};
+    EXPECT_EQ(int64_t(2), count(join_count));
+    // outer joins don't skip fragments
+    EXPECT_EQ(int64_t(2),
+              count("select count(*) from table1 left join table2 on nums1 = nums2 "
+                    "where nums1 < 3 and nums2 is null;"));
+
+    // every fragment is skipped with an empty inner table
+    sql("delete from table2;");
+    EXPECT_EQ(int64_t(0), count(join_count));
+
+    sql(R"(
+      drop table if exists table1;
+      drop table if exists table2;
+    )");
+  }
+}
+
+TEST(RuntimeFilter, KeyRangeAfterDeletes) {
+  g_device_type = ExecutorDeviceType::CPU;
+  JoinHashTableCacheInvalidator::invalidateCaches();
+
+  sql(R"(
+    drop table if exists table1;
+    drop table if exists table2;
+
+    create table table1 (nums1 integer) with (fragment_size = 2);
+    create table table2 (nums2 integer);
+
+    insert into table1 values (1);
+    insert into table1 values (2);
+    insert into table1 values (3);
+    insert into table1 values (4);
+
+    insert into table2 values (1);
+    insert into table2 values (2);
+    insert into table2 values (3);
+    insert into table2 values (4);
+    delete from table2 where nums2 < 3;
+  )");
+
+  // the metadata range of the inner column still starts at 1
+  auto hash_table = buildPerfect("table1", "nums1", "table2", "nums2");
+  const auto key_range = hash_table->getInnerKeyRange();
+  ASSERT_TRUE(key_range);
+  EXPECT_EQ(key_range->min, 3);
+  EXPECT_EQ(key_range->max, 4);
+  EXPECT_EQ(int64_t(2),
+            count("select count(*) from table1, table2 where nums1 = nums2;"));
+
+  sql(R"(
+    drop table if exists table1;
+    drop table if exists table2;
+  )");
+}
+
 int main(int argc, char** argv) {
   ::g_enable_overlaps_hashjoin = true;
   TestHelpers::init_logger_stderr_only(argc, argv);
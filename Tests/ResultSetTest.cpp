@@ -44,6 +44,7 @@
 using QR = QueryRunner::QueryRunner;
 
 extern bool g_is_test_env;
+extern bool g_enable_parallel_reduction;
 
 bool skip_tests(const ExecutorDeviceType device_type) {
 #ifdef HAVE_CUDA
@@ -1140,6 +1141,69 @@ void test_reduce(const std::vector<TargetInfo>& target_infos,
   }
 }
 
+void test_reduce_many(const std::vector<TargetInfo>& target_infos,
+                      const QueryMemoryDescriptor& query_mem_desc,
+                      const size_t result_set_count) {
+  const auto reduce_all = [&target_infos, &query_mem_desc, result_set_count](
+                              const bool parallel_reduction) {
+    const auto parallel_reduction_orig = g_enable_parallel_reduction;
+    g_enable_parallel_reduction = parallel_reduction;
+    const auto row_set_mem_owner =
+        std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+    row_set_mem_owner->addStringDict(g_sd, 1, g_sd->storageEntryCount());
+    std::vector<std::unique_ptr<ResultSet>> result_sets;
+    std::vector<ResultSet*> storage_set;
+    for (size_t i = 0; i < result_set_count; ++i) {
+      result_sets.emplace_back(std::make_unique<ResultSet>(target_infos,
+                                                           ExecutorDeviceType::CPU,
+                                                           query_mem_desc,
+                                                           row_set_mem_owner,
+                                                           nullptr,
+                                                           0,
+                                                           0));
+      const auto storage = result_sets.back()->allocateStorage();
+      EvenNumberGenerator generator;
+      fill_storage_buffer(
+          storage->getUnderlyingBuffer(), target_infos, query_mem_desc, generator, i + 1);
+      storage_set.push_back(result_sets.back().get());
+    }
+    ResultSetManager rs_manager;
+    const auto result_rs = rs_manager.reduce(storage_set);
+    g_enable_parallel_reduction = parallel_reduction_orig;
+    std::vector<std::vector<TargetValue>> rows;
+    for (size_t row_idx = 0; row_idx < result_rs->rowCount(); ++row_idx) {
+      rows.push_back(result_rs->getRowAtNoTranslations(row_idx));
+    }
+    return rows;
+  };
+  const auto tree_rows = reduce_all(true);
+  const auto serial_rows = reduce_all(false);
+  ASSERT_EQ(serial_rows.size(), tree_rows.size());
+  SQLTypeInfo double_ti(kDOUBLE, false);
+  for (size_t row_idx = 0; row_idx < serial_rows.size(); ++row_idx) {
+    const auto& serial_row = serial_rows[row_idx];
+    const auto& tree_row = tree_rows[row_idx];
+    ASSERT_EQ(serial_row.size(), tree_row.size());
+    for (size_t i = 0; i < serial_row.size(); ++i) {
+      const auto& target_info = target_infos[i];
+      const auto& ti = target_info.agg_kind == kAVG ? double_ti : target_info.sql_type;
+      switch (ti.get_type()) {
+        case kTINYINT:
+        case kSMALLINT:
+        case kINT:
+        case kBIGINT:
+          ASSERT_EQ(v<int64_t>(serial_row[i]), v<int64_t>(tree_row[i]));
+          break;
+        case kDOUBLE:
+          ASSERT_DOUBLE_EQ(v<double>(serial_row[i]), v<double>(tree_row[i]));
+          break;
+        default:
+          break;
+      }
+    }
+  }
+}
+
 void test_reduce_random_groups(const std::vector<TargetInfo>& target_infos,
                                const QueryMemoryDescriptor& query_mem_desc,
                                NumberGenerator& generator1,
@@ -1853,6 +1917,31 @@ TEST(Reduce, BaselineHashColumnar) {
   test_reduce(target_infos, query_mem_desc, generator1, generator2, 1, true);
 }
 
+TEST(ReduceMany, PerfectHashOneCol) {
+  const auto target_infos = generate_test_target_infos();
+  const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
+  for (const size_t result_set_count : {2, 3, 7, 16}) {
+    test_reduce_many(target_infos, query_mem_desc, result_set_count);
+  }
+}
+
+TEST(ReduceMany, PerfectHashOneColColumnar) {
+  const auto target_infos = generate_test_target_infos();
+  auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
+  query_mem_desc.setOutputColumnar(true);
+  for (const size_t result_set_count : {2, 3, 7, 16}) {
+    test_reduce_many(target_infos, query_mem_desc, result_set_count);
+  }
+}
+
+TEST(ReduceMany, PerfectHashTwoCol) {
+  const auto target_infos = generate_test_target_infos();
+  const auto query_mem_desc = perfect_hash_two_col_desc(target_infos, 8);
+  for (const size_t result_set_count : {5, 9}) {
+    test_reduce_many(target_infos, query_mem_desc, result_set_count);
+  }
+}
+
 #ifndef HAVE_TSAN
 // The large buffers tests allocate too much memory to instrument under TSAN
 TEST(ReduceLargeBuffers, PerfectHashOne_Overflow32) {
@@ -227,6 +227,45 @@ TEST(QueryHint, CheckQueryHintForOverlapsJoin) {
   }
 }
 
+TEST(QueryHint, CheckQueryHintForKernelScheduling) {
+  const auto create_table_ddl = "CREATE TABLE SQL_HINT_DUMMY(key int)";
+  const auto drop_table_ddl = "DROP TABLE IF EXISTS SQL_HINT_DUMMY";
+  QR::get()->runDDLStatement(drop_table_ddl);
+  QR::get()->runDDLStatement(create_table_ddl);
+  ScopeGuard drop_table = [drop_table_ddl] {
+    QR::get()->runDDLStatement(drop_table_ddl);
+  };
+
+  {
+    const auto query =
+        "SELECT /*+ kernel_priority(4), max_kernel_parallelism(2) */ COUNT(*) FROM "
+        "SQL_HINT_DUMMY;";
+    const auto query_hints = QR::get()->getParsedQueryHint(query);
+    EXPECT_TRUE(query_hints.isHintRegistered(QueryHint::kKernelPriority));
+    EXPECT_EQ(query_hints.kernel_priority, size_t(4));
+    EXPECT_TRUE(query_hints.isHintRegistered(QueryHint::kMaxKernelParallelism));
+    EXPECT_EQ(query_hints.max_kernel_parallelism, size_t(2));
+    // the query runs with the hinted share of the kernel scheduler
+    EXPECT_NO_THROW(run_query(query, ExecutorDeviceType::CPU));
+  }
+
+  {
+    const auto query = "SELECT COUNT(*) FROM SQL_HINT_DUMMY;";
+    const auto query_hints = QR::get()->getParsedQueryHint(query);
+    EXPECT_FALSE(query_hints.isHintRegistered(QueryHint::kKernelPriority));
+    EXPECT_EQ(query_hints.kernel_priority, size_t(1));
+    EXPECT_FALSE(query_hints.isHintRegistered(QueryHint::kMaxKernelParallelism));
+    EXPECT_EQ(query_hints.max_kernel_parallelism, size_t(0));
+  }
+
+  {
+    // the priority has to be positive
+    const auto query = "SELECT /*+ kernel_priority(0) */ COUNT(*) FROM SQL_HINT_DUMMY;";
+    const auto query_hints = QR::get()->getParsedQueryHint(query);
+    EXPECT_FALSE(query_hints.isHintRegistered(QueryHint::kKernelPriority));
+  }
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -17,6 +17,9 @@
 #include "TestHelpers.h"
 
 #include "../StringDictionary/StringDictionary.h"
+#include "Shared/scope.h"
+
+#include <boost/filesystem.hpp>
 
 #include <cstdlib>
 #include <limits>
@@ -101,6 +104,130 @@ TEST(StringDictionary, RecoverMany) {
   }
 }
 
+TEST(StringDictionary, RecoverStaleHashTable) {
+  const auto hash_table_path = std::string(BASE_PATH) + "/DictHashTable";
+  const int str_count{1000};
+  {
+    StringDictionary string_dict(BASE_PATH, false, false, g_cache_string_hash);
+    for (int i = 0; i < str_count; ++i) {
+      CHECK_EQ(i, string_dict.getOrAdd(std::to_string(i)));
+    }
+  }
+  ASSERT_TRUE(boost::filesystem::exists(hash_table_path));
+  {
+    // strings added after the hash table was persisted, without persisting it again
+    ScopeGuard reset = [orig = g_enable_stringdict_hash_table_persistence] {
+      g_enable_stringdict_hash_table_persistence = orig;
+    };
+    g_enable_stringdict_hash_table_persistence = false;
+    StringDictionary string_dict(BASE_PATH, false, true, g_cache_string_hash);
+    for (int i = str_count; i < 2 * str_count; ++i) {
+      CHECK_EQ(i, string_dict.getOrAdd(std::to_string(i)));
+    }
+  }
+  {
+    StringDictionary string_dict(BASE_PATH, false, true, g_cache_string_hash);
+    ASSERT_EQ(static_cast<size_t>(2 * str_count), string_dict.storageEntryCount());
+    for (int i = 0; i < 2 * str_count; ++i) {
+      CHECK_EQ(i, string_dict.getIdOfString(std::to_string(i)));
+    }
+  }
+  boost::filesystem::resize_file(hash_table_path, 64);
+  StringDictionary string_dict(BASE_PATH, false, true, g_cache_string_hash);
+  for (int i = 0; i < 2 * str_count; ++i) {
+    CHECK_EQ(i, string_dict.getIdOfString(std::to_string(i)));
+  }
+  CHECK_EQ(2 * str_count, string_dict.getOrAdd(std::to_string(2 * str_count)));
+}
+
+TEST(StringDictionary, GetLike) {
+  const auto enable_trigram_index = g_enable_stringdict_trigram_index;
+  for (const bool trigram_index : {false, true}) {
+    g_enable_stringdict_trigram_index = trigram_index;
+    StringDictionary string_dict("", true, false, g_cache_string_hash);
+    for (const auto str : {"apple",
+                           "Applesauce",
+                           "banana",
+                           "pineapple",
+                           "grape",
+                           "ap",
+                           "xapplex",
+                           "a%ple"}) {
+      string_dict.getOrAdd(str);
+    }
+    auto get_like = [&string_dict](const std::string& pattern,
+                                   const bool icase,
+                                   const bool is_simple,
+                                   const size_t generation) {
+      return string_dict.getLike(pattern, icase, is_simple, '\\', generation);
+    };
+    const size_t count = string_dict.storageEntryCount();
+    using Ids = std::vector<int32_t>;
+    EXPECT_EQ(Ids({0, 3, 6}), get_like("%apple%", false, false, count));
+    EXPECT_EQ(Ids({0, 1, 3, 6}), get_like("%apple%", true, false, count));
+    EXPECT_EQ(Ids({0, 3, 6}), get_like("apple", false, true, count));
+    EXPECT_EQ(Ids({0, 3}), get_like("%apple", false, false, count));
+    EXPECT_EQ(Ids({0, 1, 3, 6, 7}), get_like("%p_e%", true, false, count));
+    EXPECT_EQ(Ids({0, 3, 6}), get_like("%a[pq]ple%", false, false, count));
+    EXPECT_EQ(Ids({7}), get_like("a\\%ple", false, false, count));
+    EXPECT_EQ(Ids({}), get_like("%cherry%", false, false, count));
+    // the strings added after the generation aren't matched
+    EXPECT_EQ(Ids({0, 1, 3}), get_like("%pple%", true, false, 4));
+
+    // new strings invalidate the cached results and are indexed on the next lookup
+    string_dict.getOrAdd("maple apple");
+    EXPECT_EQ(Ids({0, 3, 6, 8}),
+              get_like("%apple%", false, false, string_dict.storageEntryCount()));
+  }
+  g_enable_stringdict_trigram_index = enable_trigram_index;
+}
+
+TEST(StringDictionary, GetRegexpLike) {
+  StringDictionary string_dict("", true, false, g_cache_string_hash);
+  for (const auto str : {"apple", "banana", "pineapple"}) {
+    string_dict.getOrAdd(str);
+  }
+  EXPECT_EQ(std::vector<int32_t>({0, 2}),
+            string_dict.getRegexpLike(".*apple", '\\', string_dict.storageEntryCount()));
+}
+
+TEST(StringDictionary, LikeAndRegexpCachedApart) {
+  StringDictionary string_dict("", true, false, g_cache_string_hash);
+  for (const auto str : {"apple", "banana", "pineapple"}) {
+    string_dict.getOrAdd(str);
+  }
+  // the same pattern is cached once for LIKE and once for REGEXP
+  const auto generation = string_dict.storageEntryCount();
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(std::vector<int32_t>(),
+              string_dict.getLike(".*apple", false, false, '\\', generation));
+    EXPECT_EQ(std::vector<int32_t>({0, 2}),
+              string_dict.getRegexpLike(".*apple", '\\', generation));
+  }
+}
+
+TEST(StringDictionary, StringIdsCacheBudget) {
+  const size_t entry_bytes =
+      sizeof(std::pair<std::string, std::vector<int32_t>>) + 4 * sizeof(int32_t);
+  StringIdsCache<std::string> cache(2 * entry_bytes);
+  cache.put("a", {1, 2, 3, 4});
+  cache.put("b", {1, 2, 3, 4});
+  EXPECT_EQ(2 * entry_bytes, cache.bytes());
+  // the least recently used entry is evicted
+  ASSERT_TRUE(cache.get("a"));
+  cache.put("c", {1, 2, 3, 4});
+  EXPECT_EQ(2 * entry_bytes, cache.bytes());
+  EXPECT_TRUE(cache.get("a"));
+  EXPECT_FALSE(cache.get("b"));
+  EXPECT_TRUE(cache.get("c"));
+  // results larger than the budget aren't cached
+  cache.put("d", std::vector<int32_t>(100));
+  EXPECT_FALSE(cache.get("d"));
+  EXPECT_EQ(2 * entry_bytes, cache.bytes());
+  cache.clear();
+  EXPECT_EQ(size_t(0), cache.bytes());
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
@@ -28,6 +28,7 @@
 using QR = QueryRunner::QueryRunner;
 
 extern bool g_enable_table_functions;
+extern size_t g_parallel_table_function_rows_per_thread;
 namespace {
 
 inline void run_ddl_statement(const std::string& stmt) {
@@ -278,6 +279,44 @@ TEST_F(TableFunctions, CallFailure) {
   }
 }
 
+TEST_F(TableFunctions, ParallelExecution) {
+  run_ddl_statement("DROP TABLE IF EXISTS tf_parallel_test;");
+  run_ddl_statement("CREATE TABLE tf_parallel_test (x BIGINT, y BIGINT, z BIGINT);");
+  TestHelpers::ValuesGenerator gen("tf_parallel_test");
+  constexpr int64_t num_rows = 200;
+  for (int64_t i = 0; i < num_rows; i++) {
+    run_multiple_agg(gen(i, 2 * i, 3 * i), ExecutorDeviceType::CPU);
+  }
+
+  auto check_result = [](const auto rows, const int64_t threshold) {
+    ASSERT_EQ(rows->rowCount(), static_cast<size_t>(num_rows - threshold));
+    for (int64_t i = threshold; i < num_rows; i++) {
+      auto crt_row = rows->getNextRow(false, false);
+      ASSERT_EQ(TestHelpers::v<int64_t>(crt_row[0]), i);
+      ASSERT_EQ(TestHelpers::v<int64_t>(crt_row[1]), 6 * i);
+    }
+  };
+
+  const auto rows_per_thread = g_parallel_table_function_rows_per_thread;
+  // a single slice, then as many slices as there are threads
+  for (size_t rows_per_slice : {size_t(num_rows), size_t(16)}) {
+    g_parallel_table_function_rows_per_thread = rows_per_slice;
+    for (int64_t threshold : {0, 50, 199}) {
+      for (int multiplier : {1, 3}) {
+        const auto rows = run_multiple_agg(
+            "SELECT out0, out1 FROM TABLE(ct_parallel_filter(cursor(SELECT x, y, z FROM "
+            "tf_parallel_test), " +
+                std::to_string(threshold) + ", " + std::to_string(multiplier) +
+                ")) ORDER BY out0;",
+            ExecutorDeviceType::CPU);
+        check_result(rows, threshold);
+      }
+    }
+  }
+  g_parallel_table_function_rows_per_thread = rows_per_thread;
+  run_ddl_statement("DROP TABLE IF EXISTS tf_parallel_test;");
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
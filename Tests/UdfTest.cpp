@@ -29,15 +29,19 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
+#include "QueryEngine/PersistentCodeCache.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryEngine/UDFCompiler.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
 #ifndef BASE_PATH
 #define BASE_PATH "./tmp"
 #endif
 
+extern std::unique_ptr<llvm::Module> rt_udf_cpu_module;
+
 using namespace Catalog_Namespace;
 using namespace TestHelpers;
 
@@ -526,6 +530,62 @@ TEST_F(UDFCompilerTest, UdfQuery) {
   run_ddl_statement("DROP TABLE geo_mpoly;");
 }
 
+TEST_F(UDFCompilerTest, PersistentCodeCache) {
+  const auto code_cache_path = std::string(BASE_PATH) + "/omnisci_code_cache_udf_test";
+  boost::filesystem::remove_all(code_cache_path);
+  boost::filesystem::create_directories(code_cache_path);
+  g_enable_persistent_code_cache = true;
+  g_persistent_code_cache_path = code_cache_path;
+  ScopeGuard reset = [] {
+    g_enable_persistent_code_cache = false;
+    rt_udf_cpu_module = nullptr;
+    Executor::nukeCacheOfExecutors();
+    run_ddl_statement("DROP TABLE IF EXISTS persistent_code_cache_udf;");
+  };
+  auto code_cache = PersistentCodeCache::get();
+  ASSERT_TRUE(code_cache);
+
+  run_ddl_statement("DROP TABLE IF EXISTS persistent_code_cache_udf;");
+  run_ddl_statement("CREATE TABLE persistent_code_cache_udf (x INT, y INT);");
+  run_multiple_agg("INSERT INTO persistent_code_cache_udf VALUES (3, 1);",
+                   ExecutorDeviceType::CPU);
+  // compiles the query again, as after a restart
+  const auto run_query = [] {
+    Executor::nukeCacheOfExecutors();
+    return v<int64_t>(run_simple_agg(
+        "SELECT udf_range_int(x, y) FROM persistent_code_cache_udf;",
+        ExecutorDeviceType::CPU));
+  };
+
+  auto stats = code_cache->getStats();
+  ASSERT_EQ(2, run_query());
+  auto new_stats = code_cache->getStats();
+  EXPECT_GT(new_stats.misses, stats.misses);
+  EXPECT_EQ(new_stats.hits, stats.hits);
+  EXPECT_GT(new_stats.num_entries, size_t(0));
+
+  stats = new_stats;
+  ASSERT_EQ(2, run_query());
+  new_stats = code_cache->getStats();
+  EXPECT_GT(new_stats.hits, stats.hits);
+  EXPECT_EQ(new_stats.misses, stats.misses);
+
+  // linking another version of the UDFs into the query modules makes a miss
+  read_rt_udf_cpu_module(
+      "define i32 @persistent_code_cache_udf(i32 %x) {\n  ret i32 %x\n}\n");
+  stats = new_stats;
+  ASSERT_EQ(2, run_query());
+  new_stats = code_cache->getStats();
+  EXPECT_GT(new_stats.misses, stats.misses);
+  EXPECT_EQ(new_stats.hits, stats.hits);
+
+  stats = new_stats;
+  ASSERT_EQ(2, run_query());
+  new_stats = code_cache->getStats();
+  EXPECT_GT(new_stats.hits, stats.hits);
+  EXPECT_EQ(new_stats.misses, stats.misses);
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
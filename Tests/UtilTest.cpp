@@ -15,6 +15,7 @@
  */
 
 #include "Shared/Intervals.h"
+#include "Shared/KernelScheduler.h"
 #include "TestHelpers.h"
 #include "Utils/Regexp.h"
 #include "Utils/StringLike.h"
@@ -25,6 +26,8 @@
 #include <array>
 #include <atomic>
 #include <future>
+#include <mutex>
+#include <stdexcept>
 
 // for (auto const interval : makeIntervals(0, M, n_workers)) {...}
 // iterates over interval={begin,end} pairs which satisfy:
@@ -172,6 +175,118 @@ TEST(Utils, Regexp) {
   ASSERT_TRUE(regexp_like("hello [", 7, ".*\\[.*", 6, '\\'));
 }
 
+TEST(Shared, KernelSchedulerRunsAllTasks) {
+  threadpool::KernelScheduler scheduler(4);
+  constexpr int num_groups = 8;
+  constexpr int tasks_per_group = 100;
+  std::array<std::atomic<int>, num_groups> counters;
+  std::vector<std::future<void>> queries;
+  for (int group_idx = 0; group_idx < num_groups; ++group_idx) {
+    counters[group_idx] = 0;
+    queries.push_back(std::async(std::launch::async, [&, group_idx] {
+      auto group = scheduler.createTaskGroup(group_idx + 1);
+      for (int i = 0; i < tasks_per_group; ++i) {
+        group->spawn([&counters, group_idx] { ++counters[group_idx]; });
+      }
+      group->wait();
+      EXPECT_EQ(counters[group_idx], tasks_per_group);
+    }));
+  }
+  for (auto& query : queries) {
+    query.get();
+  }
+}
+
+TEST(Shared, KernelSchedulerMaxParallelism) {
+  threadpool::KernelScheduler scheduler(8);
+  constexpr int max_parallelism = 2;
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  auto group = scheduler.createTaskGroup(1, max_parallelism);
+  for (int i = 0; i < 64; ++i) {
+    group->spawn([&running, &max_running] {
+      const int crt_running = ++running;
+      int crt_max = max_running.load();
+      while (crt_running > crt_max &&
+             !max_running.compare_exchange_weak(crt_max, crt_running)) {
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      --running;
+    });
+  }
+  group->wait();
+  EXPECT_LE(max_running.load(), max_parallelism);
+  EXPECT_GE(max_running.load(), 1);
+}
+
+TEST(Shared, KernelSchedulerFairness) {
+  // a single worker runs the tasks one at a time, in the order the scheduler picks them
+  threadpool::KernelScheduler scheduler(1);
+  std::promise<void> gate_entered;
+  std::promise<void> gate_released;
+  auto gate = scheduler.createTaskGroup();
+  gate->spawn([&gate_entered, released = gate_released.get_future().share()] {
+    gate_entered.set_value();
+    released.wait();
+  });
+  gate_entered.get_future().wait();
+
+  // both groups are queued while the worker is busy and become runnable together
+  constexpr int tasks_per_group = 40;
+  constexpr int num_tasks = 2 * tasks_per_group;
+  std::mutex order_mutex;
+  std::vector<int> order;
+  auto low_priority = scheduler.createTaskGroup(1);
+  auto high_priority = scheduler.createTaskGroup(3);
+  for (int i = 0; i < tasks_per_group; ++i) {
+    low_priority->spawn([&] {
+      std::lock_guard<std::mutex> lock(order_mutex);
+      order.push_back(1);
+    });
+    high_priority->spawn([&] {
+      std::lock_guard<std::mutex> lock(order_mutex);
+      order.push_back(3);
+    });
+  }
+  gate_released.set_value();
+  // the waiting thread would run tasks itself, so only wait once the worker is done
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(order_mutex);
+      if (order.size() == size_t(num_tasks)) {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  gate->wait();
+  low_priority->wait();
+  high_priority->wait();
+
+  // while both groups are runnable, they get the worker in proportion to their priority
+  const auto high_priority_first =
+      std::count(order.begin(), order.begin() + tasks_per_group, 3);
+  EXPECT_GE(high_priority_first, 3 * tasks_per_group / 4 - 1);
+  EXPECT_LE(high_priority_first, 3 * tasks_per_group / 4 + 1);
+}
+
+TEST(Shared, KernelSchedulerPropagatesErrors) {
+  threadpool::KernelScheduler scheduler(2);
+  auto group = scheduler.createTaskGroup();
+  std::atomic<int> completed{0};
+  group->spawn([] { throw std::runtime_error("kernel failed"); });
+  for (int i = 0; i < 16; ++i) {
+    group->spawn([&completed] { ++completed; });
+  }
+  EXPECT_THROW(group->wait(), std::runtime_error);
+  EXPECT_LE(completed.load(), 16);
+
+  // a failure in one group does not affect the others
+  auto other_group = scheduler.createTaskGroup();
+  other_group->spawn([&completed] { ++completed; });
+  EXPECT_NO_THROW(other_group->wait());
+}
+
 int main(int argc, char* argv[]) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
@@ -36,6 +36,13 @@ bool g_enable_thrift_logs{false};
 
 extern bool g_use_table_device_offset;
 extern float g_fraction_code_cache_to_evict;
+extern bool g_enable_batch_cpu_codegen;
+extern size_t g_batch_cpu_codegen_size;
+extern bool g_enable_persistent_code_cache;
+extern std::string g_persistent_code_cache_path;
+extern size_t g_persistent_code_cache_max_size_bytes;
+extern bool g_enable_result_cache;
+extern size_t g_result_cache_max_size_bytes;
 extern bool g_cache_string_hash;
 
 extern bool g_enable_left_join_filter_hoisting;
@@ -48,6 +55,14 @@ extern size_t g_approx_quantile_buffer;
 extern size_t g_approx_quantile_centroids;
 extern size_t g_parallel_top_min;
 extern size_t g_parallel_top_max;
+extern size_t g_parallel_sort_min;
+extern bool g_enable_group_by_spill;
+extern bool g_force_group_by_spill;
+extern size_t g_group_by_spill_partitions;
+extern size_t g_group_by_spill_threshold_bytes;
+extern std::string g_spill_path;
+extern size_t g_spill_max_size_bytes;
+extern bool g_enable_chunk_index_snapshot;
 
 namespace Catalog_Namespace {
 extern bool g_log_user_id;
@@ -307,6 +322,63 @@ void CommandLineOptions::fillOptions() {
                           po::value<double>(&g_overlaps_target_entries_per_bin)
                               ->default_value(g_overlaps_target_entries_per_bin),
                           "The target number of hash entries per bin for overlaps join");
+  help_desc.add_options()(
+      "hash-table-cache-max-size-bytes",
+      po::value<size_t>(&g_hash_table_cache_max_size_bytes)
+          ->default_value(g_hash_table_cache_max_size_bytes),
+      "Maximum host memory in bytes held by each join hash table cache (0 = no limit). "
+      "Least recently used hash tables are evicted beyond this size.");
+  help_desc.add_options()(
+      "hash-table-cache-cost-aware-eviction",
+      po::value<bool>(&g_hash_table_cache_cost_aware_eviction)
+          ->default_value(g_hash_table_cache_cost_aware_eviction)
+          ->implicit_value(true),
+      "Evict the cached join hash tables with the lowest build time per byte first "
+      "instead of the least recently used ones.");
+  help_desc.add_options()("enable-result-cache",
+                          po::value<bool>(&g_enable_result_cache)
+                              ->default_value(g_enable_result_cache)
+                              ->implicit_value(true),
+                          "Cache the results of query steps and reuse them until the "
+                          "tables they read change.");
+  help_desc.add_options()(
+      "result-cache-max-size-bytes",
+      po::value<size_t>(&g_result_cache_max_size_bytes)
+          ->default_value(g_result_cache_max_size_bytes),
+      "Maximum host memory in bytes held by the result cache (0 = no limit). Least "
+      "recently used results are evicted beyond this size.");
+  help_desc.add_options()("enable-group-by-spill",
+                          po::value<bool>(&g_enable_group_by_spill)
+                              ->default_value(g_enable_group_by_spill)
+                              ->implicit_value(true),
+                          "Run group by queries which run out of memory on CPU in "
+                          "partitions spilled to local disk.");
+  help_desc.add_options()("spill-path",
+                          po::value<std::string>(&g_spill_path),
+                          "Specify the scratch directory for spilled query results.");
+  help_desc.add_options()(
+      "spill-max-size-bytes",
+      po::value<size_t>(&g_spill_max_size_bytes)->default_value(g_spill_max_size_bytes),
+      "Maximum disk space in bytes a query may spill to (0 = no limit).");
+  help_desc.add_options()(
+      "group-by-spill-threshold-bytes",
+      po::value<size_t>(&g_group_by_spill_threshold_bytes)
+          ->default_value(g_group_by_spill_threshold_bytes),
+      "Maximum host memory in bytes for the group by buffer of a CPU kernel before the "
+      "group by spills to disk (0 = until allocations fail).");
+  help_desc.add_options()(
+      "enable-join-runtime-filters",
+      po::value<bool>(&g_enable_join_runtime_filters)
+          ->default_value(g_enable_join_runtime_filters)
+          ->implicit_value(true),
+      "Skip outer table fragments with no key in the range of the inner keys of a hash "
+      "join and probe a bloom filter of the inner keys before large keyed hash tables.");
+  help_desc.add_options()(
+      "join-bloom-filter-min-hash-table-bytes",
+      po::value<size_t>(&g_join_bloom_filter_min_hash_table_bytes)
+          ->default_value(g_join_bloom_filter_min_hash_table_bytes),
+      "Minimum size in bytes of a keyed CPU join hash table to build a bloom filter of "
+      "its keys for.");
   if (!dist_v5_) {
     help_desc.add_options()("port,p",
                             po::value<int>(&system_parameters.omnisci_server_port)
@@ -321,6 +393,13 @@ void CommandLineOptions::fillOptions() {
       "read-only",
       po::value<bool>(&read_only)->default_value(read_only)->implicit_value(true),
       "Enable read-only mode.");
+  help_desc.add_options()(
+      "enable-chunk-index-snapshot",
+      po::value<bool>(&g_enable_chunk_index_snapshot)
+          ->default_value(g_enable_chunk_index_snapshot)
+          ->implicit_value(true),
+      "Save the chunk index of checkpointed tables when they are closed, so that "
+      "opening them doesn't read the header of every page of their data files.");
 
   help_desc.add_options()(
       "res-gpu-mem",
@@ -371,6 +450,21 @@ void CommandLineOptions::fillOptions() {
       po::value<std::string>(&(disk_cache_level))->default_value("foreign_tables"),
       "Specify level of disk cache. Valid options are 'foreign_tables', "
       "'local_tables', 'none', and 'all'.");
+  help_desc.add_options()("enable-persistent-code-cache",
+                          po::value<bool>(&g_enable_persistent_code_cache)
+                              ->default_value(g_enable_persistent_code_cache)
+                              ->implicit_value(true),
+                          "Store the object code compiled for CPU queries on disk and "
+                          "reuse it after a restart.");
+  help_desc.add_options()("persistent-code-cache-path",
+                          po::value<std::string>(&g_persistent_code_cache_path),
+                          "Specify the path for the persistent code cache.");
+  help_desc.add_options()(
+      "persistent-code-cache-max-size-bytes",
+      po::value<size_t>(&g_persistent_code_cache_max_size_bytes)
+          ->default_value(g_persistent_code_cache_max_size_bytes),
+      "Maximum disk space in bytes used by the persistent code cache (0 = no limit). "
+      "Least recently used entries are removed beyond this size.");
 
   help_desc.add_options()(
       "enable-interoperability",
@@ -394,12 +488,38 @@ void CommandLineOptions::fillOptions() {
                               ->default_value(system_parameters.calcite_keepalive)
                               ->implicit_value(true),
                           "Enable keepalive on Calcite connections.");
+  help_desc.add_options()(
+      "calcite-plan-cache-size",
+      po::value<size_t>(&system_parameters.calcite_plan_cache_size)
+          ->default_value(system_parameters.calcite_plan_cache_size),
+      "Number of Calcite query plans cached by SQL text, reused by queries with the "
+      "same text and literals until a table or view is changed. 0 disables the cache.");
   help_desc.add_options()(
       "stringdict-parallelizm",
       po::value<bool>(&g_enable_stringdict_parallel)
           ->default_value(g_enable_stringdict_parallel)
           ->implicit_value(true),
       "Allow StringDictionary to parallelize loads using multiple threads");
+  help_desc.add_options()(
+      "enable-stringdict-trigram-index",
+      po::value<bool>(&g_enable_stringdict_trigram_index)
+          ->default_value(g_enable_stringdict_trigram_index)
+          ->implicit_value(true),
+      "Index the trigrams of dictionary strings to narrow down the strings tested against "
+      "LIKE patterns with literal substrings.");
+  help_desc.add_options()(
+      "enable-stringdict-hash-table-persistence",
+      po::value<bool>(&g_enable_stringdict_hash_table_persistence)
+          ->default_value(g_enable_stringdict_hash_table_persistence)
+          ->implicit_value(true),
+      "Save the hash tables of string dictionaries when closing them, so that reopening "
+      "them doesn't rehash all their strings.");
+  help_desc.add_options()(
+      "stringdict-pattern-cache-max-bytes",
+      po::value<size_t>(&g_stringdict_pattern_cache_max_bytes)
+          ->default_value(g_stringdict_pattern_cache_max_bytes),
+      "Maximum size of the LIKE and REGEXP results cached by each string dictionary, "
+      "shared by both kinds of patterns.");
   help_desc.add_options()(
       "log-user-id",
       po::value<bool>(&Catalog_Namespace::g_log_user_id)
@@ -438,6 +558,13 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_enable_columnar_output)
           ->implicit_value(true),
       "Enable columnar output for intermediate/final query steps.");
+  developer_desc.add_options()(
+      "enable-columnar-intermediate-results",
+      po::value<bool>(&g_enable_columnar_intermediate_results)
+          ->default_value(g_enable_columnar_intermediate_results)
+          ->implicit_value(true),
+      "Output intermediate projections columnar, so that the next query step reads them "
+      "without converting rows to columns.");
   developer_desc.add_options()(
       "enable-left-join-filter-hoisting",
       po::value<bool>(&g_enable_left_join_filter_hoisting)
@@ -471,6 +598,19 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_enable_smem_group_by)
           ->implicit_value(true),
       "Enable using GPU shared memory for some GROUP BY queries.");
+  developer_desc.add_options()(
+      "enable-cpu-shared-group-by-buffer",
+      po::value<bool>(&g_enable_cpu_shared_group_by_buffer)
+          ->default_value(g_enable_cpu_shared_group_by_buffer)
+          ->implicit_value(true),
+      "Enable inserting into a single hash table from all the CPU threads of some "
+      "GROUP BY queries, instead of one table per thread which are then reduced.");
+  developer_desc.add_options()(
+      "cpu-shared-group-by-buffer-min-entries",
+      po::value<size_t>(&g_cpu_shared_group_by_buffer_min_entries)
+          ->default_value(g_cpu_shared_group_by_buffer_min_entries),
+      "Minimum estimated number of groups of a GROUP BY query to insert into a single "
+      "hash table from all the CPU threads.");
   developer_desc.add_options()("num-executors",
                                po::value<int>(&system_parameters.num_executors)
                                    ->default_value(system_parameters.num_executors),
@@ -510,11 +650,35 @@ void CommandLineOptions::fillAdvancedOptions() {
                                    ->default_value(g_enable_window_functions)
                                    ->implicit_value(true),
                                "Enable experimental window function support.");
+  developer_desc.add_options()(
+      "enable-parallel-window-partition-compute",
+      po::value<bool>(&g_enable_parallel_window_partition_compute)
+          ->default_value(g_enable_parallel_window_partition_compute)
+          ->implicit_value(true),
+      "Sort and evaluate window function partitions on multiple threads.");
+  developer_desc.add_options()(
+      "parallel-window-partition-compute-threshold",
+      po::value<size_t>(&g_parallel_window_partition_compute_threshold)
+          ->default_value(g_parallel_window_partition_compute_threshold),
+      "Minimum number of rows of a window function for its partitions to be computed "
+      "in parallel.");
+  developer_desc.add_options()(
+      "parallel-window-partition-sort-threshold",
+      po::value<size_t>(&g_parallel_window_partition_sort_threshold)
+          ->default_value(g_parallel_window_partition_sort_threshold),
+      "Minimum number of rows of a window function partition for it to be sorted in "
+      "parallel.");
   developer_desc.add_options()("enable-table-functions",
                                po::value<bool>(&g_enable_table_functions)
                                    ->default_value(g_enable_table_functions)
                                    ->implicit_value(true),
                                "Enable experimental table functions support.");
+  developer_desc.add_options()(
+      "parallel-table-function-rows-per-thread",
+      po::value<size_t>(&g_parallel_table_function_rows_per_thread)
+          ->default_value(g_parallel_table_function_rows_per_thread),
+      "Minimum number of input rows per thread when running a parallel table function "
+      "on CPU.");
   developer_desc.add_options()(
       "jit-debug-ir",
       po::value<bool>(&jit_debug)->default_value(jit_debug)->implicit_value(true),
@@ -534,6 +698,32 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_use_tbb_pool)
           ->implicit_value(true),
       "Enable a new thread pool implementation for queuing kernels for execution.");
+  developer_desc.add_options()(
+      "enable-kernel-scheduler",
+      po::value<bool>(&g_enable_kernel_scheduler)
+          ->default_value(g_enable_kernel_scheduler)
+          ->implicit_value(true),
+      "Run CPU kernels of all queries on a shared, fair kernel scheduler instead of "
+      "serializing kernel launches across executors.");
+  developer_desc.add_options()(
+      "kernel-scheduler-max-query-parallelism",
+      po::value<size_t>(&g_kernel_scheduler_max_query_parallelism)
+          ->default_value(g_kernel_scheduler_max_query_parallelism),
+      "Maximum number of kernels of a single query running at once on the kernel "
+      "scheduler (0 = no limit).");
+  developer_desc.add_options()(
+      "enable-parallel-reduction",
+      po::value<bool>(&g_enable_parallel_reduction)
+          ->default_value(g_enable_parallel_reduction)
+          ->implicit_value(true),
+      "Reduce per-kernel results of perfect hash and non-grouped aggregates as a "
+      "parallel pairwise tree instead of folding them one at a time.");
+  developer_desc.add_options()(
+      "concurrent-subquery-executors",
+      po::value<size_t>(&g_concurrent_subquery_executors)
+          ->default_value(g_concurrent_subquery_executors),
+      "Number of helper executors used to run independent uncorrelated subqueries of a "
+      "query concurrently. 0 runs the subqueries one at a time.");
   developer_desc.add_options()(
       "skip-intermediate-count",
       po::value<bool>(&g_skip_intermediate_count)
@@ -611,6 +801,18 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_fraction_code_cache_to_evict),
       "Percentage of the GPU code cache to evict if an out of memory error is "
       "encountered while attempting to place generated code on the GPU.");
+  developer_desc.add_options()(
+      "enable-batch-cpu-codegen",
+      po::value<bool>(&g_enable_batch_cpu_codegen)
+          ->default_value(g_enable_batch_cpu_codegen)
+          ->implicit_value(true),
+      "Generate CPU kernels for non-grouped aggregates which scan their rows in fixed "
+      "size batches and run the LLVM loop vectorizer over each batch.");
+  developer_desc.add_options()(
+      "batch-cpu-codegen-size",
+      po::value<size_t>(&g_batch_cpu_codegen_size)
+          ->default_value(g_batch_cpu_codegen_size),
+      "Number of rows in a batch when enable-batch-cpu-codegen is set.");
 
   developer_desc.add_options()("ssl-cert",
                                po::value<std::string>(&system_parameters.ssl_cert_file)
@@ -732,6 +934,22 @@ void CommandLineOptions::fillAdvancedOptions() {
       po::value<size_t>(&g_parallel_top_max)->default_value(g_parallel_top_max),
       "For ResultSets requiring a heap sort, the maximum number of rows allowed by "
       "watchdog.");
+  developer_desc.add_options()(
+      "parallel-sort-min",
+      po::value<size_t>(&g_parallel_sort_min)->default_value(g_parallel_sort_min),
+      "For ResultSets requiring a full sort, the number of rows necessary to trigger "
+      "parallelSort() to sort.");
+  developer_desc.add_options()(
+      "group-by-spill-partitions",
+      po::value<size_t>(&g_group_by_spill_partitions)
+          ->default_value(g_group_by_spill_partitions),
+      "Initial number of partitions of a group by spilled to disk.");
+  developer_desc.add_options()("force-group-by-spill",
+                               po::value<bool>(&g_force_group_by_spill)
+                                   ->default_value(g_force_group_by_spill)
+                                   ->implicit_value(true),
+                               "Spill every group by which can be spilled, for testing. "
+                               "Requires --enable-group-by-spill.");
   developer_desc.add_options()("vacuum-min-selectivity",
                                po::value<float>(&g_vacuum_min_selectivity)
                                    ->default_value(g_vacuum_min_selectivity),
@@ -921,6 +1139,22 @@ void CommandLineOptions::validate() {
   }
   ddl_utils::FilePathBlacklist::addToBlacklist(disk_cache_config.path);
 
+  if (g_persistent_code_cache_path.empty()) {
+    g_persistent_code_cache_path = base_path + "/omnisci_code_cache";
+  }
+  ddl_utils::FilePathBlacklist::addToBlacklist(g_persistent_code_cache_path);
+  if (g_enable_persistent_code_cache) {
+    LOG(INFO) << "Persistent code cache enabled at " << g_persistent_code_cache_path;
+  }
+
+  if (g_spill_path.empty()) {
+    g_spill_path = base_path + "/omnisci_spill";
+  }
+  ddl_utils::FilePathBlacklist::addToBlacklist(g_spill_path);
+  if (g_enable_group_by_spill) {
+    LOG(INFO) << "Group by spill enabled at " << g_spill_path;
+  }
+
   ddl_utils::FilePathBlacklist::addToBlacklist("/etc/passwd");
   ddl_utils::FilePathBlacklist::addToBlacklist("/etc/shadow");
 
@@ -1124,6 +1358,7 @@ boost::optional<int> CommandLineOptions::parse_command_line(
             << (authMetadata.allowLocalAuthFallback ? "enabled" : "disabled");
   LOG(INFO) << " ParallelTop min threshold: " << g_parallel_top_min;
   LOG(INFO) << " ParallelTop watchdog max: " << g_parallel_top_max;
+  LOG(INFO) << " ParallelSort min threshold: " << g_parallel_sort_min;
 
   boost::algorithm::trim_if(authMetadata.distinguishedName, boost::is_any_of("\"'"));
   boost::algorithm::trim_if(authMetadata.uri, boost::is_any_of("\"'"));
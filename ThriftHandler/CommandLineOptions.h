@@ -157,16 +157,25 @@ extern float g_filter_push_down_low_frac;
 extern float g_filter_push_down_high_frac;
 extern size_t g_filter_push_down_passing_row_ubound;
 extern bool g_enable_columnar_output;
+extern bool g_enable_columnar_intermediate_results;
 extern bool g_optimize_row_initialization;
 extern bool g_enable_overlaps_hashjoin;
 extern bool g_enable_hashjoin_many_to_many;
 extern size_t g_overlaps_max_table_size_bytes;
+extern size_t g_hash_table_cache_max_size_bytes;
+extern bool g_hash_table_cache_cost_aware_eviction;
+extern bool g_enable_join_runtime_filters;
+extern size_t g_join_bloom_filter_min_hash_table_bytes;
 extern double g_overlaps_target_entries_per_bin;
 extern bool g_strip_join_covered_quals;
 extern size_t g_constrained_by_in_threshold;
 extern size_t g_big_group_threshold;
 extern bool g_enable_window_functions;
+extern bool g_enable_parallel_window_partition_compute;
+extern size_t g_parallel_window_partition_compute_threshold;
+extern size_t g_parallel_window_partition_sort_threshold;
 extern bool g_enable_table_functions;
+extern size_t g_parallel_table_function_rows_per_thread;
 extern size_t g_max_memory_allocation_size;
 extern double g_bump_allocator_step_reduction;
 extern bool g_enable_direct_columnarization;
@@ -196,7 +205,11 @@ extern bool g_enable_fsi;
 extern bool g_enable_s3_fsi;
 extern bool g_enable_interop;
 extern bool g_enable_union;
+extern size_t g_concurrent_subquery_executors;
 extern bool g_use_tbb_pool;
+extern bool g_enable_kernel_scheduler;
+extern size_t g_kernel_scheduler_max_query_parallelism;
+extern bool g_enable_parallel_reduction;
 extern bool g_enable_filter_function;
 extern size_t g_max_import_threads;
 extern bool g_enable_auto_metadata_update;
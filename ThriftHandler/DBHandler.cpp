@@ -5576,6 +5576,7 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
   const auto rs = _return.getRows();
   if (rs) {
     execution_time_ms -= rs->getQueueTime();
+    VLOG(1) << "Result set reduction took " << rs->getReductionTime() << " ms.";
   }
   _return.setExecutionTime(execution_time_ms);
   VLOG(1) << cat.getDataMgr().getSystemMemoryUsage();
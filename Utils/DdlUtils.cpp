@@ -426,6 +426,38 @@ void validate_and_set_date_encoding(ColumnDescriptor& cd, int encoding_size) {
   cd.columnType.set_comp_param((encoding_size == 16) ? 16 : 0);
 }
 
+void validate_and_set_run_length_or_diff_encoding(ColumnDescriptor& cd,
+                                                   const EncodingType encoding,
+                                                   int encoding_size) {
+  const auto type = cd.columnType.get_type();
+  const auto encoding_name =
+      encoding == kENCODING_RL ? std::string("RL") : std::string("DIFF");
+  if (!IS_INTEGER(type) && !is_datetime(type) &&
+      !(type == kDECIMAL || type == kNUMERIC)) {
+    throw std::runtime_error(cd.columnName + ": " + encoding_name +
+                             " encoding is only supported for integer, decimal or time "
+                             "columns.");
+  }
+  if (encoding == kENCODING_RL) {
+    if (encoding_size != 0) {
+      throw std::runtime_error(cd.columnName +
+                               ": RL encoding does not take a compression parameter.");
+    }
+  } else {
+    // the width of the deltas new chunks start with, they are widened as needed
+    if (encoding_size == 0) {
+      encoding_size = 16;
+    }
+    if (encoding_size != 8 && encoding_size != 16 && encoding_size != 32) {
+      throw std::runtime_error(cd.columnName +
+                               ": Compression parameter for DIFF encoding must be 8, 16 "
+                               "or 32.");
+    }
+  }
+  cd.columnType.set_compression(encoding);
+  cd.columnType.set_comp_param(encoding_size);
+}
+
 void validate_and_set_encoding(ColumnDescriptor& cd,
                                const Encoding* encoding,
                                const SqlType* column_type) {
@@ -437,14 +469,12 @@ void validate_and_set_encoding(ColumnDescriptor& cd,
       validate_and_set_fixed_encoding(cd, encoding->get_encoding_param(), column_type);
     } else if (boost::iequals(comp, "rl")) {
       // run length encoding
-      cd.columnType.set_compression(kENCODING_RL);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("RL(Run Length) encoding not supported yet.");
+      validate_and_set_run_length_or_diff_encoding(
+          cd, kENCODING_RL, encoding->get_encoding_param());
     } else if (boost::iequals(comp, "diff")) {
       // differential encoding
-      cd.columnType.set_compression(kENCODING_DIFF);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("DIFF(differential) encoding not supported yet.");
+      validate_and_set_run_length_or_diff_encoding(
+          cd, kENCODING_DIFF, encoding->get_encoding_param());
     } else if (boost::iequals(comp, "dict")) {
       validate_and_set_dictionary_encoding(cd, encoding->get_encoding_param());
     } else if (boost::iequals(comp, "NONE")) {
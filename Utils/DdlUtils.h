@@ -122,6 +122,10 @@ void validate_and_set_compressed_encoding(ColumnDescriptor& cd, int encoding_siz
 
 void validate_and_set_date_encoding(ColumnDescriptor& cd, int encoding_size);
 
+void validate_and_set_run_length_or_diff_encoding(ColumnDescriptor& cd,
+                                                   const EncodingType encoding,
+                                                   int encoding_size);
+
 void validate_and_set_encoding(ColumnDescriptor& cd,
                                const Encoding* encoding,
                                const SqlType* column_type);
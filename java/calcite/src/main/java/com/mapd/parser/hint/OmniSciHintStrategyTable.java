@@ -17,6 +17,8 @@ public class OmniSciHintStrategyTable {
             .hintStrategy("overlaps_allow_gpu_build", HintPredicates.SET_VAR)
             .hintStrategy("overlaps_no_cache", HintPredicates.SET_VAR)
             .hintStrategy("overlaps_keys_per_bin", HintPredicates.SET_VAR)
+            .hintStrategy("kernel_priority", HintPredicates.SET_VAR)
+            .hintStrategy("max_kernel_parallelism", HintPredicates.SET_VAR)
             .build();
   }
 }